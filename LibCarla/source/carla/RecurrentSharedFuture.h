@@ -12,9 +12,10 @@
 #include <boost/optional.hpp>
 #include <boost/variant.hpp>
 
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <exception>
-#include <map>
 #include <mutex>
 
 namespace carla {
@@ -31,6 +32,11 @@ namespace detail {
 
   /// This class is meant to be used similar to a shared future, but the value
   /// can be set any number of times.
+  ///
+  /// Only the latest value is kept, in a single slot shared by all the
+  /// waiters. Each call to SetValue increments a generation counter, a waiter
+  /// wakes up once the generation differs from the one it saw when it started
+  /// waiting.
   template <typename T>
   class RecurrentSharedFuture {
   public:
@@ -38,7 +44,8 @@ namespace detail {
     using SharedException = detail::SharedException;
 
     /// Wait until the next value is set. Any number of threads can be waiting
-    /// simultaneously.
+    /// simultaneously. If several values are set before the thread wakes up,
+    /// only the latest is returned.
     ///
     /// @return empty optional if the timeout is met.
     boost::optional<T> WaitFor(time_duration timeout);
@@ -61,12 +68,11 @@ namespace detail {
 
     std::condition_variable _cv;
 
-    struct mapped_type {
-      bool should_wait;
-      boost::variant<T, SharedException> value;
-    };
+    /// Incremented each time a value is set. Modified only while holding the
+    /// mutex, but it can be read without it.
+    std::atomic<uint64_t> _generation{0u};
 
-    std::map<const char *, mapped_type> _map;
+    boost::variant<T, SharedException> _value;
   };
 
   // ===========================================================================
@@ -75,8 +81,6 @@ namespace detail {
 
 namespace detail {
 
-  static thread_local const char thread_tag{};
-
   class SharedException : public std::exception {
   public:
 
@@ -102,26 +106,31 @@ namespace detail {
 
   template <typename T>
   boost::optional<T> RecurrentSharedFuture<T>::WaitFor(time_duration timeout) {
+    // Any value set after this point wakes us up, no need to hold the lock
+    // for reading the generation.
+    const auto generation = _generation.load(std::memory_order_acquire);
     std::unique_lock<std::mutex> lock(_mutex);
-    auto &r = _map[&detail::thread_tag];
-    r.should_wait = true;
-    if (!_cv.wait_for(lock, timeout.to_chrono(), [&]() { return !r.should_wait; })) {
+    if (!_cv.wait_for(lock, timeout.to_chrono(), [&]() {
+          return _generation.load(std::memory_order_relaxed) != generation;
+        })) {
       return {};
     }
-    if (r.value.which() == 1) {
-      throw_exception(boost::get<SharedException>(r.value));
+    if (_value.which() == 1) {
+      throw_exception(boost::get<SharedException>(_value));
     }
-    return boost::get<T>(std::move(r.value));
+    return boost::get<T>(_value);
   }
 
   template <typename T>
   template <typename T2>
   void RecurrentSharedFuture<T>::SetValue(const T2 &value) {
-    std::lock_guard<std::mutex> lock(_mutex);
-    for (auto &pair : _map) {
-      pair.second.should_wait = false;
-      pair.second.value = value;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _value = value;
+      _generation.fetch_add(1u, std::memory_order_release);
     }
+    // Notify after releasing the lock so the threads woken up don't block
+    // again on the mutex.
     _cv.notify_all();
   }
 
@@ -0,0 +1,38 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Memory.h"
+#include "carla/client/ActorList.h"
+
+#include <vector>
+
+namespace carla {
+namespace client {
+
+  /// Actors spawned and destroyed in the world since a given frame.
+  class ActorChanges {
+  public:
+
+    /// Latest frame covered by these changes.
+    size_t frame_count = 0u;
+
+    /// Actors spawned since the given frame and still alive.
+    SharedPtr<ActorList> spawned;
+
+    /// Ids of the actors destroyed since the given frame.
+    std::vector<ActorId> destroyed;
+
+    /// True if the changes since the given frame are no longer available,
+    /// e.g. the frame is too old or belongs to a previous episode. Some
+    /// destroyed actors may be missing, the list of actors should be
+    /// retrieved again with World::GetActors.
+    bool truncated = false;
+  };
+
+} // namespace client
+} // namespace carla
@@ -0,0 +1,89 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/ActorStateArrays.h"
+
+#include "carla/client/detail/EpisodeState.h"
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  static void AppendVector(std::vector<float> &out, const geom::Vector3D &v) {
+    out.emplace_back(v.x);
+    out.emplace_back(v.y);
+    out.emplace_back(v.z);
+  }
+
+  static void AppendControl(
+      std::vector<float> &out,
+      const rpc::VehicleControl &control) {
+    out.emplace_back(control.throttle);
+    out.emplace_back(control.steer);
+    out.emplace_back(control.brake);
+    out.emplace_back(control.hand_brake ? 1.0f : 0.0f);
+    out.emplace_back(control.reverse ? 1.0f : 0.0f);
+    out.emplace_back(static_cast<float>(control.gear));
+  }
+
+  ActorStateArrays PackActorStates(
+      const EpisodeState &state,
+      const std::vector<ActorId> &ids,
+      const uint32_t fields,
+      const std::unordered_set<ActorId> &vehicles) {
+    ActorStateArrays result;
+    result.frame_count = state.GetFrameCount();
+    result.ids = ids;
+    result.valid.reserve(ids.size());
+    auto reserve = [&](ActorStateArrays::Field field, std::vector<float> &v, size_t n) {
+      if (fields & field) {
+        v.reserve(n * ids.size());
+      }
+    };
+    reserve(ActorStateArrays::Location, result.locations, 3u);
+    reserve(ActorStateArrays::Rotation, result.rotations, 3u);
+    reserve(ActorStateArrays::Velocity, result.velocities, 3u);
+    reserve(ActorStateArrays::AngularVelocity, result.angular_velocities, 3u);
+    reserve(ActorStateArrays::Acceleration, result.accelerations, 3u);
+    reserve(ActorStateArrays::VehicleControl, result.vehicle_controls, 6u);
+
+    const EpisodeState::ActorState empty_state{};
+    for (auto id : ids) {
+      const auto *actor = state.FindActorState(id);
+      result.valid.emplace_back(actor != nullptr ? 1u : 0u);
+      const auto &data = (actor != nullptr ? *actor : empty_state);
+      if (fields & ActorStateArrays::Location) {
+        AppendVector(result.locations, data.transform.location);
+      }
+      if (fields & ActorStateArrays::Rotation) {
+        const auto &rotation = data.transform.rotation;
+        result.rotations.emplace_back(rotation.pitch);
+        result.rotations.emplace_back(rotation.yaw);
+        result.rotations.emplace_back(rotation.roll);
+      }
+      if (fields & ActorStateArrays::Velocity) {
+        AppendVector(result.velocities, data.velocity);
+      }
+      if (fields & ActorStateArrays::AngularVelocity) {
+        AppendVector(result.angular_velocities, data.angular_velocity);
+      }
+      if (fields & ActorStateArrays::Acceleration) {
+        AppendVector(result.accelerations, data.acceleration);
+      }
+      if (fields & ActorStateArrays::VehicleControl) {
+        AppendControl(
+            result.vehicle_controls,
+            (actor != nullptr) && (vehicles.count(id) > 0u) ?
+                rpc::VehicleControl(data.state.vehicle_data.control) :
+                rpc::VehicleControl{});
+      }
+    }
+    return result;
+  }
+
+} // namespace detail
+} // namespace client
+} // namespace carla
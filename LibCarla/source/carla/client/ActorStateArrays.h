@@ -0,0 +1,85 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/rpc/ActorId.h"
+
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+namespace carla {
+namespace client {
+
+  /// State of a list of actors at a single frame, stored as a structure of
+  /// arrays. Each array holds the values of every actor contiguously, in the
+  /// same order the ids were requested, e.g. locations are stored as
+  /// [x0, y0, z0, x1, y1, z1, ...].
+  ///
+  /// Only the arrays of the fields requested are filled, the rest are left
+  /// empty.
+  class ActorStateArrays {
+  public:
+
+    /// Can be used as flags
+    enum Field : uint32_t {
+      None            = 0u,
+      Location        = 1u << 0u,
+      Rotation        = 1u << 1u,
+      Velocity        = 1u << 2u,
+      AngularVelocity = 1u << 3u,
+      Acceleration    = 1u << 4u,
+      VehicleControl  = 1u << 5u,
+      All             = (1u << 6u) - 1u
+    };
+
+    /// Frame at which the state was taken.
+    std::size_t frame_count = 0u;
+
+    /// Ids of the actors, in the order requested.
+    std::vector<ActorId> ids;
+
+    /// 1 if the actor was found in the episode, 0 otherwise. The values of the
+    /// actors not found are set to zero.
+    std::vector<uint8_t> valid;
+
+    /// [x, y, z] per actor.
+    std::vector<float> locations;
+
+    /// [pitch, yaw, roll] per actor.
+    std::vector<float> rotations;
+
+    /// [x, y, z] per actor.
+    std::vector<float> velocities;
+
+    /// [x, y, z] per actor.
+    std::vector<float> angular_velocities;
+
+    /// [x, y, z] per actor.
+    std::vector<float> accelerations;
+
+    /// [throttle, steer, brake, hand_brake, reverse, gear] per actor. Only
+    /// meaningful for vehicles, zero for any other actor.
+    std::vector<float> vehicle_controls;
+  };
+
+namespace detail {
+
+  class EpisodeState;
+
+  /// Pack the state in @a state of the actors @a ids. Only the @a fields
+  /// requested are filled, and only the actors in @a vehicles get a vehicle
+  /// control.
+  ActorStateArrays PackActorStates(
+      const EpisodeState &state,
+      const std::vector<ActorId> &ids,
+      uint32_t fields,
+      const std::unordered_set<ActorId> &vehicles);
+
+} // namespace detail
+} // namespace client
+} // namespace carla
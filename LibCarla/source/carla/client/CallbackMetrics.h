@@ -0,0 +1,42 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <cstdint>
+
+namespace carla {
+namespace client {
+
+  /// Statistics of a callback registered in the world. Times are given in
+  /// seconds.
+  class CallbackMetrics {
+  public:
+
+    /// Id returned when the callback was registered.
+    std::size_t id = 0u;
+
+    /// Number of times the callback has been executed.
+    std::size_t call_count = 0u;
+
+    /// Number of calls discarded because a more recent one was queued for the
+    /// same callback (only if the callback coalesces calls).
+    std::size_t dropped_count = 0u;
+
+    /// Time elapsed between the tick being received and the callback starting
+    /// execution.
+    double mean_queue_time = 0.0;
+
+    double max_queue_time = 0.0;
+
+    /// Time spent executing the callback.
+    double mean_execution_time = 0.0;
+
+    double max_execution_time = 0.0;
+  };
+
+} // namespace client
+} // namespace carla
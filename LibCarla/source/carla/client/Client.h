@@ -33,6 +33,15 @@ namespace client {
       _simulator->SetNetworkingTimeout(timeout);
     }
 
+    /// Deserialize the data received from the sensors in @a worker_threads
+    /// dedicated threads, keeping the networking threads free to read from
+    /// the sockets. The data of each sensor is always deserialized by the
+    /// same thread and in the order it was received. Only affects the
+    /// sensors that start listening afterwards, and can be set only once.
+    void SetDeserializationWorkerThreads(size_t worker_threads) {
+      _simulator->SetDeserializationWorkerThreads(worker_threads);
+    }
+
     /// Return the version string of this client API.
     std::string GetClientVersion() const {
       return _simulator->GetClientVersion();
@@ -88,6 +97,25 @@ namespace client {
       _simulator->ApplyBatch(std::move(commands), do_tick_cue);
     }
 
+    /// Apply @a commands and wait for the response to each of them, the id of
+    /// the actor the command applied to or the error. Commands executed after
+    /// a SpawnActor command (SpawnActor::do_after) follow its response.
+    std::vector<rpc::CommandResponse> ApplyBatchSync(
+        std::vector<rpc::Command> commands,
+        bool do_tick_cue = false) const {
+      return _simulator->ApplyBatchSync(std::move(commands), do_tick_cue);
+    }
+
+    /// Apply @a commands and signal the simulator to continue to next tick
+    /// (synchronous mode). Returns as soon as the commands are applied, so
+    /// the commands of the next frame can be prepared while this one is
+    /// being simulated.
+    ///
+    /// @return the frame number of the frame simulated with these commands.
+    uint64_t ApplyBatchAndTick(std::vector<rpc::Command> commands) const {
+      return _simulator->ApplyBatchAndTick(std::move(commands));
+    }
+
   private:
 
     std::shared_ptr<detail::Simulator> _simulator;
@@ -0,0 +1,214 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Debug.h"
+#include "carla/NonCopyable.h"
+#include "carla/Time.h"
+
+#include <boost/optional.hpp>
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  // ===========================================================================
+  // -- FutureState ------------------------------------------------------------
+  // ===========================================================================
+
+  /// Shared state of a Future, implemented by the source of the value.
+  template <typename T>
+  class FutureState : private NonCopyable {
+  public:
+
+    virtual ~FutureState() = default;
+
+    /// Wait up to @a timeout for the value, return whether it is ready.
+    virtual bool WaitFor(time_duration timeout) = 0;
+
+    /// Block until the value is ready and return it, or throw the error of
+    /// the operation if it failed. May be called any number of times.
+    virtual T Get() = 0;
+  };
+
+  /// A FutureState that computes its value (or error) on the first call to
+  /// Get and returns the same for the following calls.
+  template <typename T>
+  class CachedFutureState : public FutureState<T> {
+  public:
+
+    T Get() override {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (!_value.has_value() && (_error == nullptr)) {
+        try {
+          _value = Compute();
+        } catch (...) {
+          _error = std::current_exception();
+        }
+      }
+      if (_error != nullptr) {
+        std::rethrow_exception(_error);
+      }
+      return *_value;
+    }
+
+  protected:
+
+    virtual T Compute() = 0;
+
+    /// Whether Get has already computed the value, or the error.
+    bool IsComputed() {
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _value.has_value() || (_error != nullptr);
+    }
+
+  private:
+
+    std::mutex _mutex;
+
+    boost::optional<T> _value;
+
+    std::exception_ptr _error;
+  };
+
+  template <typename T>
+  class ReadyFutureState final : public FutureState<T> {
+  public:
+
+    explicit ReadyFutureState(T value) : _value(std::move(value)) {}
+
+    bool WaitFor(time_duration) override {
+      return true;
+    }
+
+    T Get() override {
+      return _value;
+    }
+
+  private:
+
+    const T _value;
+  };
+
+} // namespace detail
+
+  // ===========================================================================
+  // -- Future -----------------------------------------------------------------
+  // ===========================================================================
+
+  /// Result of an operation sent to the simulator without waiting for its
+  /// response. Futures are cheap to copy, all the copies share the same
+  /// result.
+  ///
+  /// Errors of the operation, including a timeout waiting for its response,
+  /// are thrown by Get.
+  template <typename T>
+  class Future {
+  public:
+
+    using value_type = T;
+
+    Future() = default;
+
+    explicit Future(std::shared_ptr<detail::FutureState<T>> state)
+      : _state(std::move(state)) {}
+
+    /// A future holding an already available @a value.
+    static Future MakeReady(T value) {
+      return Future{std::make_shared<detail::ReadyFutureState<T>>(std::move(value))};
+    }
+
+    bool IsValid() const {
+      return _state != nullptr;
+    }
+
+    /// Whether the result is available, i.e. Get won't block.
+    bool IsReady() const {
+      return WaitFor(time_duration::milliseconds(0u));
+    }
+
+    /// Wait up to @a timeout for the result, return whether it is available.
+    bool WaitFor(time_duration timeout) const {
+      DEBUG_ASSERT(IsValid());
+      return _state->WaitFor(timeout);
+    }
+
+    /// Block until the result is available and return it.
+    T Get() const {
+      DEBUG_ASSERT(IsValid());
+      return _state->Get();
+    }
+
+    /// Return a future whose value is @a function applied to the value of
+    /// this one. The function is called by the first thread calling Get.
+    template <typename F>
+    auto Then(F function) const {
+      using result_type = typename std::decay<decltype(function(std::declval<T>()))>::type;
+      return Future<result_type>{std::make_shared<ThenState<result_type>>(*this, std::move(function))};
+    }
+
+  private:
+
+    template <typename U>
+    class ThenState final : public detail::CachedFutureState<U> {
+    public:
+
+      ThenState(Future parent, std::function<U(T)> function)
+        : _parent(std::move(parent)),
+          _function(std::move(function)) {}
+
+      bool WaitFor(time_duration timeout) override {
+        return _parent.WaitFor(timeout);
+      }
+
+    private:
+
+      U Compute() override {
+        return _function(_parent.Get());
+      }
+
+      const Future _parent;
+
+      const std::function<U(T)> _function;
+    };
+
+    std::shared_ptr<detail::FutureState<T>> _state;
+  };
+
+  /// Wait for every one of @a futures and return their values, in the same
+  /// order. If any of the operations failed, its error is thrown once all of
+  /// them have completed; if several failed, the first one in @a futures.
+  template <typename T>
+  std::vector<T> WhenAll(const std::vector<Future<T>> &futures) {
+    std::vector<T> result;
+    result.reserve(futures.size());
+    std::exception_ptr error;
+    for (auto &future : futures) {
+      try {
+        result.emplace_back(future.Get());
+      } catch (...) {
+        if (error == nullptr) {
+          error = std::current_exception();
+        }
+      }
+    }
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+    return result;
+  }
+
+} // namespace client
+} // namespace carla
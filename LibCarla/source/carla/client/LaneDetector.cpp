@@ -7,41 +7,20 @@
 #include "carla/client/LaneDetector.h"
 
 #include "carla/Logging.h"
-#include "carla/client/Map.h"
 #include "carla/client/Vehicle.h"
+#include "carla/client/detail/LaneInvasionService.h"
 #include "carla/client/detail/Simulator.h"
-#include "carla/geom/Math.h"
 #include "carla/sensor/data/LaneInvasionEvent.h"
 
-#include <exception>
-
 namespace carla {
 namespace client {
 
-  static geom::Location Rotate(float yaw, const geom::Location &location) {
-    yaw *= geom::Math::pi() / 180.0f;
-    const float c = std::cos(yaw);
-    const float s = std::sin(yaw);
-    return {
-        c * location.x - s * location.y,
-        s * location.x + c * location.y,
-        location.z};
-  }
-
-  static std::array<geom::Location, 4u> GetVehicleBounds(const Vehicle &vehicle) {
-    const auto &box = vehicle.GetBoundingBox();
-    const auto &transform = vehicle.GetTransform();
-    const auto location = transform.location + box.location;
-    const auto yaw = transform.rotation.yaw;
-    return {
-        location + Rotate(yaw, geom::Location( box.extent.x,  box.extent.y, 0.0f)),
-        location + Rotate(yaw, geom::Location(-box.extent.x,  box.extent.y, 0.0f)),
-        location + Rotate(yaw, geom::Location( box.extent.x, -box.extent.y, 0.0f)),
-        location + Rotate(yaw, geom::Location(-box.extent.x, -box.extent.y, 0.0f))};
+  LaneDetector::~LaneDetector() {
+    if (_service != nullptr) {
+      _service->Unsubscribe(_subscription_id);
+    }
   }
 
-  LaneDetector::~LaneDetector() = default;
-
   void LaneDetector::Listen(CallbackFunctionType callback) {
     if (_is_listening) {
       log_error(GetDisplayId(), ": already listening");
@@ -54,53 +33,38 @@ namespace client {
       return;
     }
 
-    _map = GetWorld().GetMap();
-    DEBUG_ASSERT(_map != nullptr);
+    _service = GetEpisode().Lock()->GetLaneInvasionService();
+    DEBUG_ASSERT(_service != nullptr);
 
     auto self = boost::static_pointer_cast<LaneDetector>(shared_from_this());
 
-    log_debug(GetDisplayId(), ": subscribing to tick event");
-    GetEpisode().Lock()->RegisterOnTickEvent([
-        cb=std::move(callback),
-        weak_self=WeakPtr<LaneDetector>(self)](const auto &timestamp) {
+    log_debug(GetDisplayId(), ": subscribing to lane invasion service");
+    _subscription_id = _service->Subscribe(
+        _vehicle->GetId(),
+        _vehicle->GetBoundingBox(),
+        [cb=std::move(callback), weak_self=WeakPtr<LaneDetector>(self)](
+            const auto &timestamp,
+            const auto &transform,
+            auto crossed_lanes) {
       auto self = weak_self.lock();
       if (self != nullptr) {
-        auto data = self->TickLaneDetector(timestamp);
-        if (data != nullptr) {
-          cb(std::move(data));
-        }
+        cb(MakeShared<sensor::data::LaneInvasionEvent>(
+            timestamp.frame_count,
+            timestamp.elapsed_seconds,
+            transform,
+            self->_vehicle,
+            std::move(crossed_lanes)));
       }
     });
     _is_listening = true;
   }
 
   void LaneDetector::Stop() {
-    throw_exception(std::runtime_error("LaneDetector::Stop(): not implemented."));
-  }
-
-  SharedPtr<sensor::SensorData> LaneDetector::TickLaneDetector(
-      const Timestamp &timestamp) {
-    try {
-      const auto new_bounds = GetVehicleBounds(*_vehicle);
-      std::vector<road::element::LaneMarking> crossed_lanes;
-      for (auto i = 0u; i < _bounds.size(); ++i) {
-        const auto lanes = _map->CalculateCrossedLanes(_bounds[i], new_bounds[i]);
-        crossed_lanes.insert(crossed_lanes.end(), lanes.begin(), lanes.end());
-      }
-      _bounds = new_bounds;
-      return crossed_lanes.empty() ?
-          nullptr :
-          MakeShared<sensor::data::LaneInvasionEvent>(
-              timestamp.frame_count,
-              timestamp.elapsed_seconds,
-              _vehicle->GetTransform(),
-              _vehicle,
-              crossed_lanes);
-    } catch (const std::exception &e) {
-      /// @todo We need to unsubscribe the sensor.
-      // log_error("LaneDetector:", e.what());
-      return nullptr;
+    if (_service != nullptr) {
+      _service->Unsubscribe(_subscription_id);
+      _service = nullptr;
     }
+    _is_listening = false;
   }
 
 } // namespace client
@@ -7,16 +7,20 @@
 #pragma once
 
 #include "carla/client/ClientSideSensor.h"
-#include "carla/geom/Location.h"
 
-#include <array>
+#include <memory>
 
 namespace carla {
 namespace client {
 
-  class Map;
   class Vehicle;
 
+namespace detail {
+
+  class LaneInvasionService;
+
+} // namespace detail
+
   class LaneDetector final : public ClientSideSensor {
   public:
 
@@ -32,7 +36,6 @@ namespace client {
     void Listen(CallbackFunctionType callback) override;
 
     /// Stop listening for new measurements.
-    /// @throw Not implemented error.
     void Stop() override;
 
     /// Return whether this Sensor instance is currently listening to the
@@ -43,15 +46,15 @@ namespace client {
 
   private:
 
-    SharedPtr<sensor::SensorData> TickLaneDetector(const Timestamp &timestamp);
-
     bool _is_listening = false;
 
-    SharedPtr<Map> _map;
-
     SharedPtr<Vehicle> _vehicle;
 
-    std::array<geom::Location, 4u> _bounds;
+    /// The lane invasions of every vehicle are computed together by this
+    /// service, this sensor only subscribes to it.
+    std::shared_ptr<detail::LaneInvasionService> _service;
+
+    size_t _subscription_id = 0u;
   };
 
 } // namespace client
@@ -0,0 +1,425 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/LaneOccupancyIndex.h"
+
+#include "carla/Debug.h"
+#include "carla/geom/Math.h"
+#include "carla/road/Map.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <tuple>
+
+namespace carla {
+namespace client {
+
+  using road::element::WaypointHandle;
+  using road::element::id_type;
+
+  // ===========================================================================
+  // -- Static local methods ---------------------------------------------------
+  // ===========================================================================
+
+  /// Actors that moved less than this since the previous update keep their
+  /// lane without looking it up again [meters].
+  static constexpr double STILL_DISTANCE = 1e-2;
+
+  static auto LaneKey(const WaypointHandle &waypoint) {
+    return std::make_tuple(waypoint.road_id, waypoint.lane_id);
+  }
+
+  static bool IsBefore(const LaneOccupant &lhs, const LaneOccupant &rhs) {
+    return std::tie(lhs.waypoint.road_id, lhs.waypoint.lane_id, lhs.waypoint.s, lhs.id) <
+           std::tie(rhs.waypoint.road_id, rhs.waypoint.lane_id, rhs.waypoint.s, rhs.id);
+  }
+
+  /// Sort @a items, of which the first @a number_of_sorted are in the order of
+  /// the previous update. Most of them keep their place between updates, the
+  /// insertion sort of those is close to linear; the rest are sorted apart
+  /// and merged.
+  template <typename T, typename CompareT>
+  static void SortIncrementally(std::vector<T> &items, size_t number_of_sorted, CompareT compare) {
+    DEBUG_ASSERT(number_of_sorted <= items.size());
+    for (auto i = 1u; i < number_of_sorted; ++i) {
+      auto item = std::move(items[i]);
+      auto j = i;
+      for (; (j > 0u) && compare(item, items[j - 1u]); --j) {
+        items[j] = std::move(items[j - 1u]);
+      }
+      items[j] = std::move(item);
+    }
+    const auto middle = items.begin() + static_cast<std::ptrdiff_t>(number_of_sorted);
+    std::sort(middle, items.end(), compare);
+    std::inplace_merge(items.begin(), middle, items.end(), compare);
+  }
+
+  /// Key of the cell (@a x, @a y), the sign bits are flipped so that the
+  /// cells of a column are sorted by y.
+  static uint64_t MakeCellKey(int64_t x, int64_t y) {
+    constexpr uint32_t sign = 0x80000000u;
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x) ^ sign) << 32u) |
+           (static_cast<uint32_t>(y) ^ sign);
+  }
+
+  // ===========================================================================
+  // -- LaneOccupancyIndex::Snapshot -------------------------------------------
+  // ===========================================================================
+
+  struct LaneOccupancyIndex::Snapshot {
+
+    size_t frame_count = 0u;
+
+    /// Sorted by road, lane, distance along the road and id.
+    std::vector<LaneOccupant> occupants;
+
+    /// (id, index in occupants) sorted by id.
+    std::vector<std::pair<ActorId, uint32_t>> ids;
+
+    /// (cell, index in occupants) sorted by cell.
+    std::vector<std::pair<uint64_t, uint32_t>> cells;
+
+    const LaneOccupant *Find(ActorId id) const {
+      const auto it = std::lower_bound(ids.begin(), ids.end(), std::make_pair(id, 0u));
+      return ((it != ids.end()) && (it->first == id)) ? &occupants[it->second] : nullptr;
+    }
+
+    /// Range of occupants of a lane.
+    std::pair<const LaneOccupant *, const LaneOccupant *> GetLane(id_type road_id, int lane_id) const {
+      const auto key = std::make_tuple(road_id, lane_id);
+      const auto range = std::equal_range(
+          occupants.begin(),
+          occupants.end(),
+          key,
+          [](const auto &lhs, const auto &rhs) { return Key(lhs) < Key(rhs); });
+      return {occupants.data() + (range.first - occupants.begin()),
+              occupants.data() + (range.second - occupants.begin())};
+    }
+
+    /// Nearest occupant of a lane to the distance @a s along the road, going
+    /// in the direction of increasing s if @a increasing.
+    const LaneOccupant *FindNearestInLane(
+        id_type road_id,
+        int lane_id,
+        double s,
+        bool increasing) const {
+      const auto lane = GetLane(road_id, lane_id);
+      if (increasing) {
+        const auto it = std::lower_bound(lane.first, lane.second, s, [](const LaneOccupant &lhs, double rhs) {
+          return lhs.waypoint.s < rhs;
+        });
+        return it != lane.second ? it : nullptr;
+      } else {
+        const auto it = std::upper_bound(lane.first, lane.second, s, [](double lhs, const LaneOccupant &rhs) {
+          return lhs < rhs.waypoint.s;
+        });
+        return it != lane.first ? it - 1 : nullptr;
+      }
+    }
+
+  private:
+
+    static auto Key(const std::tuple<id_type, int> &key) {
+      return key;
+    }
+
+    static auto Key(const LaneOccupant &occupant) {
+      return LaneKey(occupant.waypoint);
+    }
+  };
+
+  // ===========================================================================
+  // -- LaneOccupancyIndex -----------------------------------------------------
+  // ===========================================================================
+
+  LaneOccupancyIndex::LaneOccupancyIndex(SharedPtr<const road::Map> map, double cell_size)
+    : _map(std::move(map)),
+      _cell_size(cell_size),
+      _snapshot(std::make_shared<const Snapshot>()) {
+    DEBUG_ASSERT(_map != nullptr);
+    DEBUG_ASSERT(_cell_size > 0.0);
+  }
+
+  LaneOccupancyIndex::~LaneOccupancyIndex() = default;
+
+  void LaneOccupancyIndex::Update(
+      const size_t frame_count,
+      const std::vector<ActorId> &ids,
+      const std::vector<geom::Location> &locations) {
+    DEBUG_ASSERT(ids.size() == locations.size());
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+    const auto previous = _snapshot.load();
+    auto next = std::make_shared<Snapshot>();
+    next->frame_count = frame_count;
+
+    // Input of each occupant of the previous snapshot still present, the
+    // rest of the inputs are new actors.
+    std::vector<uint32_t> input_of_previous(previous->occupants.size(), NONE);
+    std::vector<uint32_t> new_inputs;
+    std::vector<LaneOccupant> inputs;
+    inputs.reserve(ids.size());
+    for (auto i = 0u; i < ids.size(); ++i) {
+      const auto &location = locations[i];
+      WaypointHandle waypoint;
+      const auto *before = previous->Find(ids[i]);
+      if (before == nullptr) {
+        waypoint = _map->GetClosestWaypointOnRoad(location).GetHandle();
+      } else if (geom::Math::DistanceSquared2D(before->location, location) < STILL_DISTANCE * STILL_DISTANCE) {
+        waypoint = before->waypoint;
+      } else {
+        // An actor keeps its lane while it is still inside of it, even if a
+        // lane of an overlapping road (e.g. in a junction) is nearer.
+        const auto inside = _map->GetWaypointInsideLane(before->waypoint.road_id, location);
+        waypoint = inside.has_value() ?
+            *inside :
+            _map->TrackWaypoint(before->waypoint, location);
+      }
+      inputs.push_back({ids[i], waypoint, location});
+      auto *slot = (before != nullptr) ?
+          &input_of_previous[static_cast<size_t>(before - previous->occupants.data())] :
+          nullptr;
+      if ((slot != nullptr) && (*slot == NONE)) {
+        *slot = i;
+      } else {
+        new_inputs.emplace_back(i);
+      }
+    }
+    const auto number_of_survivors = inputs.size() - new_inputs.size();
+
+    // Inputs in the order of the previous snapshot, then the new ones.
+    std::vector<uint32_t> order;
+    order.reserve(inputs.size());
+    for (auto i : input_of_previous) {
+      if (i != NONE) {
+        order.emplace_back(i);
+      }
+    }
+    order.insert(order.end(), new_inputs.begin(), new_inputs.end());
+    SortIncrementally(order, number_of_survivors, [&](uint32_t lhs, uint32_t rhs) {
+      return IsBefore(inputs[lhs], inputs[rhs]);
+    });
+
+    auto &occupants = next->occupants;
+    occupants.reserve(inputs.size());
+    std::vector<uint32_t> index_of_input(inputs.size());
+    for (auto i : order) {
+      index_of_input[i] = static_cast<uint32_t>(occupants.size());
+      occupants.emplace_back(inputs[i]);
+    }
+
+    // Same for the ids and the cells, starting from their previous order.
+    auto get_cell = [this](const geom::Location &location) {
+      return MakeCellKey(
+          static_cast<int64_t>(std::floor(location.x / _cell_size)),
+          static_cast<int64_t>(std::floor(location.y / _cell_size)));
+    };
+    next->ids.reserve(occupants.size());
+    for (auto &&item : previous->ids) {
+      const auto i = input_of_previous[item.second];
+      if (i != NONE) {
+        next->ids.emplace_back(item.first, index_of_input[i]);
+      }
+    }
+    next->cells.reserve(occupants.size());
+    for (auto &&item : previous->cells) {
+      const auto i = input_of_previous[item.second];
+      if (i != NONE) {
+        next->cells.emplace_back(get_cell(inputs[i].location), index_of_input[i]);
+      }
+    }
+    for (auto i : new_inputs) {
+      next->ids.emplace_back(inputs[i].id, index_of_input[i]);
+      next->cells.emplace_back(get_cell(inputs[i].location), index_of_input[i]);
+    }
+    SortIncrementally(next->ids, number_of_survivors, std::less<std::pair<ActorId, uint32_t>>{});
+    SortIncrementally(next->cells, number_of_survivors, std::less<std::pair<uint64_t, uint32_t>>{});
+
+    _snapshot.store(std::move(next));
+  }
+
+  size_t LaneOccupancyIndex::GetFrameCount() const {
+    return _snapshot.load()->frame_count;
+  }
+
+  size_t LaneOccupancyIndex::size() const {
+    return _snapshot.load()->occupants.size();
+  }
+
+  boost::optional<LaneOccupant> LaneOccupancyIndex::GetActor(const ActorId id) const {
+    const auto snapshot = _snapshot.load();
+    const auto *occupant = snapshot->Find(id);
+    if (occupant == nullptr) {
+      return {};
+    }
+    return *occupant;
+  }
+
+  std::vector<LaneOccupant> LaneOccupancyIndex::GetActorsInLane(
+      const id_type road_id,
+      const int lane_id,
+      const double s_min,
+      const double s_max) const {
+    const auto snapshot = _snapshot.load();
+    const auto begin = snapshot->FindNearestInLane(road_id, lane_id, s_min, true);
+    const auto end = snapshot->GetLane(road_id, lane_id).second;
+    std::vector<LaneOccupant> result;
+    for (auto it = begin; (it != nullptr) && (it != end) && (it->waypoint.s <= s_max); ++it) {
+      result.emplace_back(*it);
+    }
+    return result;
+  }
+
+  boost::optional<LaneOccupancyIndex::Neighbor> LaneOccupancyIndex::GetLeader(
+      const ActorId id,
+      const double max_distance) const {
+    return FindNeighbor(*_snapshot.load(), id, max_distance, true);
+  }
+
+  boost::optional<LaneOccupancyIndex::Neighbor> LaneOccupancyIndex::GetFollower(
+      const ActorId id,
+      const double max_distance) const {
+    return FindNeighbor(*_snapshot.load(), id, max_distance, false);
+  }
+
+  boost::optional<LaneOccupancyIndex::Neighbor> LaneOccupancyIndex::FindNeighbor(
+      const Snapshot &snapshot,
+      const ActorId id,
+      const double max_distance,
+      const bool ahead) const {
+    const auto *self = snapshot.Find(id);
+    if (self == nullptr) {
+      return {};
+    }
+    // Lanes with negative id go in the direction of increasing s.
+    auto is_increasing = [ahead](int lane_id) {
+      return (lane_id < 0) == ahead;
+    };
+
+    // In the lane of the actor the occupants are already sorted, the nearest
+    // one is next to it.
+    const auto &self_waypoint = self->waypoint;
+    const auto lane = snapshot.GetLane(self_waypoint.road_id, self_waypoint.lane_id);
+    const LaneOccupant *nearest = nullptr;
+    if (is_increasing(self_waypoint.lane_id)) {
+      nearest = (self + 1 != lane.second) ? self + 1 : nullptr;
+    } else {
+      nearest = (self != lane.first) ? self - 1 : nullptr;
+    }
+    if (nearest != nullptr) {
+      const auto distance = std::abs(nearest->waypoint.s - self_waypoint.s);
+      if (distance <= max_distance) {
+        return Neighbor{*nearest, distance};
+      }
+      return {};
+    }
+
+    // Otherwise follow the lanes connected, depth first, skipping the
+    // branches already farther than the nearest actor found.
+    const auto &data = _map->GetData();
+    const auto &table = _map->GetSuccessorTable();
+    auto get_next_lanes = [&](const WaypointHandle &waypoint) {
+      return ahead ?
+          table.GetSuccessors(waypoint.road_id, waypoint.lane_id) :
+          table.GetPredecessors(waypoint.road_id, waypoint.lane_id);
+    };
+    auto get_distance_to_end = [&](const WaypointHandle &waypoint) {
+      return is_increasing(waypoint.lane_id) ?
+          data.GetRoad(waypoint.road_id)->GetLength() - waypoint.s :
+          waypoint.s;
+    };
+
+    boost::optional<Neighbor> result;
+    auto best_distance = max_distance;
+    // (entrance to the lane, distance along the lanes to it)
+    std::vector<std::pair<WaypointHandle, double>> stack;
+    // Shortest distance at which each lane has been entered.
+    std::vector<std::pair<std::tuple<id_type, int>, double>> visited;
+    const auto distance_to_end = get_distance_to_end(self_waypoint);
+    for (auto &&next : get_next_lanes(self_waypoint)) {
+      stack.emplace_back(next, distance_to_end);
+    }
+    while (!stack.empty()) {
+      const auto entrance = stack.back().first;
+      const auto distance = stack.back().second;
+      stack.pop_back();
+      if (distance > best_distance) {
+        continue;
+      }
+      const auto key = LaneKey(entrance);
+      auto it = std::find_if(visited.begin(), visited.end(), [&](const auto &item) {
+        return item.first == key;
+      });
+      if (it != visited.end()) {
+        if (it->second <= distance) {
+          continue;
+        }
+        it->second = distance;
+      } else {
+        visited.emplace_back(key, distance);
+      }
+      const auto *found = snapshot.FindNearestInLane(
+          entrance.road_id,
+          entrance.lane_id,
+          entrance.s,
+          is_increasing(entrance.lane_id));
+      if (found == self) {
+        // Back to the lane of the actor, anything beyond is the actor itself.
+        continue;
+      } else if (found != nullptr) {
+        const auto found_distance = distance + std::abs(found->waypoint.s - entrance.s);
+        if (found_distance <= best_distance) {
+          best_distance = found_distance;
+          result = Neighbor{*found, found_distance};
+        }
+      } else {
+        const auto next_distance = distance + get_distance_to_end(entrance);
+        for (auto &&next : get_next_lanes(entrance)) {
+          stack.emplace_back(next, next_distance);
+        }
+      }
+    }
+    return result;
+  }
+
+  std::vector<LaneOccupant> LaneOccupancyIndex::GetActorsInRadius(
+      const geom::Location &location,
+      const double radius) const {
+    const auto snapshot = _snapshot.load();
+    const auto &cells = snapshot->cells;
+    const auto min_x = static_cast<int64_t>(std::floor((location.x - radius) / _cell_size));
+    const auto max_x = static_cast<int64_t>(std::floor((location.x + radius) / _cell_size));
+    const auto min_y = static_cast<int64_t>(std::floor((location.y - radius) / _cell_size));
+    const auto max_y = static_cast<int64_t>(std::floor((location.y + radius) / _cell_size));
+    const auto radius_squared = radius * radius;
+    std::vector<std::pair<double, uint32_t>> found;
+    for (auto x = min_x; x <= max_x; ++x) {
+      // Cells of the same column are consecutive, only one search per column.
+      auto it = std::lower_bound(
+          cells.begin(),
+          cells.end(),
+          std::make_pair(MakeCellKey(x, min_y), 0u));
+      const auto end = MakeCellKey(x, max_y);
+      for (; (it != cells.end()) && (it->first <= end); ++it) {
+        const auto &occupant = snapshot->occupants[it->second];
+        const auto distance = geom::Math::DistanceSquared2D(occupant.location, location);
+        if (distance <= radius_squared) {
+          found.emplace_back(distance, it->second);
+        }
+      }
+    }
+    std::sort(found.begin(), found.end());
+    std::vector<LaneOccupant> result;
+    result.reserve(found.size());
+    for (auto &&item : found) {
+      result.emplace_back(snapshot->occupants[item.second]);
+    }
+    return result;
+  }
+
+} // namespace client
+} // namespace carla
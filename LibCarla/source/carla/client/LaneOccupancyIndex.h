@@ -0,0 +1,118 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/AtomicSharedPtr.h"
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+#include "carla/geom/Location.h"
+#include "carla/road/element/WaypointHandle.h"
+#include "carla/rpc/ActorId.h"
+
+#include <boost/optional.hpp>
+
+#include <vector>
+
+namespace carla {
+namespace road { class Map; }
+namespace client {
+
+  /// An actor and the position it occupies in the lanes of the map.
+  struct LaneOccupant {
+
+    ActorId id;
+
+    /// Lane nearest to the actor, with the distance along its road.
+    road::element::WaypointHandle waypoint;
+
+    geom::Location location;
+  };
+
+  /// Index of the actors by the lane they occupy, answering which actors are
+  /// in a lane, which actor leads or follows another one and which actors
+  /// are near a location without scanning every actor.
+  ///
+  /// Actors are stored sorted by road, lane and distance along the road, and
+  /// bucketed in a 2D grid of @a cell_size meters. Every Update builds a new
+  /// immutable snapshot, the lane of each actor already indexed is tracked
+  /// from the one it had in the previous snapshot, and the actors are sorted
+  /// starting from their previous order. Queries can run in any
+  /// thread concurrently with Update, each query reads a single snapshot;
+  /// Update itself must not be called concurrently.
+  class LaneOccupancyIndex : private NonCopyable {
+  public:
+
+    /// An actor found by GetLeader or GetFollower.
+    struct Neighbor {
+
+      LaneOccupant occupant;
+
+      /// Distance along the lanes [meters].
+      double distance;
+    };
+
+    explicit LaneOccupancyIndex(SharedPtr<const road::Map> map, double cell_size = 20.0);
+
+    ~LaneOccupancyIndex();
+
+    /// Replace the actors indexed with the actors @a ids at @a locations, as
+    /// they were at frame @a frame_count.
+    void Update(
+        size_t frame_count,
+        const std::vector<ActorId> &ids,
+        const std::vector<geom::Location> &locations);
+
+    /// Frame of the latest Update.
+    size_t GetFrameCount() const;
+
+    /// Number of actors indexed.
+    size_t size() const;
+
+    boost::optional<LaneOccupant> GetActor(ActorId id) const;
+
+    /// Actors in lane @a lane_id of road @a road_id at a distance along the
+    /// road between @a s_min and @a s_max, sorted by that distance.
+    std::vector<LaneOccupant> GetActorsInLane(
+        road::element::id_type road_id,
+        int lane_id,
+        double s_min,
+        double s_max) const;
+
+    /// Nearest actor ahead of actor @a id, in its direction of travel along
+    /// its lane and the lanes that follow, at most @a max_distance meters
+    /// away along the lanes.
+    boost::optional<Neighbor> GetLeader(ActorId id, double max_distance = 100.0) const;
+
+    /// Same as GetLeader, but behind actor @a id, following the lanes that
+    /// lead to its lane.
+    boost::optional<Neighbor> GetFollower(ActorId id, double max_distance = 100.0) const;
+
+    /// Actors at most @a radius meters away from @a location, in 2D, sorted
+    /// by distance.
+    std::vector<LaneOccupant> GetActorsInRadius(
+        const geom::Location &location,
+        double radius) const;
+
+  private:
+
+    struct Snapshot;
+
+    boost::optional<Neighbor> FindNeighbor(
+        const Snapshot &snapshot,
+        ActorId id,
+        double max_distance,
+        bool ahead) const;
+
+    const SharedPtr<const road::Map> _map;
+
+    const double _cell_size;
+
+    AtomicSharedPtr<const Snapshot> _snapshot;
+  };
+
+} // namespace client
+} // namespace carla
@@ -6,24 +6,20 @@
 
 #include "carla/client/Map.h"
 
+#include "carla/Exception.h"
+#include "carla/client/LaneOccupancyIndex.h"
 #include "carla/client/Waypoint.h"
-#include "carla/opendrive/OpenDrive.h"
+#include "carla/client/detail/MapCache.h"
 #include "carla/road/Map.h"
+#include "carla/road/RoutePlanner.h"
 #include "carla/road/WaypointGenerator.h"
 
-#include <sstream>
-
 namespace carla {
 namespace client {
 
-  static auto MakeMap(const std::string &opendrive_contents) {
-    auto stream = std::istringstream(opendrive_contents);
-    return opendrive::OpenDrive::Load(stream);
-  }
-
   Map::Map(rpc::MapInfo description)
     : _description(std::move(description)),
-      _map(MakeMap(_description.open_drive_file)) {
+      _map(detail::MapCache::GetOrBuild(_description.open_drive_file)) {
     if (_map == nullptr) {
       throw_exception(std::runtime_error("failed to generate map"));
     }
@@ -71,9 +67,11 @@ namespace client {
     return result;
   }
 
-  std::vector<SharedPtr<Waypoint>> Map::GenerateWaypoints(double distance) const {
+  std::vector<SharedPtr<Waypoint>> Map::GenerateWaypoints(
+      double distance,
+      road::element::LaneTypeMask lane_type) const {
     std::vector<SharedPtr<Waypoint>> result;
-    const auto waypoints = road::WaypointGenerator::GenerateAll(*_map, distance);
+    const auto waypoints = road::WaypointGenerator::GenerateAll(*_map, distance, lane_type);
     result.reserve(waypoints.size());
     for (const auto &waypoint : waypoints) {
       result.emplace_back(SharedPtr<Waypoint>(new Waypoint{shared_from_this(), waypoint}));
@@ -81,12 +79,70 @@ namespace client {
     return result;
   }
 
+  road::WaypointArrays Map::GenerateWaypointArrays(
+      double distance,
+      road::element::LaneTypeMask lane_type) const {
+    return road::WaypointGenerator::GenerateAllArrays(*_map, distance, lane_type);
+  }
+
+  road::TopologyArrays Map::GetTopologyArrays() const {
+    return road::WaypointGenerator::GenerateTopologyArrays(*_map);
+  }
+
+  SharedPtr<Waypoint> Map::MakeWaypoint(const road::element::WaypointHandle &handle) const {
+    auto is_valid = [&]() {
+      const auto *road = _map->GetData().GetRoad(handle.road_id);
+      if ((road == nullptr) || (handle.s < 0.0) || (handle.s > road->GetLength())) {
+        return false;
+      }
+      const auto lanes = road->GetInfo<road::element::RoadInfoLane>(handle.s);
+      return (lanes != nullptr) && (lanes->getLane(handle.lane_id) != nullptr);
+    };
+    if (!is_valid()) {
+      throw_exception(std::out_of_range("waypoint not found in map " + GetName()));
+    }
+    return SharedPtr<Waypoint>(new Waypoint{shared_from_this(), _map->MakeWaypoint(handle)});
+  }
+
+  SharedPtr<road::RoutePlanner> Map::MakeRoutePlanner(double lane_change_cost) const {
+    return MakeShared<road::RoutePlanner>(_map, lane_change_cost);
+  }
+
+  SharedPtr<LaneOccupancyIndex> Map::MakeLaneOccupancyIndex(double cell_size) const {
+    return MakeShared<LaneOccupancyIndex>(_map, cell_size);
+  }
+
   std::vector<road::element::LaneMarking> Map::CalculateCrossedLanes(
       const geom::Location &origin,
       const geom::Location &destination) const {
     return _map->CalculateCrossedLanes(origin, destination);
   }
 
+  std::vector<road::element::Waypoint> Map::GetClosestWaypointsOnRoad(
+      const std::vector<geom::Location> &locations,
+      const std::vector<road::element::Waypoint> &previous) const {
+    if (!previous.empty()) {
+      if (previous.size() != locations.size()) {
+        throw_exception(std::invalid_argument("previous waypoints do not match the locations"));
+      }
+      return _map->TrackWaypoints(previous, locations);
+    }
+    std::vector<road::element::Waypoint> result;
+    result.reserve(locations.size());
+    for (auto &&location : locations) {
+      result.emplace_back(_map->GetClosestWaypointOnRoad(location));
+    }
+    return result;
+  }
+
+  std::vector<road::element::LaneMarking> Map::CalculateCrossedLanes(
+      const road::element::Waypoint &origin_waypoint,
+      const geom::Location &origin,
+      const road::element::Waypoint &destination_waypoint,
+      const geom::Location &destination) const {
+    return _map->CalculateCrossedLanes(origin_waypoint, origin, destination_waypoint, destination);
+  }
+
   const geom::GeoLocation &Map::GetGeoReference() const {
     return _map->GetData().GetGeoReference();
   }
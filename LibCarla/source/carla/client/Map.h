@@ -8,16 +8,20 @@
 
 #include "carla/Memory.h"
 #include "carla/NonCopyable.h"
+#include "carla/road/WaypointArrays.h"
 #include "carla/road/element/LaneMarking.h"
+#include "carla/road/element/LaneType.h"
+#include "carla/road/element/Waypoint.h"
 #include "carla/rpc/MapInfo.h"
 
 #include <string>
 
 namespace carla {
 namespace geom { class GeoLocation; }
-namespace road { class Map; }
+namespace road { class Map; class RoutePlanner; }
 namespace client {
 
+  class LaneOccupancyIndex;
   class Waypoint;
 
   class Map
@@ -25,6 +29,8 @@ namespace client {
       private NonCopyable {
   public:
 
+    /// Build the map described by @a description. The road map is shared
+    /// with any other Map created from the same OpenDRIVE file.
     explicit Map(rpc::MapInfo description);
 
     ~Map();
@@ -49,10 +55,54 @@ namespace client {
 
     TopologyList GetTopology() const;
 
-    std::vector<SharedPtr<Waypoint>> GenerateWaypoints(double distance) const;
+    /// Generate waypoints separated by @a distance on every lane whose type
+    /// matches @a lane_type, e.g. LaneType::Driving | LaneType::Parking.
+    std::vector<SharedPtr<Waypoint>> GenerateWaypoints(
+        double distance,
+        road::element::LaneTypeMask lane_type =
+            static_cast<road::element::LaneTypeMask>(road::element::LaneType::Driving)) const;
 
+    /// Same as GenerateWaypoints, but the waypoints are returned as flat
+    /// arrays, computed in parallel over the road segments.
+    road::WaypointArrays GenerateWaypointArrays(
+        double distance,
+        road::element::LaneTypeMask lane_type =
+            static_cast<road::element::LaneTypeMask>(road::element::LaneType::Driving)) const;
+
+    /// Same as GetTopology, but the edges are returned as flat arrays.
+    road::TopologyArrays GetTopologyArrays() const;
+
+    /// Make a waypoint from a handle stored in the arrays returned by
+    /// GenerateWaypointArrays or GetTopologyArrays.
+    SharedPtr<Waypoint> MakeWaypoint(const road::element::WaypointHandle &handle) const;
+
+    /// Build a route planner over the drivable lanes of this map. Changing
+    /// lanes costs as much as driving @a lane_change_cost meters.
+    SharedPtr<road::RoutePlanner> MakeRoutePlanner(double lane_change_cost = 10.0) const;
+
+    /// Make an empty index of actors by lane over this map, with a grid of
+    /// @a cell_size meters for the radius queries. See
+    /// World::MakeLaneOccupancyIndex for one refreshed every tick.
+    SharedPtr<LaneOccupancyIndex> MakeLaneOccupancyIndex(double cell_size = 20.0) const;
+
+    std::vector<road::element::LaneMarking> CalculateCrossedLanes(
+        const geom::Location &origin,
+        const geom::Location &destination) const;
+
+    /// Waypoints on the driving lanes nearest to each of @a locations. If
+    /// @a previous holds the waypoints of nearby locations, e.g. of the same
+    /// points on the previous tick, they are tracked from them instead of
+    /// searched in the whole map, see road::Map::TrackWaypoints.
+    std::vector<road::element::Waypoint> GetClosestWaypointsOnRoad(
+        const std::vector<geom::Location> &locations,
+        const std::vector<road::element::Waypoint> &previous = {}) const;
+
+    /// Same as CalculateCrossedLanes with the waypoints of @a origin and
+    /// @a destination already computed by GetClosestWaypointsOnRoad.
     std::vector<road::element::LaneMarking> CalculateCrossedLanes(
+        const road::element::Waypoint &origin_waypoint,
         const geom::Location &origin,
+        const road::element::Waypoint &destination_waypoint,
         const geom::Location &destination) const;
 
     const geom::GeoLocation &GetGeoReference() const;
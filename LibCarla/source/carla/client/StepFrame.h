@@ -0,0 +1,31 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Memory.h"
+#include "carla/client/Timestamp.h"
+
+#include <vector>
+
+namespace carla {
+namespace sensor { class SensorData; }
+namespace client {
+
+  /// A frame simulated by World::Step, together with the data the sensors
+  /// generated on that frame.
+  class StepFrame {
+  public:
+
+    Timestamp timestamp;
+
+    /// Data of each of the sensors given to Step, in the same order. Null if
+    /// the sensor did not deliver data for this frame.
+    std::vector<SharedPtr<sensor::SensorData>> sensor_data;
+  };
+
+} // namespace client
+} // namespace carla
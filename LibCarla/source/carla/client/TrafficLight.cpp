@@ -60,15 +60,30 @@ namespace client {
     return GetEpisode().Lock()->GetActorDynamicState(*this).state.traffic_light_data.pole_index;
   }
 
-  std::vector<SharedPtr<TrafficLight>> TrafficLight::GetGroupTrafficLights() {
+  static std::vector<SharedPtr<TrafficLight>> FindTrafficLights(
+      World world,
+      const std::vector<ActorId> &ids) {
     std::vector<SharedPtr<TrafficLight>> result;
-    auto ids = GetEpisode().Lock()->GetGroupTrafficLights(*this);
+    auto actors = world.GetActors();
     for (auto id : ids) {
-      SharedPtr<Actor> actor = GetWorld().GetActors()->Find(id);
+      SharedPtr<Actor> actor = actors->Find(id);
       result.push_back(boost::static_pointer_cast<TrafficLight>(actor));
     }
     return result;
   }
 
+  std::vector<SharedPtr<TrafficLight>> TrafficLight::GetGroupTrafficLights() {
+    auto ids = GetEpisode().Lock()->GetGroupTrafficLights(*this);
+    return FindTrafficLights(GetWorld(), ids);
+  }
+
+  Future<std::vector<SharedPtr<TrafficLight>>> TrafficLight::AsyncGetGroupTrafficLights() {
+    auto world = GetWorld();
+    return GetEpisode().Lock()->AsyncGetGroupTrafficLights(*this).Then(
+        [world](const std::vector<ActorId> &ids) {
+      return FindTrafficLights(world, ids);
+    });
+  }
+
 } // namespace client
 } // namespace carla
@@ -51,6 +51,10 @@ namespace client {
     return GetEpisode().Lock()->GetVehiclePhysicsControl(*this);
   }
 
+  Future<Vehicle::PhysicsControl> Vehicle::AsyncGetPhysicsControl() const {
+    return GetEpisode().Lock()->AsyncGetVehiclePhysicsControl(*this);
+  }
+
   float Vehicle::GetSpeedLimit() const {
     return GetEpisode().Lock()->GetActorDynamicState(*this).state.vehicle_data.speed_limit;
   }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/client/Actor.h"
+#include "carla/client/Future.h"
 #include "carla/rpc/VehicleControl.h"
 #include "carla/rpc/VehiclePhysicsControl.h"
 #include "carla/rpc/TrafficLightState.h"
@@ -41,6 +42,10 @@ namespace client {
     Control GetControl() const;
     PhysicsControl GetPhysicsControl() const;
 
+    /// Same as GetPhysicsControl but return as soon as the request is sent,
+    /// so the physics control of many vehicles can be requested at once.
+    Future<PhysicsControl> AsyncGetPhysicsControl() const;
+
     /// Return the speed limit currently affecting this vehicle.
     ///
     /// @note This function does not call the simulator, it returns the data
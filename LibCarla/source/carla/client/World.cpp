@@ -7,12 +7,20 @@
 #include "carla/client/World.h"
 
 #include "carla/Logging.h"
+#include "carla/StringUtil.h"
 #include "carla/client/Actor.h"
 #include "carla/client/ActorBlueprint.h"
+#include "carla/client/ActorChanges.h"
 #include "carla/client/ActorList.h"
+#include "carla/client/LaneOccupancyIndex.h"
+#include "carla/client/Map.h"
+#include "carla/client/Sensor.h"
 #include "carla/client/detail/Simulator.h"
 
 #include <exception>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace carla {
 namespace client {
@@ -51,6 +59,137 @@ namespace client {
                                   _episode.Lock()->GetAllTheActorsInTheEpisode()}};
   }
 
+  static ActorChanges MakeActorChanges(
+      SharedPtr<ActorList> spawned,
+      detail::ActorIdChanges changes) {
+    ActorChanges result;
+    result.frame_count = changes.frame_count;
+    result.spawned = std::move(spawned);
+    result.destroyed = std::move(changes.destroyed);
+    result.truncated = changes.truncated;
+    return result;
+  }
+
+  ActorChanges World::GetActorChanges(size_t since_frame) const {
+    auto simulator = _episode.Lock();
+    auto changes = simulator->GetActorChanges(since_frame);
+    auto spawned = SharedPtr<ActorList>{new ActorList{
+                                          _episode,
+                                          simulator->GetActorsById(changes.spawned)}};
+    return MakeActorChanges(std::move(spawned), std::move(changes));
+  }
+
+  ActorStateArrays World::GetActorStates(
+      const std::vector<ActorId> &ids,
+      const uint32_t fields) const {
+    auto simulator = _episode.Lock();
+
+    std::unordered_set<ActorId> vehicles;
+    if (fields & ActorStateArrays::VehicleControl) {
+      // The type of the actor is not part of the episode state, so we need
+      // the descriptions; these are cached after the first call.
+      for (auto &&actor : simulator->GetActorsById(ids)) {
+        if (StringUtil::StartsWith(actor.description.id, "vehicle.")) {
+          vehicles.insert(actor.id);
+        }
+      }
+    }
+
+    const auto state = simulator->GetEpisodeState();
+    return detail::PackActorStates(*state, ids, fields, vehicles);
+  }
+
+  SharedPtr<LaneOccupancyIndex> World::MakeLaneOccupancyIndex(
+      const std::string &actor_filter,
+      const double cell_size) {
+    auto simulator = _episode.Lock();
+    auto index = simulator->GetCurrentMap()->MakeLaneOccupancyIndex(cell_size);
+
+    // Whether each actor seen matches the filter. The type of the actor is not
+    // part of the episode state, the descriptions of the new actors are
+    // requested without waiting for them in the tick callback; actors are
+    // left out of the index until their description arrives.
+    struct ActorFilter {
+      std::mutex mutex;
+      std::unordered_map<ActorId, bool> matches;
+      std::vector<ActorId> requested;
+      Future<std::vector<rpc::Actor>> pending;
+    };
+    auto filter = std::make_shared<ActorFilter>();
+    auto update = [filter, actor_filter](
+        detail::Simulator &simulator,
+        LaneOccupancyIndex &index,
+        const bool wait_for_actors) {
+      std::lock_guard<std::mutex> lock(filter->mutex);
+      const auto state = simulator.GetEpisodeState();
+      const auto actor_ids = state->GetActorIds();
+      auto &matches = filter->matches;
+      if (!filter->pending.IsValid()) {
+        std::vector<ActorId> missing;
+        for (auto id : actor_ids) {
+          if (matches.find(id) == matches.end()) {
+            missing.emplace_back(id);
+          }
+        }
+        if (!missing.empty()) {
+          filter->pending = simulator.AsyncGetActorsById(missing);
+          filter->requested = std::move(missing);
+        }
+      }
+      if (filter->pending.IsValid() && (wait_for_actors || filter->pending.IsReady())) {
+        auto pending = std::move(filter->pending);
+        filter->pending = {};
+        // If the request failed they are requested again on the next update.
+        const auto actors = pending.Get();
+        // Actors destroyed before the response are not in it.
+        for (auto id : filter->requested) {
+          matches[id] = false;
+        }
+        for (auto &&actor : actors) {
+          matches[actor.id] = StringUtil::Match(actor.description.id, actor_filter);
+        }
+      }
+      if (matches.size() > 2u * static_cast<size_t>(actor_ids.size())) {
+        // Forget the actors destroyed.
+        std::unordered_map<ActorId, bool> alive;
+        for (auto id : actor_ids) {
+          const auto it = matches.find(id);
+          if (it != matches.end()) {
+            alive.emplace(*it);
+          }
+        }
+        matches = std::move(alive);
+      }
+      std::vector<ActorId> ids;
+      std::vector<geom::Location> locations;
+      for (auto id : actor_ids) {
+        const auto it = matches.find(id);
+        if ((it != matches.end()) && it->second) {
+          ids.emplace_back(id);
+          locations.emplace_back(state->FindActorState(id)->transform.location);
+        }
+      }
+      index.Update(state->GetFrameCount(), ids, locations);
+    };
+
+    update(*simulator, *index, true);
+    simulator->RegisterOnTickEvent([
+        update,
+        weak_index=WeakPtr<LaneOccupancyIndex>(index),
+        weak_episode=detail::WeakEpisodeProxy{simulator}](const auto &) {
+      auto index = weak_index.lock();
+      auto simulator = weak_episode.TryLock();
+      if ((index != nullptr) && (simulator != nullptr)) {
+        try {
+          update(*simulator, *index, false);
+        } catch (const std::exception &e) {
+          log_error("exception updating lane occupancy index:", e.what());
+        }
+      }
+    });
+    return index;
+  }
+
   SharedPtr<Actor> World::SpawnActor(
       const ActorBlueprint &blueprint,
       const geom::Transform &transform,
@@ -58,6 +197,13 @@ namespace client {
     return _episode.Lock()->SpawnActor(blueprint, transform, parent_actor);
   }
 
+  Future<SharedPtr<Actor>> World::AsyncSpawnActor(
+      const ActorBlueprint &blueprint,
+      const geom::Transform &transform,
+      Actor *parent_actor) {
+    return _episode.Lock()->AsyncSpawnActor(blueprint, transform, parent_actor);
+  }
+
   SharedPtr<Actor> World::TrySpawnActor(
       const ActorBlueprint &blueprint,
       const geom::Transform &transform,
@@ -73,13 +219,51 @@ namespace client {
     return _episode.Lock()->WaitForTick(timeout);
   }
 
-  void World::OnTick(std::function<void(Timestamp)> callback) {
-    return _episode.Lock()->RegisterOnTickEvent(std::move(callback));
+  size_t World::OnTick(std::function<void(Timestamp)> callback, const bool coalesce) {
+    return _episode.Lock()->RegisterOnTickEvent(std::move(callback), coalesce);
+  }
+
+  size_t World::OnActorsChanged(std::function<void(ActorChanges)> callback) {
+    auto episode = _episode;
+    return _episode.Lock()->RegisterOnActorsChangedEvent(
+        [episode, cb=std::move(callback)](detail::ActorIdChanges changes) {
+      try {
+        auto spawned = SharedPtr<ActorList>{new ActorList{
+                                              episode,
+                                              episode.Lock()->GetActorsById(changes.spawned)}};
+        cb(MakeActorChanges(std::move(spawned), std::move(changes)));
+      } catch (const std::exception &e) {
+        log_error("exception in actors changed callback:", e.what());
+      }
+    });
+  }
+
+  void World::SetCallbackWorkerThreads(const size_t worker_threads) {
+    _episode.Lock()->SetCallbackWorkerThreads(worker_threads);
+  }
+
+  std::vector<CallbackMetrics> World::GetCallbackMetrics() const {
+    return _episode.Lock()->GetCallbackMetrics();
   }
 
   void World::Tick() {
     _episode.Lock()->Tick();
   }
 
+  void World::Step(
+      const size_t number_of_frames,
+      std::function<void(StepFrame)> on_frame,
+      const std::vector<SharedPtr<Sensor>> &sensors,
+      const size_t max_in_flight,
+      const time_duration timeout) {
+    std::vector<ActorId> ids;
+    ids.reserve(sensors.size());
+    for (auto &sensor : sensors) {
+      DEBUG_ASSERT(sensor != nullptr);
+      ids.emplace_back(sensor->GetId());
+    }
+    _episode.Lock()->Step(number_of_frames, ids, std::move(on_frame), max_in_flight, timeout);
+  }
+
 } // namespace client
 } // namespace carla
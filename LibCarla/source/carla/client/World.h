@@ -8,7 +8,11 @@
 
 #include "carla/Memory.h"
 #include "carla/Time.h"
+#include "carla/client/ActorStateArrays.h"
+#include "carla/client/CallbackMetrics.h"
 #include "carla/client/DebugHelper.h"
+#include "carla/client/Future.h"
+#include "carla/client/StepFrame.h"
 #include "carla/client/Timestamp.h"
 #include "carla/client/detail/EpisodeProxy.h"
 #include "carla/geom/Transform.h"
@@ -22,9 +26,12 @@ namespace client {
 
   class Actor;
   class ActorBlueprint;
+  class ActorChanges;
   class ActorList;
   class BlueprintLibrary;
+  class LaneOccupancyIndex;
   class Map;
+  class Sensor;
 
   class World {
   public:
@@ -66,6 +73,26 @@ namespace client {
     /// Return a list with all the actors currently present in the world.
     SharedPtr<ActorList> GetActors() const;
 
+    /// Return the actors spawned and destroyed after @a since_frame. Unlike
+    /// GetActors, only the descriptions of the new actors are retrieved, so
+    /// polling it every tick costs proportional to the actors changed, not to
+    /// the number of actors in the world.
+    ActorChanges GetActorChanges(size_t since_frame) const;
+
+    /// Return the state of the actors in @a ids, all of them taken at the same
+    /// frame. Only the @a fields requested are filled, @a fields is a
+    /// combination of ActorStateArrays::Field flags.
+    ActorStateArrays GetActorStates(
+        const std::vector<ActorId> &ids,
+        uint32_t fields = ActorStateArrays::All) const;
+
+    /// Make an index of the actors whose type matches @a actor_filter by the
+    /// lane they occupy, refreshed on every world tick. See
+    /// Map::MakeLaneOccupancyIndex.
+    SharedPtr<LaneOccupancyIndex> MakeLaneOccupancyIndex(
+        const std::string &actor_filter = "vehicle.*",
+        double cell_size = 20.0);
+
     /// Spawn an actor into the world based on the @a blueprint provided at @a
     /// transform. If a @a parent is provided, the actor is attached to
     /// @a parent.
@@ -74,6 +101,16 @@ namespace client {
         const geom::Transform &transform,
         Actor *parent = nullptr);
 
+    /// Same as SpawnActor but return as soon as the request is sent, requests
+    /// sent one after another are processed together by the simulator. The
+    /// actor, or the error spawning it, is retrieved from the future. If the
+    /// future is dropped without reading it, dropping it waits for the actor
+    /// and then releases it, as if SpawnActor had returned it.
+    Future<SharedPtr<Actor>> AsyncSpawnActor(
+        const ActorBlueprint &blueprint,
+        const geom::Transform &transform,
+        Actor *parent = nullptr);
+
     /// Same as SpawnActor but return nullptr on failure instead of throwing an
     /// exception.
     SharedPtr<Actor> TrySpawnActor(
@@ -85,12 +122,45 @@ namespace client {
     Timestamp WaitForTick(time_duration timeout) const;
 
     /// Register a @a callback to be called every time a world tick is received.
-    void OnTick(std::function<void(Timestamp)> callback);
+    /// If @a coalesce is true and the callback falls behind, intermediate ticks
+    /// are skipped and only the latest one is delivered.
+    ///
+    /// @return the id of the callback, used to identify its metrics.
+    size_t OnTick(std::function<void(Timestamp)> callback, bool coalesce = false);
+
+    /// Register a @a callback to be called every time a world tick is received
+    /// in which actors have been spawned or destroyed.
+    ///
+    /// @return the id of the callback, used to identify its metrics.
+    size_t OnActorsChanged(std::function<void(ActorChanges)> callback);
+
+    /// Execute the callbacks registered in the world (including client-side
+    /// sensors) in @a worker_threads threads, instead of in the thread that
+    /// receives the world ticks. Calls to the same callback are still executed
+    /// one at a time and in order. The number of threads can only be
+    /// increased.
+    void SetCallbackWorkerThreads(size_t worker_threads);
+
+    /// Return queueing and execution times of every callback registered.
+    std::vector<CallbackMetrics> GetCallbackMetrics() const;
 
     /// Signal the simulator to continue to next tick (only has effect on
     /// synchronous mode).
     void Tick();
 
+    /// Simulate @a number_of_frames frames in synchronous mode, sending up to
+    /// @a max_in_flight tick cues ahead instead of waiting a full round trip
+    /// per frame. Each frame is passed to @a on_frame, in order, together with
+    /// the data generated on that frame by @a sensors, which must be
+    /// listening. A sensor that does not generate data on a frame gets null
+    /// for it. No tick cue should be pending when called.
+    void Step(
+        size_t number_of_frames,
+        std::function<void(StepFrame)> on_frame,
+        const std::vector<SharedPtr<Sensor>> &sensors = {},
+        size_t max_in_flight = 2u,
+        time_duration timeout = time_duration::seconds(10u));
+
     DebugHelper MakeDebugHelper() const {
       return DebugHelper{_episode};
     }
@@ -0,0 +1,201 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/client/detail/EpisodeState.h"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  // ===========================================================================
+  // -- ActorIdChanges ---------------------------------------------------------
+  // ===========================================================================
+
+  /// Ids of the actors spawned and destroyed in a range of frames.
+  struct ActorIdChanges {
+
+    /// Latest frame covered by these changes.
+    size_t frame_count = 0u;
+
+    std::vector<ActorId> spawned;
+
+    std::vector<ActorId> destroyed;
+
+    /// True if the history kept did not reach back to the frame requested,
+    /// because it was truncated or the episode changed. The actors destroyed
+    /// before the oldest frame available are missing, the whole list of
+    /// actors should be retrieved again.
+    bool truncated = false;
+
+    bool empty() const {
+      return spawned.empty() && destroyed.empty();
+    }
+  };
+
+  // ===========================================================================
+  // -- ActorChangeLog ---------------------------------------------------------
+  // ===========================================================================
+
+  /// Keeps a history of the actors spawned and destroyed at each frame, so
+  /// clients can learn about new and removed actors without retrieving the
+  /// whole list of actors every tick.
+  ///
+  /// Only frames in which the set of actors changed are stored, so the memory
+  /// used scales with the churn of actors, not with the number of frames.
+  class ActorChangeLog : private NonCopyable {
+  public:
+
+    /// Maximum number of frames with changes kept in the history.
+    static constexpr size_t max_size() {
+      return 1024u;
+    }
+
+    /// Computes the difference between the actors present in @a prev and
+    /// @a next, and adds it to the history.
+    ///
+    /// @return the changes introduced by @a next.
+    ActorIdChanges Record(const EpisodeState &prev, const EpisodeState &next);
+
+    /// Add to the history the actors @a spawned and @a destroyed at
+    /// @a frame_count.
+    void Record(
+        size_t frame_count,
+        std::vector<ActorId> spawned,
+        std::vector<ActorId> destroyed);
+
+    /// Return the actors spawned and destroyed after @a since_frame.
+    ///
+    /// If @a since_frame is older than the history kept, the actors destroyed
+    /// before the oldest frame available are not reported and the result is
+    /// flagged as truncated.
+    ActorIdChanges GetChangesSince(size_t since_frame) const;
+
+    /// Discard the history and start a new one at @a frame_count, e.g. when
+    /// a new episode starts. Changes requested since an earlier frame are
+    /// reported as truncated.
+    void Reset(size_t frame_count);
+
+    void Clear() {
+      Reset(0u);
+    }
+
+  private:
+
+    struct Entry {
+      size_t frame_count;
+      std::vector<ActorId> spawned;
+      std::vector<ActorId> destroyed;
+    };
+
+    mutable std::mutex _mutex;
+
+    /// The history is complete for the changes after this frame.
+    size_t _first_frame = 0u;
+
+    size_t _last_frame = 0u;
+
+    std::deque<Entry> _entries;
+  };
+
+  // ===========================================================================
+  // -- ActorChangeLog implementation ------------------------------------------
+  // ===========================================================================
+
+  inline ActorIdChanges ActorChangeLog::Record(
+      const EpisodeState &prev,
+      const EpisodeState &next) {
+    ActorIdChanges changes;
+    changes.frame_count = next.GetFrameCount();
+    for (auto id : next.GetActorIds()) {
+      if (!prev.ContainsActor(id)) {
+        changes.spawned.emplace_back(id);
+      }
+    }
+    for (auto id : prev.GetActorIds()) {
+      if (!next.ContainsActor(id)) {
+        changes.destroyed.emplace_back(id);
+      }
+    }
+    Record(changes.frame_count, changes.spawned, changes.destroyed);
+    return changes;
+  }
+
+  inline void ActorChangeLog::Record(
+      const size_t frame_count,
+      std::vector<ActorId> spawned,
+      std::vector<ActorId> destroyed) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _last_frame = std::max(_last_frame, frame_count);
+    if (!spawned.empty() || !destroyed.empty()) {
+      // Ticks are usually received in order, but keep the history sorted in
+      // case two of them are processed concurrently.
+      auto it = std::upper_bound(
+          _entries.begin(),
+          _entries.end(),
+          frame_count,
+          [](size_t frame, const Entry &entry) { return frame < entry.frame_count; });
+      _entries.insert(it, Entry{frame_count, std::move(spawned), std::move(destroyed)});
+      if (_entries.size() > max_size()) {
+        _first_frame = std::max(_first_frame, _entries.front().frame_count);
+        _entries.pop_front();
+      }
+    }
+  }
+
+  inline ActorIdChanges ActorChangeLog::GetChangesSince(size_t since_frame) const {
+    std::unordered_set<ActorId> spawned;
+    std::unordered_set<ActorId> destroyed;
+    ActorIdChanges result;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      result.frame_count = _last_frame;
+      result.truncated = since_frame < _first_frame;
+      auto it = std::upper_bound(
+          _entries.begin(),
+          _entries.end(),
+          since_frame,
+          [](size_t frame, const Entry &entry) { return frame < entry.frame_count; });
+      for (; it != _entries.end(); ++it) {
+        for (auto id : it->spawned) {
+          // An actor destroyed and spawned again keeps its previous state.
+          if (destroyed.erase(id) == 0u) {
+            spawned.insert(id);
+          }
+        }
+        for (auto id : it->destroyed) {
+          // An actor spawned and destroyed in between is not reported.
+          if (spawned.erase(id) == 0u) {
+            destroyed.insert(id);
+          }
+        }
+      }
+    }
+    result.spawned.assign(spawned.begin(), spawned.end());
+    result.destroyed.assign(destroyed.begin(), destroyed.end());
+    std::sort(result.spawned.begin(), result.spawned.end());
+    std::sort(result.destroyed.begin(), result.destroyed.end());
+    return result;
+  }
+
+  inline void ActorChangeLog::Reset(const size_t frame_count) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+    _first_frame = frame_count;
+    _last_frame = frame_count;
+  }
+
+} // namespace detail
+} // namespace client
+} // namespace carla
@@ -0,0 +1,135 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/detail/CallbackExecutor.h"
+
+#include "carla/Logging.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  CallbackExecutor::CallbackExecutor() : _work_to_do(_io_service) {}
+
+  CallbackExecutor::~CallbackExecutor() {
+    _io_service.stop();
+    _workers.JoinAll();
+  }
+
+  void CallbackExecutor::SetWorkerThreads(const size_t worker_threads) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const size_t current = _number_of_workers;
+    if (worker_threads < current) {
+      log_warning("callback executor: cannot reduce the number of worker threads");
+      return;
+    }
+    _workers.CreateThreads(worker_threads - current, [this]() { _io_service.run(); });
+    _number_of_workers = worker_threads;
+  }
+
+  std::vector<CallbackMetrics> CallbackExecutor::GetMetrics() const {
+    using seconds = std::chrono::duration<double>;
+    auto to_seconds = [](clock::duration duration) {
+      return std::chrono::duration_cast<seconds>(duration).count();
+    };
+    std::vector<CallbackMetrics> result;
+    std::lock_guard<std::mutex> lock(_mutex);
+    result.reserve(_tasks.size());
+    for (auto &task : _tasks) {
+      std::lock_guard<std::mutex> task_lock(task->mutex);
+      CallbackMetrics metrics;
+      metrics.id = task->id;
+      metrics.call_count = task->call_count;
+      metrics.dropped_count = task->dropped_count;
+      metrics.max_queue_time = to_seconds(task->max_queue_time);
+      metrics.max_execution_time = to_seconds(task->max_execution_time);
+      if (task->call_count > 0u) {
+        const auto count = static_cast<double>(task->call_count);
+        metrics.mean_queue_time = to_seconds(task->total_queue_time) / count;
+        metrics.mean_execution_time = to_seconds(task->total_execution_time) / count;
+      }
+      result.emplace_back(metrics);
+    }
+    return result;
+  }
+
+  void CallbackExecutor::Clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _tasks.clear();
+  }
+
+  std::shared_ptr<CallbackExecutor::Task> CallbackExecutor::MakeTask(const bool coalesce) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto task = std::make_shared<Task>(_next_id++, coalesce);
+    _tasks.emplace_back(task);
+    return task;
+  }
+
+  void CallbackExecutor::Post(const std::shared_ptr<Task> &task, std::function<void()> job) {
+    const auto now = clock::now();
+    if (_number_of_workers == 0u) {
+      Execute(*task, now, job);
+      return;
+    }
+    bool should_schedule = false;
+    {
+      std::lock_guard<std::mutex> lock(task->mutex);
+      if (task->coalesce && !task->queue.empty()) {
+        // The callback fell behind, replace the call still waiting.
+        task->queue.back() = std::make_pair(now, std::move(job));
+        ++task->dropped_count;
+      } else {
+        task->queue.emplace_back(now, std::move(job));
+      }
+      should_schedule = !task->is_running;
+      task->is_running = true;
+    }
+    if (should_schedule) {
+      _io_service.post([task]() { Drain(task); });
+    }
+  }
+
+  void CallbackExecutor::Execute(
+      Task &task,
+      const clock::time_point queued,
+      const std::function<void()> &job) {
+    const auto start = clock::now();
+    try {
+      job();
+    } catch (const std::exception &e) {
+      log_error("exception thrown in callback:", e.what());
+    }
+    const auto end = clock::now();
+    std::lock_guard<std::mutex> lock(task.mutex);
+    ++task.call_count;
+    task.total_queue_time += start - queued;
+    task.max_queue_time = std::max(task.max_queue_time, start - queued);
+    task.total_execution_time += end - start;
+    task.max_execution_time = std::max(task.max_execution_time, end - start);
+  }
+
+  void CallbackExecutor::Drain(const std::shared_ptr<Task> &task) {
+    for (;;) {
+      std::pair<clock::time_point, std::function<void()>> item;
+      {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        if (task->queue.empty()) {
+          task->is_running = false;
+          return;
+        }
+        item = std::move(task->queue.front());
+        task->queue.pop_front();
+      }
+      Execute(*task, item.first, item.second);
+    }
+  }
+
+} // namespace detail
+} // namespace client
+} // namespace carla
@@ -0,0 +1,128 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/ThreadGroup.h"
+#include "carla/client/CallbackMetrics.h"
+
+#include <boost/asio/io_service.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  /// Executes the callbacks registered in the episode.
+  ///
+  /// By default the callbacks are executed in the calling thread (the
+  /// streaming thread that received the tick). If worker threads are added,
+  /// the calls are queued and executed by the workers instead, so a slow
+  /// callback does not delay the rest. Each callback keeps its own queue,
+  /// calls to the same callback are always executed serially and in order.
+  ///
+  /// A callback can be registered to coalesce calls, in that case if the
+  /// callback falls behind only the latest call queued is executed.
+  class CallbackExecutor : private NonCopyable {
+  public:
+
+    CallbackExecutor();
+
+    ~CallbackExecutor();
+
+    /// Start executing the callbacks in @a worker_threads threads. The number
+    /// of worker threads can only be increased.
+    void SetWorkerThreads(size_t worker_threads);
+
+    /// Return a function that dispatches the calls to @a callback through
+    /// this executor, together with the id that identifies its metrics.
+    template <typename... InputsT>
+    std::pair<size_t, std::function<void(InputsT...)>> Wrap(
+        std::function<void(InputsT...)> callback,
+        bool coalesce);
+
+    /// Return the metrics of every callback wrapped since the last Clear.
+    std::vector<CallbackMetrics> GetMetrics() const;
+
+    /// Forget the metrics of the callbacks wrapped so far.
+    void Clear();
+
+  private:
+
+    using clock = std::chrono::steady_clock;
+
+    struct Task {
+      Task(size_t in_id, bool in_coalesce) : id(in_id), coalesce(in_coalesce) {}
+
+      const size_t id;
+
+      const bool coalesce;
+
+      std::mutex mutex;
+
+      std::deque<std::pair<clock::time_point, std::function<void()>>> queue;
+
+      bool is_running = false;
+
+      size_t call_count = 0u;
+
+      size_t dropped_count = 0u;
+
+      clock::duration total_queue_time = clock::duration::zero();
+
+      clock::duration max_queue_time = clock::duration::zero();
+
+      clock::duration total_execution_time = clock::duration::zero();
+
+      clock::duration max_execution_time = clock::duration::zero();
+    };
+
+    std::shared_ptr<Task> MakeTask(bool coalesce);
+
+    void Post(const std::shared_ptr<Task> &task, std::function<void()> job);
+
+    static void Execute(Task &task, clock::time_point queued, const std::function<void()> &job);
+
+    static void Drain(const std::shared_ptr<Task> &task);
+
+    mutable std::mutex _mutex;
+
+    size_t _next_id = 0u;
+
+    std::vector<std::shared_ptr<Task>> _tasks;
+
+    boost::asio::io_service _io_service;
+
+    boost::asio::io_service::work _work_to_do;
+
+    std::atomic_size_t _number_of_workers{0u};
+
+    ThreadGroup _workers;
+  };
+
+  template <typename... InputsT>
+  inline std::pair<size_t, std::function<void(InputsT...)>> CallbackExecutor::Wrap(
+      std::function<void(InputsT...)> callback,
+      const bool coalesce) {
+    auto task = MakeTask(coalesce);
+    const auto id = task->id;
+    return std::make_pair(id, [this, task=std::move(task), cb=std::move(callback)](InputsT... args) {
+      Post(task, [cb, args...]() { cb(args...); });
+    });
+  }
+
+} // namespace detail
+} // namespace client
+} // namespace carla
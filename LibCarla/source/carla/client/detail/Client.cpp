@@ -9,6 +9,7 @@
 #include "carla/Exception.h"
 #include "carla/Version.h"
 #include "carla/client/TimeoutException.h"
+#include "carla/client/detail/RpcFutureState.h"
 #include "carla/rpc/ActorDescription.h"
 #include "carla/rpc/Client.h"
 #include "carla/rpc/DebugShape.h"
@@ -19,21 +20,13 @@
 
 #include <rpc/rpc_error.h>
 
+#include <future>
 #include <thread>
 
 namespace carla {
 namespace client {
 namespace detail {
 
-  template <typename T>
-  static T Get(carla::rpc::Response<T> &response) {
-    return response.Get();
-  }
-
-  static bool Get(carla::rpc::Response<void> &) {
-    return true;
-  }
-
   // ===========================================================================
   // -- Client::Pimpl ----------------------------------------------------------
   // ===========================================================================
@@ -69,7 +62,7 @@ namespace detail {
       if (response.HasError()) {
         throw_exception(std::runtime_error(response.GetError().What()));
       }
-      return Get(response);
+      return GetResponseValue(response);
     }
 
     template <typename... Args>
@@ -78,6 +71,15 @@ namespace detail {
       rpc_client.async_call(function, std::forward<Args>(args)...);
     }
 
+    template <typename T, typename... Args>
+    auto AsyncCallAndGetFuture(const std::string &function, Args &&... args) {
+      using state_type = RpcFutureState<T>;
+      return Future<typename state_type::value_type>{std::make_shared<state_type>(
+          rpc_client.async_call(function, std::forward<Args>(args)...),
+          endpoint,
+          GetTimeout())};
+    }
+
     time_duration GetTimeout() const {
       auto timeout = rpc_client.get_timeout();
       DEBUG_ASSERT(timeout.has_value());
@@ -293,6 +295,10 @@ namespace detail {
     return _pimpl->CallAndWait<std::string>("replay_file", name, start, duration, follow_id);
   }
 
+  void Client::SetDeserializationWorkerThreads(const size_t worker_threads) {
+    _pimpl->streaming_client.SetDeserializationWorkerThreads(worker_threads);
+  }
+
   void Client::SubscribeToStream(
       const streaming::Token &token,
       std::function<void(Buffer)> callback) {
@@ -311,10 +317,250 @@ namespace detail {
     _pimpl->AsyncCall("apply_batch", std::move(commands), do_tick_cue);
   }
 
+  std::vector<rpc::CommandResponse> Client::ApplyBatchSync(
+      std::vector<rpc::Command> commands,
+      const bool do_tick_cue) {
+    using return_t = std::vector<rpc::CommandResponse>;
+    return _pimpl->CallAndWait<return_t>("apply_batch_sync", std::move(commands), do_tick_cue);
+  }
+
   void Client::SendTickCue() {
     _pimpl->AsyncCall("tick_cue");
   }
 
+  uint64_t Client::ApplyBatchAndTick(std::vector<rpc::Command> commands) {
+    return _pimpl->CallAndWait<uint64_t>("apply_batch_and_tick", std::move(commands));
+  }
+
+  // ===========================================================================
+  // -- Client asynchronous calls ----------------------------------------------
+  // ===========================================================================
+
+  Future<std::string> Client::AsyncGetServerVersion() {
+    return _pimpl->AsyncCallAndGetFuture<std::string>("version");
+  }
+
+  Future<bool> Client::AsyncLoadEpisode(std::string map_name) {
+    return _pimpl->AsyncCallAndGetFuture<void>("load_new_episode", std::move(map_name));
+  }
+
+  Future<rpc::EpisodeInfo> Client::AsyncGetEpisodeInfo() {
+    return _pimpl->AsyncCallAndGetFuture<rpc::EpisodeInfo>("get_episode_info");
+  }
+
+  Future<rpc::MapInfo> Client::AsyncGetMapInfo() {
+    return _pimpl->AsyncCallAndGetFuture<rpc::MapInfo>("get_map_info");
+  }
+
+  Future<std::vector<std::string>> Client::AsyncGetAvailableMaps() {
+    return _pimpl->AsyncCallAndGetFuture<std::vector<std::string>>("get_available_maps");
+  }
+
+  Future<std::vector<rpc::ActorDefinition>> Client::AsyncGetActorDefinitions() {
+    return _pimpl->AsyncCallAndGetFuture<std::vector<rpc::ActorDefinition>>("get_actor_definitions");
+  }
+
+  Future<rpc::Actor> Client::AsyncGetSpectator() {
+    return _pimpl->AsyncCallAndGetFuture<rpc::Actor>("get_spectator");
+  }
+
+  Future<rpc::EpisodeSettings> Client::AsyncGetEpisodeSettings() {
+    return _pimpl->AsyncCallAndGetFuture<rpc::EpisodeSettings>("get_episode_settings");
+  }
+
+  Future<bool> Client::AsyncSetEpisodeSettings(const rpc::EpisodeSettings &settings) {
+    return _pimpl->AsyncCallAndGetFuture<void>("set_episode_settings", settings);
+  }
+
+  Future<rpc::WeatherParameters> Client::AsyncGetWeatherParameters() {
+    return _pimpl->AsyncCallAndGetFuture<rpc::WeatherParameters>("get_weather_parameters");
+  }
+
+  Future<bool> Client::AsyncSetWeatherParameters(const rpc::WeatherParameters &weather) {
+    return _pimpl->AsyncCallAndGetFuture<void>("set_weather_parameters", weather);
+  }
+
+  Future<std::vector<rpc::Actor>> Client::AsyncGetActorsById(
+      const std::vector<ActorId> &ids) {
+    return _pimpl->AsyncCallAndGetFuture<std::vector<rpc::Actor>>("get_actors_by_id", ids);
+  }
+
+  Future<rpc::VehiclePhysicsControl> Client::AsyncGetVehiclePhysicsControl(
+      const rpc::ActorId vehicle) {
+    return _pimpl->AsyncCallAndGetFuture<rpc::VehiclePhysicsControl>("get_physics_control", vehicle);
+  }
+
+  Future<bool> Client::AsyncApplyPhysicsControlToVehicle(
+      const rpc::ActorId vehicle,
+      const rpc::VehiclePhysicsControl &physics_control) {
+    return _pimpl->AsyncCallAndGetFuture<void>("apply_physics_control", vehicle, physics_control);
+  }
+
+  Future<rpc::Actor> Client::AsyncSpawnActor(
+      const rpc::ActorDescription &description,
+      const geom::Transform &transform) {
+    return _pimpl->AsyncCallAndGetFuture<rpc::Actor>("spawn_actor", description, transform);
+  }
+
+  Future<rpc::Actor> Client::AsyncSpawnActorWithParent(
+      const rpc::ActorDescription &description,
+      const geom::Transform &transform,
+      const rpc::ActorId parent) {
+    return _pimpl->AsyncCallAndGetFuture<rpc::Actor>("spawn_actor_with_parent", description, transform, parent);
+  }
+
+  Future<bool> Client::AsyncDestroyActor(const rpc::ActorId actor) {
+    return _pimpl->AsyncCallAndGetFuture<void>("destroy_actor", actor);
+  }
+
+  Future<bool> Client::AsyncSetActorLocation(
+      const rpc::ActorId actor,
+      const geom::Location &location) {
+    return _pimpl->AsyncCallAndGetFuture<void>("set_actor_location", actor, location);
+  }
+
+  Future<bool> Client::AsyncSetActorTransform(
+      const rpc::ActorId actor,
+      const geom::Transform &transform) {
+    return _pimpl->AsyncCallAndGetFuture<void>("set_actor_transform", actor, transform);
+  }
+
+  Future<bool> Client::AsyncSetActorVelocity(
+      const rpc::ActorId actor,
+      const geom::Vector3D &vector) {
+    return _pimpl->AsyncCallAndGetFuture<void>("set_actor_velocity", actor, vector);
+  }
+
+  Future<bool> Client::AsyncSetActorAngularVelocity(
+      const rpc::ActorId actor,
+      const geom::Vector3D &vector) {
+    return _pimpl->AsyncCallAndGetFuture<void>("set_actor_angular_velocity", actor, vector);
+  }
+
+  Future<bool> Client::AsyncAddActorImpulse(
+      const rpc::ActorId actor,
+      const geom::Vector3D &vector) {
+    return _pimpl->AsyncCallAndGetFuture<void>("add_actor_impulse", actor, vector);
+  }
+
+  Future<bool> Client::AsyncSetActorSimulatePhysics(
+      const rpc::ActorId actor,
+      const bool enabled) {
+    return _pimpl->AsyncCallAndGetFuture<void>("set_actor_simulate_physics", actor, enabled);
+  }
+
+  Future<bool> Client::AsyncSetActorAutopilot(
+      const rpc::ActorId vehicle,
+      const bool enabled) {
+    return _pimpl->AsyncCallAndGetFuture<void>("set_actor_autopilot", vehicle, enabled);
+  }
+
+  Future<bool> Client::AsyncApplyControlToVehicle(
+      const rpc::ActorId vehicle,
+      const rpc::VehicleControl &control) {
+    return _pimpl->AsyncCallAndGetFuture<void>("apply_control_to_vehicle", vehicle, control);
+  }
+
+  Future<bool> Client::AsyncApplyControlToWalker(
+      const rpc::ActorId walker,
+      const rpc::WalkerControl &control) {
+    return _pimpl->AsyncCallAndGetFuture<void>("apply_control_to_walker", walker, control);
+  }
+
+  Future<bool> Client::AsyncSetTrafficLightState(
+      const rpc::ActorId traffic_light,
+      const rpc::TrafficLightState traffic_light_state) {
+    return _pimpl->AsyncCallAndGetFuture<void>("set_traffic_light_state", traffic_light, traffic_light_state);
+  }
+
+  Future<bool> Client::AsyncSetTrafficLightGreenTime(
+      const rpc::ActorId traffic_light,
+      const float green_time) {
+    return _pimpl->AsyncCallAndGetFuture<void>("set_traffic_light_green_time", traffic_light, green_time);
+  }
+
+  Future<bool> Client::AsyncSetTrafficLightYellowTime(
+      const rpc::ActorId traffic_light,
+      const float yellow_time) {
+    return _pimpl->AsyncCallAndGetFuture<void>("set_traffic_light_yellow_time", traffic_light, yellow_time);
+  }
+
+  Future<bool> Client::AsyncSetTrafficLightRedTime(
+      const rpc::ActorId traffic_light,
+      const float red_time) {
+    return _pimpl->AsyncCallAndGetFuture<void>("set_traffic_light_red_time", traffic_light, red_time);
+  }
+
+  Future<bool> Client::AsyncFreezeTrafficLight(
+      const rpc::ActorId traffic_light,
+      const bool freeze) {
+    return _pimpl->AsyncCallAndGetFuture<void>("freeze_traffic_light", traffic_light, freeze);
+  }
+
+  Future<std::vector<ActorId>> Client::AsyncGetGroupTrafficLights(
+      const rpc::ActorId traffic_light) {
+    return _pimpl->AsyncCallAndGetFuture<std::vector<ActorId>>("get_group_traffic_lights", traffic_light);
+  }
+
+  Future<std::string> Client::AsyncStartRecorder(std::string name) {
+    return _pimpl->AsyncCallAndGetFuture<std::string>("start_recorder", std::move(name));
+  }
+
+  Future<bool> Client::AsyncStopRecorder() {
+    return _pimpl->AsyncCallAndGetFuture<void>("stop_recorder");
+  }
+
+  Future<std::string> Client::AsyncShowRecorderFileInfo(std::string name) {
+    return _pimpl->AsyncCallAndGetFuture<std::string>("show_recorder_file_info", std::move(name));
+  }
+
+  Future<std::string> Client::AsyncShowRecorderCollisions(
+      std::string name,
+      const char type1,
+      const char type2) {
+    return _pimpl->AsyncCallAndGetFuture<std::string>("show_recorder_collisions", std::move(name), type1, type2);
+  }
+
+  Future<std::string> Client::AsyncShowRecorderActorsBlocked(
+      std::string name,
+      const double min_time,
+      const double min_distance) {
+    return _pimpl->AsyncCallAndGetFuture<std::string>("show_recorder_actors_blocked", std::move(name), min_time, min_distance);
+  }
+
+  Future<std::string> Client::AsyncReplayFile(
+      std::string name,
+      const double start,
+      const double duration,
+      const uint32_t follow_id) {
+    return _pimpl->AsyncCallAndGetFuture<std::string>("replay_file", std::move(name), start, duration, follow_id);
+  }
+
+  Future<bool> Client::AsyncDrawDebugShape(const rpc::DebugShape &shape) {
+    return _pimpl->AsyncCallAndGetFuture<void>("draw_debug_shape", shape);
+  }
+
+  Future<bool> Client::AsyncApplyBatch(
+      std::vector<rpc::Command> commands,
+      const bool do_tick_cue) {
+    return _pimpl->AsyncCallAndGetFuture<void>("apply_batch", std::move(commands), do_tick_cue);
+  }
+
+  Future<std::vector<rpc::CommandResponse>> Client::AsyncApplyBatchSync(
+      std::vector<rpc::Command> commands,
+      const bool do_tick_cue) {
+    using return_t = std::vector<rpc::CommandResponse>;
+    return _pimpl->AsyncCallAndGetFuture<return_t>("apply_batch_sync", std::move(commands), do_tick_cue);
+  }
+
+  Future<bool> Client::AsyncSendTickCue() {
+    return _pimpl->AsyncCallAndGetFuture<void>("tick_cue");
+  }
+
+  Future<uint64_t> Client::AsyncApplyBatchAndTick(std::vector<rpc::Command> commands) {
+    return _pimpl->AsyncCallAndGetFuture<uint64_t>("apply_batch_and_tick", std::move(commands));
+  }
+
 } // namespace detail
 } // namespace client
 } // namespace carla
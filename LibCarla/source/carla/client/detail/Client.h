@@ -9,10 +9,12 @@
 #include "carla/Memory.h"
 #include "carla/NonCopyable.h"
 #include "carla/Time.h"
+#include "carla/client/Future.h"
 #include "carla/geom/Transform.h"
 #include "carla/rpc/Actor.h"
 #include "carla/rpc/ActorDefinition.h"
 #include "carla/rpc/Command.h"
+#include "carla/rpc/CommandResponse.h"
 #include "carla/rpc/EpisodeInfo.h"
 #include "carla/rpc/EpisodeSettings.h"
 #include "carla/rpc/MapInfo.h"
@@ -181,6 +183,8 @@ namespace detail {
 
     std::string ReplayFile(std::string name, double start, double duration, uint32_t follow_id);
 
+    void SetDeserializationWorkerThreads(size_t worker_threads);
+
     void SubscribeToStream(
         const streaming::Token &token,
         std::function<void(Buffer)> callback);
@@ -191,8 +195,149 @@ namespace detail {
 
     void ApplyBatch(std::vector<rpc::Command> commands, bool do_tick_cue);
 
+    /// Apply @a commands and wait for the response to each of them.
+    std::vector<rpc::CommandResponse> ApplyBatchSync(
+        std::vector<rpc::Command> commands,
+        bool do_tick_cue);
+
     void SendTickCue();
 
+    /// Apply @a commands and signal the simulator to continue to next tick.
+    ///
+    /// @return the frame that will be simulated with these commands.
+    uint64_t ApplyBatchAndTick(std::vector<rpc::Command> commands);
+
+    // =========================================================================
+    // -- Asynchronous calls ---------------------------------------------------
+    // =========================================================================
+
+    // Same as the calls above but return as soon as the request is sent,
+    // consecutive requests are pipelined on the same connection. Errors,
+    // including time-outs waiting for the response, are thrown by the
+    // returned future. Calls without result return a Future<bool>.
+
+    Future<std::string> AsyncGetServerVersion();
+
+    Future<bool> AsyncLoadEpisode(std::string map_name);
+
+    Future<rpc::EpisodeInfo> AsyncGetEpisodeInfo();
+
+    Future<rpc::MapInfo> AsyncGetMapInfo();
+
+    Future<std::vector<std::string>> AsyncGetAvailableMaps();
+
+    Future<std::vector<rpc::ActorDefinition>> AsyncGetActorDefinitions();
+
+    Future<rpc::Actor> AsyncGetSpectator();
+
+    Future<rpc::EpisodeSettings> AsyncGetEpisodeSettings();
+
+    Future<bool> AsyncSetEpisodeSettings(const rpc::EpisodeSettings &settings);
+
+    Future<rpc::WeatherParameters> AsyncGetWeatherParameters();
+
+    Future<bool> AsyncSetWeatherParameters(const rpc::WeatherParameters &weather);
+
+    Future<std::vector<rpc::Actor>> AsyncGetActorsById(const std::vector<ActorId> &ids);
+
+    Future<rpc::VehiclePhysicsControl> AsyncGetVehiclePhysicsControl(
+        rpc::ActorId vehicle);
+
+    Future<bool> AsyncApplyPhysicsControlToVehicle(
+        rpc::ActorId vehicle,
+        const rpc::VehiclePhysicsControl &physics_control);
+
+    Future<rpc::Actor> AsyncSpawnActor(
+        const rpc::ActorDescription &description,
+        const geom::Transform &transform);
+
+    Future<rpc::Actor> AsyncSpawnActorWithParent(
+        const rpc::ActorDescription &description,
+        const geom::Transform &transform,
+        rpc::ActorId parent);
+
+    Future<bool> AsyncDestroyActor(rpc::ActorId actor);
+
+    Future<bool> AsyncSetActorLocation(
+        rpc::ActorId actor,
+        const geom::Location &location);
+
+    Future<bool> AsyncSetActorTransform(
+        rpc::ActorId actor,
+        const geom::Transform &transform);
+
+    Future<bool> AsyncSetActorVelocity(rpc::ActorId actor, const geom::Vector3D &vector);
+
+    Future<bool> AsyncSetActorAngularVelocity(
+        rpc::ActorId actor,
+        const geom::Vector3D &vector);
+
+    Future<bool> AsyncAddActorImpulse(rpc::ActorId actor, const geom::Vector3D &vector);
+
+    Future<bool> AsyncSetActorSimulatePhysics(rpc::ActorId actor, bool enabled);
+
+    Future<bool> AsyncSetActorAutopilot(rpc::ActorId vehicle, bool enabled);
+
+    Future<bool> AsyncApplyControlToVehicle(
+        rpc::ActorId vehicle,
+        const rpc::VehicleControl &control);
+
+    Future<bool> AsyncApplyControlToWalker(
+        rpc::ActorId walker,
+        const rpc::WalkerControl &control);
+
+    Future<bool> AsyncSetTrafficLightState(
+        rpc::ActorId traffic_light,
+        rpc::TrafficLightState traffic_light_state);
+
+    Future<bool> AsyncSetTrafficLightGreenTime(
+        rpc::ActorId traffic_light,
+        float green_time);
+
+    Future<bool> AsyncSetTrafficLightYellowTime(
+        rpc::ActorId traffic_light,
+        float yellow_time);
+
+    Future<bool> AsyncSetTrafficLightRedTime(rpc::ActorId traffic_light, float red_time);
+
+    Future<bool> AsyncFreezeTrafficLight(rpc::ActorId traffic_light, bool freeze);
+
+    Future<std::vector<ActorId>> AsyncGetGroupTrafficLights(rpc::ActorId traffic_light);
+
+    Future<std::string> AsyncStartRecorder(std::string name);
+
+    Future<bool> AsyncStopRecorder();
+
+    Future<std::string> AsyncShowRecorderFileInfo(std::string name);
+
+    Future<std::string> AsyncShowRecorderCollisions(
+        std::string name,
+        char type1,
+        char type2);
+
+    Future<std::string> AsyncShowRecorderActorsBlocked(
+        std::string name,
+        double min_time,
+        double min_distance);
+
+    Future<std::string> AsyncReplayFile(
+        std::string name,
+        double start,
+        double duration,
+        uint32_t follow_id);
+
+    Future<bool> AsyncDrawDebugShape(const rpc::DebugShape &shape);
+
+    Future<bool> AsyncApplyBatch(std::vector<rpc::Command> commands, bool do_tick_cue);
+
+    Future<std::vector<rpc::CommandResponse>> AsyncApplyBatchSync(
+        std::vector<rpc::Command> commands,
+        bool do_tick_cue);
+
+    Future<bool> AsyncSendTickCue();
+
+    Future<uint64_t> AsyncApplyBatchAndTick(std::vector<rpc::Command> commands);
+
   private:
 
     class Pimpl;
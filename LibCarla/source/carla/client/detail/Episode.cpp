@@ -53,30 +53,64 @@ namespace detail {
           }
         } while (!self->_state.compare_exchange(&prev, next));
 
+        // The actors of a new episode are not compared against the ones of
+        // the previous episode, the history of changes starts again.
+        ActorIdChanges changes;
         if (next->GetEpisodeId() != prev->GetEpisodeId()) {
-          self->OnEpisodeStarted();
+          self->OnEpisodeStarted(*next);
+        } else {
+          changes = self->_actor_changes.Record(*prev, *next);
         }
 
         // Notify waiting threads and do the callbacks.
         self->_timestamp.SetValue(next->GetTimestamp());
         self->_on_tick_callbacks.Call(next->GetTimestamp());
+        if (!changes.empty()) {
+          self->_on_actors_changed_callbacks.Call(std::move(changes));
+        }
       }
     });
   }
 
+  template <typename RangeT>
+  static std::vector<rpc::Actor> GetActorsById_Impl(
+      Client &client,
+      CachedActorList &actors,
+      const RangeT &actor_ids) {
+    auto missing_ids = actors.GetMissingIds(actor_ids);
+    if (!missing_ids.empty()) {
+      actors.InsertRange(client.GetActorsById(missing_ids));
+    }
+    return actors.GetActorsById(actor_ids);
+  }
+
   std::vector<rpc::Actor> Episode::GetActors() {
     const auto state = GetState();
-    const auto actor_ids = state->GetActorIds();
-    auto missing_ids = _actors.GetMissingIds(actor_ids);
-    if (!missing_ids.empty()) {
-      _actors.InsertRange(_client.GetActorsById(missing_ids));
+    return GetActorsById_Impl(_client, _actors, state->GetActorIds());
+  }
+
+  std::vector<rpc::Actor> Episode::GetActorsById(const std::vector<ActorId> &ids) {
+    return GetActorsById_Impl(_client, _actors, ids);
+  }
+
+  Future<std::vector<rpc::Actor>> Episode::AsyncGetActorsById(const std::vector<ActorId> &ids) {
+    auto missing_ids = _actors.GetMissingIds(ids);
+    if (missing_ids.empty()) {
+      return Future<std::vector<rpc::Actor>>::MakeReady(_actors.GetActorsById(ids));
     }
-    return _actors.GetActorsById(actor_ids);
+    auto self = shared_from_this();
+    return _client.AsyncGetActorsById(missing_ids).Then([self, ids](std::vector<rpc::Actor> actors) {
+      self->_actors.InsertRange(std::move(actors));
+      return self->_actors.GetActorsById(ids);
+    });
   }
 
-  void Episode::OnEpisodeStarted() {
+  void Episode::OnEpisodeStarted(const EpisodeState &state) {
     _actors.Clear();
+    _actor_changes.Reset(state.GetFrameCount());
     _on_tick_callbacks.Clear();
+    _on_actors_changed_callbacks.Clear();
+    _callback_executor.Clear();
   }
 
 } // namespace detail
@@ -9,8 +9,11 @@
 #include "carla/AtomicSharedPtr.h"
 #include "carla/NonCopyable.h"
 #include "carla/RecurrentSharedFuture.h"
+#include "carla/client/Future.h"
 #include "carla/client/Timestamp.h"
+#include "carla/client/detail/ActorChangeLog.h"
 #include "carla/client/detail/CachedActorList.h"
+#include "carla/client/detail/CallbackExecutor.h"
 #include "carla/client/detail/CallbackList.h"
 #include "carla/client/detail/EpisodeState.h"
 #include "carla/rpc/EpisodeInfo.h"
@@ -51,19 +54,61 @@ namespace detail {
 
     std::vector<rpc::Actor> GetActors();
 
+    /// Retrieve the descriptions of the actors in @a ids, requesting to the
+    /// server only the ones not yet cached.
+    std::vector<rpc::Actor> GetActorsById(const std::vector<ActorId> &ids);
+
+    /// Same as GetActorsById without waiting for the response of the server,
+    /// the result is ready already if every actor is cached.
+    Future<std::vector<rpc::Actor>> AsyncGetActorsById(const std::vector<ActorId> &ids);
+
+    /// Return the ids of the actors spawned and destroyed after
+    /// @a since_frame.
+    ActorIdChanges GetActorChanges(size_t since_frame) const {
+      return _actor_changes.GetChangesSince(since_frame);
+    }
+
     boost::optional<Timestamp> WaitForState(time_duration timeout) {
       return _timestamp.WaitFor(timeout);
     }
 
-    void RegisterOnTickEvent(std::function<void(Timestamp)> callback) {
-      _on_tick_callbacks.RegisterCallback(std::move(callback));
+    /// Register a @a callback to be called on every tick. If @a coalesce is
+    /// true and the callback falls behind, only the latest tick is delivered.
+    ///
+    /// @return the id of the callback, used to identify its metrics.
+    size_t RegisterOnTickEvent(
+        std::function<void(Timestamp)> callback,
+        bool coalesce = false) {
+      auto result = _callback_executor.Wrap(std::move(callback), coalesce);
+      _on_tick_callbacks.RegisterCallback(std::move(result.second));
+      return result.first;
+    }
+
+    /// Register a @a callback to be called on every tick in which actors
+    /// have been spawned or destroyed.
+    ///
+    /// @return the id of the callback, used to identify its metrics.
+    size_t RegisterOnActorsChangedEvent(std::function<void(ActorIdChanges)> callback) {
+      auto result = _callback_executor.Wrap(std::move(callback), false);
+      _on_actors_changed_callbacks.RegisterCallback(std::move(result.second));
+      return result.first;
+    }
+
+    /// Execute the callbacks in @a worker_threads threads instead of the
+    /// thread receiving the ticks.
+    void SetCallbackWorkerThreads(size_t worker_threads) {
+      _callback_executor.SetWorkerThreads(worker_threads);
+    }
+
+    std::vector<CallbackMetrics> GetCallbackMetrics() const {
+      return _callback_executor.GetMetrics();
     }
 
   private:
 
     Episode(Client &client, const rpc::EpisodeInfo &info);
 
-    void OnEpisodeStarted();
+    void OnEpisodeStarted(const EpisodeState &state);
 
     Client &_client;
 
@@ -71,11 +116,19 @@ namespace detail {
 
     CachedActorList _actors;
 
+    ActorChangeLog _actor_changes;
+
     CallbackList<Timestamp> _on_tick_callbacks;
 
+    CallbackList<ActorIdChanges> _on_actors_changed_callbacks;
+
     RecurrentSharedFuture<Timestamp> _timestamp;
 
     const streaming::Token _token;
+
+    // Declared last so worker threads are joined before anything else is
+    // destroyed.
+    CallbackExecutor _callback_executor;
   };
 
 } // namespace detail
@@ -38,6 +38,14 @@ namespace detail {
 
     explicit EpisodeState(const sensor::data::RawEpisodeState &state);
 
+    EpisodeState(
+        uint64_t episode_id,
+        const Timestamp &timestamp,
+        std::unordered_map<ActorId, ActorState> actors)
+      : _episode_id(episode_id),
+        _timestamp(timestamp),
+        _actors(std::move(actors)) {}
+
     auto GetEpisodeId() const {
       return _episode_id;
     }
@@ -50,6 +58,17 @@ namespace detail {
       return _timestamp;
     }
 
+    bool ContainsActor(ActorId id) const {
+      return _actors.find(id) != _actors.end();
+    }
+
+    /// Return a pointer to the state of the actor, or nullptr if the actor is
+    /// not present in this episode state.
+    const ActorState *FindActorState(ActorId id) const {
+      auto it = _actors.find(id);
+      return it != _actors.end() ? &it->second : nullptr;
+    }
+
     ActorState GetActorState(ActorId id) const {
       ActorState state;
       auto it = _actors.find(id);
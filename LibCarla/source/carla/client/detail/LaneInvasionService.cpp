@@ -0,0 +1,138 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/detail/LaneInvasionService.h"
+
+#include "carla/Logging.h"
+#include "carla/client/Map.h"
+#include "carla/client/detail/EpisodeState.h"
+#include "carla/geom/Math.h"
+
+#include <exception>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  static geom::Location Rotate(float yaw, const geom::Location &location) {
+    yaw *= geom::Math::pi() / 180.0f;
+    const float c = std::cos(yaw);
+    const float s = std::sin(yaw);
+    return {
+        c * location.x - s * location.y,
+        s * location.x + c * location.y,
+        location.z};
+  }
+
+  static std::vector<geom::Location> GetVehicleBounds(
+      const geom::Transform &transform,
+      const geom::BoundingBox &box) {
+    const auto location = transform.location + box.location;
+    const auto yaw = transform.rotation.yaw;
+    return {
+        location + Rotate(yaw, geom::Location( box.extent.x,  box.extent.y, 0.0f)),
+        location + Rotate(yaw, geom::Location(-box.extent.x,  box.extent.y, 0.0f)),
+        location + Rotate(yaw, geom::Location( box.extent.x, -box.extent.y, 0.0f)),
+        location + Rotate(yaw, geom::Location(-box.extent.x, -box.extent.y, 0.0f))};
+  }
+
+  LaneInvasionService::LaneInvasionService(SharedPtr<Map> map)
+    : _map(std::move(map)) {
+    DEBUG_ASSERT(_map != nullptr);
+  }
+
+  LaneInvasionService::~LaneInvasionService() = default;
+
+  size_t LaneInvasionService::Subscribe(
+      const ActorId vehicle_id,
+      const geom::BoundingBox &bounding_box,
+      CallbackType callback) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto id = _next_id++;
+    _subscribers.emplace(id, std::make_shared<Subscriber>(vehicle_id, bounding_box, std::move(callback)));
+    return id;
+  }
+
+  void LaneInvasionService::Unsubscribe(const size_t id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto it = _subscribers.find(id);
+    if (it != _subscribers.end()) {
+      it->second->is_subscribed = false;
+      _subscribers.erase(it);
+    }
+  }
+
+  void LaneInvasionService::Tick(const Timestamp &timestamp, const EpisodeState &state) {
+    Tick(timestamp, [&](ActorId id) -> const geom::Transform * {
+      const auto *actor_state = state.FindActorState(id);
+      return actor_state != nullptr ? &actor_state->transform : nullptr;
+    });
+  }
+
+  void LaneInvasionService::Tick(
+      const Timestamp &timestamp,
+      const std::function<const geom::Transform *(ActorId)> &get_transform) {
+    std::lock_guard<std::mutex> tick_lock(_tick_mutex);
+
+    std::vector<std::shared_ptr<Subscriber>> subscribers;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      subscribers.reserve(_subscribers.size());
+      for (auto &&item : _subscribers) {
+        subscribers.emplace_back(item.second);
+      }
+    }
+    // A few waypoint lookups per vehicle, cheaper than handing them over to
+    // other threads every tick.
+    for (auto &&subscriber : subscribers) {
+      TickSubscriber(*subscriber, get_transform(subscriber->vehicle_id));
+    }
+
+    // A callback may unsubscribe the ones that follow, e.g. stopping other
+    // sensors.
+    for (auto &&subscriber : subscribers) {
+      if (!subscriber->crossed_lanes.empty() && subscriber->is_subscribed) {
+        subscriber->callback(timestamp, subscriber->transform, std::move(subscriber->crossed_lanes));
+        subscriber->crossed_lanes.clear();
+      }
+    }
+  }
+
+  void LaneInvasionService::TickSubscriber(
+      Subscriber &subscriber,
+      const geom::Transform *transform) const {
+    subscriber.crossed_lanes.clear();
+    if (transform == nullptr) {
+      // The vehicle is gone, start again if it comes back.
+      subscriber.bounds.clear();
+      subscriber.waypoints.clear();
+      return;
+    }
+    try {
+      subscriber.transform = *transform;
+      auto new_bounds = GetVehicleBounds(*transform, subscriber.bounding_box);
+      auto new_waypoints = _map->GetClosestWaypointsOnRoad(new_bounds, subscriber.waypoints);
+      for (auto i = 0u; i < subscriber.waypoints.size(); ++i) {
+        const auto lanes = _map->CalculateCrossedLanes(
+            subscriber.waypoints[i],
+            subscriber.bounds[i],
+            new_waypoints[i],
+            new_bounds[i]);
+        subscriber.crossed_lanes.insert(subscriber.crossed_lanes.end(), lanes.begin(), lanes.end());
+      }
+      subscriber.bounds = std::move(new_bounds);
+      subscriber.waypoints = std::move(new_waypoints);
+    } catch (const std::exception &e) {
+      log_debug("LaneInvasionService:", e.what());
+      subscriber.crossed_lanes.clear();
+      subscriber.bounds.clear();
+      subscriber.waypoints.clear();
+    }
+  }
+
+} // namespace detail
+} // namespace client
+} // namespace carla
@@ -0,0 +1,128 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+#include "carla/client/Timestamp.h"
+#include "carla/geom/BoundingBox.h"
+#include "carla/geom/Transform.h"
+#include "carla/road/element/LaneMarking.h"
+#include "carla/road/element/Waypoint.h"
+#include "carla/rpc/ActorId.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace carla {
+namespace client {
+
+  class Map;
+
+namespace detail {
+
+  class EpisodeState;
+
+  /// Computes the lane invasions of every vehicle with a lane invasion sensor
+  /// in a single pass per tick.
+  ///
+  /// The waypoints of the corners of each vehicle are kept from one tick to
+  /// the next, the new ones are tracked from them instead of searched in the
+  /// whole map.
+  class LaneInvasionService : private NonCopyable {
+  public:
+
+    /// Called with the transform of the vehicle and the lane markings crossed
+    /// in a tick, only if any.
+    using CallbackType = std::function<void(
+        const Timestamp &,
+        const geom::Transform &,
+        std::vector<road::element::LaneMarking>)>;
+
+    explicit LaneInvasionService(SharedPtr<Map> map);
+
+    ~LaneInvasionService();
+
+    const SharedPtr<Map> &GetMap() const {
+      return _map;
+    }
+
+    /// Call @a callback every tick in which the vehicle @a vehicle_id, with
+    /// bounding box @a bounding_box, invades another lane.
+    ///
+    /// @return the id of the subscription.
+    size_t Subscribe(
+        ActorId vehicle_id,
+        const geom::BoundingBox &bounding_box,
+        CallbackType callback);
+
+    /// The callback is not called anymore once this returns, unless it is
+    /// running already.
+    void Unsubscribe(size_t id);
+
+    /// Compute the lane invasions of every vehicle subscribed at the state
+    /// @a state, and call the callbacks in this thread.
+    void Tick(const Timestamp &timestamp, const EpisodeState &state);
+
+    /// Same as above, reading the transform of each vehicle from
+    /// @a get_transform, which returns nullptr if the vehicle is gone.
+    void Tick(
+        const Timestamp &timestamp,
+        const std::function<const geom::Transform *(ActorId)> &get_transform);
+
+  private:
+
+    struct Subscriber {
+
+      Subscriber(ActorId in_vehicle_id, const geom::BoundingBox &in_bounding_box, CallbackType in_callback)
+        : vehicle_id(in_vehicle_id),
+          bounding_box(in_bounding_box),
+          callback(std::move(in_callback)) {}
+
+      const ActorId vehicle_id;
+
+      const geom::BoundingBox bounding_box;
+
+      const CallbackType callback;
+
+      /// Cleared on Unsubscribe, a tick may still hold this subscriber.
+      std::atomic_bool is_subscribed{true};
+
+      /// Corners of the vehicle on the previous tick.
+      std::vector<geom::Location> bounds;
+
+      /// Waypoints of bounds, the new ones are tracked from these.
+      std::vector<road::element::Waypoint> waypoints;
+
+      /// Results of the current tick.
+      geom::Transform transform;
+
+      std::vector<road::element::LaneMarking> crossed_lanes;
+    };
+
+    void TickSubscriber(Subscriber &subscriber, const geom::Transform *transform) const;
+
+    const SharedPtr<Map> _map;
+
+    std::mutex _mutex;
+
+    size_t _next_id = 0u;
+
+    std::unordered_map<size_t, std::shared_ptr<Subscriber>> _subscribers;
+
+    /// Serializes the ticks, the state of the subscribers is only modified
+    /// while holding this mutex.
+    std::mutex _tick_mutex;
+  };
+
+} // namespace detail
+} // namespace client
+} // namespace carla
@@ -0,0 +1,191 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/detail/MapCache.h"
+
+#include "carla/Logging.h"
+#include "carla/opendrive/OpenDrive.h"
+#include "carla/road/CompiledMap.h"
+#include "carla/road/Map.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+#ifdef _WIN32
+#  include <process.h>
+#else
+#  include <unistd.h>
+#endif // _WIN32
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  // ===========================================================================
+  // -- Static local methods ---------------------------------------------------
+  // ===========================================================================
+
+  namespace {
+
+    struct KeyHasher {
+      size_t operator()(const MapCache::Key &key) const {
+        static_assert(sizeof(size_t) <= sizeof(key.digest), "Digest too short.");
+        size_t hash;
+        std::memcpy(&hash, key.digest.data(), sizeof(hash));
+        return hash;
+      }
+    };
+
+    /// A map of the cache. Its mutex is held while building the map so
+    /// concurrent requests of the same map (e.g. several sensors spawned at
+    /// once) parse the file only once, without blocking other maps.
+    struct Entry {
+      std::mutex mutex;
+      WeakPtr<const road::Map> map;
+    };
+
+    struct Cache {
+      std::mutex mutex;
+      std::unordered_map<MapCache::Key, std::shared_ptr<Entry>, KeyHasher> maps;
+    };
+
+  } // namespace
+
+  static Cache &GetCache() {
+    static Cache cache;
+    return cache;
+  }
+
+  /// Remove the entries whose map is no longer alive and that nobody else is
+  /// building. Must be called with the lock of the cache held.
+  static void RemoveExpired(Cache &cache) {
+    for (auto it = cache.maps.begin(); it != cache.maps.end();) {
+      if ((it->second.use_count() == 1) && it->second->map.expired()) {
+        it = cache.maps.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  /// Name of a temporary file next to @a path, unique among the processes
+  /// and threads writing to the same directory.
+  static std::string MakeTemporaryPath(const std::string &path) {
+    static std::atomic<uint64_t> count{0u};
+#ifdef _WIN32
+    const auto pid = ::_getpid();
+#else
+    const auto pid = ::getpid();
+#endif // _WIN32
+    return path + ".tmp" + std::to_string(pid) + '-' + std::to_string(count++);
+  }
+
+  static void WriteCompiledMap(
+      const road::Map &map,
+      const MapCache::Key &key,
+      const std::string &path) {
+    const auto blob = road::CompiledMap::Write(map, key);
+    // Write to a temporary file and rename it so other processes never see a
+    // partially written map.
+    const auto temp_path = MakeTemporaryPath(path);
+    {
+      std::ofstream file(temp_path, std::ios::binary);
+      file.write(reinterpret_cast<const char *>(blob.data()), static_cast<std::streamsize>(blob.size()));
+      if (!file.good()) {
+        log_warning("map cache: unable to write", temp_path);
+        file.close();
+        std::remove(temp_path.c_str());
+        return;
+      }
+    }
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+      log_warning("map cache: unable to write", path);
+      std::remove(temp_path.c_str());
+    }
+  }
+
+  static SharedPtr<road::Map> Build(const MapCache::Key &key, const std::string &contents) {
+    const auto path = MapCache::GetCompiledMapPath(key);
+    if (!path.empty()) {
+      std::string error;
+      auto map = opendrive::OpenDrive::LoadCompiledFile(path, &error, &key);
+      if (map != nullptr) {
+        log_debug("map cache: loaded compiled map", path);
+        return map;
+      }
+      log_debug("map cache:", error);
+    }
+    log_debug("map cache: building map of", contents.size(), "bytes");
+    auto stream = std::istringstream(contents);
+    auto map = opendrive::OpenDrive::Load(stream);
+    if ((map != nullptr) && !path.empty()) {
+      WriteCompiledMap(*map, key, path);
+    }
+    return map;
+  }
+
+  // ===========================================================================
+  // -- MapCache ---------------------------------------------------------------
+  // ===========================================================================
+
+  std::string MapCache::GetCompiledMapPath(const Key &key) {
+    const char *dir = std::getenv("CARLA_MAP_CACHE_DIR");
+    if ((dir == nullptr) || (*dir == '\0')) {
+      return {};
+    }
+    std::ostringstream path;
+    path << dir << '/' << std::hex << std::setfill('0');
+    for (auto byte : key.digest) {
+      path << std::setw(2) << static_cast<unsigned>(byte);
+    }
+    path << ".v" << std::dec << road::CompiledMap::version() << ".bin";
+    return path.str();
+  }
+
+  SharedPtr<const road::Map> MapCache::GetOrBuild(const std::string &contents) {
+    const auto key = MakeKey(contents);
+    std::shared_ptr<Entry> entry;
+    {
+      auto &cache = GetCache();
+      std::lock_guard<std::mutex> lock(cache.mutex);
+      RemoveExpired(cache);
+      auto &item = cache.maps[key];
+      if (item == nullptr) {
+        item = std::make_shared<Entry>();
+      }
+      entry = item;
+    }
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    auto map = entry->map.lock();
+    if (map == nullptr) {
+      map = Build(key, contents);
+      entry->map = map;
+    }
+    return map;
+  }
+
+  size_t MapCache::size() {
+    auto &cache = GetCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return cache.maps.size();
+  }
+
+  void MapCache::Clear() {
+    auto &cache = GetCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.maps.clear();
+  }
+
+} // namespace detail
+} // namespace client
+} // namespace carla
@@ -0,0 +1,64 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+#include "carla/road/CompiledMap.h"
+
+#include <cstdint>
+#include <string>
+
+namespace carla {
+namespace road { class Map; }
+namespace client {
+namespace detail {
+
+  /// Process-wide cache of the road maps built from OpenDRIVE files, keyed by
+  /// the size and digest of the OpenDRIVE contents. Every client::Map created from the same
+  /// OpenDRIVE shares the same road::Map, so the file is parsed only once.
+  ///
+  /// The cache does not keep the maps alive, a map is discarded once nobody
+  /// holds a reference to it.
+  ///
+  /// If the environment variable CARLA_MAP_CACHE_DIR is set, the maps are also
+  /// stored there as road::CompiledMap files, so that later processes load
+  /// them without parsing the OpenDRIVE. A file is only loaded if its header
+  /// matches the key of the OpenDRIVE and its contents are valid, otherwise
+  /// the OpenDRIVE is parsed and the file replaced.
+  class MapCache : private NonCopyable {
+  public:
+
+    /// Identifies an OpenDRIVE by its size and SHA-1 digest, both must match
+    /// for a map to be reused.
+    using Key = road::CompiledMap::Source;
+
+    static Key MakeKey(const std::string &contents) {
+      return road::CompiledMap::MakeSource(contents);
+    }
+
+    /// Path of the compiled map of @a key in the directory given by the
+    /// environment variable CARLA_MAP_CACHE_DIR, or empty if it is not set.
+    static std::string GetCompiledMapPath(const Key &key);
+
+    /// Return the map built from the OpenDRIVE @a contents, building it only
+    /// if it is not present in the cache.
+    ///
+    /// @return nullptr if the map could not be built.
+    static SharedPtr<const road::Map> GetOrBuild(const std::string &contents);
+
+    /// Number of entries in the cache. The entries of maps no longer alive
+    /// are removed on the next call to GetOrBuild.
+    static size_t size();
+
+    /// Remove all the maps from the cache.
+    static void Clear();
+  };
+
+} // namespace detail
+} // namespace client
+} // namespace carla
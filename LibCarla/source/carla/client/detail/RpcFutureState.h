@@ -0,0 +1,86 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Exception.h"
+#include "carla/Time.h"
+#include "carla/client/Future.h"
+#include "carla/client/TimeoutException.h"
+#include "carla/rpc/Response.h"
+
+#include <rpc/msgpack.hpp>
+
+#include <future>
+#include <stdexcept>
+#include <string>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  template <typename T>
+  inline T GetResponseValue(carla::rpc::Response<T> &response) {
+    return response.Get();
+  }
+
+  inline bool GetResponseValue(carla::rpc::Response<void> &) {
+    return true;
+  }
+
+  /// Type returned by GetResponseValue for a response of type @a T.
+  template <typename T>
+  using response_value_t = decltype(GetResponseValue(std::declval<carla::rpc::Response<T> &>()));
+
+  /// State of the future returned by an asynchronous call, converts the
+  /// response once received. An error response is thrown by Get.
+  template <typename T>
+  class RpcFutureState final : public CachedFutureState<response_value_t<T>> {
+  public:
+
+    using value_type = response_value_t<T>;
+
+    RpcFutureState(
+        std::future<clmdep_msgpack::object_handle> future,
+        const std::string &endpoint,
+        time_duration timeout)
+      : _future(future.share()),
+        _endpoint(endpoint),
+        _timeout(timeout) {}
+
+    bool WaitFor(time_duration timeout) override {
+      return _future.wait_for(timeout.to_chrono()) == std::future_status::ready;
+    }
+
+    value_type Get() override {
+      // Time-outs are not cached, the response may still arrive.
+      if (!WaitFor(_timeout)) {
+        throw_exception(TimeoutException(_endpoint, _timeout));
+      }
+      return CachedFutureState<value_type>::Get();
+    }
+
+  private:
+
+    value_type Compute() override {
+      using R = typename carla::rpc::Response<T>;
+      auto response = _future.get().get().template as<R>();
+      if (response.HasError()) {
+        throw_exception(std::runtime_error(response.GetError().What()));
+      }
+      return GetResponseValue(response);
+    }
+
+    const std::shared_future<clmdep_msgpack::object_handle> _future;
+
+    const std::string _endpoint;
+
+    const time_duration _timeout;
+  };
+
+} // namespace detail
+} // namespace client
+} // namespace carla
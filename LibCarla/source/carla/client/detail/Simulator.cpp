@@ -14,8 +14,10 @@
 #include "carla/client/Sensor.h"
 #include "carla/client/TimeoutException.h"
 #include "carla/client/detail/ActorFactory.h"
+#include "carla/client/detail/LaneInvasionService.h"
 #include "carla/sensor/Deserializer.h"
 
+#include <algorithm>
 #include <exception>
 
 using namespace std::string_literals;
@@ -28,6 +30,48 @@ namespace detail {
   // -- Static local methods ---------------------------------------------------
   // ===========================================================================
 
+  /// Time Step waits for the data of a sensor after the tick of a frame
+  /// before returning the frame without it [milliseconds].
+  static constexpr size_t SENSOR_DATA_GRACE_PERIOD_MS = 500u;
+
+  /// State of the future returned by AsyncSpawnActor. If the future is
+  /// dropped before reading its value, the actor is made anyway once the
+  /// response arrives, so it is registered and then destroyed, or kept,
+  /// according to its garbage collection policy as if SpawnActor returned it.
+  class SpawnActorFutureState final : public CachedFutureState<SharedPtr<Actor>> {
+  public:
+
+    SpawnActorFutureState(
+        Future<rpc::Actor> response,
+        std::function<SharedPtr<Actor>(const rpc::Actor &)> make_actor)
+      : _response(std::move(response)),
+        _make_actor(std::move(make_actor)) {}
+
+    ~SpawnActorFutureState() {
+      if (!IsComputed()) {
+        try {
+          Get();
+        } catch (const std::exception &e) {
+          log_error("dropped actor spawn failed:", e.what());
+        }
+      }
+    }
+
+    bool WaitFor(time_duration timeout) override {
+      return _response.WaitFor(timeout);
+    }
+
+  private:
+
+    SharedPtr<Actor> Compute() override {
+      return _make_actor(_response.Get());
+    }
+
+    const Future<rpc::Actor> _response;
+
+    const std::function<SharedPtr<Actor>(const rpc::Actor &)> _make_actor;
+  };
+
   static void ValidateVersions(Client &client) {
     const auto vc = client.GetClientVersion();
     const auto vs = client.GetServerVersion();
@@ -89,7 +133,46 @@ namespace detail {
   }
 
   SharedPtr<Map> Simulator::GetCurrentMap() {
-    return MakeShared<Map>(_client.GetMapInfo());
+    const auto episode_id = GetCurrentEpisodeId();
+    {
+      std::lock_guard<std::mutex> lock(_map_mutex);
+      if ((_map != nullptr) && (_map_episode_id == episode_id)) {
+        return _map;
+      }
+    }
+    // Requested and built without the lock, other callers do not wait for
+    // the round trip and the parsing. If several callers race, the first map
+    // built is kept.
+    auto map = MakeShared<Map>(_client.GetMapInfo());
+    std::lock_guard<std::mutex> lock(_map_mutex);
+    if ((_map != nullptr) && (_map_episode_id == episode_id)) {
+      return _map;
+    }
+    if (episode_id == GetCurrentEpisodeId()) {
+      _map = map;
+      _map_episode_id = episode_id;
+    }
+    return map;
+  }
+
+  std::shared_ptr<LaneInvasionService> Simulator::GetLaneInvasionService() {
+    auto map = GetCurrentMap();
+    std::lock_guard<std::mutex> lock(_map_mutex);
+    if ((_lane_invasion_service == nullptr) || (_lane_invasion_service->GetMap() != map)) {
+      // The tick callbacks are cleared with every new episode, so is the
+      // service along with its map.
+      _lane_invasion_service = std::make_shared<LaneInvasionService>(std::move(map));
+      std::weak_ptr<LaneInvasionService> weak_service = _lane_invasion_service;
+      std::weak_ptr<Episode> weak_episode = _episode;
+      _episode->RegisterOnTickEvent([weak_service, weak_episode](const auto &timestamp) {
+        auto service = weak_service.lock();
+        auto episode = weak_episode.lock();
+        if ((service != nullptr) && (episode != nullptr)) {
+          service->Tick(timestamp, *episode->GetState());
+        }
+      });
+    }
+    return _lane_invasion_service;
   }
 
   // ===========================================================================
@@ -105,6 +188,58 @@ namespace detail {
     return *result;
   }
 
+  void Simulator::Step(
+      const size_t number_of_frames,
+      const std::vector<ActorId> &sensors,
+      std::function<void(StepFrame)> on_frame,
+      const size_t max_in_flight,
+      const time_duration timeout) {
+    DEBUG_ASSERT(_episode != nullptr);
+    if (max_in_flight == 0u) {
+      throw_exception(std::invalid_argument("max_in_flight must be greater than zero"));
+    }
+    std::lock_guard<std::mutex> lock(_step_mutex);
+
+    // The tick callbacks are cleared with every new episode.
+    const auto episode_id = GetCurrentEpisodeId();
+    if (_step_episode_id != episode_id) {
+      std::weak_ptr<Simulator> weak = shared_from_this();
+      _episode->RegisterOnTickEvent([weak](const auto &timestamp) {
+        auto self = weak.lock();
+        if (self != nullptr) {
+          auto pipeline = self->_step_pipeline.load();
+          if (pipeline != nullptr) {
+            pipeline->OnTick(timestamp);
+          }
+        }
+      });
+      _step_episode_id = episode_id;
+    }
+
+    auto pipeline = std::make_shared<StepPipeline>(
+        _episode->GetState()->GetFrameCount() + 1u,
+        sensors,
+        time_duration::milliseconds(std::min(timeout.milliseconds(), SENSOR_DATA_GRACE_PERIOD_MS)));
+    _step_pipeline = pipeline;
+
+    size_t received = 0u;
+    try {
+      received = pipeline->Run(
+          number_of_frames,
+          max_in_flight,
+          timeout,
+          [this]() { _client.SendTickCue(); },
+          on_frame);
+    } catch (...) {
+      _step_pipeline = nullptr;
+      throw;
+    }
+    _step_pipeline = nullptr;
+    if (received < number_of_frames) {
+      throw_exception(TimeoutException(_client.GetEndpoint(), timeout));
+    }
+  }
+
   // ===========================================================================
   // -- Access to global objects in the episode --------------------------------
   // ===========================================================================
@@ -150,11 +285,47 @@ namespace detail {
           blueprint.MakeActorDescription(),
           transform);
     }
+    auto parent_ptr = parent != nullptr ? parent->shared_from_this() : SharedPtr<Actor>();
+    return MakeSpawnedActor(actor, std::move(parent_ptr), gc);
+  }
+
+  Future<SharedPtr<Actor>> Simulator::AsyncSpawnActor(
+      const ActorBlueprint &blueprint,
+      const geom::Transform &transform,
+      Actor *parent,
+      GarbageCollectionPolicy gc) {
+    auto parent_ptr = parent != nullptr ? parent->shared_from_this() : SharedPtr<Actor>();
+    Future<rpc::Actor> future;
+    if (blueprint.GetId() == "sensor.other.lane_detector") { /// @todo
+      rpc::Actor actor;
+      actor.description = blueprint.MakeActorDescription();
+      future = Future<rpc::Actor>::MakeReady(std::move(actor));
+    } else if (parent != nullptr) {
+      future = _client.AsyncSpawnActorWithParent(
+          blueprint.MakeActorDescription(),
+          transform,
+          parent->GetId());
+    } else {
+      future = _client.AsyncSpawnActor(
+          blueprint.MakeActorDescription(),
+          transform);
+    }
+    auto self = shared_from_this();
+    return Future<SharedPtr<Actor>>{std::make_shared<SpawnActorFutureState>(
+        std::move(future),
+        [self, parent_ptr, gc](const rpc::Actor &actor) {
+          return self->MakeSpawnedActor(actor, parent_ptr, gc);
+        })};
+  }
+
+  SharedPtr<Actor> Simulator::MakeSpawnedActor(
+      const rpc::Actor &actor,
+      SharedPtr<Actor> parent,
+      GarbageCollectionPolicy gc) {
     DEBUG_ASSERT(_episode != nullptr);
     _episode->RegisterActor(actor);
     const auto gca = (gc == GarbageCollectionPolicy::Inherit ? _gc_policy : gc);
-    auto parent_ptr = parent != nullptr ? parent->shared_from_this() : SharedPtr<Actor>();
-    auto result = ActorFactory::MakeActor(GetCurrentEpisode(), actor, parent_ptr, gca);
+    auto result = ActorFactory::MakeActor(GetCurrentEpisode(), actor, std::move(parent), gca);
     log_debug(
         result->GetDisplayId(),
         "created",
@@ -188,9 +359,19 @@ namespace detail {
     DEBUG_ASSERT(_episode != nullptr);
     _client.SubscribeToStream(
         sensor.GetActorDescription().GetStreamToken(),
-        [cb=std::move(callback), ep=WeakEpisodeProxy{shared_from_this()}](auto buffer) {
+        [cb=std::move(callback),
+         ep=WeakEpisodeProxy{shared_from_this()},
+         weak=std::weak_ptr<Simulator>{shared_from_this()},
+         id=sensor.GetId()](auto buffer) {
           auto data = sensor::Deserializer::Deserialize(std::move(buffer));
           data->_episode = ep.TryLock();
+          auto self = weak.lock();
+          if (self != nullptr) {
+            auto pipeline = self->_step_pipeline.load();
+            if (pipeline != nullptr) {
+              pipeline->OnSensorData(id, data);
+            }
+          }
           cb(std::move(data));
         });
   }
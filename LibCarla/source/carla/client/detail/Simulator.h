@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "carla/AtomicSharedPtr.h"
 #include "carla/Debug.h"
 #include "carla/Memory.h"
 #include "carla/NonCopyable.h"
@@ -17,10 +18,13 @@
 #include "carla/client/detail/Client.h"
 #include "carla/client/detail/Episode.h"
 #include "carla/client/detail/EpisodeProxy.h"
+#include "carla/client/detail/StepPipeline.h"
 #include "carla/profiler/LifetimeProfiled.h"
 #include "carla/rpc/TrafficLightState.h"
 
+#include <functional>
 #include <memory>
+#include <mutex>
 
 namespace carla {
 namespace client {
@@ -32,6 +36,8 @@ namespace client {
 
 namespace detail {
 
+  class LaneInvasionService;
+
   /// Connects and controls a CARLA Simulator.
   ///
   /// @todo Make sure this class is really thread-safe.
@@ -84,8 +90,15 @@ namespace detail {
     // =========================================================================
     /// @{
 
+    /// Return the map of the current episode. The map is built once per
+    /// episode and shared by every caller.
     SharedPtr<Map> GetCurrentMap();
 
+    /// Return the service computing the lane invasions of the vehicles in the
+    /// current episode, created on first use and shared by every lane
+    /// invasion sensor.
+    std::shared_ptr<LaneInvasionService> GetLaneInvasionService();
+
     std::vector<std::string> GetAvailableMaps() {
       return _client.GetAvailableMaps();
     }
@@ -110,6 +123,10 @@ namespace detail {
       _client.SetTimeout(timeout);
     }
 
+    void SetDeserializationWorkerThreads(size_t worker_threads) {
+      _client.SetDeserializationWorkerThreads(worker_threads);
+    }
+
     std::string GetClientVersion() {
       return _client.GetClientVersion();
     }
@@ -126,15 +143,45 @@ namespace detail {
 
     Timestamp WaitForTick(time_duration timeout);
 
-    void RegisterOnTickEvent(std::function<void(Timestamp)> callback) {
+    size_t RegisterOnTickEvent(
+        std::function<void(Timestamp)> callback,
+        bool coalesce = false) {
+      DEBUG_ASSERT(_episode != nullptr);
+      return _episode->RegisterOnTickEvent(std::move(callback), coalesce);
+    }
+
+    size_t RegisterOnActorsChangedEvent(std::function<void(ActorIdChanges)> callback) {
+      DEBUG_ASSERT(_episode != nullptr);
+      return _episode->RegisterOnActorsChangedEvent(std::move(callback));
+    }
+
+    void SetCallbackWorkerThreads(size_t worker_threads) {
+      DEBUG_ASSERT(_episode != nullptr);
+      _episode->SetCallbackWorkerThreads(worker_threads);
+    }
+
+    std::vector<CallbackMetrics> GetCallbackMetrics() const {
       DEBUG_ASSERT(_episode != nullptr);
-      _episode->RegisterOnTickEvent(std::move(callback));
+      return _episode->GetCallbackMetrics();
     }
 
     void Tick() {
       _client.SendTickCue();
     }
 
+    /// Simulate @a number_of_frames frames in synchronous mode, keeping up to
+    /// @a max_in_flight tick cues sent ahead of the ticks received. Each
+    /// frame is passed to @a on_frame, in order, together with the data
+    /// generated on that frame by the listening @a sensors; null for a sensor
+    /// that did not deliver data for the frame. The simulator never runs more
+    /// than @a max_in_flight frames ahead of the ticks received.
+    void Step(
+        size_t number_of_frames,
+        const std::vector<ActorId> &sensors,
+        std::function<void(StepFrame)> on_frame,
+        size_t max_in_flight,
+        time_duration timeout);
+
     /// @}
     // =========================================================================
     /// @name Access to global objects in the episode
@@ -165,6 +212,10 @@ namespace detail {
       return _client.GetVehiclePhysicsControl(vehicle.GetId());
     }
 
+    Future<rpc::VehiclePhysicsControl> AsyncGetVehiclePhysicsControl(const Vehicle &vehicle) {
+      return _client.AsyncGetVehiclePhysicsControl(vehicle.GetId());
+    }
+
     /// @}
     // =========================================================================
     /// @name General operations with actors
@@ -176,6 +227,21 @@ namespace detail {
       return _episode->GetActors();
     }
 
+    std::vector<rpc::Actor> GetActorsById(const std::vector<ActorId> &actor_ids) const {
+      DEBUG_ASSERT(_episode != nullptr);
+      return _episode->GetActorsById(actor_ids);
+    }
+
+    Future<std::vector<rpc::Actor>> AsyncGetActorsById(const std::vector<ActorId> &actor_ids) const {
+      DEBUG_ASSERT(_episode != nullptr);
+      return _episode->AsyncGetActorsById(actor_ids);
+    }
+
+    ActorIdChanges GetActorChanges(size_t since_frame) const {
+      DEBUG_ASSERT(_episode != nullptr);
+      return _episode->GetActorChanges(since_frame);
+    }
+
     /// If @a gc is GarbageCollectionPolicy::Enabled, the shared pointer
     /// returned is provided with a custom deleter that calls Destroy() on the
     /// actor. If @gc is GarbageCollectionPolicy::Enabled, the default garbage
@@ -186,8 +252,23 @@ namespace detail {
         Actor *parent = nullptr,
         GarbageCollectionPolicy gc = GarbageCollectionPolicy::Inherit);
 
+    /// Same as SpawnActor but return as soon as the request is sent, the
+    /// actor (or the error spawning it) is retrieved from the future.
+    Future<SharedPtr<Actor>> AsyncSpawnActor(
+        const ActorBlueprint &blueprint,
+        const geom::Transform &transform,
+        Actor *parent = nullptr,
+        GarbageCollectionPolicy gc = GarbageCollectionPolicy::Inherit);
+
     bool DestroyActor(Actor &actor);
 
+    /// Return the latest episode state received, all the values read from the
+    /// same pointer correspond to the same frame.
+    std::shared_ptr<const EpisodeState> GetEpisodeState() const {
+      DEBUG_ASSERT(_episode != nullptr);
+      return _episode->GetState();
+    }
+
     auto GetActorDynamicState(const Actor &actor) const {
       DEBUG_ASSERT(_episode != nullptr);
       return _episode->GetState()->GetActorState(actor.GetId());
@@ -330,6 +411,10 @@ namespace detail {
       return _client.GetGroupTrafficLights(trafficLight.GetId());
     }
 
+    Future<std::vector<ActorId>> AsyncGetGroupTrafficLights(TrafficLight &trafficLight) {
+      return _client.AsyncGetGroupTrafficLights(trafficLight.GetId());
+    }
+
     /// @}
     // =========================================================================
     /// @name Debug
@@ -350,15 +435,44 @@ namespace detail {
       _client.ApplyBatch(std::move(commands), do_tick_cue);
     }
 
+    std::vector<rpc::CommandResponse> ApplyBatchSync(
+        std::vector<rpc::Command> commands,
+        bool do_tick_cue) {
+      return _client.ApplyBatchSync(std::move(commands), do_tick_cue);
+    }
+
+    uint64_t ApplyBatchAndTick(std::vector<rpc::Command> commands) {
+      return _client.ApplyBatchAndTick(std::move(commands));
+    }
+
     /// @}
 
   private:
 
+    SharedPtr<Actor> MakeSpawnedActor(
+        const rpc::Actor &actor,
+        SharedPtr<Actor> parent,
+        GarbageCollectionPolicy gc);
+
     Client _client;
 
     std::shared_ptr<Episode> _episode;
 
     GarbageCollectionPolicy _gc_policy;
+
+    std::mutex _map_mutex;
+
+    uint64_t _map_episode_id = 0u;
+
+    SharedPtr<Map> _map;
+
+    std::shared_ptr<LaneInvasionService> _lane_invasion_service;
+
+    std::mutex _step_mutex;
+
+    uint64_t _step_episode_id = 0u;
+
+    AtomicSharedPtr<StepPipeline> _step_pipeline;
   };
 
 } // namespace detail
@@ -0,0 +1,157 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/detail/StepPipeline.h"
+
+#include "carla/sensor/SensorData.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  StepPipeline::StepPipeline(
+      const size_t first_frame,
+      std::vector<ActorId> sensors,
+      const time_duration grace_period)
+    : _sensors(std::move(sensors)),
+      _grace_period(grace_period.to_chrono()),
+      _next_frame(first_frame) {}
+
+  void StepPipeline::OnTick(const Timestamp &timestamp) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (timestamp.frame_count < _next_frame) {
+        return;
+      }
+      auto &frame = GetPendingFrame(timestamp.frame_count);
+      if (!frame.timestamp.has_value()) {
+        frame.tick_time = clock::now();
+        ++_number_of_ticks;
+      }
+      frame.timestamp = timestamp;
+    }
+    _condition.notify_one();
+  }
+
+  void StepPipeline::OnSensorData(const ActorId sensor, SharedPtr<sensor::SensorData> data) {
+    DEBUG_ASSERT(data != nullptr);
+    const auto it = std::find(_sensors.begin(), _sensors.end(), sensor);
+    if (it == _sensors.end()) {
+      return;
+    }
+    const auto index = static_cast<size_t>(std::distance(_sensors.begin(), it));
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      const auto frame_number = data->GetFrameNumber();
+      if (frame_number < _next_frame) {
+        return;
+      }
+      auto &frame = GetPendingFrame(frame_number);
+      if (frame.sensor_data[index] == nullptr) {
+        ++frame.received;
+      }
+      frame.sensor_data[index] = std::move(data);
+    }
+    _condition.notify_one();
+  }
+
+  size_t StepPipeline::GetNumberOfTicks() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _number_of_ticks;
+  }
+
+  boost::optional<StepFrame> StepPipeline::WaitForFrame(const time_duration timeout) {
+    return WaitForFrame(std::numeric_limits<size_t>::max(), timeout);
+  }
+
+  boost::optional<StepFrame> StepPipeline::WaitForFrame(
+      const size_t number_of_ticks,
+      const time_duration timeout) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    const auto deadline = clock::now() + timeout.to_chrono();
+    for (;;) {
+      const auto now = clock::now();
+      auto wake_up = deadline;
+      auto it = FindNextFrame(now, wake_up);
+      if (it != _frames.end()) {
+        // Sensor data of a frame whose tick never arrived cannot be returned.
+        _frames.erase(_frames.begin(), it);
+        StepFrame result;
+        result.timestamp = *it->second.timestamp;
+        result.sensor_data = std::move(it->second.sensor_data);
+        _next_frame = it->first + 1u;
+        _frames.erase(it);
+        return result;
+      }
+      if ((_number_of_ticks > number_of_ticks) || (now >= deadline)) {
+        return {};
+      }
+      _condition.wait_until(lock, wake_up);
+    }
+  }
+
+  size_t StepPipeline::Run(
+      const size_t number_of_frames,
+      const size_t max_in_flight,
+      const time_duration timeout,
+      const std::function<void()> &send_tick_cue,
+      const std::function<void(StepFrame)> &on_frame) {
+    DEBUG_ASSERT(max_in_flight > 0u);
+    size_t sent = 0u;
+    size_t received = 0u;
+    while (received < number_of_frames) {
+      const auto ticks = GetNumberOfTicks();
+      for (; (sent < number_of_frames) && (sent < ticks + max_in_flight); ++sent) {
+        send_tick_cue();
+      }
+      auto frame = WaitForFrame(ticks, timeout);
+      if (frame.has_value()) {
+        ++received;
+        on_frame(std::move(*frame));
+      } else if (GetNumberOfTicks() == ticks) {
+        break;
+      }
+    }
+    return received;
+  }
+
+  StepPipeline::PendingFrame &StepPipeline::GetPendingFrame(const size_t frame) {
+    auto result = _frames.emplace(frame, PendingFrame{});
+    if (result.second) {
+      result.first->second.sensor_data.resize(_sensors.size());
+    }
+    return result.first->second;
+  }
+
+  StepPipeline::iterator StepPipeline::FindNextFrame(
+      const clock::time_point now,
+      clock::time_point &wake_up) {
+    const auto next = std::find_if(_frames.begin(), _frames.end(), [](const auto &pair) {
+      return pair.second.timestamp.has_value();
+    });
+    if (next == _frames.end()) {
+      return next;
+    }
+    const auto due = next->second.tick_time + _grace_period;
+    const bool ready =
+        (now >= due) ||
+        std::any_of(next, _frames.end(), [this](const auto &pair) {
+          return IsComplete(pair.second);
+        });
+    if (ready) {
+      return next;
+    }
+    wake_up = std::min(wake_up, due);
+    return _frames.end();
+  }
+
+} // namespace detail
+} // namespace client
+} // namespace carla
@@ -0,0 +1,122 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+#include "carla/Time.h"
+#include "carla/client/StepFrame.h"
+#include "carla/rpc/ActorId.h"
+
+#include <boost/optional.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  /// Collects the ticks and the sensor data received while stepping the
+  /// simulation and matches them by frame number.
+  ///
+  /// Frames are returned in order once the tick and the data of every sensor
+  /// have been received. If a sensor misses a frame, the frame is returned
+  /// without its data as soon as a later frame is complete, or once
+  /// @a grace_period has passed since its tick. Frames before @a first_frame
+  /// are ignored, as well as sensor data of frames whose tick was not
+  /// received by then.
+  class StepPipeline : private NonCopyable {
+  public:
+
+    StepPipeline(size_t first_frame, std::vector<ActorId> sensors, time_duration grace_period);
+
+    void OnTick(const Timestamp &timestamp);
+
+    void OnSensorData(ActorId sensor, SharedPtr<sensor::SensorData> data);
+
+    /// Number of ticks received since the first frame.
+    size_t GetNumberOfTicks() const;
+
+    /// Block until the next frame is ready.
+    ///
+    /// @return empty optional if the timeout is met.
+    boost::optional<StepFrame> WaitForFrame(time_duration timeout);
+
+    /// Block until the next frame is ready, or until more than
+    /// @a number_of_ticks ticks have been received.
+    ///
+    /// @return empty optional if no frame is ready yet.
+    boost::optional<StepFrame> WaitForFrame(size_t number_of_ticks, time_duration timeout);
+
+    /// Step @a number_of_frames frames, calling @a send_tick_cue for each of
+    /// them while less than @a max_in_flight of the cues sent have not been
+    /// ticked yet. Each frame is passed to @a on_frame in order.
+    ///
+    /// The cues only wait for the ticks, a frame waiting for the data of a
+    /// sensor does not hold back the next ones.
+    ///
+    /// @return the number of frames passed to @a on_frame, less than
+    /// @a number_of_frames only if no tick nor frame was received for
+    /// @a timeout.
+    size_t Run(
+        size_t number_of_frames,
+        size_t max_in_flight,
+        time_duration timeout,
+        const std::function<void()> &send_tick_cue,
+        const std::function<void(StepFrame)> &on_frame);
+
+  private:
+
+    using clock = std::chrono::steady_clock;
+
+    struct PendingFrame {
+      boost::optional<Timestamp> timestamp;
+
+      /// When the tick was received.
+      clock::time_point tick_time;
+
+      std::vector<SharedPtr<sensor::SensorData>> sensor_data;
+
+      size_t received = 0u;
+    };
+
+    using iterator = std::map<size_t, PendingFrame>::iterator;
+
+    PendingFrame &GetPendingFrame(size_t frame);
+
+    bool IsComplete(const PendingFrame &frame) const {
+      return frame.timestamp.has_value() && (frame.received == _sensors.size());
+    }
+
+    /// Find the next frame that can be returned at @a now, or end if none;
+    /// in that case @a wake_up is moved earlier to when the next frame is
+    /// due, if any. Must be called with the mutex locked.
+    iterator FindNextFrame(clock::time_point now, clock::time_point &wake_up);
+
+    const std::vector<ActorId> _sensors;
+
+    const clock::duration _grace_period;
+
+    mutable std::mutex _mutex;
+
+    std::condition_variable _condition;
+
+    size_t _next_frame;
+
+    size_t _number_of_ticks = 0u;
+
+    std::map<size_t, PendingFrame> _frames;
+  };
+
+} // namespace detail
+} // namespace client
+} // namespace carla
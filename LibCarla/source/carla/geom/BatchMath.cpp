@@ -0,0 +1,418 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/geom/BatchMath.h"
+
+#include "carla/Debug.h"
+#include "carla/geom/Math.h"
+#include "carla/geom/Simd.h"
+
+#include <array>
+#include <cmath>
+
+namespace carla {
+namespace geom {
+
+  /// Affine map M * (p + a) + b, the translation @a a is applied before the
+  /// rotation to keep the precision of points far from the origin.
+  struct AffineMap {
+
+    /// Map of Transform::TransformPoint.
+    static AffineMap Forward(const Transform &transform) {
+      return {
+          Math::GetRotationMatrix(transform.rotation),
+          {0.0, 0.0, 0.0},
+          {transform.location.x, transform.location.y, transform.location.z}};
+    }
+
+    /// Map of Transform::InverseTransformPoint.
+    static AffineMap Inverse(const Transform &transform) {
+      const auto m = Math::GetRotationMatrix(transform.rotation);
+      return {
+          {m[0u], m[3u], m[6u], m[1u], m[4u], m[7u], m[2u], m[5u], m[8u]},
+          {-transform.location.x, -transform.location.y, -transform.location.z},
+          {0.0, 0.0, 0.0}};
+    }
+
+    Vector3D operator()(float x, float y, float z) const {
+      const double px = x + a[0u];
+      const double py = y + a[1u];
+      const double pz = z + a[2u];
+      return {
+          static_cast<float>(m[0u] * px + m[1u] * py + m[2u] * pz + b[0u]),
+          static_cast<float>(m[3u] * px + m[4u] * py + m[5u] * pz + b[1u]),
+          static_cast<float>(m[6u] * px + m[7u] * py + m[8u] * pz + b[2u])};
+    }
+
+    std::array<double, 9u> m;
+
+    std::array<double, 3u> a;
+
+    std::array<double, 3u> b;
+  };
+
+#ifdef LIBCARLA_WITH_AVX2
+
+  // ===========================================================================
+  // -- AVX2 kernels -----------------------------------------------------------
+  // ===========================================================================
+
+  // The point kernels process 8 floats at once, the transform kernels 4
+  // doubles at once. Each kernel processes the first count - count % width
+  // elements and returns the number of elements processed.
+
+  static constexpr size_t AVX2_FLOAT_WIDTH = 8u;
+
+  static constexpr size_t AVX2_DOUBLE_WIDTH = 4u;
+
+  /// AffineMap broadcast to the lanes of a float register.
+  struct AffineMapAVX2 {
+
+    LIBCARLA_TARGET_AVX2 explicit AffineMapAVX2(const AffineMap &map) {
+      for (auto i = 0u; i < 9u; ++i) {
+        m[i] = _mm256_set1_ps(static_cast<float>(map.m[i]));
+      }
+      for (auto i = 0u; i < 3u; ++i) {
+        a[i] = _mm256_set1_ps(static_cast<float>(map.a[i]));
+        b[i] = _mm256_set1_ps(static_cast<float>(map.b[i]));
+      }
+    }
+
+    LIBCARLA_TARGET_AVX2 void Apply(
+        __m256 x, __m256 y, __m256 z,
+        __m256 &out_x, __m256 &out_y, __m256 &out_z) const {
+      x = _mm256_add_ps(x, a[0u]);
+      y = _mm256_add_ps(y, a[1u]);
+      z = _mm256_add_ps(z, a[2u]);
+      out_x = _mm256_fmadd_ps(m[0u], x, _mm256_fmadd_ps(m[1u], y, _mm256_fmadd_ps(m[2u], z, b[0u])));
+      out_y = _mm256_fmadd_ps(m[3u], x, _mm256_fmadd_ps(m[4u], y, _mm256_fmadd_ps(m[5u], z, b[1u])));
+      out_z = _mm256_fmadd_ps(m[6u], x, _mm256_fmadd_ps(m[7u], y, _mm256_fmadd_ps(m[8u], z, b[2u])));
+    }
+
+    __m256 m[9u];
+
+    __m256 a[3u];
+
+    __m256 b[3u];
+  };
+
+  LIBCARLA_TARGET_AVX2 static size_t ApplyAVX2(
+      const AffineMap &map,
+      const PointArrays &points,
+      PointArrays &out) {
+    const AffineMapAVX2 simd_map(map);
+    const auto count = points.size();
+    size_t i = 0u;
+    for (; i + AVX2_FLOAT_WIDTH <= count; i += AVX2_FLOAT_WIDTH) {
+      __m256 x, y, z;
+      simd_map.Apply(
+          _mm256_loadu_ps(points.x.data() + i),
+          _mm256_loadu_ps(points.y.data() + i),
+          _mm256_loadu_ps(points.z.data() + i),
+          x, y, z);
+      _mm256_storeu_ps(out.x.data() + i, x);
+      _mm256_storeu_ps(out.y.data() + i, y);
+      _mm256_storeu_ps(out.z.data() + i, z);
+    }
+    return i;
+  }
+
+  LIBCARLA_TARGET_AVX2 static size_t ContainsAVX2(
+      const AffineMap &map,
+      const Vector3D &extent,
+      const PointArrays &points,
+      std::vector<uint8_t> &out) {
+    const AffineMapAVX2 simd_map(map);
+    const auto sign_mask = _mm256_set1_ps(-0.0f);
+    const auto ex = _mm256_set1_ps(extent.x);
+    const auto ey = _mm256_set1_ps(extent.y);
+    const auto ez = _mm256_set1_ps(extent.z);
+    const auto count = points.size();
+    size_t i = 0u;
+    for (; i + AVX2_FLOAT_WIDTH <= count; i += AVX2_FLOAT_WIDTH) {
+      __m256 x, y, z;
+      simd_map.Apply(
+          _mm256_loadu_ps(points.x.data() + i),
+          _mm256_loadu_ps(points.y.data() + i),
+          _mm256_loadu_ps(points.z.data() + i),
+          x, y, z);
+      const auto inside = _mm256_and_ps(
+          _mm256_cmp_ps(_mm256_andnot_ps(sign_mask, x), ex, _CMP_LE_OQ),
+          _mm256_and_ps(
+              _mm256_cmp_ps(_mm256_andnot_ps(sign_mask, y), ey, _CMP_LE_OQ),
+              _mm256_cmp_ps(_mm256_andnot_ps(sign_mask, z), ez, _CMP_LE_OQ)));
+      const auto bits = _mm256_movemask_ps(inside);
+      for (auto j = 0u; j < AVX2_FLOAT_WIDTH; ++j) {
+        out[i + j] = static_cast<uint8_t>((bits >> j) & 1);
+      }
+    }
+    return i;
+  }
+
+  /// Rotation matrices of AVX2_DOUBLE_WIDTH rotations, one per lane, as
+  /// Math::GetRotationMatrix computes them.
+  LIBCARLA_TARGET_AVX2 static void GetRotationMatricesAVX2(
+      __m256d pitch,
+      __m256d yaw,
+      __m256d roll,
+      __m256d (&m)[9u]) {
+    __m256d sp, cp, sy, cy, sr, cr;
+    simd::SinCosDegrees(pitch, sp, cp);
+    simd::SinCosDegrees(yaw, sy, cy);
+    simd::SinCosDegrees(roll, sr, cr);
+    const auto cy_sp = _mm256_mul_pd(cy, sp);
+    const auto sy_sp = _mm256_mul_pd(sy, sp);
+    m[0u] = _mm256_mul_pd(cp, cy);
+    m[1u] = _mm256_fmsub_pd(cy_sp, sr, _mm256_mul_pd(sy, cr));
+    m[2u] = _mm256_fnmsub_pd(cy_sp, cr, _mm256_mul_pd(sy, sr));
+    m[3u] = _mm256_mul_pd(cp, sy);
+    m[4u] = _mm256_fmadd_pd(sy_sp, sr, _mm256_mul_pd(cy, cr));
+    m[5u] = _mm256_fnmadd_pd(sy_sp, cr, _mm256_mul_pd(cy, sr));
+    m[6u] = sp;
+    m[7u] = _mm256_xor_pd(_mm256_mul_pd(cp, sr), _mm256_set1_pd(-0.0));
+    m[8u] = _mm256_mul_pd(cp, cr);
+  }
+
+  /// Member @a member of the rotations of AVX2_DOUBLE_WIDTH transforms.
+  LIBCARLA_TARGET_AVX2 static __m256d GatherRotation(
+      const Transform *transforms,
+      float Rotation::*member) {
+    return _mm256_set_pd(
+        transforms[3u].rotation.*member,
+        transforms[2u].rotation.*member,
+        transforms[1u].rotation.*member,
+        transforms[0u].rotation.*member);
+  }
+
+  /// Member @a member of the locations of AVX2_DOUBLE_WIDTH transforms.
+  LIBCARLA_TARGET_AVX2 static __m256d GatherLocation(
+      const Transform *transforms,
+      float Vector3D::*member) {
+    return _mm256_set_pd(
+        transforms[3u].location.*member,
+        transforms[2u].location.*member,
+        transforms[1u].location.*member,
+        transforms[0u].location.*member);
+  }
+
+  /// Rotation matrices of AVX2_DOUBLE_WIDTH transforms.
+  LIBCARLA_TARGET_AVX2 static void GatherRotationMatrices(
+      const Transform *transforms,
+      __m256d (&m)[9u]) {
+    GetRotationMatricesAVX2(
+        GatherRotation(transforms, &Rotation::pitch),
+        GatherRotation(transforms, &Rotation::yaw),
+        GatherRotation(transforms, &Rotation::roll),
+        m);
+  }
+
+  LIBCARLA_TARGET_AVX2 static size_t ComposeTransformsAVX2(
+      const std::vector<Transform> &parents,
+      const std::vector<Transform> &children,
+      std::vector<Transform> &out) {
+    const auto to_degrees = _mm256_set1_pd(180.0 / Math::pi());
+    alignas(32) double result[6u][AVX2_DOUBLE_WIDTH];
+    const auto count = parents.size();
+    size_t i = 0u;
+    for (; i + AVX2_DOUBLE_WIDTH <= count; i += AVX2_DOUBLE_WIDTH) {
+      const auto *parent = parents.data() + i;
+      const auto *child = children.data() + i;
+      __m256d p[9u], c[9u];
+      GatherRotationMatrices(parent, p);
+      GatherRotationMatrices(child, c);
+      // Rotation, the product of both matrices.
+      __m256d m[9u];
+      for (auto row = 0u; row < 3u; ++row) {
+        for (auto col = 0u; col < 3u; ++col) {
+          m[3u * row + col] = _mm256_fmadd_pd(
+              p[3u * row],
+              c[col],
+              _mm256_fmadd_pd(
+                  p[3u * row + 1u],
+                  c[3u + col],
+                  _mm256_mul_pd(p[3u * row + 2u], c[6u + col])));
+        }
+      }
+      // Location, the location of the child transformed by the parent.
+      const auto x = GatherLocation(child, &Vector3D::x);
+      const auto y = GatherLocation(child, &Vector3D::y);
+      const auto z = GatherLocation(child, &Vector3D::z);
+      const __m256d t[3u] = {
+          GatherLocation(parent, &Vector3D::x),
+          GatherLocation(parent, &Vector3D::y),
+          GatherLocation(parent, &Vector3D::z)};
+      for (auto row = 0u; row < 3u; ++row) {
+        _mm256_store_pd(result[row], _mm256_fmadd_pd(
+            p[3u * row],
+            x,
+            _mm256_fmadd_pd(p[3u * row + 1u], y, _mm256_fmadd_pd(p[3u * row + 2u], z, t[row]))));
+      }
+      _mm256_store_pd(result[3u], _mm256_mul_pd(simd::Asin(m[6u]), to_degrees));
+      _mm256_store_pd(result[4u], _mm256_mul_pd(simd::Atan2(m[3u], m[0u]), to_degrees));
+      _mm256_store_pd(result[5u], _mm256_mul_pd(
+          simd::Atan2(_mm256_xor_pd(m[7u], _mm256_set1_pd(-0.0)), m[8u]),
+          to_degrees));
+      for (auto j = 0u; j < AVX2_DOUBLE_WIDTH; ++j) {
+        auto &transform = out[i + j];
+        transform.location.x = static_cast<float>(result[0u][j]);
+        transform.location.y = static_cast<float>(result[1u][j]);
+        transform.location.z = static_cast<float>(result[2u][j]);
+        transform.rotation.pitch = static_cast<float>(result[3u][j]);
+        transform.rotation.yaw = static_cast<float>(result[4u][j]);
+        transform.rotation.roll = static_cast<float>(result[5u][j]);
+      }
+    }
+    return i;
+  }
+
+  LIBCARLA_TARGET_AVX2 static size_t GetWorldVerticesAVX2(
+      const std::vector<BoundingBox> &boxes,
+      const std::vector<Transform> &bbox_to_world,
+      PointArrays &out) {
+    // Sign of the extent of each vertex, see BoundingBox::GetLocalVertices.
+    const auto sign_x = _mm256_set_ps(1.0f, 1.0f, 1.0f, 1.0f, -1.0f, -1.0f, -1.0f, -1.0f);
+    const auto sign_y = _mm256_set_ps(1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, -1.0f, -1.0f);
+    const auto sign_z = _mm256_set_ps(1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f);
+    alignas(32) double matrices[9u][AVX2_DOUBLE_WIDTH];
+    const auto count = boxes.size();
+    size_t i = 0u;
+    for (; i + AVX2_DOUBLE_WIDTH <= count; i += AVX2_DOUBLE_WIDTH) {
+      __m256d m[9u];
+      GatherRotationMatrices(bbox_to_world.data() + i, m);
+      for (auto k = 0u; k < 9u; ++k) {
+        _mm256_store_pd(matrices[k], m[k]);
+      }
+      for (auto j = 0u; j < AVX2_DOUBLE_WIDTH; ++j) {
+        const auto &box = boxes[i + j];
+        const auto &location = bbox_to_world[i + j].location;
+        AffineMap map;
+        for (auto k = 0u; k < map.m.size(); ++k) {
+          map.m[k] = matrices[k][j];
+        }
+        map.a = {0.0, 0.0, 0.0};
+        map.b = {location.x, location.y, location.z};
+        // The 8 vertices of the box, one per lane.
+        __m256 x, y, z;
+        AffineMapAVX2(map).Apply(
+            _mm256_fmadd_ps(sign_x, _mm256_set1_ps(box.extent.x), _mm256_set1_ps(box.location.x)),
+            _mm256_fmadd_ps(sign_y, _mm256_set1_ps(box.extent.y), _mm256_set1_ps(box.location.y)),
+            _mm256_fmadd_ps(sign_z, _mm256_set1_ps(box.extent.z), _mm256_set1_ps(box.location.z)),
+            x, y, z);
+        const auto offset = 8u * (i + j);
+        _mm256_storeu_ps(out.x.data() + offset, x);
+        _mm256_storeu_ps(out.y.data() + offset, y);
+        _mm256_storeu_ps(out.z.data() + offset, z);
+      }
+    }
+    return i;
+  }
+
+#endif // LIBCARLA_WITH_AVX2
+
+  // ===========================================================================
+  // -- BatchMath --------------------------------------------------------------
+  // ===========================================================================
+
+  static void Apply(const AffineMap &map, const PointArrays &points, PointArrays &out) {
+    const auto count = points.size();
+    out.resize(count);
+    size_t i = 0u;
+#ifdef LIBCARLA_WITH_AVX2
+    if (simd::HasAVX2()) {
+      i = ApplyAVX2(map, points, out);
+    }
+#endif // LIBCARLA_WITH_AVX2
+    for (; i < count; ++i) {
+      const auto point = map(points.x[i], points.y[i], points.z[i]);
+      out.x[i] = point.x;
+      out.y[i] = point.y;
+      out.z[i] = point.z;
+    }
+  }
+
+  void BatchMath::TransformPoints(
+      const Transform &transform,
+      const PointArrays &points,
+      PointArrays &out) {
+    Apply(AffineMap::Forward(transform), points, out);
+  }
+
+  void BatchMath::InverseTransformPoints(
+      const Transform &transform,
+      const PointArrays &points,
+      PointArrays &out) {
+    Apply(AffineMap::Inverse(transform), points, out);
+  }
+
+  void BatchMath::ComposeTransforms(
+      const std::vector<Transform> &parents,
+      const std::vector<Transform> &children,
+      std::vector<Transform> &out) {
+    DEBUG_ASSERT(parents.size() == children.size());
+    const auto count = parents.size();
+    out.resize(count);
+    size_t i = 0u;
+#ifdef LIBCARLA_WITH_AVX2
+    if (simd::HasAVX2()) {
+      i = ComposeTransformsAVX2(parents, children, out);
+    }
+#endif // LIBCARLA_WITH_AVX2
+    for (; i < count; ++i) {
+      out[i] = parents[i].Compose(children[i]);
+    }
+  }
+
+  void BatchMath::Contains(
+      const BoundingBox &box,
+      const Transform &bbox_to_world,
+      const PointArrays &points,
+      std::vector<uint8_t> &out) {
+    // Into the local space of the transform, then relative to the center of
+    // the box.
+    auto map = AffineMap::Inverse(bbox_to_world);
+    map.b = {-box.location.x, -box.location.y, -box.location.z};
+    const auto count = points.size();
+    out.resize(count);
+    size_t i = 0u;
+#ifdef LIBCARLA_WITH_AVX2
+    if (simd::HasAVX2()) {
+      i = ContainsAVX2(map, box.extent, points, out);
+    }
+#endif // LIBCARLA_WITH_AVX2
+    for (; i < count; ++i) {
+      const auto point = map(points.x[i], points.y[i], points.z[i]);
+      out[i] =
+          (std::abs(point.x) <= box.extent.x) &&
+          (std::abs(point.y) <= box.extent.y) &&
+          (std::abs(point.z) <= box.extent.z);
+    }
+  }
+
+  void BatchMath::GetWorldVertices(
+      const std::vector<BoundingBox> &boxes,
+      const std::vector<Transform> &bbox_to_world,
+      PointArrays &out) {
+    DEBUG_ASSERT(boxes.size() == bbox_to_world.size());
+    const auto count = boxes.size();
+    out.resize(8u * count);
+    size_t i = 0u;
+#ifdef LIBCARLA_WITH_AVX2
+    if (simd::HasAVX2()) {
+      i = GetWorldVerticesAVX2(boxes, bbox_to_world, out);
+    }
+#endif // LIBCARLA_WITH_AVX2
+    for (; i < count; ++i) {
+      const auto vertices = boxes[i].GetWorldVertices(bbox_to_world[i]);
+      for (auto k = 0u; k < vertices.size(); ++k) {
+        out.x[8u * i + k] = vertices[k].x;
+        out.y[8u * i + k] = vertices[k].y;
+        out.z[8u * i + k] = vertices[k].z;
+      }
+    }
+  }
+
+} // namespace geom
+} // namespace carla
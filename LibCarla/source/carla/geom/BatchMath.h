@@ -0,0 +1,64 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/geom/BoundingBox.h"
+#include "carla/geom/PointArrays.h"
+#include "carla/geom/Transform.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace carla {
+namespace geom {
+
+  /// Batch versions of the geometry operations of Transform and BoundingBox,
+  /// vectorized with AVX2 when the CPU supports it. The results match the
+  /// scalar versions up to float precision.
+  class BatchMath {
+  public:
+
+    /// Apply Transform::TransformPoint to each of @a points. @a out may be
+    /// @a points.
+    static void TransformPoints(
+        const Transform &transform,
+        const PointArrays &points,
+        PointArrays &out);
+
+    /// Apply Transform::InverseTransformPoint to each of @a points. @a out
+    /// may be @a points.
+    static void InverseTransformPoints(
+        const Transform &transform,
+        const PointArrays &points,
+        PointArrays &out);
+
+    /// Compose each of @a parents with the child of the same index, as
+    /// Transform::Compose does.
+    static void ComposeTransforms(
+        const std::vector<Transform> &parents,
+        const std::vector<Transform> &children,
+        std::vector<Transform> &out);
+
+    /// Whether each of @a points is inside @a box, as BoundingBox::Contains
+    /// does; @a out is set to 1 if it is, 0 otherwise.
+    static void Contains(
+        const BoundingBox &box,
+        const Transform &bbox_to_world,
+        const PointArrays &points,
+        std::vector<uint8_t> &out);
+
+    /// Vertices of each of @a boxes transformed by the transform of the same
+    /// index, as BoundingBox::GetWorldVertices returns them. Vertex @b k of
+    /// box @b i is stored at index 8 * i + k.
+    static void GetWorldVertices(
+        const std::vector<BoundingBox> &boxes,
+        const std::vector<Transform> &bbox_to_world,
+        PointArrays &out);
+  };
+
+} // namespace geom
+} // namespace carla
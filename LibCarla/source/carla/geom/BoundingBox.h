@@ -9,8 +9,12 @@
 #include "carla/Debug.h"
 #include "carla/MsgPack.h"
 #include "carla/geom/Location.h"
+#include "carla/geom/Transform.h"
 #include "carla/geom/Vector3D.h"
 
+#include <array>
+#include <cmath>
+
 #ifdef LIBCARLA_INCLUDED_FROM_UE4
 #  include "Carla/Util/BoundingBox.h"
 #endif // LIBCARLA_INCLUDED_FROM_UE4
@@ -33,6 +37,41 @@ namespace geom {
     Location location;
     Vector3D extent;
 
+    /// Whether @a world_point is inside the box, the box being relative to
+    /// @a bbox_to_world.
+    bool Contains(const Location &world_point, const Transform &bbox_to_world) const {
+      Vector3D point = world_point;
+      bbox_to_world.InverseTransformPoint(point);
+      point -= location;
+      return
+          (std::abs(point.x) <= extent.x) &&
+          (std::abs(point.y) <= extent.y) &&
+          (std::abs(point.z) <= extent.z);
+    }
+
+    /// Vertices of the box in its local space. Vertex @b k is at the
+    /// negative extent in x, y and z unless bits 2, 1 and 0 of @b k are set,
+    /// respectively.
+    std::array<Location, 8u> GetLocalVertices() const {
+      std::array<Location, 8u> vertices;
+      for (auto k = 0u; k < vertices.size(); ++k) {
+        vertices[k] = location + Location(
+            (k & 4u) ? extent.x : -extent.x,
+            (k & 2u) ? extent.y : -extent.y,
+            (k & 1u) ? extent.z : -extent.z);
+      }
+      return vertices;
+    }
+
+    /// Same as GetLocalVertices, transformed by @a bbox_to_world.
+    std::array<Location, 8u> GetWorldVertices(const Transform &bbox_to_world) const {
+      auto vertices = GetLocalVertices();
+      for (auto &vertex : vertices) {
+        bbox_to_world.TransformPoint(vertex);
+      }
+      return vertices;
+    }
+
     bool operator==(const BoundingBox &rhs) const  {
       return (location == rhs.location) && (extent == rhs.extent);
     }
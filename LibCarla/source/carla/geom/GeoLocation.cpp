@@ -8,6 +8,7 @@
 
 #include "carla/geom/Location.h"
 #include "carla/geom/Math.h"
+#include "carla/geom/Simd.h"
 
 #include <cmath>
 
@@ -47,29 +48,165 @@ namespace geom {
     lat = 360.0 * std::atan(std::exp(my / (EARTH_RADIUS_EQUA * scale))) / Math::pi() - 90.0;
   }
 
-  /// Adds meters dx/dy to given lat/lon and returns new lat/lon.
-  static void LatLonAddMeters(
-      double lat_start,
-      double lon_start,
-      double dx,
-      double dy,
-      double &lat_end,
-      double &lon_end) {
-    double scale = LatToScale(lat_start);
-    double mx, my;
-    LatLonToMercator(lat_start, lon_start, scale, mx, my);
-    mx += dx;
-    my += dy;
-    MercatorToLatLon(mx, my, scale, lat_end, lon_end);
+  /// Mercator projection of a geo-reference, computed once to transform any
+  /// number of locations.
+  struct MercatorReference {
+
+    explicit MercatorReference(const GeoLocation &reference)
+      : scale(LatToScale(reference.latitude)),
+        altitude(reference.altitude) {
+      LatLonToMercator(reference.latitude, reference.longitude, scale, mx, my);
+    }
+
+    /// Adds meters dx/dy to the geo-reference.
+    GeoLocation Transform(const Location &location) const {
+      GeoLocation result{0.0, 0.0, altitude + location.z};
+      MercatorToLatLon(mx + location.x, my + location.y, scale, result.latitude, result.longitude);
+      return result;
+    }
+
+    /// Meters dx/dy from the geo-reference.
+    Location InverseTransform(const GeoLocation &geo_location) const {
+      double x, y;
+      LatLonToMercator(geo_location.latitude, geo_location.longitude, scale, x, y);
+      return {
+          static_cast<float>(x - mx),
+          static_cast<float>(y - my),
+          static_cast<float>(geo_location.altitude - altitude)};
+    }
+
+    double scale;
+
+    double mx;
+
+    double my;
+
+    double altitude;
+  };
+
+#ifdef LIBCARLA_WITH_AVX2
+
+  // ===========================================================================
+  // -- AVX2 kernels -----------------------------------------------------------
+  // ===========================================================================
+
+  /// Number of points transformed at once.
+  static constexpr size_t AVX2_WIDTH = 4u;
+
+  /// Transform the first count - count % AVX2_WIDTH locations, return the
+  /// number of locations transformed.
+  LIBCARLA_TARGET_AVX2 static size_t TransformAVX2(
+      const MercatorReference &reference,
+      const Location *locations,
+      const size_t count,
+      GeoLocation *out) {
+    const auto mx = _mm256_set1_pd(reference.mx);
+    const auto my = _mm256_set1_pd(reference.my);
+    const auto to_longitude = _mm256_set1_pd(180.0 / (Math::pi() * EARTH_RADIUS_EQUA * reference.scale));
+    const auto to_t = _mm256_set1_pd(1.0 / (EARTH_RADIUS_EQUA * reference.scale));
+    const auto to_latitude = _mm256_set1_pd(360.0 / Math::pi());
+    alignas(32) double latitudes[AVX2_WIDTH];
+    alignas(32) double longitudes[AVX2_WIDTH];
+    size_t i = 0u;
+    for (; i + AVX2_WIDTH <= count; i += AVX2_WIDTH) {
+      const auto *l = locations + i;
+      const auto x = _mm256_set_pd(l[3].x, l[2].x, l[1].x, l[0].x);
+      const auto y = _mm256_set_pd(l[3].y, l[2].y, l[1].y, l[0].y);
+      const auto longitude = _mm256_mul_pd(_mm256_add_pd(mx, x), to_longitude);
+      const auto t = _mm256_mul_pd(_mm256_add_pd(my, y), to_t);
+      const auto latitude = _mm256_fmsub_pd(
+          to_latitude,
+          simd::Atan(simd::Exp(t)),
+          _mm256_set1_pd(90.0));
+      _mm256_store_pd(latitudes, latitude);
+      _mm256_store_pd(longitudes, longitude);
+      for (auto j = 0u; j < AVX2_WIDTH; ++j) {
+        out[i + j] = {latitudes[j], longitudes[j], reference.altitude + l[j].z};
+      }
+    }
+    return i;
   }
 
+  /// Inverse of TransformAVX2.
+  LIBCARLA_TARGET_AVX2 static size_t InverseTransformAVX2(
+      const MercatorReference &reference,
+      const GeoLocation *geo_locations,
+      const size_t count,
+      Location *out) {
+    const auto mx = _mm256_set1_pd(reference.mx);
+    const auto my = _mm256_set1_pd(reference.my);
+    const auto meters_per_degree = _mm256_set1_pd(reference.scale * EARTH_RADIUS_EQUA * Math::pi() / 180.0);
+    const auto meters_per_radian = _mm256_set1_pd(reference.scale * EARTH_RADIUS_EQUA);
+    const auto to_half_radians = _mm256_set1_pd(Math::pi() / 360.0);
+    const auto one = _mm256_set1_pd(1.0);
+    alignas(32) double xs[AVX2_WIDTH];
+    alignas(32) double ys[AVX2_WIDTH];
+    size_t i = 0u;
+    for (; i + AVX2_WIDTH <= count; i += AVX2_WIDTH) {
+      const auto *g = geo_locations + i;
+      const auto latitude = _mm256_set_pd(g[3].latitude, g[2].latitude, g[1].latitude, g[0].latitude);
+      const auto longitude = _mm256_set_pd(g[3].longitude, g[2].longitude, g[1].longitude, g[0].longitude);
+      // tan(pi/4 + lat/2) = (1 + tan(lat/2)) / (1 - tan(lat/2)).
+      const auto h = simd::TanQuarterPi(_mm256_mul_pd(latitude, to_half_radians));
+      const auto u = _mm256_div_pd(_mm256_add_pd(one, h), _mm256_sub_pd(one, h));
+      const auto x = _mm256_fmsub_pd(longitude, meters_per_degree, mx);
+      const auto y = _mm256_fmsub_pd(simd::Log(u), meters_per_radian, my);
+      _mm256_store_pd(xs, x);
+      _mm256_store_pd(ys, y);
+      for (auto j = 0u; j < AVX2_WIDTH; ++j) {
+        out[i + j] = {
+            static_cast<float>(xs[j]),
+            static_cast<float>(ys[j]),
+            static_cast<float>(g[j].altitude - reference.altitude)};
+      }
+    }
+    return i;
+  }
+
+#endif // LIBCARLA_WITH_AVX2
+
+  // ===========================================================================
+  // -- GeoLocation ------------------------------------------------------------
+  // ===========================================================================
+
   GeoLocation GeoLocation::Transform(const Location &location) const {
-    GeoLocation result{0.0, 0.0, altitude + location.z};
-    LatLonAddMeters(
-        latitude, longitude,
-        location.x, location.y,
-        result.latitude, result.longitude);
-    return result;
+    return MercatorReference(*this).Transform(location);
+  }
+
+  Location GeoLocation::InverseTransform(const GeoLocation &geo_location) const {
+    return MercatorReference(*this).InverseTransform(geo_location);
+  }
+
+  void GeoLocation::Transform(
+      const Location *locations,
+      const size_t count,
+      GeoLocation *out) const {
+    const MercatorReference reference(*this);
+    size_t i = 0u;
+#ifdef LIBCARLA_WITH_AVX2
+    if (simd::HasAVX2()) {
+      i = TransformAVX2(reference, locations, count, out);
+    }
+#endif // LIBCARLA_WITH_AVX2
+    for (; i < count; ++i) {
+      out[i] = reference.Transform(locations[i]);
+    }
+  }
+
+  void GeoLocation::InverseTransform(
+      const GeoLocation *geo_locations,
+      const size_t count,
+      Location *out) const {
+    const MercatorReference reference(*this);
+    size_t i = 0u;
+#ifdef LIBCARLA_WITH_AVX2
+    if (simd::HasAVX2()) {
+      i = InverseTransformAVX2(reference, geo_locations, count, out);
+    }
+#endif // LIBCARLA_WITH_AVX2
+    for (; i < count; ++i) {
+      out[i] = reference.InverseTransform(geo_locations[i]);
+    }
   }
 
 } // namespace geom
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 namespace carla {
 namespace geom {
 
@@ -45,6 +47,19 @@ namespace geom {
     /// geo-reference.
     GeoLocation Transform(const Location &location) const;
 
+    /// Transform the given @a geo_location back to a Location using this as
+    /// geo-reference, the inverse of Transform.
+    Location InverseTransform(const GeoLocation &geo_location) const;
+
+    /// Transform the @a count locations at @a locations, writing the results
+    /// to @a out. Same as Transform on each of them, but the projection of
+    /// this geo-reference is computed once and the points are transformed
+    /// several at a time with SIMD instructions if the CPU supports them.
+    void Transform(const Location *locations, size_t count, GeoLocation *out) const;
+
+    /// Same as above for InverseTransform.
+    void InverseTransform(const GeoLocation *geo_locations, size_t count, Location *out) const;
+
     // =========================================================================
     // -- Comparison operators -------------------------------------------------
     // =========================================================================
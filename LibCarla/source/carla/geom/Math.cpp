@@ -137,5 +137,26 @@ namespace geom {
     return {cy * cp, sy * cp, sp};
   }
 
+  std::array<double, 9> Math::GetRotationMatrix(const Rotation &rotation) {
+    const double cp = std::cos(to_radians(rotation.pitch));
+    const double sp = std::sin(to_radians(rotation.pitch));
+    const double cy = std::cos(to_radians(rotation.yaw));
+    const double sy = std::sin(to_radians(rotation.yaw));
+    const double cr = std::cos(to_radians(rotation.roll));
+    const double sr = std::sin(to_radians(rotation.roll));
+    return {
+        cp * cy, cy * sp * sr - sy * cr, -cy * sp * cr - sy * sr,
+        cp * sy, sy * sp * sr + cy * cr, -sy * sp * cr + cy * sr,
+        sp,      -cp * sr,               cp * cr};
+  }
+
+  Rotation Math::GetRotation(const std::array<double, 9> &matrix) {
+    const double sp = clamp(matrix[6u], -1.0, 1.0);
+    return {
+        static_cast<float>(to_degrees(std::asin(sp))),
+        static_cast<float>(to_degrees(std::atan2(matrix[3u], matrix[0u]))),
+        static_cast<float>(to_degrees(std::atan2(-matrix[7u], matrix[8u])))};
+  }
+
 } // namespace geom
 } // namespace carla
@@ -9,6 +9,7 @@
 #include "carla/Debug.h"
 #include "carla/geom/Vector3D.h"
 
+#include <array>
 #include <utility>
 #include <cmath>
 
@@ -104,6 +105,14 @@ namespace geom {
 
     /// Compute the unit vector pointing towards the X-axis of @a rotation.
     static Vector3D GetForwardVector(const Rotation &rotation);
+
+    /// Compute the rotation matrix of @a rotation, row major. It is the
+    /// matrix applied by Transform::TransformPoint.
+    static std::array<double, 9> GetRotationMatrix(const Rotation &rotation);
+
+    /// Compute the rotation of the rotation matrix @a matrix, inverse of
+    /// GetRotationMatrix.
+    static Rotation GetRotation(const std::array<double, 9> &matrix);
   };
 
 } // namespace geom
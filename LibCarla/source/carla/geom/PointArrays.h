@@ -0,0 +1,63 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Debug.h"
+#include "carla/geom/Vector3D.h"
+
+#include <vector>
+
+namespace carla {
+namespace geom {
+
+  /// Points stored as a structure of arrays, one array per coordinate, the
+  /// layout of the batch kernels of BatchMath.
+  struct PointArrays {
+
+    PointArrays() = default;
+
+    explicit PointArrays(size_t size)
+      : x(size),
+        y(size),
+        z(size) {}
+
+    size_t size() const {
+      DEBUG_ASSERT((x.size() == y.size()) && (x.size() == z.size()));
+      return x.size();
+    }
+
+    void resize(size_t size) {
+      x.resize(size);
+      y.resize(size);
+      z.resize(size);
+    }
+
+    void reserve(size_t size) {
+      x.reserve(size);
+      y.reserve(size);
+      z.reserve(size);
+    }
+
+    void push_back(const Vector3D &point) {
+      x.push_back(point.x);
+      y.push_back(point.y);
+      z.push_back(point.z);
+    }
+
+    Vector3D operator[](size_t i) const {
+      return {x[i], y[i], z[i]};
+    }
+
+    std::vector<float> x;
+
+    std::vector<float> y;
+
+    std::vector<float> z;
+  };
+
+} // namespace geom
+} // namespace carla
@@ -0,0 +1,259 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+/// Support for the AVX2 kernels of the geom module. The kernels are compiled
+/// for AVX2 with a target attribute, the rest of the library keeps the
+/// default instruction set, so the kernels may only run after checking
+/// simd::HasAVX2 at run time. Include only from translation units.
+
+#include "carla/geom/Math.h"
+
+#include <cstddef>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  define LIBCARLA_WITH_AVX2
+#  define LIBCARLA_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#  include <immintrin.h>
+#endif
+
+namespace carla {
+namespace geom {
+namespace simd {
+
+  /// Whether the AVX2 kernels can run in this CPU.
+  inline bool HasAVX2() {
+#ifdef LIBCARLA_WITH_AVX2
+    static const bool result =
+        __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return result;
+#else
+    return false;
+#endif // LIBCARLA_WITH_AVX2
+  }
+
+#ifdef LIBCARLA_WITH_AVX2
+
+  // ===========================================================================
+  // -- Math functions ---------------------------------------------------------
+  // ===========================================================================
+
+  // Vectorized versions of the exp, atan and tan implementations of the
+  // Cephes Math Library (http://www.netlib.org/cephes/), with their double
+  // precision coefficients, and of log, sin and cos. The branches of the
+  // scalar versions are replaced by blends.
+
+  /// Evaluate the polynomial with coefficients @a coef, highest degree first.
+  template <size_t N>
+  LIBCARLA_TARGET_AVX2 inline __m256d Polevl(__m256d x, const double (&coef)[N]) {
+    __m256d result = _mm256_set1_pd(coef[0]);
+    for (auto i = 1u; i < N; ++i) {
+      result = _mm256_fmadd_pd(result, x, _mm256_set1_pd(coef[i]));
+    }
+    return result;
+  }
+
+  /// Same as Polevl with an implicit leading coefficient of 1.
+  template <size_t N>
+  LIBCARLA_TARGET_AVX2 inline __m256d P1evl(__m256d x, const double (&coef)[N]) {
+    __m256d result = _mm256_add_pd(x, _mm256_set1_pd(coef[0]));
+    for (auto i = 1u; i < N; ++i) {
+      result = _mm256_fmadd_pd(result, x, _mm256_set1_pd(coef[i]));
+    }
+    return result;
+  }
+
+  /// exp(x) for |x| < 700.
+  LIBCARLA_TARGET_AVX2 inline __m256d Exp(__m256d x) {
+    static constexpr double P[] = {
+        1.26177193074810590878E-4,
+        3.02994407707441961300E-2,
+        9.99999999999999999910E-1};
+    static constexpr double Q[] = {
+        3.00198505138664455042E-6,
+        2.52448340349684104192E-3,
+        2.27265548208155028766E-1,
+        2.00000000000000000009E0};
+    const auto n = _mm256_round_pd(
+        _mm256_mul_pd(x, _mm256_set1_pd(1.4426950408889634073599)),
+        _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    x = _mm256_fnmadd_pd(n, _mm256_set1_pd(6.93145751953125E-1), x);
+    x = _mm256_fnmadd_pd(n, _mm256_set1_pd(1.42860682030941723212E-6), x);
+    const auto xx = _mm256_mul_pd(x, x);
+    const auto px = _mm256_mul_pd(x, Polevl(xx, P));
+    x = _mm256_div_pd(px, _mm256_sub_pd(Polevl(xx, Q), px));
+    x = _mm256_fmadd_pd(_mm256_set1_pd(2.0), x, _mm256_set1_pd(1.0));
+    // Multiply by 2^n building the exponent bits.
+    const auto exponent = _mm256_slli_epi64(
+        _mm256_add_epi64(
+            _mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(n)),
+            _mm256_set1_epi64x(1023)),
+        52);
+    return _mm256_mul_pd(x, _mm256_castsi256_pd(exponent));
+  }
+
+  /// atan(x).
+  LIBCARLA_TARGET_AVX2 inline __m256d Atan(__m256d x) {
+    static constexpr double P[] = {
+        -8.750608600031904122785E-1,
+        -1.615753718733365076637E1,
+        -7.500855792314704667340E1,
+        -1.228866684490136173410E2,
+        -6.485021904942025371773E1};
+    static constexpr double Q[] = {
+        2.485846490142306297962E1,
+        1.650270098316988542046E2,
+        4.328810604912902668951E2,
+        4.853903996359136964868E2,
+        1.945506571482613964425E2};
+    constexpr double T3P8 = 2.41421356237309504880;
+    constexpr double MOREBITS = 6.123233995736765886130E-17;
+    const auto sign_mask = _mm256_set1_pd(-0.0);
+    const auto sign = _mm256_and_pd(x, sign_mask);
+    x = _mm256_andnot_pd(sign_mask, x);
+    // Reduce the range, x > tan(3pi/8) and tan(3pi/8) >= x > 0.66.
+    const auto big = _mm256_cmp_pd(x, _mm256_set1_pd(T3P8), _CMP_GT_OQ);
+    const auto mid = _mm256_andnot_pd(big, _mm256_cmp_pd(x, _mm256_set1_pd(0.66), _CMP_GT_OQ));
+    const auto one = _mm256_set1_pd(1.0);
+    const auto x_big = _mm256_div_pd(_mm256_set1_pd(-1.0), x);
+    const auto x_mid = _mm256_div_pd(_mm256_sub_pd(x, one), _mm256_add_pd(x, one));
+    x = _mm256_blendv_pd(_mm256_blendv_pd(x, x_mid, mid), x_big, big);
+    const auto y0 = _mm256_blendv_pd(
+        _mm256_blendv_pd(_mm256_setzero_pd(), _mm256_set1_pd(Math::pi() / 4.0), mid),
+        _mm256_set1_pd(Math::pi_half()),
+        big);
+    const auto more_bits = _mm256_blendv_pd(
+        _mm256_blendv_pd(_mm256_setzero_pd(), _mm256_set1_pd(0.5 * MOREBITS), mid),
+        _mm256_set1_pd(MOREBITS),
+        big);
+    const auto z = _mm256_mul_pd(x, x);
+    auto y = _mm256_div_pd(_mm256_mul_pd(z, Polevl(z, P)), P1evl(z, Q));
+    y = _mm256_add_pd(_mm256_fmadd_pd(x, y, x), more_bits);
+    return _mm256_or_pd(_mm256_add_pd(y0, y), sign);
+  }
+
+  /// tan(x) for |x| <= pi/4.
+  LIBCARLA_TARGET_AVX2 inline __m256d TanQuarterPi(__m256d x) {
+    static constexpr double P[] = {
+        -1.30936939181383777646E4,
+        1.15351664838587416140E6,
+        -1.79565251976484877988E7};
+    static constexpr double Q[] = {
+        1.36812963470692954678E4,
+        -1.32089234440210967447E6,
+        2.50083801823357915839E7,
+        -5.38695755929454629881E7};
+    const auto z = _mm256_mul_pd(x, x);
+    const auto y = _mm256_div_pd(_mm256_mul_pd(z, Polevl(z, P)), P1evl(z, Q));
+    return _mm256_fmadd_pd(x, y, x);
+  }
+
+  /// log(x) for finite x > 0.
+  LIBCARLA_TARGET_AVX2 inline __m256d Log(__m256d x) {
+    // Series of atanh, log(m) = 2 atanh((m - 1) / (m + 1)).
+    static constexpr double P[] = {
+        1.0 / 19.0, 1.0 / 17.0, 1.0 / 15.0, 1.0 / 13.0, 1.0 / 11.0,
+        1.0 / 9.0, 1.0 / 7.0, 1.0 / 5.0, 1.0 / 3.0, 1.0};
+    constexpr double SQRTH = 0.70710678118654752440;
+    // Split x into a mantissa in [0.5, 1) and an exponent, as frexp does. The
+    // biased exponent is converted to double adding it to the bits of 2^52.
+    const auto bits = _mm256_castpd_si256(x);
+    const auto biased_exponent = _mm256_srli_epi64(bits, 52);
+    const auto two_52 = _mm256_set1_pd(4503599627370496.0);
+    auto e = _mm256_sub_pd(
+        _mm256_sub_pd(
+            _mm256_castsi256_pd(_mm256_or_si256(biased_exponent, _mm256_castpd_si256(two_52))),
+            two_52),
+        _mm256_set1_pd(1022.0));
+    auto m = _mm256_castsi256_pd(_mm256_or_si256(
+        _mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFll)),
+        _mm256_set1_epi64x(0x3FE0000000000000ll)));
+    // Keep the mantissa in [sqrt(1/2), sqrt(2)), |(m - 1) / (m + 1)| < 0.18.
+    const auto small = _mm256_cmp_pd(m, _mm256_set1_pd(SQRTH), _CMP_LT_OQ);
+    e = _mm256_sub_pd(e, _mm256_and_pd(small, _mm256_set1_pd(1.0)));
+    m = _mm256_add_pd(m, _mm256_and_pd(small, m));
+    const auto one = _mm256_set1_pd(1.0);
+    const auto s = _mm256_div_pd(_mm256_sub_pd(m, one), _mm256_add_pd(m, one));
+    const auto y = _mm256_mul_pd(_mm256_add_pd(s, s), Polevl(_mm256_mul_pd(s, s), P));
+    // e * log(2) with log(2) split in two parts to keep the precision.
+    return _mm256_fmadd_pd(
+        e,
+        _mm256_set1_pd(0.693359375),
+        _mm256_fmadd_pd(e, _mm256_set1_pd(-2.121944400546905827679e-4), y));
+  }
+
+  /// Mask of the lanes of @a n with @a bit set.
+  LIBCARLA_TARGET_AVX2 inline __m256d IsBitSet(__m256i n, long long bit) {
+    const auto mask = _mm256_set1_epi64x(bit);
+    return _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(n, mask), mask));
+  }
+
+  /// Sine and cosine of @a degrees.
+  LIBCARLA_TARGET_AVX2 inline void SinCosDegrees(__m256d degrees, __m256d &sin, __m256d &cos) {
+    // Taylor series, exact to double precision for |x| <= pi/4.
+    static constexpr double S[] = {
+        1.0 / 355687428096000.0, -1.0 / 1307674368000.0, 1.0 / 6227020800.0,
+        -1.0 / 39916800.0, 1.0 / 362880.0, -1.0 / 5040.0, 1.0 / 120.0, -1.0 / 6.0, 1.0};
+    static constexpr double C[] = {
+        -1.0 / 6402373705728000.0, 1.0 / 20922789888000.0, -1.0 / 87178291200.0,
+        1.0 / 479001600.0, -1.0 / 3628800.0, 1.0 / 40320.0, -1.0 / 720.0, 1.0 / 24.0,
+        -1.0 / 2.0, 1.0};
+    // Reduce to |x| <= 45 degrees in quadrant n.
+    const auto q = _mm256_round_pd(
+        _mm256_mul_pd(degrees, _mm256_set1_pd(1.0 / 90.0)),
+        _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    const auto x = _mm256_mul_pd(
+        _mm256_fnmadd_pd(q, _mm256_set1_pd(90.0), degrees),
+        _mm256_set1_pd(Math::pi() / 180.0));
+    const auto z = _mm256_mul_pd(x, x);
+    const auto sin_x = _mm256_mul_pd(x, Polevl(z, S));
+    const auto cos_x = Polevl(z, C);
+    const auto n = _mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(q));
+    const auto sign_mask = _mm256_set1_pd(-0.0);
+    // sin: sin x, cos x, -sin x, -cos x; cos: cos x, -sin x, -cos x, sin x.
+    const auto odd = IsBitSet(n, 1);
+    sin = _mm256_xor_pd(
+        _mm256_blendv_pd(sin_x, cos_x, odd),
+        _mm256_and_pd(IsBitSet(n, 2), sign_mask));
+    cos = _mm256_xor_pd(
+        _mm256_blendv_pd(cos_x, sin_x, odd),
+        _mm256_and_pd(IsBitSet(_mm256_add_epi64(n, _mm256_set1_epi64x(1)), 2), sign_mask));
+  }
+
+  /// atan2(y, x), 0 if both are 0.
+  LIBCARLA_TARGET_AVX2 inline __m256d Atan2(__m256d y, __m256d x) {
+    const auto zero = _mm256_setzero_pd();
+    const auto sign_mask = _mm256_set1_pd(-0.0);
+    const auto y_sign = _mm256_and_pd(y, sign_mask);
+    auto result = Atan(_mm256_div_pd(y, x));
+    // Add pi, with the sign of y, on the left half-plane.
+    const auto negative_x = _mm256_cmp_pd(x, zero, _CMP_LT_OQ);
+    result = _mm256_add_pd(
+        result,
+        _mm256_and_pd(negative_x, _mm256_or_pd(_mm256_set1_pd(Math::pi()), y_sign)));
+    // On the y axis, pi/2 with the sign of y or 0 at the origin.
+    const auto zero_x = _mm256_cmp_pd(x, zero, _CMP_EQ_OQ);
+    const auto zero_y = _mm256_cmp_pd(y, zero, _CMP_EQ_OQ);
+    const auto on_axis = _mm256_andnot_pd(
+        zero_y,
+        _mm256_or_pd(_mm256_set1_pd(Math::pi_half()), y_sign));
+    return _mm256_blendv_pd(result, on_axis, zero_x);
+  }
+
+  /// asin(x), @a x is clamped to [-1, 1].
+  LIBCARLA_TARGET_AVX2 inline __m256d Asin(__m256d x) {
+    const auto one = _mm256_set1_pd(1.0);
+    x = _mm256_max_pd(_mm256_min_pd(x, one), _mm256_set1_pd(-1.0));
+    const auto cos = _mm256_sqrt_pd(_mm256_fnmadd_pd(x, x, one));
+    return Atan2(x, cos);
+  }
+
+#endif // LIBCARLA_WITH_AVX2
+
+} // namespace simd
+} // namespace geom
+} // namespace carla
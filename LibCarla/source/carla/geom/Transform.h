@@ -54,30 +54,48 @@ namespace geom {
     }
 
     void TransformPoint(Vector3D &in_point) const {
-      // Rotate
-      double cy = cos(Math::to_radians(rotation.yaw));
-      double sy = sin(Math::to_radians(rotation.yaw));
-      double cr = cos(Math::to_radians(rotation.roll));
-      double sr = sin(Math::to_radians(rotation.roll));
-      double cp = cos(Math::to_radians(rotation.pitch));
-      double sp = sin(Math::to_radians(rotation.pitch));
-
-      Vector3D out_point;
-      out_point.x = in_point.x * (cp * cy) +
-          in_point.y * (cy * sp * sr - sy * cr) +
-          in_point.z * (-cy * sp * cr - sy * sr);
-      out_point.y = in_point.x * (cp * sy) +
-          in_point.y * (sy * sp * sr + cy * cr) +
-          in_point.z * (-sy * sp * cr + cy * sr);
-
-      out_point.z = in_point.x *  (sp) +
-          in_point.y * -(cp * sr) +
-          in_point.z *  (cp * cr);
-
-      // Translate
-      out_point += location;
-
-      in_point = out_point;
+      const auto m = Math::GetRotationMatrix(rotation);
+      const double x = in_point.x;
+      const double y = in_point.y;
+      const double z = in_point.z;
+
+      // Rotate, then translate.
+      in_point.x = static_cast<float>(x * m[0u] + y * m[1u] + z * m[2u]) + location.x;
+      in_point.y = static_cast<float>(x * m[3u] + y * m[4u] + z * m[5u]) + location.y;
+      in_point.z = static_cast<float>(x * m[6u] + y * m[7u] + z * m[8u]) + location.z;
+    }
+
+    /// Inverse of TransformPoint, convert @a in_point from the space this
+    /// transform is relative to into the local space of the transform.
+    void InverseTransformPoint(Vector3D &in_point) const {
+      const auto m = Math::GetRotationMatrix(rotation);
+      const double x = in_point.x - location.x;
+      const double y = in_point.y - location.y;
+      const double z = in_point.z - location.z;
+
+      // Rotate by the transpose.
+      in_point.x = static_cast<float>(x * m[0u] + y * m[3u] + z * m[6u]);
+      in_point.y = static_cast<float>(x * m[1u] + y * m[4u] + z * m[7u]);
+      in_point.z = static_cast<float>(x * m[2u] + y * m[5u] + z * m[8u]);
+    }
+
+    /// Compose this transform with @a child, a transform relative to this
+    /// one, the result is relative to the same space this transform is.
+    Transform Compose(const Transform &child) const {
+      const auto p = Math::GetRotationMatrix(rotation);
+      const auto c = Math::GetRotationMatrix(child.rotation);
+      std::array<double, 9u> m;
+      for (auto i = 0u; i < 3u; ++i) {
+        for (auto j = 0u; j < 3u; ++j) {
+          m[3u * i + j] =
+              p[3u * i] * c[j] +
+              p[3u * i + 1u] * c[3u + j] +
+              p[3u * i + 2u] * c[6u + j];
+        }
+      }
+      Vector3D child_location = child.location;
+      TransformPoint(child_location);
+      return {child_location, Math::GetRotation(m)};
     }
 
     // =========================================================================
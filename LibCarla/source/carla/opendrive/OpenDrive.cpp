@@ -6,9 +6,20 @@
 
 #include "OpenDrive.h"
 
+#include "carla/road/CompiledMap.h"
 #include "carla/road/MapBuilder.h"
 #include "carla/Debug.h"
 
+#ifdef _WIN32
+#  include <fstream>
+#  include <iterator>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
 namespace carla {
 namespace opendrive {
 
@@ -55,7 +66,7 @@ namespace opendrive {
         itSec != roadInfo->lanes.lane_sections.rend() - 1;
         ++itSec) {
       for (auto itLane = itSec->left.begin(); itLane != itSec->left.end(); ++itLane) {
-        if (itLane->attributes.type == "driving" && itLane->attributes.id == id) {
+        if (itLane->attributes.type == road::element::LaneType::Driving && itLane->attributes.id == id) {
           id = itLane->link ? itLane->link->predecessor_id : 0;
           break;
         }
@@ -99,7 +110,7 @@ namespace opendrive {
 
     // Transforma data for the MapBuilder
     for (road_data_t::iterator it = road_data.begin(); it != road_data.end(); ++it) {
-      carla::road::element::RoadSegmentDefinition road_segment(it->first);
+      carla::road::element::RoadSegmentDefinition road_segment(it->first, &mapBuilder.GetArena());
       carla::road::element::RoadInfoLane *RoadInfoLanes =
           road_segment.MakeInfo<carla::road::element::RoadInfoLane>();
 
@@ -136,7 +147,7 @@ namespace opendrive {
 
       for (auto &&left_lanes : it->second->lanes.lane_sections[0].left) {
         if (left_lanes.link != nullptr) {
-          if (left_lanes.attributes.type != "driving") {
+          if (left_lanes.attributes.type != road::element::LaneType::Driving) {
             continue;
           }
           if (left_lanes.link->successor_id != 0) {
@@ -161,7 +172,7 @@ namespace opendrive {
 
       for (auto &&right_lanes : it->second->lanes.lane_sections[0].right) {
         if (right_lanes.link != nullptr) {
-          if (right_lanes.attributes.type != "driving") {
+          if (right_lanes.attributes.type != road::element::LaneType::Driving) {
             continue;
           }
           if (right_lanes.link->successor_id != 0) {
@@ -470,5 +481,81 @@ namespace opendrive {
     return Load(fileContent, XmlInputType::CONTENT, out_error);
   }
 
+  std::vector<unsigned char> OpenDrive::Compile(
+      const std::string &xml,
+      std::string *out_error) {
+    std::string error;
+    auto map = Load(xml, XmlInputType::CONTENT, &error);
+    if ((map == nullptr) || !error.empty()) {
+      if (out_error != nullptr) {
+        *out_error = error.empty() ? "unable to build the map" : error;
+      }
+      return {};
+    }
+    return road::CompiledMap::Write(*map, road::CompiledMap::MakeSource(xml));
+  }
+
+  SharedPtr<road::Map> OpenDrive::LoadCompiled(
+      const unsigned char *data,
+      const size_t size,
+      std::string *out_error,
+      const road::CompiledMap::Source *source) {
+    return road::CompiledMap::Read(data, size, out_error, source);
+  }
+
+  static SharedPtr<road::Map> CompiledFileError(
+      const std::string &path,
+      std::string *out_error) {
+    if (out_error != nullptr) {
+      *out_error = "unable to read compiled map \"" + path + "\"";
+    }
+    return nullptr;
+  }
+
+#ifdef _WIN32
+
+  SharedPtr<road::Map> OpenDrive::LoadCompiledFile(
+      const std::string &path,
+      std::string *out_error,
+      const road::CompiledMap::Source *source) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+      return CompiledFileError(path, out_error);
+    }
+    const std::vector<unsigned char> blob{
+        std::istreambuf_iterator<char>(file),
+        std::istreambuf_iterator<char>()};
+    return LoadCompiled(blob, out_error, source);
+  }
+
+#else
+
+  SharedPtr<road::Map> OpenDrive::LoadCompiledFile(
+      const std::string &path,
+      std::string *out_error,
+      const road::CompiledMap::Source *source) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return CompiledFileError(path, out_error);
+    }
+    struct stat info;
+    if ((::fstat(fd, &info) != 0) || (info.st_size <= 0)) {
+      ::close(fd);
+      return CompiledFileError(path, out_error);
+    }
+    const auto size = static_cast<size_t>(info.st_size);
+    void *data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file.
+    ::close(fd);
+    if (data == MAP_FAILED) {
+      return CompiledFileError(path, out_error);
+    }
+    auto map = LoadCompiled(static_cast<const unsigned char *>(data), size, out_error, source);
+    ::munmap(data, size);
+    return map;
+  }
+
+#endif // _WIN32
+
 } // namespace opendrive
 } // namespace carla
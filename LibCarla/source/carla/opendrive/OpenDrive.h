@@ -7,12 +7,14 @@
 #pragma once
 
 #include "carla/Memory.h"
+#include "carla/road/CompiledMap.h"
 #include "carla/road/Map.h"
 #include "parser/OpenDriveParser.h"
 
 #include <istream>
 #include <ostream>
 #include <string>
+#include <vector>
 
 namespace carla {
 namespace opendrive {
@@ -30,6 +32,35 @@ namespace opendrive {
         std::string *out_error = nullptr);
 
     static void Dump(const road::Map &map, std::ostream &output);
+
+    /// Parse the OpenDRIVE @a xml and return the built map serialized as a
+    /// road::CompiledMap, or an empty blob on error. The blob records the
+    /// size and digest of @a xml.
+    static std::vector<unsigned char> Compile(
+        const std::string &xml,
+        std::string *out_error = nullptr);
+
+    /// Load a map serialized with Compile. If @a source is provided, the map
+    /// is rejected unless it was compiled from that OpenDRIVE.
+    static SharedPtr<road::Map> LoadCompiled(
+        const unsigned char *data,
+        size_t size,
+        std::string *out_error = nullptr,
+        const road::CompiledMap::Source *source = nullptr);
+
+    static SharedPtr<road::Map> LoadCompiled(
+        const std::vector<unsigned char> &blob,
+        std::string *out_error = nullptr,
+        const road::CompiledMap::Source *source = nullptr) {
+      return LoadCompiled(blob.data(), blob.size(), out_error, source);
+    }
+
+    /// Load a map serialized with Compile from the file at @a path, the file
+    /// is memory-mapped instead of read whenever the platform allows it.
+    static SharedPtr<road::Map> LoadCompiledFile(
+        const std::string &path,
+        std::string *out_error = nullptr,
+        const road::CompiledMap::Source *source = nullptr);
   };
 
 } // namespace opendrive
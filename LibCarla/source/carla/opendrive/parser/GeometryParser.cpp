@@ -5,6 +5,7 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include "GeometryParser.h"
+#include "NumberParser.h"
 
 #include <cassert>
 
@@ -15,7 +16,7 @@ void carla::opendrive::parser::GeometryParser::ParseArc(
     const pugi::xml_node &xmlNode,
     carla::opendrive::types::GeometryAttributesArc *out_geometry_arc) {
   out_geometry_arc->type = opendrive::types::GeometryType::ARC;
-  out_geometry_arc->curvature = std::stod(xmlNode.attribute("curvature").value());
+  out_geometry_arc->curvature = ParseDouble(xmlNode.attribute("curvature").value());
 }
 
 void carla::opendrive::parser::GeometryParser::ParseLine(
@@ -29,8 +30,8 @@ void carla::opendrive::parser::GeometryParser::ParseSpiral(
     const pugi::xml_node &xmlNode,
     carla::opendrive::types::GeometryAttributesSpiral *out_geometry_spiral) {
   out_geometry_spiral->type = opendrive::types::GeometryType::SPIRAL;
-  out_geometry_spiral->curve_end = std::stod(xmlNode.attribute("curvEnd").value());
-  out_geometry_spiral->curve_start = std::stod(xmlNode.attribute("curvStart").value());
+  out_geometry_spiral->curve_end = ParseDouble(xmlNode.attribute("curvEnd").value());
+  out_geometry_spiral->curve_start = ParseDouble(xmlNode.attribute("curvStart").value());
 }
 
 void carla::opendrive::parser::GeometryParser::Parse(
@@ -60,13 +61,13 @@ void carla::opendrive::parser::GeometryParser::Parse(
       ODP_ASSERT(false, "Geometry type unknown");
     }
 
-    geometry_attributes->start_position = std::stod(roadGeometry.attribute("s").value());
+    geometry_attributes->start_position = ParseDouble(roadGeometry.attribute("s").value());
 
-    geometry_attributes->start_position_x = std::stod(roadGeometry.attribute("x").value());
-    geometry_attributes->start_position_y = std::stod(roadGeometry.attribute("y").value());
+    geometry_attributes->start_position_x = ParseDouble(roadGeometry.attribute("x").value());
+    geometry_attributes->start_position_y = ParseDouble(roadGeometry.attribute("y").value());
 
-    geometry_attributes->heading = std::stod(roadGeometry.attribute("hdg").value());
-    geometry_attributes->length = std::stod(roadGeometry.attribute("length").value());
+    geometry_attributes->heading = ParseDouble(roadGeometry.attribute("hdg").value());
+    geometry_attributes->length = ParseDouble(roadGeometry.attribute("length").value());
 
     out_geometry_attributes.emplace_back(std::move(geometry_attributes));
   }
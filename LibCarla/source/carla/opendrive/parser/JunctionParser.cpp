@@ -5,6 +5,7 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include "JunctionParser.h"
+#include "NumberParser.h"
 
 void carla::opendrive::parser::JunctionParser::Parse(
     const pugi::xml_node &xmlNode,
@@ -12,7 +13,7 @@ void carla::opendrive::parser::JunctionParser::Parse(
   carla::opendrive::parser::JunctionParser parser;
   carla::opendrive::types::Junction junction;
 
-  junction.attributes.id = std::atoi(xmlNode.attribute("id").value());
+  junction.attributes.id = ParseInt(xmlNode.attribute("id").value());
   junction.attributes.name = xmlNode.attribute("name").value();
 
   parser.ParseConnection(xmlNode, junction.connections);
@@ -27,12 +28,12 @@ void carla::opendrive::parser::JunctionParser::ParseConnection(
       junctionConnection = junctionConnection.next_sibling("connection")) {
     carla::opendrive::types::JunctionConnection jConnection;
 
-    jConnection.attributes.id = std::atoi(junctionConnection.attribute("id").value());
+    jConnection.attributes.id = ParseInt(junctionConnection.attribute("id").value());
     jConnection.attributes.contact_point = junctionConnection.attribute("contactPoint").value();
 
-    jConnection.attributes.incoming_road = std::atoi(junctionConnection.attribute("incomingRoad").value());
+    jConnection.attributes.incoming_road = ParseInt(junctionConnection.attribute("incomingRoad").value());
     jConnection.attributes.connecting_road =
-        std::atoi(junctionConnection.attribute("connectingRoad").value());
+        ParseInt(junctionConnection.attribute("connectingRoad").value());
 
     ParseLaneLink(junctionConnection, jConnection.links);
     out_connections.emplace_back(jConnection);
@@ -47,8 +48,8 @@ void carla::opendrive::parser::JunctionParser::ParseLaneLink(
       junctionLaneLink = junctionLaneLink.next_sibling("laneLink")) {
     carla::opendrive::types::JunctionLaneLink jLaneLink;
 
-    jLaneLink.from = std::atoi(junctionLaneLink.attribute("from").value());
-    jLaneLink.to = std::atoi(junctionLaneLink.attribute("to").value());
+    jLaneLink.from = ParseInt(junctionLaneLink.attribute("from").value());
+    jLaneLink.to = ParseInt(junctionLaneLink.attribute("to").value());
 
     out_lane_link.emplace_back(jLaneLink);
   }
@@ -5,6 +5,7 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include "LaneParser.h"
+#include "NumberParser.h"
 
 namespace carla {
 namespace opendrive {
@@ -16,9 +17,9 @@ namespace parser {
     for (pugi::xml_node lane = xmlNode.child("lane"); lane; lane = lane.next_sibling("lane")) {
       types::LaneInfo currentLane;
 
-      currentLane.attributes.type = lane.attribute("type").value();
+      currentLane.attributes.type = road::element::ParseLaneType(lane.attribute("type").value());
       currentLane.attributes.level = lane.attribute("level").value();
-      currentLane.attributes.id = std::atoi(lane.attribute("id").value());
+      currentLane.attributes.id = ParseInt(lane.attribute("id").value());
 
       ParseLaneSpeed(lane, currentLane.lane_speed);
       ParseLaneWidth(lane, currentLane.lane_width);
@@ -38,13 +39,13 @@ namespace parser {
         laneWidth = laneWidth.next_sibling("width")) {
       types::LaneWidth laneWidthInfo;
 
-      laneWidthInfo.soffset = std::stod(laneWidth.attribute("sOffset").value());
+      laneWidthInfo.soffset = ParseDouble(laneWidth.attribute("sOffset").value());
 
-      laneWidthInfo.width = std::stod(laneWidth.attribute("a").value());
-      laneWidthInfo.slope = std::stod(laneWidth.attribute("b").value());
+      laneWidthInfo.width = ParseDouble(laneWidth.attribute("a").value());
+      laneWidthInfo.slope = ParseDouble(laneWidth.attribute("b").value());
 
-      laneWidthInfo.vertical_curvature = std::stod(laneWidth.attribute("c").value());
-      laneWidthInfo.curvature_change = std::stod(laneWidth.attribute("d").value());
+      laneWidthInfo.vertical_curvature = ParseDouble(laneWidth.attribute("c").value());
+      laneWidthInfo.curvature_change = ParseDouble(laneWidth.attribute("d").value());
 
       out_lane_width.emplace_back(laneWidthInfo);
     }
@@ -62,8 +63,8 @@ namespace parser {
       return;
     }
 
-    out_lane_link->predecessor_id = predecessorNode ? std::atoi(predecessorNode.attribute("id").value()) : 0;
-    out_lane_link->successor_id = successorNode ? std::atoi(successorNode.attribute("id").value()) : 0;
+    out_lane_link->predecessor_id = predecessorNode ? ParseInt(predecessorNode.attribute("id").value()) : 0;
+    out_lane_link->successor_id = successorNode ? ParseInt(successorNode.attribute("id").value()) : 0;
   }
 
   void LaneParser::ParseLaneOffset(
@@ -71,11 +72,11 @@ namespace parser {
       std::vector<types::LaneOffset> &out_lane_offset) {
     types::LaneOffset lanesOffset;
 
-    lanesOffset.s = std::stod(xmlNode.attribute("s").value());
-    lanesOffset.a = std::stod(xmlNode.attribute("a").value());
-    lanesOffset.b = std::stod(xmlNode.attribute("b").value());
-    lanesOffset.c = std::stod(xmlNode.attribute("c").value());
-    lanesOffset.d = std::stod(xmlNode.attribute("d").value());
+    lanesOffset.s = ParseDouble(xmlNode.attribute("s").value());
+    lanesOffset.a = ParseDouble(xmlNode.attribute("a").value());
+    lanesOffset.b = ParseDouble(xmlNode.attribute("b").value());
+    lanesOffset.c = ParseDouble(xmlNode.attribute("c").value());
+    lanesOffset.d = ParseDouble(xmlNode.attribute("d").value());
 
     out_lane_offset.emplace_back(lanesOffset);
   }
@@ -89,11 +90,11 @@ namespace parser {
       types::LaneRoadMark roadMarker;
 
       if (road_mark.attribute("sOffset") != nullptr) {
-        roadMarker.soffset = std::stod(road_mark.attribute("sOffset").value());
+        roadMarker.soffset = ParseDouble(road_mark.attribute("sOffset").value());
       }
 
       if (road_mark.attribute("width") != nullptr) {
-        roadMarker.width = std::stod(road_mark.attribute("width").value());
+        roadMarker.width = ParseDouble(road_mark.attribute("width").value());
       }
 
       if (road_mark.attribute("type") != nullptr) {
@@ -128,8 +129,8 @@ namespace parser {
         laneSpeed = laneSpeed.next_sibling("speed")) {
       types::LaneSpeed lane_speed = { 0.0, 0.0 };
 
-      lane_speed.soffset = std::stod(laneSpeed.attribute("sOffset").value());
-      lane_speed.max_speed = std::stod(laneSpeed.attribute("max").value());
+      lane_speed.soffset = ParseDouble(laneSpeed.attribute("sOffset").value());
+      lane_speed.max_speed = ParseDouble(laneSpeed.attribute("max").value());
 
       out_lane_speed.emplace_back(lane_speed);
     }
@@ -150,7 +151,7 @@ namespace parser {
         laneSection;
         laneSection = laneSection.next_sibling("laneSection")) {
       types::LaneSection laneSec;
-      laneSec.start_position = std::stod(laneSection.attribute("s").value());
+      laneSec.start_position = ParseDouble(laneSection.attribute("s").value());
 
       pugi::xml_node lane = laneSection.child("left");
       laneParser.ParseLane(lane, laneSec.left);
@@ -0,0 +1,162 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/opendrive/parser/NumberParser.h"
+
+#include <cstdint>
+#include <limits>
+
+#include <locale.h>
+#include <stdlib.h>
+
+namespace carla {
+namespace opendrive {
+namespace parser {
+
+  static bool IsSpace(char c) {
+    return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r');
+  }
+
+  static bool IsDigit(char c) {
+    return (c >= '0') && (c <= '9');
+  }
+
+  /// Slow path, for numbers that cannot be converted exactly with a single
+  /// floating point operation.
+  static double ParseDoubleWithCLocale(const char *str) {
+#ifdef _WIN32
+    static const _locale_t locale = _create_locale(LC_NUMERIC, "C");
+    return _strtod_l(str, nullptr, locale);
+#else
+    static const locale_t locale = newlocale(LC_NUMERIC_MASK, "C", static_cast<locale_t>(0));
+    return strtod_l(str, nullptr, locale);
+#endif // _WIN32
+  }
+
+  double ParseDouble(const char *str) {
+    // Powers of ten exactly representable as double.
+    static constexpr double POWERS_OF_TEN[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    constexpr int max_exact_exponent = 22;
+    // Integers up to 2^53 are exactly representable as double.
+    constexpr uint64_t max_exact_mantissa = uint64_t(1u) << 53u;
+    constexpr int max_digits = 19;
+
+    if (str == nullptr) {
+      return 0.0;
+    }
+    while (IsSpace(*str)) {
+      ++str;
+    }
+    const char *it = str;
+    const bool negative = (*it == '-');
+    if ((*it == '-') || (*it == '+')) {
+      ++it;
+    }
+
+    uint64_t mantissa = 0u;
+    int significant_digits = 0;
+    int exponent = 0;
+    bool has_digits = false;
+    bool truncated = false;
+    auto add_digit = [&](char c, bool is_fraction) {
+      has_digits = true;
+      if (significant_digits < max_digits) {
+        mantissa = 10u * mantissa + static_cast<uint64_t>(c - '0');
+        if (mantissa != 0u) {
+          ++significant_digits;
+        }
+        if (is_fraction) {
+          --exponent;
+        }
+      } else {
+        truncated = truncated || (c != '0');
+        if (!is_fraction) {
+          ++exponent;
+        }
+      }
+    };
+    for (; IsDigit(*it); ++it) {
+      add_digit(*it, false);
+    }
+    if (*it == '.') {
+      for (++it; IsDigit(*it); ++it) {
+        add_digit(*it, true);
+      }
+    }
+    if (!has_digits) {
+      return 0.0;
+    }
+    if ((*it == 'e') || (*it == 'E')) {
+      const char *exponent_it = it + 1;
+      const bool negative_exponent = (*exponent_it == '-');
+      if ((*exponent_it == '-') || (*exponent_it == '+')) {
+        ++exponent_it;
+      }
+      if (IsDigit(*exponent_it)) {
+        int value = 0;
+        for (; IsDigit(*exponent_it); ++exponent_it) {
+          // Saturate, anything this large goes through the slow path anyway.
+          if (value < 10000) {
+            value = 10 * value + (*exponent_it - '0');
+          }
+        }
+        exponent += negative_exponent ? -value : value;
+        it = exponent_it;
+      }
+    }
+
+    if (truncated ||
+        (mantissa > max_exact_mantissa) ||
+        (exponent < -max_exact_exponent) ||
+        (exponent > max_exact_exponent)) {
+      return ParseDoubleWithCLocale(str);
+    }
+    // Both operands are exact, so the single rounding of the product or the
+    // quotient gives the correctly rounded result.
+    double value = static_cast<double>(mantissa);
+    if (exponent < 0) {
+      value /= POWERS_OF_TEN[-exponent];
+    } else {
+      value *= POWERS_OF_TEN[exponent];
+    }
+    return negative ? -value : value;
+  }
+
+  int ParseInt(const char *str) {
+    if (str == nullptr) {
+      return 0;
+    }
+    while (IsSpace(*str)) {
+      ++str;
+    }
+    const bool negative = (*str == '-');
+    if ((*str == '-') || (*str == '+')) {
+      ++str;
+    }
+    constexpr int64_t limit = std::numeric_limits<int>::max();
+    int64_t value = 0;
+    for (; IsDigit(*str); ++str) {
+      if (value <= limit) {
+        value = 10 * value + (*str - '0');
+      }
+    }
+    if (negative) {
+      value = -value;
+    }
+    if (value > limit) {
+      return std::numeric_limits<int>::max();
+    }
+    if (value < std::numeric_limits<int>::min()) {
+      return std::numeric_limits<int>::min();
+    }
+    return static_cast<int>(value);
+  }
+
+} // namespace parser
+} // namespace opendrive
+} // namespace carla
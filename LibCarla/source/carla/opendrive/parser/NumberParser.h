@@ -0,0 +1,27 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+namespace carla {
+namespace opendrive {
+namespace parser {
+
+  /// Parse the number at the beginning of @a str in the "C" locale regardless
+  /// of the global locale, ignoring leading whitespace and anything after the
+  /// number. Return 0.0 if @a str does not start with a number.
+  ///
+  /// Numbers with up to 15 significant digits and a small exponent are
+  /// converted with a single floating point operation, the rest with the
+  /// C library; the result is always the closest double to the decimal value.
+  double ParseDouble(const char *str);
+
+  /// Like std::atoi, but independent of the global locale.
+  int ParseInt(const char *str);
+
+} // namespace parser
+} // namespace opendrive
+} // namespace carla
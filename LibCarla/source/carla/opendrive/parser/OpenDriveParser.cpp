@@ -19,11 +19,37 @@
 
 #include "./pugixml/pugixml.hpp"
 
+#include "carla/ThreadGroup.h"
+#include "carla/opendrive/parser/NumberParser.h"
+
+#include <algorithm>
+#include <atomic>
+
+static void ParseRoad(
+    const pugi::xml_node &road,
+    carla::opendrive::types::RoadInformation &out_road) {
+  namespace odp = carla::opendrive::parser;
+
+  out_road.attributes.name = road.attribute("name").value();
+  out_road.attributes.id = odp::ParseInt(road.attribute("id").value());
+  out_road.attributes.length = odp::ParseDouble(road.attribute("length").value());
+  out_road.attributes.junction = odp::ParseInt(road.attribute("junction").value());
+
+  odp::ProfilesParser::Parse(road, out_road.road_profiles);
+
+  odp::RoadLinkParser::Parse(road.child("link"), out_road.road_link);
+  odp::TrafficSignalsParser::Parse(road.child("signals"), out_road.trafic_signals);
+
+  odp::LaneParser::Parse(road.child("lanes"), out_road.lanes);
+  odp::GeometryParser::Parse(road.child("planView"), out_road.geometry_attributes);
+}
+
 bool OpenDriveParser::Parse(
     const char *xml,
     carla::opendrive::types::OpenDriveData &out_open_drive_data,
     XmlInputType inputType,
-    std::string *out_error) {
+    std::string *out_error,
+    size_t number_of_threads) {
   namespace odp = carla::opendrive::parser;
 
   pugi::xml_document xmlDoc;
@@ -52,29 +78,36 @@ bool OpenDriveParser::Parse(
     return false;
   }
 
+  // Roads are independent of each other, parse them in parallel once the
+  // document is loaded. Each road is stored at the position it has in the
+  // document, so the result does not depend on the number of threads.
+  std::vector<pugi::xml_node> road_nodes;
   for (pugi::xml_node road = xmlDoc.child("OpenDRIVE").child("road");
       road;
       road = road.next_sibling("road")) {
-    carla::opendrive::types::RoadInformation openDriveRoadInformation;
-
-    openDriveRoadInformation.attributes.name = road.attribute("name").value();
-    openDriveRoadInformation.attributes.id = std::atoi(road.attribute("id").value());
-    openDriveRoadInformation.attributes.length = std::stod(road.attribute("length").value());
-    openDriveRoadInformation.attributes.junction = std::atoi(road.attribute("junction").value());
-
-    ///////////////////////////////////////////////////////////////////////////////
-
-    odp::ProfilesParser::Parse(road, openDriveRoadInformation.road_profiles);
-
-    odp::RoadLinkParser::Parse(road.child("link"), openDriveRoadInformation.road_link);
-    odp::TrafficSignalsParser::Parse(road.child("signals"),
-        openDriveRoadInformation.trafic_signals);
-
-    odp::LaneParser::Parse(road.child("lanes"), openDriveRoadInformation.lanes);
-    odp::GeometryParser::Parse(road.child("planView"),
-        openDriveRoadInformation.geometry_attributes);
-
-    out_open_drive_data.roads.emplace_back(std::move(openDriveRoadInformation));
+    road_nodes.emplace_back(road);
+  }
+  auto &roads = out_open_drive_data.roads;
+  const size_t first_road = roads.size();
+  roads.resize(first_road + road_nodes.size());
+  std::atomic_size_t next_road{0u};
+  auto worker = [&]() {
+    for (auto i = next_road++; i < road_nodes.size(); i = next_road++) {
+      ParseRoad(road_nodes[i], roads[first_road + i]);
+    }
+  };
+  // Not worth starting a thread for less than a few roads.
+  constexpr size_t min_roads_per_thread = 16u;
+  if (number_of_threads == 0u) {
+    number_of_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  number_of_threads = std::min(number_of_threads, road_nodes.size() / min_roads_per_thread);
+  if (number_of_threads <= 1u) {
+    worker();
+  } else {
+    carla::ThreadGroup workers;
+    workers.CreateThreads(number_of_threads - 1u, worker);
+    worker();
   }
 
   for (pugi::xml_node junction = xmlDoc.child("OpenDRIVE").child("junction");
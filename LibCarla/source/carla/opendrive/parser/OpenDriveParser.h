@@ -14,9 +14,13 @@ enum class XmlInputType : int {
 };
 
 struct OpenDriveParser {
+  /// Parse the OpenDRIVE @a xml into @a out_open_drive_data. Roads are parsed
+  /// by @a number_of_threads threads, 0 to use one per hardware thread; the
+  /// result is the same for any number of threads.
   static bool Parse(
       const char *xml,
       carla::opendrive::types::OpenDriveData &out_open_drive_data,
       XmlInputType inputType,
-      std::string *out_error = nullptr);
+      std::string *out_error = nullptr,
+      size_t number_of_threads = 0u);
 };
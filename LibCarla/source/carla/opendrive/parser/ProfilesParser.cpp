@@ -5,6 +5,7 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include "ProfilesParser.h"
+#include "NumberParser.h"
 
 void carla::opendrive::parser::ProfilesParser::ParseElevation(
     const pugi::xml_node &xmlNode,
@@ -14,11 +15,11 @@ void carla::opendrive::parser::ProfilesParser::ParseElevation(
       laneSection = laneSection.next_sibling("elevation")) {
     carla::opendrive::types::ElevationProfile elevationProfile;
 
-    elevationProfile.start_position = std::stod(laneSection.attribute("s").value());
-    elevationProfile.elevation = std::stod(laneSection.attribute("a").value());
-    elevationProfile.slope = std::stod(laneSection.attribute("b").value());
-    elevationProfile.vertical_curvature = std::stod(laneSection.attribute("c").value());
-    elevationProfile.curvature_change = std::stod(laneSection.attribute("d").value());
+    elevationProfile.start_position = ParseDouble(laneSection.attribute("s").value());
+    elevationProfile.elevation = ParseDouble(laneSection.attribute("a").value());
+    elevationProfile.slope = ParseDouble(laneSection.attribute("b").value());
+    elevationProfile.vertical_curvature = ParseDouble(laneSection.attribute("c").value());
+    elevationProfile.curvature_change = ParseDouble(laneSection.attribute("d").value());
 
     out_elevation_profile.emplace_back(elevationProfile);
   }
@@ -32,11 +33,11 @@ void carla::opendrive::parser::ProfilesParser::ParseLateral(
       laneSection = laneSection.next_sibling("superelevation")) {
     carla::opendrive::types::LateralProfile lateralProfile;
 
-    lateralProfile.start_position = std::stod(laneSection.attribute("s").value());
-    lateralProfile.elevation = std::stod(laneSection.attribute("a").value());
-    lateralProfile.slope = std::stod(laneSection.attribute("b").value());
-    lateralProfile.vertical_curvature = std::stod(laneSection.attribute("c").value());
-    lateralProfile.curvature_change = std::stod(laneSection.attribute("d").value());
+    lateralProfile.start_position = ParseDouble(laneSection.attribute("s").value());
+    lateralProfile.elevation = ParseDouble(laneSection.attribute("a").value());
+    lateralProfile.slope = ParseDouble(laneSection.attribute("b").value());
+    lateralProfile.vertical_curvature = ParseDouble(laneSection.attribute("c").value());
+    lateralProfile.curvature_change = ParseDouble(laneSection.attribute("d").value());
 
     out_lateral_profile.emplace_back(lateralProfile);
   }
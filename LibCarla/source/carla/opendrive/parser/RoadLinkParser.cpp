@@ -5,13 +5,14 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include "RoadLinkParser.h"
+#include "NumberParser.h"
 
 #include <cstdlib>
 
 void carla::opendrive::parser::RoadLinkParser::ParseLink(
     const pugi::xml_node &xmlNode,
     carla::opendrive::types::RoadLinkInformation *out_link_information) {
-  out_link_information->id = std::atoi(xmlNode.attribute("elementId").value());
+  out_link_information->id = ParseInt(xmlNode.attribute("elementId").value());
   out_link_information->element_type = xmlNode.attribute("elementType").value();
   out_link_information->contact_point = xmlNode.attribute("contactPoint").value();
 }
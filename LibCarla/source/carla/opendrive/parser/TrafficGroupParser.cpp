@@ -5,6 +5,7 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include "TrafficGroupParser.h"
+#include "NumberParser.h"
 #include <iostream>
 
 void carla::opendrive::parser::TrafficGroupParser::Parse(
@@ -13,9 +14,9 @@ void carla::opendrive::parser::TrafficGroupParser::Parse(
   carla::opendrive::parser::TrafficGroupParser parser;
   carla::opendrive::types::TrafficLightGroup traffic_light_group;
 
-  traffic_light_group.red_time = std::atoi(xmlNode.attribute("redTime").value());
-  traffic_light_group.yellow_time = std::atoi(xmlNode.attribute("yellowTime").value());
-  traffic_light_group.green_time = std::atoi(xmlNode.attribute("greenTime").value());
+  traffic_light_group.red_time = ParseInt(xmlNode.attribute("redTime").value());
+  traffic_light_group.yellow_time = ParseInt(xmlNode.attribute("yellowTime").value());
+  traffic_light_group.green_time = ParseInt(xmlNode.attribute("greenTime").value());
 
   parser.ParseTrafficLight(xmlNode, traffic_light_group.traffic_lights);
   out_trafficLights.emplace_back(traffic_light_group);
@@ -30,12 +31,12 @@ void carla::opendrive::parser::TrafficGroupParser::ParseTrafficLight(
       trafficlight = trafficlight.next_sibling("trafficlight")) {
     carla::opendrive::types::TrafficLight jTrafficlight;
 
-    jTrafficlight.x_pos = std::stod(trafficlight.attribute("xPos").value());
-    jTrafficlight.y_pos = std::stod(trafficlight.attribute("yPos").value());
-    jTrafficlight.z_pos = std::stod(trafficlight.attribute("zPos").value());
-    jTrafficlight.x_rot = std::stod(trafficlight.attribute("xRot").value());
-    jTrafficlight.y_rot = std::stod(trafficlight.attribute("yRot").value());
-    jTrafficlight.z_rot = std::stod(trafficlight.attribute("zRot").value());
+    jTrafficlight.x_pos = ParseDouble(trafficlight.attribute("xPos").value());
+    jTrafficlight.y_pos = ParseDouble(trafficlight.attribute("yPos").value());
+    jTrafficlight.z_pos = ParseDouble(trafficlight.attribute("zPos").value());
+    jTrafficlight.x_rot = ParseDouble(trafficlight.attribute("xRot").value());
+    jTrafficlight.y_rot = ParseDouble(trafficlight.attribute("yRot").value());
+    jTrafficlight.z_rot = ParseDouble(trafficlight.attribute("zRot").value());
 
     ParseBoxAreas(trafficlight, jTrafficlight.box_areas);
 
@@ -52,12 +53,12 @@ void carla::opendrive::parser::TrafficGroupParser::ParseBoxAreas(
       boxcomponent = boxcomponent.next_sibling("tfBox")) {
     carla::opendrive::types::BoxComponent jBoxComponent;
 
-    jBoxComponent.x_pos = std::stod(boxcomponent.attribute("xPos").value());
-    jBoxComponent.y_pos = std::stod(boxcomponent.attribute("yPos").value());
-    jBoxComponent.z_pos = std::stod(boxcomponent.attribute("zPos").value());
-    jBoxComponent.x_rot = std::stod(boxcomponent.attribute("xRot").value());
-    jBoxComponent.y_rot = std::stod(boxcomponent.attribute("yRot").value());
-    jBoxComponent.z_rot = std::stod(boxcomponent.attribute("zRot").value());
+    jBoxComponent.x_pos = ParseDouble(boxcomponent.attribute("xPos").value());
+    jBoxComponent.y_pos = ParseDouble(boxcomponent.attribute("yPos").value());
+    jBoxComponent.z_pos = ParseDouble(boxcomponent.attribute("zPos").value());
+    jBoxComponent.x_rot = ParseDouble(boxcomponent.attribute("xRot").value());
+    jBoxComponent.y_rot = ParseDouble(boxcomponent.attribute("yRot").value());
+    jBoxComponent.z_rot = ParseDouble(boxcomponent.attribute("zRot").value());
 
     out_boxcomponent.emplace_back(jBoxComponent);
   }
@@ -5,6 +5,7 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include "TrafficSignParser.h"
+#include "NumberParser.h"
 #include <iostream>
 
 void carla::opendrive::parser::TrafficSignParser::Parse(
@@ -13,13 +14,13 @@ void carla::opendrive::parser::TrafficSignParser::Parse(
   carla::opendrive::parser::TrafficSignParser parser;
   carla::opendrive::types::TrafficSign trafficsign;
 
-  trafficsign.speed = std::atoi(xmlNode.attribute("speed").value());
-  trafficsign.x_pos = std::stod(xmlNode.attribute("xPos").value());
-  trafficsign.y_pos = std::stod(xmlNode.attribute("yPos").value());
-  trafficsign.z_pos = std::stod(xmlNode.attribute("zPos").value());
-  trafficsign.x_rot = std::stod(xmlNode.attribute("xRot").value());
-  trafficsign.y_rot = std::stod(xmlNode.attribute("yRot").value());
-  trafficsign.z_rot = std::stod(xmlNode.attribute("zRot").value());
+  trafficsign.speed = ParseInt(xmlNode.attribute("speed").value());
+  trafficsign.x_pos = ParseDouble(xmlNode.attribute("xPos").value());
+  trafficsign.y_pos = ParseDouble(xmlNode.attribute("yPos").value());
+  trafficsign.z_pos = ParseDouble(xmlNode.attribute("zPos").value());
+  trafficsign.x_rot = ParseDouble(xmlNode.attribute("xRot").value());
+  trafficsign.y_rot = ParseDouble(xmlNode.attribute("yRot").value());
+  trafficsign.z_rot = ParseDouble(xmlNode.attribute("zRot").value());
 
   parser.ParseBoxAreas(xmlNode, trafficsign.box_areas);
   out_trafficsigns.emplace_back(trafficsign);
@@ -33,12 +34,12 @@ void carla::opendrive::parser::TrafficSignParser::ParseBoxAreas(
       boxcomponent = boxcomponent.next_sibling("tsBox")) {
     carla::opendrive::types::BoxComponent jBoxComponent;
 
-    jBoxComponent.x_pos = std::stod(boxcomponent.attribute("xPos").value());
-    jBoxComponent.y_pos = std::stod(boxcomponent.attribute("yPos").value());
-    jBoxComponent.z_pos = std::stod(boxcomponent.attribute("zPos").value());
-    jBoxComponent.x_rot = std::stod(boxcomponent.attribute("xRot").value());
-    jBoxComponent.y_rot = std::stod(boxcomponent.attribute("yRot").value());
-    jBoxComponent.z_rot = std::stod(boxcomponent.attribute("zRot").value());
+    jBoxComponent.x_pos = ParseDouble(boxcomponent.attribute("xPos").value());
+    jBoxComponent.y_pos = ParseDouble(boxcomponent.attribute("yPos").value());
+    jBoxComponent.z_pos = ParseDouble(boxcomponent.attribute("zPos").value());
+    jBoxComponent.x_rot = ParseDouble(boxcomponent.attribute("xRot").value());
+    jBoxComponent.y_rot = ParseDouble(boxcomponent.attribute("yRot").value());
+    jBoxComponent.z_rot = ParseDouble(boxcomponent.attribute("zRot").value());
 
     out_boxcomponent.emplace_back(jBoxComponent);
   }
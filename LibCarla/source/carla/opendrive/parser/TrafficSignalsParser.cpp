@@ -5,6 +5,7 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include "TrafficSignalsParser.h"
+#include "NumberParser.h"
 
 void carla::opendrive::parser::TrafficSignalsParser::Parse(
     const pugi::xml_node &xmlNode,
@@ -12,13 +13,13 @@ void carla::opendrive::parser::TrafficSignalsParser::Parse(
   for (pugi::xml_node signal = xmlNode.child("signal"); signal; signal = signal.next_sibling("signal")) {
     carla::opendrive::types::TrafficSignalInformation trafficSignalInformation;
 
-    trafficSignalInformation.id = std::atoi(signal.attribute("id").value());
+    trafficSignalInformation.id = ParseInt(signal.attribute("id").value());
 
-    trafficSignalInformation.start_position = std::stod(signal.attribute("s").value());
-    trafficSignalInformation.track_position = std::stod(signal.attribute("t").value());
+    trafficSignalInformation.start_position = ParseDouble(signal.attribute("s").value());
+    trafficSignalInformation.track_position = ParseDouble(signal.attribute("t").value());
 
-    trafficSignalInformation.zoffset = std::stod(signal.attribute("zOffset").value());
-    trafficSignalInformation.value = std::stod(signal.attribute("value").value());
+    trafficSignalInformation.zoffset = ParseDouble(signal.attribute("zOffset").value());
+    trafficSignalInformation.value = ParseDouble(signal.attribute("value").value());
 
     trafficSignalInformation.name = signal.attribute("name").value();
     trafficSignalInformation.dynamic = signal.attribute("dynamic").value();
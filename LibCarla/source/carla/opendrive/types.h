@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/geom/GeoLocation.h"
+#include "carla/road/element/LaneType.h"
 
 #include <memory>
 #include <string>
@@ -51,7 +52,7 @@ namespace types {
 
   struct LaneAttributes {
     int id;
-    std::string type;
+    road::element::LaneType type;
     std::string level;
   };
 
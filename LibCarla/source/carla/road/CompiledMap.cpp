@@ -0,0 +1,681 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/road/CompiledMap.h"
+
+#include "carla/road/Map.h"
+#include "carla/road/MapBuilder.h"
+#include "carla/road/element/RoadInfoVisitor.h"
+
+#include <boost/uuid/detail/sha1.hpp>
+
+#include <array>
+#include <cstring>
+#include <type_traits>
+#include <unordered_set>
+
+namespace carla {
+namespace road {
+
+  using namespace carla::road::element;
+  using namespace carla::opendrive::types;
+
+  // ===========================================================================
+  // -- Static local methods ---------------------------------------------------
+  // ===========================================================================
+
+  static constexpr char MAGIC[8u] = {'C', 'A', 'R', 'L', 'A', 'M', 'A', 'P'};
+
+  /// Written in native byte order, read back differently if the byte order
+  /// of the reader does not match.
+  static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304u;
+
+  /// Tag identifying the type of each road information.
+  enum class InfoTag : uint8_t {
+    Lane,
+    General,
+    Velocity,
+    Elevation,
+    LaneWidth,
+    MarkRecord,
+    LaneOffset
+  };
+
+  namespace {
+
+    class BlobWriter {
+    public:
+
+      template <typename T>
+      void Write(const T &value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Type not serializable.");
+        const auto *bytes = reinterpret_cast<const unsigned char *>(&value);
+        _data.insert(_data.end(), bytes, bytes + sizeof(T));
+      }
+
+      void WriteString(const std::string &str) {
+        Write(static_cast<uint32_t>(str.size()));
+        _data.insert(_data.end(), str.begin(), str.end());
+      }
+
+      /// Write the size of @a container followed by each of its elements
+      /// written with @a func.
+      template <typename ContainerT, typename FuncT>
+      void WriteSequence(const ContainerT &container, FuncT &&func) {
+        Write(static_cast<uint32_t>(container.size()));
+        for (auto &&item : container) {
+          func(item);
+        }
+      }
+
+      template <typename T>
+      void WriteValues(const std::vector<T> &values) {
+        WriteSequence(values, [this](const T &value) { Write(value); });
+      }
+
+      std::vector<unsigned char> Pop() {
+        return std::move(_data);
+      }
+
+    private:
+
+      std::vector<unsigned char> _data;
+    };
+
+    /// Reads the values written by BlobWriter. Reading past the end of the
+    /// data does not fail immediately, it sets the failed flag and returns
+    /// default values so the caller can check once at the end.
+    class BlobReader {
+    public:
+
+      BlobReader(const unsigned char *data, size_t size)
+        : _data(data),
+          _size(size) {}
+
+      template <typename T>
+      T Read() {
+        static_assert(std::is_trivially_copyable<T>::value, "Type not serializable.");
+        T value{};
+        if (Consume(sizeof(T))) {
+          std::memcpy(&value, _data + _position - sizeof(T), sizeof(T));
+        }
+        return value;
+      }
+
+      std::string ReadString() {
+        const auto size = Read<uint32_t>();
+        return Consume(size) ?
+            std::string(reinterpret_cast<const char *>(_data + _position - size), size) :
+            std::string();
+      }
+
+      /// Read the size of a sequence whose elements take at least
+      /// @a min_element_size bytes each, fails if the remaining data is not
+      /// enough to hold it.
+      uint32_t ReadCount(size_t min_element_size) {
+        const auto count = Read<uint32_t>();
+        if (static_cast<uint64_t>(count) * min_element_size > _size - _position) {
+          _failed = true;
+          return 0u;
+        }
+        return count;
+      }
+
+      template <typename T>
+      std::vector<T> ReadValues() {
+        std::vector<T> result(ReadCount(sizeof(T)));
+        for (auto &&value : result) {
+          value = Read<T>();
+        }
+        return result;
+      }
+
+      bool failed() const {
+        return _failed;
+      }
+
+      bool AtEnd() const {
+        return _position == _size;
+      }
+
+    private:
+
+      bool Consume(size_t size) {
+        if (_failed || (size > _size - _position)) {
+          _failed = true;
+          return false;
+        }
+        _position += size;
+        return true;
+      }
+
+      const unsigned char *_data;
+
+      size_t _size;
+
+      size_t _position = 0u;
+
+      bool _failed = false;
+    };
+
+  } // namespace
+
+  // ===========================================================================
+  // -- Write ------------------------------------------------------------------
+  // ===========================================================================
+
+  static void WriteLaneLinks(
+      BlobWriter &out,
+      const std::map<int, std::vector<std::pair<int, int>>> &lane_links) {
+    out.WriteSequence(lane_links, [&](const auto &item) {
+      out.Write(static_cast<int32_t>(item.first));
+      out.WriteSequence(item.second, [&](const std::pair<int, int> &link) {
+        out.Write(static_cast<int32_t>(link.first));
+        out.Write(static_cast<int32_t>(link.second));
+      });
+    });
+  }
+
+  static void WriteRoadLinks(
+      BlobWriter &out,
+      const std::vector<id_type> &ids,
+      const std::vector<bool> &is_start) {
+    out.Write(static_cast<uint32_t>(ids.size()));
+    for (auto i = 0u; i < ids.size(); ++i) {
+      out.Write(static_cast<uint64_t>(ids[i]));
+      out.Write(static_cast<uint8_t>(i < is_start.size() ? is_start[i] : true));
+    }
+  }
+
+  static void WriteGeometry(BlobWriter &out, const Geometry &geometry) {
+    out.Write(static_cast<uint8_t>(geometry.GetType()));
+    out.Write(geometry.GetStartOffset());
+    out.Write(geometry.GetLength());
+    out.Write(geometry.GetHeading());
+    out.Write(geometry.GetStartPosition());
+    switch (geometry.GetType()) {
+      case GeometryType::LINE:
+        break;
+      case GeometryType::ARC:
+        out.Write(static_cast<const GeometryArc &>(geometry).GetCurvature());
+        break;
+      case GeometryType::SPIRAL: {
+        const auto &spiral = static_cast<const GeometrySpiral &>(geometry);
+        out.Write(spiral.GetCurveStart());
+        out.Write(spiral.GetCurveEnd());
+      } break;
+    }
+  }
+
+  static void WritePolynomial(BlobWriter &out, const geom::CubicPolynomial &polynomial) {
+    out.Write(polynomial.GetA());
+    out.Write(polynomial.GetB());
+    out.Write(polynomial.GetC());
+    out.Write(polynomial.GetD());
+  }
+
+  namespace {
+
+    /// Write each road information preceded by its tag and distance.
+    class InfoWriter : public RoadInfoVisitor {
+    public:
+
+      explicit InfoWriter(BlobWriter &out) : _out(out) {}
+
+      void Visit(RoadInfoLane &info) final {
+        Begin(InfoTag::Lane, info);
+        const auto ids = info.getLanesIDs();
+        _out.WriteSequence(ids, [&](int id) {
+          const auto &lane = *info.getLane(id);
+          _out.Write(static_cast<int32_t>(lane._id));
+          _out.Write(lane._width);
+          _out.Write(static_cast<uint32_t>(lane._type));
+          _out.WriteValues(lane._successor);
+          _out.WriteValues(lane._predecessor);
+        });
+      }
+
+      void Visit(RoadGeneralInfo &info) final {
+        Begin(InfoTag::General, info);
+        _out.Write(static_cast<int32_t>(info.GetJunctionId()));
+        _out.WriteSequence(info.GetLanesOffset(), [this](const std::pair<double, double> &offset) {
+          _out.Write(offset.first);
+          _out.Write(offset.second);
+        });
+      }
+
+      void Visit(RoadInfoVelocity &info) final {
+        Begin(InfoTag::Velocity, info);
+        _out.Write(info.velocity);
+      }
+
+      void Visit(RoadElevationInfo &info) final {
+        Begin(InfoTag::Elevation, info);
+        _out.Write(info.GetStartPosition());
+        _out.Write(info.GetElevation());
+        _out.Write(info.GetSlope());
+        _out.Write(info.GetVerticalCurvature());
+        _out.Write(info.GetCurvatureChange());
+      }
+
+      void Visit(RoadInfoLaneWidth &info) final {
+        Begin(InfoTag::LaneWidth, info);
+        _out.Write(static_cast<int32_t>(info.GetLaneId()));
+        WritePolynomial(_out, info.GetPolynomial());
+      }
+
+      void Visit(RoadInfoMarkRecord &info) final {
+        Begin(InfoTag::MarkRecord, info);
+        _out.Write(static_cast<int32_t>(info.GetLaneId()));
+        _out.WriteString(info.GetType());
+        _out.WriteString(info.GetWeight());
+        _out.WriteString(info.GetColor());
+        _out.WriteString(info.GetMaterial());
+        _out.Write(info.GetWidth());
+        _out.Write(static_cast<uint8_t>(info.GetLaneChange()));
+        _out.Write(info.GetHeight());
+      }
+
+      void Visit(RoadInfoLaneOffset &info) final {
+        Begin(InfoTag::LaneOffset, info);
+        WritePolynomial(_out, info.GetPolynomial());
+      }
+
+    private:
+
+      void Begin(InfoTag tag, const RoadInfo &info) {
+        _out.Write(tag);
+        _out.Write(info.d);
+      }
+
+      BlobWriter &_out;
+    };
+
+  } // namespace
+
+  static void WriteBoxComponent(BlobWriter &out, const BoxComponent &box) {
+    out.Write(box.pos);
+    out.Write(box.rot);
+    out.Write(box.scale);
+  }
+
+  CompiledMap::Source CompiledMap::MakeSource(const std::string &open_drive) {
+    boost::uuids::detail::sha1 sha1;
+    sha1.process_bytes(open_drive.data(), open_drive.size());
+    boost::uuids::detail::sha1::digest_type words;
+    sha1.get_digest(words);
+    Source source;
+    source.size = open_drive.size();
+    // The digest as the usual big-endian sequence of bytes.
+    for (auto i = 0u; i < source.digest.size(); ++i) {
+      source.digest[i] = static_cast<uint8_t>(words[i / 4u] >> (24u - 8u * (i % 4u)));
+    }
+    return source;
+  }
+
+  std::vector<unsigned char> CompiledMap::Write(const Map &map, const Source &source) {
+    const auto &data = map.GetData();
+    BlobWriter out;
+    out.Write(MAGIC);
+    out.Write(version());
+    out.Write(BYTE_ORDER_MARK);
+    out.Write(source.size);
+    out.Write(source.digest);
+
+    const auto &geo_reference = data.GetGeoReference();
+    out.Write(geo_reference.latitude);
+    out.Write(geo_reference.longitude);
+    out.Write(geo_reference.altitude);
+
+    out.Write(static_cast<uint32_t>(data.GetRoadCount()));
+    for (auto &&road : data.GetRoadSegments()) {
+      out.Write(static_cast<uint64_t>(road.GetId()));
+      WriteRoadLinks(out, road.GetSuccessorsIds(), road.GetSuccessorsIsSTart());
+      WriteRoadLinks(out, road.GetPredecessorsIds(), road.GetPredecessorsIsStart());
+      WriteLaneLinks(out, road.GetNextLanes());
+      WriteLaneLinks(out, road.GetPrevLanes());
+      out.WriteSequence(road.GetGeometries(), [&](const Geometry *geometry) {
+        WriteGeometry(out, *geometry);
+      });
+      uint32_t number_of_infos = 0u;
+      road.ForEachInfo([&](const RoadInfo &) { ++number_of_infos; });
+      out.Write(number_of_infos);
+      InfoWriter info_writer(out);
+      road.ForEachInfo([&](RoadInfo &info) { info.AcceptVisitor(info_writer); });
+    }
+
+    out.WriteSequence(data.GetJunctionInformation(), [&](const lane_junction_t &junction) {
+      out.WriteString(junction.contact_point);
+      out.Write(static_cast<int32_t>(junction.junction_id));
+      out.Write(static_cast<int32_t>(junction.connection_road));
+      out.Write(static_cast<int32_t>(junction.incomming_road));
+      out.WriteValues(junction.from_lane);
+      out.WriteValues(junction.to_lane);
+    });
+
+    out.WriteSequence(data.GetTrafficGroups(), [&](const TrafficLightGroup &group) {
+      out.WriteSequence(group.traffic_lights, [&](const TrafficLight &light) {
+        out.Write(light.pos);
+        out.Write(light.rot);
+        out.Write(light.scale);
+        out.WriteSequence(light.box_areas, [&](const BoxComponent &box) {
+          WriteBoxComponent(out, box);
+        });
+      });
+      out.Write(group.red_time);
+      out.Write(group.yellow_time);
+      out.Write(group.green_time);
+    });
+
+    out.WriteSequence(data.GetTrafficSigns(), [&](const TrafficSign &sign) {
+      out.Write(sign.pos);
+      out.Write(sign.rot);
+      out.Write(sign.scale);
+      out.Write(static_cast<int32_t>(sign.speed));
+      out.WriteSequence(sign.box_areas, [&](const BoxComponent &box) {
+        WriteBoxComponent(out, box);
+      });
+    });
+
+    return out.Pop();
+  }
+
+  // ===========================================================================
+  // -- Read -------------------------------------------------------------------
+  // ===========================================================================
+
+  static void ReadRoadLinks(BlobReader &in, RoadSegmentDefinition &def, bool successors) {
+    const auto count = in.ReadCount(sizeof(uint64_t) + sizeof(uint8_t));
+    for (auto i = 0u; i < count; ++i) {
+      const auto id = static_cast<id_type>(in.Read<uint64_t>());
+      const bool is_start = in.Read<uint8_t>() != 0u;
+      if (successors) {
+        def.AddSuccessorID(id, is_start);
+      } else {
+        def.AddPredecessorID(id, is_start);
+      }
+    }
+  }
+
+  /// Whether @a value is one of the values of LaneType. A lane has a single
+  /// type, combinations are only used as masks.
+  static bool IsValidLaneType(uint32_t value) {
+    return
+        ((value & (value - 1u)) == 0u) &&
+        (value <= static_cast<uint32_t>(LaneType::OnRamp));
+  }
+
+  static bool IsValidLaneChange(uint8_t value) {
+    return value <= static_cast<uint8_t>(RoadInfoMarkRecord::LaneChange::Both);
+  }
+
+  /// Reads the lane links of a road, collecting the roads they point to in
+  /// @a linked_roads. Returns false if a link points to lane 0.
+  static bool ReadLaneLinks(
+      BlobReader &in,
+      RoadSegmentDefinition &def,
+      bool next,
+      std::vector<id_type> &linked_roads) {
+    const auto number_of_lanes = in.ReadCount(2u * sizeof(uint32_t));
+    for (auto i = 0u; i < number_of_lanes; ++i) {
+      const auto lane_id = in.Read<int32_t>();
+      const auto number_of_links = in.ReadCount(2u * sizeof(int32_t));
+      for (auto j = 0u; j < number_of_links; ++j) {
+        const auto next_lane_id = in.Read<int32_t>();
+        const auto next_road_id = in.Read<int32_t>();
+        if (next_lane_id == 0) {
+          return false;
+        }
+        linked_roads.emplace_back(static_cast<id_type>(next_road_id));
+        if (next) {
+          def.AddNextLaneInfo(lane_id, next_lane_id, next_road_id);
+        } else {
+          def.AddPrevLaneInfo(lane_id, next_lane_id, next_road_id);
+        }
+      }
+    }
+    return true;
+  }
+
+  static bool ReadGeometry(BlobReader &in, RoadSegmentDefinition &def) {
+    const auto type = static_cast<GeometryType>(in.Read<uint8_t>());
+    const auto start_offset = in.Read<double>();
+    const auto length = in.Read<double>();
+    const auto heading = in.Read<double>();
+    const auto start_position = in.Read<geom::Location>();
+    switch (type) {
+      case GeometryType::LINE:
+        def.MakeGeometry<GeometryLine>(start_offset, length, heading, start_position);
+        return true;
+      case GeometryType::ARC: {
+        const auto curvature = in.Read<double>();
+        def.MakeGeometry<GeometryArc>(start_offset, length, heading, start_position, curvature);
+      } return true;
+      case GeometryType::SPIRAL: {
+        const auto curve_start = in.Read<double>();
+        const auto curve_end = in.Read<double>();
+        def.MakeGeometry<GeometrySpiral>(start_offset, length, heading, start_position, curve_start, curve_end);
+      } return true;
+    }
+    return false;
+  }
+
+  static geom::CubicPolynomial ReadPolynomial(BlobReader &in) {
+    const auto a = in.Read<double>();
+    const auto b = in.Read<double>();
+    const auto c = in.Read<double>();
+    const auto d = in.Read<double>();
+    return {a, b, c, d};
+  }
+
+  static BoxComponent ReadBoxComponent(BlobReader &in) {
+    BoxComponent box;
+    std::memcpy(box.pos, in.Read<std::array<double, 3u>>().data(), sizeof(box.pos));
+    std::memcpy(box.rot, in.Read<std::array<double, 3u>>().data(), sizeof(box.rot));
+    box.scale = in.Read<double>();
+    return box;
+  }
+
+  SharedPtr<Map> CompiledMap::Read(
+      const unsigned char *data,
+      const size_t size,
+      std::string *out_error,
+      const Source *source) {
+    auto fail = [out_error](const char *message) -> SharedPtr<Map> {
+      if (out_error != nullptr) {
+        *out_error = message;
+      }
+      return nullptr;
+    };
+
+    BlobReader in(data, size);
+    const auto magic = in.Read<std::array<char, sizeof(MAGIC)>>();
+    if (in.failed() || (std::memcmp(magic.data(), MAGIC, sizeof(MAGIC)) != 0)) {
+      return fail("not a compiled map");
+    }
+    if (in.Read<uint32_t>() != version()) {
+      return fail("compiled map version mismatch");
+    }
+    if (in.Read<uint32_t>() != BYTE_ORDER_MARK) {
+      return fail("compiled map byte order mismatch");
+    }
+    Source blob_source;
+    blob_source.size = in.Read<uint64_t>();
+    blob_source.digest = in.Read<decltype(blob_source.digest)>();
+    if (in.failed()) {
+      return fail("truncated or corrupted compiled map");
+    }
+    if ((source != nullptr) && (*source != blob_source)) {
+      return fail("compiled map built from a different OpenDRIVE");
+    }
+
+    MapBuilder builder;
+
+    const auto latitude = in.Read<double>();
+    const auto longitude = in.Read<double>();
+    const auto altitude = in.Read<double>();
+    builder.SetGeoReference({latitude, longitude, altitude});
+
+    std::unordered_set<id_type> road_ids;
+    std::vector<id_type> linked_roads;
+    const auto number_of_roads = in.ReadCount(sizeof(uint64_t));
+    for (auto i = 0u; (i < number_of_roads) && !in.failed(); ++i) {
+      RoadSegmentDefinition def(static_cast<id_type>(in.Read<uint64_t>()), &builder.GetArena());
+      road_ids.emplace(def.GetId());
+      ReadRoadLinks(in, def, true);
+      ReadRoadLinks(in, def, false);
+      if (!ReadLaneLinks(in, def, true, linked_roads) ||
+          !ReadLaneLinks(in, def, false, linked_roads)) {
+        return fail("invalid lane link in compiled map");
+      }
+      const auto number_of_geometries = in.ReadCount(sizeof(uint8_t));
+      for (auto j = 0u; (j < number_of_geometries) && !in.failed(); ++j) {
+        if (!ReadGeometry(in, def)) {
+          return fail("invalid geometry in compiled map");
+        }
+      }
+      const auto number_of_infos = in.ReadCount(sizeof(uint8_t) + sizeof(double));
+      for (auto j = 0u; (j < number_of_infos) && !in.failed(); ++j) {
+        const auto tag = in.Read<InfoTag>();
+        const auto d = in.Read<double>();
+        switch (tag) {
+          case InfoTag::Lane: {
+            auto *info = def.MakeInfo<RoadInfoLane>();
+            info->d = d;
+            const auto number_of_lanes = in.ReadCount(sizeof(int32_t));
+            for (auto k = 0u; k < number_of_lanes; ++k) {
+              const auto id = in.Read<int32_t>();
+              const auto width = in.Read<double>();
+              const auto type = in.Read<uint32_t>();
+              if (!IsValidLaneType(type)) {
+                return fail("invalid lane type in compiled map");
+              }
+              info->addLaneInfo(id, width, static_cast<LaneType>(type));
+              auto *lane = info->getMutableLane(id);
+              lane->_successor = in.ReadValues<int>();
+              lane->_predecessor = in.ReadValues<int>();
+            }
+          } break;
+          case InfoTag::General: {
+            auto *info = def.MakeInfo<RoadGeneralInfo>();
+            info->d = d;
+            info->SetJunctionId(in.Read<int32_t>());
+            const auto number_of_offsets = in.ReadCount(2u * sizeof(double));
+            for (auto k = 0u; k < number_of_offsets; ++k) {
+              const auto start_position = in.Read<double>();
+              const auto lateral_offset = in.Read<double>();
+              info->SetLanesOffset(start_position, lateral_offset);
+            }
+          } break;
+          case InfoTag::Velocity:
+            def.MakeInfo<RoadInfoVelocity>(d, in.Read<double>());
+            break;
+          case InfoTag::Elevation: {
+            const auto start_position = in.Read<double>();
+            const auto elevation = in.Read<double>();
+            const auto slope = in.Read<double>();
+            const auto vertical_curvature = in.Read<double>();
+            const auto curvature_change = in.Read<double>();
+            def.MakeInfo<RoadElevationInfo>(
+                d,
+                start_position,
+                elevation,
+                slope,
+                vertical_curvature,
+                curvature_change);
+          } break;
+          case InfoTag::LaneWidth: {
+            const auto lane_id = in.Read<int32_t>();
+            def.MakeInfo<RoadInfoLaneWidth>(d, lane_id, ReadPolynomial(in));
+          } break;
+          case InfoTag::MarkRecord: {
+            const auto lane_id = in.Read<int32_t>();
+            auto type = in.ReadString();
+            auto weight = in.ReadString();
+            auto color = in.ReadString();
+            auto material = in.ReadString();
+            const auto width = in.Read<double>();
+            const auto lane_change = in.Read<uint8_t>();
+            const auto height = in.Read<double>();
+            if (!IsValidLaneChange(lane_change)) {
+              return fail("invalid lane change in compiled map");
+            }
+            def.MakeInfo<RoadInfoMarkRecord>(
+                d,
+                lane_id,
+                std::move(type),
+                std::move(weight),
+                std::move(color),
+                std::move(material),
+                width,
+                static_cast<RoadInfoMarkRecord::LaneChange>(lane_change),
+                height);
+          } break;
+          case InfoTag::LaneOffset:
+            def.MakeInfo<RoadInfoLaneOffset>(d, ReadPolynomial(in));
+            break;
+          default:
+            return fail("invalid road information in compiled map");
+        }
+      }
+      builder.AddRoadSegmentDefinition(def);
+    }
+
+    std::vector<lane_junction_t> junctions(in.ReadCount(sizeof(uint32_t)));
+    for (auto &&junction : junctions) {
+      junction.contact_point = in.ReadString();
+      junction.junction_id = in.Read<int32_t>();
+      junction.connection_road = in.Read<int32_t>();
+      junction.incomming_road = in.Read<int32_t>();
+      junction.from_lane = in.ReadValues<int>();
+      junction.to_lane = in.ReadValues<int>();
+    }
+    builder.SetJunctionInformation(junctions);
+
+    std::vector<TrafficLightGroup> groups(in.ReadCount(sizeof(uint32_t)));
+    for (auto &&group : groups) {
+      group.traffic_lights.resize(in.ReadCount(sizeof(TrafficLight::pos)));
+      for (auto &&light : group.traffic_lights) {
+        std::memcpy(light.pos, in.Read<std::array<double, 3u>>().data(), sizeof(light.pos));
+        std::memcpy(light.rot, in.Read<std::array<double, 3u>>().data(), sizeof(light.rot));
+        light.scale = in.Read<double>();
+        light.box_areas.resize(in.ReadCount(sizeof(BoxComponent::pos)));
+        for (auto &&box : light.box_areas) {
+          box = ReadBoxComponent(in);
+        }
+      }
+      group.red_time = in.Read<double>();
+      group.yellow_time = in.Read<double>();
+      group.green_time = in.Read<double>();
+    }
+    builder.SetTrafficGroupData(groups);
+
+    std::vector<TrafficSign> signs(in.ReadCount(sizeof(TrafficSign::pos)));
+    for (auto &&sign : signs) {
+      std::memcpy(sign.pos, in.Read<std::array<double, 3u>>().data(), sizeof(sign.pos));
+      std::memcpy(sign.rot, in.Read<std::array<double, 3u>>().data(), sizeof(sign.rot));
+      sign.scale = in.Read<double>();
+      sign.speed = in.Read<int32_t>();
+      sign.box_areas.resize(in.ReadCount(sizeof(BoxComponent::pos)));
+      for (auto &&box : sign.box_areas) {
+        box = ReadBoxComponent(in);
+      }
+    }
+    builder.SetTrafficSignData(signs);
+
+    if (in.failed() || !in.AtEnd()) {
+      return fail("truncated or corrupted compiled map");
+    }
+    for (auto id : linked_roads) {
+      if (road_ids.find(id) == road_ids.end()) {
+        return fail("lane link to a missing road in compiled map");
+      }
+    }
+    return builder.Build();
+  }
+
+} // namespace road
+} // namespace carla
@@ -0,0 +1,80 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Memory.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace carla {
+namespace road {
+
+  class Map;
+
+  /// Versioned binary serialization of the data of a built road::Map: roads,
+  /// geometries, road and lane information, lane links, junctions, traffic
+  /// lights, traffic signs and geo-reference.
+  ///
+  /// Values are stored in native byte order as they are in memory, reading a
+  /// compiled map is just copying them back and running MapBuilder; no text
+  /// is parsed. A blob is only readable by a build with the same format
+  /// version and byte order, Read rejects any other.
+  ///
+  /// The header also identifies the OpenDRIVE the map was compiled from, so
+  /// a blob found on disk can be checked against the OpenDRIVE it is supposed
+  /// to replace.
+  class CompiledMap {
+  public:
+
+    /// Version of the format, to be increased on every change of the layout.
+    static constexpr uint32_t version() {
+      return 2u;
+    }
+
+    /// Size and SHA-1 digest of an OpenDRIVE. A default-constructed Source
+    /// stands for an unknown OpenDRIVE.
+    struct Source {
+      uint64_t size = 0u;
+      std::array<uint8_t, 20u> digest = {};
+
+      bool operator==(const Source &rhs) const {
+        return (size == rhs.size) && (digest == rhs.digest);
+      }
+
+      bool operator!=(const Source &rhs) const {
+        return !(*this == rhs);
+      }
+    };
+
+    static Source MakeSource(const std::string &open_drive);
+
+    static std::vector<unsigned char> Write(const Map &map, const Source &source);
+
+    static std::vector<unsigned char> Write(const Map &map) {
+      return Write(map, Source{});
+    }
+
+    /// Build the map stored in @a data. If @a source is provided, the map
+    /// must have been compiled from that OpenDRIVE.
+    ///
+    /// The data is validated before building the map, a corrupted blob is
+    /// rejected instead of producing an inconsistent map.
+    ///
+    /// @return nullptr if @a data is not a valid compiled map of this version,
+    /// with the reason in @a out_error if provided.
+    static SharedPtr<Map> Read(
+        const unsigned char *data,
+        size_t size,
+        std::string *out_error = nullptr,
+        const Source *source = nullptr);
+  };
+
+} // namespace road
+} // namespace carla
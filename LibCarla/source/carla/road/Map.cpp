@@ -6,8 +6,13 @@
 
 #include "carla/road/Map.h"
 
+#include "carla/geom/CubicPolynomial.h"
+#include "carla/geom/Math.h"
 #include "carla/road/element/LaneCrossingCalculator.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace carla {
 namespace road {
 
@@ -19,22 +24,202 @@ namespace road {
 
   boost::optional<Waypoint> Map::GetWaypoint(const geom::Location &loc) const {
     Waypoint w = Waypoint(shared_from_this(), loc);
-    auto d = geom::Math::Distance2D(w.ComputeTransform().location, loc);
-    const auto inf = _data.GetRoad(w._road_id)->GetInfo<RoadInfoLane>(w._dist);
-
-    if (d < inf->getLane(w._lane_id)->_width * 0.5) {
+    if (IsInsideLane(w.GetHandle(), loc)) {
       return w;
     }
 
     return {};
   }
 
+  bool Map::IsInsideLane(const WaypointHandle &waypoint, const geom::Location &loc) const {
+    auto d = geom::Math::Distance2D(ComputeTransform(waypoint).location, loc);
+    const auto inf = _data.GetRoad(waypoint.road_id)->GetInfo<RoadInfoLane>(waypoint.s);
+    return d < inf->getLane(waypoint.lane_id)->_width * 0.5;
+  }
+
+  Waypoint Map::TrackWaypoint(
+      const Waypoint &previous,
+      const geom::Location &loc) const {
+    WaypointHandle handle;
+    if (TrackHandle(previous.GetHandle(), loc, handle)) {
+      return Waypoint(shared_from_this(), handle.road_id, handle.lane_id, handle.s);
+    }
+    return Waypoint(shared_from_this(), loc);
+  }
+
+  WaypointHandle Map::TrackWaypoint(
+      const WaypointHandle &previous,
+      const geom::Location &loc) const {
+    WaypointHandle handle;
+    if (TrackHandle(previous, loc, handle)) {
+      return handle;
+    }
+    return Waypoint(shared_from_this(), loc).GetHandle();
+  }
+
+  std::vector<Waypoint> Map::TrackWaypoints(
+      const std::vector<Waypoint> &previous,
+      const std::vector<geom::Location> &locations) const {
+    DEBUG_ASSERT(previous.size() == locations.size());
+    const auto self = shared_from_this();
+    std::vector<Waypoint> result;
+    result.reserve(locations.size());
+    WaypointHandle handle;
+    for (auto i = 0u; i < locations.size(); ++i) {
+      if (TrackHandle(previous[i].GetHandle(), locations[i], handle)) {
+        result.emplace_back(Waypoint(self, handle.road_id, handle.lane_id, handle.s));
+      } else {
+        result.emplace_back(Waypoint(self, locations[i]));
+      }
+    }
+    return result;
+  }
+
+  boost::optional<WaypointHandle> Map::GetWaypointInsideLane(
+      const id_type road_id,
+      const geom::Location &loc) const {
+    const auto *road = _data.GetRoad(road_id);
+    if (road == nullptr) {
+      return {};
+    }
+    const auto nearest = road->GetNearestPoint(loc);
+    if ((nearest.first <= 0.0) || (nearest.first >= road->GetLength())) {
+      return {};
+    }
+    const auto lane_dist = road->GetNearestLane(nearest.first, loc);
+    const auto info = road->GetInfo<RoadInfoLane>(0.0);
+    if ((lane_dist.first == 0) || (info == nullptr) ||
+        !(lane_dist.second < info->getLane(lane_dist.first)->_width * 0.5)) {
+      return {};
+    }
+    return WaypointHandle{road_id, lane_dist.first, nearest.first};
+  }
+
+  bool Map::TrackHandle(
+      const WaypointHandle &previous,
+      const geom::Location &loc,
+      WaypointHandle &out_handle) const {
+    const auto *previous_road = _data.GetRoad(previous.road_id);
+    if (previous_road == nullptr) {
+      return false;
+    }
+
+    // The road of the previous waypoint first, so it wins any tie, then the
+    // roads linked to any of its lanes. There are only a few of them, a
+    // vector is faster than a set.
+    std::vector<const RoadSegment *> roads = {previous_road};
+    auto add_linked_roads = [&](const auto &lane_links) {
+      for (auto &&lane : lane_links) {
+        for (auto &&link : lane.second) {
+          const auto *road = _data.GetRoad(static_cast<id_type>(link.second));
+          if ((road != nullptr) && (std::find(roads.begin(), roads.end(), road) == roads.end())) {
+            roads.emplace_back(road);
+          }
+        }
+      }
+    };
+    add_linked_roads(previous_road->GetNextLanes());
+    add_linked_roads(previous_road->GetPrevLanes());
+
+    auto nearest_lane_dist = std::numeric_limits<double>::max();
+    for (auto *road : roads) {
+      const auto nearest = road->GetNearestPoint(loc);
+      const auto lane_dist = road->GetNearestLane(nearest.first, loc);
+      if ((lane_dist.first != 0) && (lane_dist.second < nearest_lane_dist)) {
+        nearest_lane_dist = lane_dist.second;
+        out_handle = {road->GetId(), lane_dist.first, std::min(nearest.first, road->GetLength())};
+      }
+    }
+    // Near the border of a lane or inside a junction an unrelated road may
+    // be the one the location is on, only a location inside the lane is
+    // trusted.
+    return (nearest_lane_dist < std::numeric_limits<double>::max()) && IsInsideLane(out_handle, loc);
+  }
+
+  Waypoint Map::MakeWaypoint(const WaypointHandle &waypoint) const {
+    return Waypoint(shared_from_this(), waypoint.road_id, waypoint.lane_id, waypoint.s);
+  }
+
+  geom::Transform Map::ComputeTransform(const WaypointHandle &waypoint) const {
+    const auto road_segment = _data.GetRoad(waypoint.road_id);
+    DEBUG_ASSERT(road_segment != nullptr);
+
+    road::element::DirectedPoint dp = road_segment->GetDirectedPointIn(waypoint.s);
+
+    geom::Rotation rot(geom::Math::to_degrees(dp.pitch), geom::Math::to_degrees(dp.tangent), 0.0);
+    if (waypoint.lane_id > 0) {
+      rot.yaw += 180.0;
+      rot.pitch = 360 - rot.pitch;
+    }
+
+    const auto general_info = road_segment->GetInfo<RoadGeneralInfo>(waypoint.s);
+    if ((general_info != nullptr) && general_info->IsJunction()) {
+      // @todo: fix intersection lane_id to allow compute the lane distance in a correct way
+      // old way to calculate lane position
+      const auto info = road_segment->GetInfo<RoadInfoLane>(0.0);
+      DEBUG_ASSERT(info != nullptr);
+
+      dp.ApplyLateralOffset(info->getLane(waypoint.lane_id)->_lane_center_offset);
+    } else {
+      // new way to calculate lane position
+      const auto lane_offset_info = road_segment->GetInfo<RoadInfoLaneOffset>(waypoint.s);
+      geom::CubicPolynomial final_polynomial = lane_offset_info->GetPolynomial();
+
+      // the first RoadInfoLaneWidth found for each lane id is the nearest one
+      // that is affecting at this dist (t); there are only a few lanes so a
+      // linear search is faster than filling a map on every call
+      const auto lane_width_info = road_segment->GetInfos<RoadInfoLaneWidth>(waypoint.s);
+      auto get_lane_width = [&](int lane_id) {
+        const auto it = std::find_if(lane_width_info.begin(), lane_width_info.end(), [=](const auto &info) {
+          return info->GetLaneId() == lane_id;
+        });
+        DEBUG_ASSERT(it != lane_width_info.end());
+        return *it;
+      };
+
+      DEBUG_ASSERT(waypoint.lane_id != 0);
+
+      // iterate over the previous lanes until lane_id is 0 and add the polynomial info
+      const int inc = waypoint.lane_id < 0 ? - 1 : + 1;
+      // increase or decrease the lane_id depending on if waypoint.lane_id is
+      // positive or negative in order to get closer to that id
+      for (int lane_id = inc; lane_id != waypoint.lane_id; lane_id += inc) {
+        // final_polynomial += geom::CubicPolynomial();
+        final_polynomial += get_lane_width(lane_id)->GetPolynomial() * (waypoint.lane_id < 0 ? -1.0 : 1.0);
+      }
+
+      // use half of the last polynomial to get the center of the road
+      final_polynomial += get_lane_width(waypoint.lane_id)->GetPolynomial() * (waypoint.lane_id < 0 ? -0.5 : 0.5);
+
+      // compute the final lane offset
+      dp.ApplyLateralOffset(final_polynomial.Evaluate(waypoint.s));
+
+      const auto tangent = geom::Math::to_degrees(final_polynomial.Tangent(waypoint.s));
+      rot.yaw += waypoint.lane_id < 0 ? -tangent : tangent;
+    }
+
+    return geom::Transform(dp.location, rot);
+  }
+
   std::vector<element::LaneMarking> Map::CalculateCrossedLanes(
       const geom::Location &origin,
       const geom::Location &destination) const {
     return element::LaneCrossingCalculator::Calculate(*this, origin, destination);
   }
 
+  std::vector<element::LaneMarking> Map::CalculateCrossedLanes(
+      const Waypoint &origin_waypoint,
+      const geom::Location &origin,
+      const Waypoint &destination_waypoint,
+      const geom::Location &destination) const {
+    return element::LaneCrossingCalculator::Calculate(
+        *this,
+        origin_waypoint,
+        origin,
+        destination_waypoint,
+        destination);
+  }
+
   const MapData &Map::GetData() const {
     return _data;
   }
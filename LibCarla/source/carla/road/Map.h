@@ -9,6 +9,8 @@
 #include "carla/Memory.h"
 #include "carla/NonCopyable.h"
 #include "carla/road/MapData.h"
+#include "carla/road/SpatialIndex.h"
+#include "carla/road/SuccessorTable.h"
 #include "carla/road/element/LaneMarking.h"
 #include "carla/road/element/Waypoint.h"
 
@@ -26,21 +28,92 @@ namespace road {
   public:
 
     Map(MapData m)
-      : _data(std::move(m)) {}
+      : _data(std::move(m)),
+        _index(_data),
+        _successors(_data) {}
 
     element::Waypoint GetClosestWaypointOnRoad(const geom::Location &) const;
 
     boost::optional<element::Waypoint> GetWaypoint(const geom::Location &) const;
 
+    /// Same as GetClosestWaypointOnRoad, but tracking the waypoint from
+    /// @a previous, the waypoint of a location close to @a location (e.g. the
+    /// same actor on the previous tick), instead of searching the whole map.
+    ///
+    /// Only the road of @a previous, with all its driving lanes, and the roads
+    /// linked to its start and end are searched. If @a location is not inside
+    /// the nearest lane found there (see IsInsideLane), the whole map is
+    /// searched as GetClosestWaypointOnRoad does.
+    element::Waypoint TrackWaypoint(
+        const element::Waypoint &previous,
+        const geom::Location &location) const;
+
+    /// Same as above with handles, no Waypoint is created.
+    element::WaypointHandle TrackWaypoint(
+        const element::WaypointHandle &previous,
+        const geom::Location &location) const;
+
+    /// TrackWaypoint of every location in @a locations from the waypoint at
+    /// the same position in @a previous, e.g. for every actor at once.
+    std::vector<element::Waypoint> TrackWaypoints(
+        const std::vector<element::Waypoint> &previous,
+        const std::vector<geom::Location> &locations) const;
+
+    /// Whether @a location is less than half the lane width away from
+    /// @a waypoint, the check GetWaypoint does to tell if it is on the road.
+    bool IsInsideLane(
+        const element::WaypointHandle &waypoint,
+        const geom::Location &location) const;
+
+    /// Waypoint of the driving lane of road @a road_id that @a location lies
+    /// inside of, if any. Cheaper than TrackWaypoint as the roads linked to
+    /// @a road_id are not searched, an overlapping road may be nearer.
+    boost::optional<element::WaypointHandle> GetWaypointInsideLane(
+        element::id_type road_id,
+        const geom::Location &location) const;
+
+    /// Make a Waypoint, which keeps this map alive, from @a waypoint.
+    element::Waypoint MakeWaypoint(const element::WaypointHandle &waypoint) const;
+
+    /// Compute the transform of @a waypoint without creating a Waypoint.
+    geom::Transform ComputeTransform(const element::WaypointHandle &waypoint) const;
+
+    std::vector<element::LaneMarking> CalculateCrossedLanes(
+        const geom::Location &origin,
+        const geom::Location &destination) const;
+
+    /// Same as above with the waypoints of @a origin and @a destination
+    /// already computed, e.g. by TrackWaypoint.
     std::vector<element::LaneMarking> CalculateCrossedLanes(
+        const element::Waypoint &origin_waypoint,
         const geom::Location &origin,
+        const element::Waypoint &destination_waypoint,
         const geom::Location &destination) const;
 
     const MapData &GetData() const;
 
+    const SpatialIndex &GetSpatialIndex() const {
+      return _index;
+    }
+
+    const SuccessorTable &GetSuccessorTable() const {
+      return _successors;
+    }
+
   private:
 
+    /// Find the driving lane nearest to @a location in the roads around
+    /// @a previous, return false if @a location is not inside it.
+    bool TrackHandle(
+        const element::WaypointHandle &previous,
+        const geom::Location &location,
+        element::WaypointHandle &out_handle) const;
+
     MapData _data;
+
+    SpatialIndex _index;
+
+    SuccessorTable _successors;
   };
 
 } // namespace road
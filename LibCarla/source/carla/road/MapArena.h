@@ -0,0 +1,167 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Debug.h"
+#include "carla/NonCopyable.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace carla {
+namespace road {
+
+  /// Monotonic arena owning the elements of a map. Elements are constructed
+  /// one after another in large blocks of memory and are only destroyed,
+  /// all together, with the arena, so elements of a map are allocated with
+  /// a few allocations instead of one each and remain valid for the whole
+  /// lifetime of the map.
+  ///
+  /// Moving an arena, or splicing it into another one, does not move the
+  /// elements; pointers to them remain valid. Not thread-safe, concurrent
+  /// loaders use an arena each and splice them together afterwards.
+  class MapArena : private MovableNonCopyable {
+  public:
+
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 1024u;
+
+    static constexpr size_t MAX_BLOCK_SIZE = 64u * 1024u;
+
+    explicit MapArena(size_t block_size = DEFAULT_BLOCK_SIZE)
+      : _next_block_size(block_size) {}
+
+    MapArena(MapArena &&rhs) noexcept
+      : _blocks(std::move(rhs._blocks)),
+        _destructors(std::move(rhs._destructors)),
+        _current(rhs._current),
+        _remaining(rhs._remaining),
+        _next_block_size(rhs._next_block_size),
+        _size(rhs._size) {
+      rhs.Reset();
+    }
+
+    MapArena &operator=(MapArena &&rhs) noexcept {
+      if (this != &rhs) {
+        Clear();
+        _blocks = std::move(rhs._blocks);
+        _destructors = std::move(rhs._destructors);
+        _current = rhs._current;
+        _remaining = rhs._remaining;
+        _next_block_size = rhs._next_block_size;
+        _size = rhs._size;
+        rhs.Reset();
+      }
+      return *this;
+    }
+
+    ~MapArena() {
+      Clear();
+    }
+
+    /// Construct an element of type @a T in the arena.
+    template <typename T, typename ... Args>
+    T *Make(Args && ... args) {
+      void *memory = Allocate(sizeof(T), alignof(T));
+      T *element = new (memory) T(std::forward<Args>(args) ...);
+      if (!std::is_trivially_destructible<T>::value) {
+        _destructors.push_back({element, [](void *p) { static_cast<T *>(p)->~T(); }});
+      }
+      return element;
+    }
+
+    /// Raw memory of @a size bytes aligned to @a alignment.
+    void *Allocate(size_t size, size_t alignment) {
+      DEBUG_ASSERT((alignment & (alignment - 1u)) == 0u);
+      auto padding = Padding(_current, alignment);
+      if (_current == nullptr || (padding + size > _remaining)) {
+        AddBlock(size + alignment);
+        padding = Padding(_current, alignment);
+      }
+      void *result = _current + padding;
+      _current += padding + size;
+      _remaining -= padding + size;
+      return result;
+    }
+
+    /// Take ownership of every element of @a rhs, which is left empty.
+    void Splice(MapArena &&rhs) {
+      _blocks.insert(
+          _blocks.end(),
+          std::make_move_iterator(rhs._blocks.begin()),
+          std::make_move_iterator(rhs._blocks.end()));
+      _destructors.insert(_destructors.end(), rhs._destructors.begin(), rhs._destructors.end());
+      _size += rhs._size;
+      rhs.Reset();
+    }
+
+    /// Bytes of memory reserved by the arena.
+    size_t GetSize() const {
+      return _size;
+    }
+
+  private:
+
+    struct Destructor {
+      void *element;
+      void (*destroy)(void *);
+    };
+
+    static size_t Padding(const unsigned char *p, size_t alignment) {
+      const auto address = reinterpret_cast<uintptr_t>(p);
+      return (alignment - (address % alignment)) % alignment;
+    }
+
+    void AddBlock(size_t min_size) {
+      const auto size = std::max(_next_block_size, min_size);
+      if (_next_block_size < MAX_BLOCK_SIZE) {
+        _next_block_size *= 2u;
+      }
+      _blocks.emplace_back(new unsigned char[size]);
+      _current = _blocks.back().get();
+      _remaining = size;
+      _size += size;
+    }
+
+    /// Destroy the elements in the reverse order they were constructed.
+    void Clear() {
+      for (auto it = _destructors.rbegin(); it != _destructors.rend(); ++it) {
+        it->destroy(it->element);
+      }
+      Reset();
+    }
+
+    /// Forget the elements without destroying them, after they have been
+    /// moved to another arena.
+    void Reset() {
+      _blocks.clear();
+      _destructors.clear();
+      _current = nullptr;
+      _remaining = 0u;
+      _size = 0u;
+    }
+
+    std::vector<std::unique_ptr<unsigned char[]>> _blocks;
+
+    std::vector<Destructor> _destructors;
+
+    unsigned char *_current = nullptr;
+
+    size_t _remaining = 0u;
+
+    size_t _next_block_size;
+
+    size_t _size = 0u;
+  };
+
+} // namespace road
+} // namespace carla
@@ -18,9 +18,13 @@ namespace road {
   }
 
   SharedPtr<Map> MapBuilder::Build() {
-    // Move the RoadSegmentDefinitions needed information to a RoadSegments
+    // Move the RoadSegmentDefinitions needed information to a RoadSegments,
+    // stored sorted by id as the definitions are. The geometries and
+    // information of each definition are moved to the arena of the map.
+    _map_data._roads.reserve(_temp_sections.size());
     for (auto &&id_seg : _temp_sections) {
-      MakeElement<RoadSegment>(id_seg.first, std::move(id_seg.second));
+      _map_data._arena.Splice(std::move(id_seg.second._arena));
+      _map_data._roads.emplace_back(std::move(id_seg.second));
     }
 
     SetTotalRoadSegmentLength();
@@ -36,65 +40,65 @@ namespace road {
   }
 
   void MapBuilder::SetTotalRoadSegmentLength() {
-    for (auto &&id_seg : _map_data._elements) {
+    for (auto &&road : _map_data._roads) {
       double total_length = 0.0;
-      for (auto &&geom : id_seg.second.get()->_geom) {
-        total_length += geom.get()->GetLength();
+      for (auto &&geom : road._geom) {
+        total_length += geom->GetLength();
       }
-      id_seg.second.get()->_length = total_length;
+      road._length = total_length;
     }
   }
 
   void MapBuilder::CreatePointersBetweenRoadSegments() {
+    // The roads are not added or removed anymore, pointers to them remain
+    // valid.
     for (auto &&id_seg : _temp_sections) {
+      auto *road = GetRoad(id_seg.first);
+      DEBUG_ASSERT(road != nullptr);
       for (auto &t : id_seg.second.GetPredecessorID()) {
-        _map_data._elements[id_seg.first]->PredEmplaceBack(_map_data._elements[t].get());
+        road->PredEmplaceBack(GetRoad(t));
       }
       for (auto &t : id_seg.second.GetSuccessorID()) {
-        _map_data._elements[id_seg.first]->SuccEmplaceBack(_map_data._elements[t].get());
+        road->SuccEmplaceBack(GetRoad(t));
       }
     }
   }
 
   void MapBuilder::ComputeLaneCenterOffset() {
-    for (auto &&element : _map_data._elements) {
-      RoadSegment *road_seg = element.second.get();
+    for (auto &&road : _map_data._roads) {
+      RoadSegment *road_seg = &road;
 
-      // get all the RoadGeneralInfo given the type and a distance 0.0
-      auto up_bound_g = decltype(road_seg->_info)::reverse_iterator(road_seg->_info.upper_bound(0.0));
-      auto general_info = MakeRoadInfoIterator<RoadGeneralInfo>(up_bound_g, road_seg->_info.rend());
-
-      // get all the RoadInfoLane given the type and a distance 0.0
-      auto up_bound_l = decltype(road_seg->_info)::reverse_iterator(road_seg->_info.upper_bound(0.0));
-      auto lane_info = MakeRoadInfoIterator<RoadInfoLane>(up_bound_l, road_seg->_info.rend());
+      // get the RoadGeneralInfo and the RoadInfoLane at distance 0.0
+      auto general_info = road_seg->_info.GetInfo<RoadGeneralInfo>(0.0);
+      auto lane_info = road_seg->_info.GetInfo<RoadInfoLane>(0.0);
 
       // check that have a RoadGeneralInfo
-      if (!lane_info.IsAtEnd()) {
+      if (lane_info != nullptr) {
 
         double lane_offset = 0.0;
-        if (!general_info.IsAtEnd()) {
-          lane_offset = (*general_info)->GetLanesOffset().at(0).second;
+        if (general_info != nullptr) {
+          lane_offset = general_info->GetLanesOffset().at(0).second;
         }
 
         double current_width = lane_offset;
 
         for (auto &&current_lane_id :
-            (*lane_info)->getLanesIDs(element::RoadInfoLane::which_lane_e::Left)) {
-          const double half_width = (*lane_info)->getLane(current_lane_id)->_width * 0.5;
+            lane_info->getLanesIDs(element::RoadInfoLane::which_lane_e::Left)) {
+          const double half_width = lane_info->getLane(current_lane_id)->_width * 0.5;
 
           current_width += half_width;
-          (*lane_info)->_lanes[current_lane_id]._lane_center_offset = current_width;
+          lane_info->getMutableLane(current_lane_id)->_lane_center_offset = current_width;
           current_width += half_width;
         }
 
         current_width = lane_offset;
 
         for (auto &&current_lane_id :
-            (*lane_info)->getLanesIDs(element::RoadInfoLane::which_lane_e::Right)) {
-          const double half_width = (*lane_info)->getLane(current_lane_id)->_width * 0.5;
+            lane_info->getLanesIDs(element::RoadInfoLane::which_lane_e::Right)) {
+          const double half_width = lane_info->getLane(current_lane_id)->_width * 0.5;
 
           current_width -= half_width;
-          (*lane_info)->_lanes[current_lane_id]._lane_center_offset = current_width;
+          lane_info->getMutableLane(current_lane_id)->_lane_center_offset = current_width;
           current_width -= half_width;
         }
       }
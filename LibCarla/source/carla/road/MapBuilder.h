@@ -35,16 +35,18 @@ namespace road {
       _map_data.SetTrafficSignData(trafficSignData);
     }
 
+    /// Arena of the map being built. Road segment definitions allocating
+    /// from it place the elements of every road together.
+    MapArena &GetArena() {
+      return _map_data._arena;
+    }
+
     SharedPtr<Map> Build();
 
   private:
 
-    template <typename T, typename ... Args>
-    T &MakeElement(element::id_type id, Args && ... args) {
-      auto inst = std::make_unique<T>(std::forward<Args>(args) ...);
-      T &r = *inst;
-      _map_data._elements.emplace(id, std::move(inst));
-      return r;
+    element::RoadSegment *GetRoad(element::id_type id) {
+      return const_cast<element::RoadSegment *>(_map_data.GetRoad(id));
     }
 
     /// Set the total length of each road based on the geometries
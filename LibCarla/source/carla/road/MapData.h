@@ -6,15 +6,16 @@
 
 #pragma once
 
-#include "carla/Iterator.h"
 #include "carla/ListView.h"
 #include "carla/NonCopyable.h"
+#include "carla/road/MapArena.h"
 #include "carla/road/element/RoadSegment.h"
 #include "carla/opendrive/types.h"
 
 #include <boost/iterator/transform_iterator.hpp>
 
-#include <unordered_map>
+#include <algorithm>
+#include <vector>
 
 namespace carla {
 namespace road {
@@ -35,18 +36,31 @@ namespace road {
   public:
 
     const element::RoadSegment *GetRoad(element::id_type id) const {
-      auto it = _elements.find(id);
-      return it != _elements.end() ? it->second.get() : nullptr;
+      // Roads are sorted by id, ids are usually consecutive from zero.
+      if ((id < _roads.size()) && (_roads[id].GetId() == id)) {
+        return &_roads[id];
+      }
+      auto it = std::lower_bound(_roads.begin(), _roads.end(), id, [](const auto &road, auto id) {
+        return road.GetId() < id;
+      });
+      return ((it != _roads.end()) && (it->GetId() == id)) ? &*it : nullptr;
     }
 
+    /// Ids of the roads, sorted.
     auto GetAllIds() const {
+      auto get = [](const element::RoadSegment &road) { return road.GetId(); };
       return MakeListView(
-          iterator::make_map_keys_iterator(_elements.begin()),
-          iterator::make_map_keys_iterator(_elements.end()));
+          boost::make_transform_iterator(_roads.begin(), get),
+          boost::make_transform_iterator(_roads.end(), get));
     }
 
     size_t GetRoadCount() const {
-      return _elements.size();
+      return _roads.size();
+    }
+
+    /// Bytes of memory reserved by the arena of the map elements.
+    size_t GetArenaSize() const {
+      return _arena.GetSize();
     }
 
     const std::vector<lane_junction_t> &GetJunctionInformation() const {
@@ -65,12 +79,9 @@ namespace road {
       return _traffic_signs;
     }
 
-    auto GetRoadSegments() const {
-      using const_ref = const element::RoadSegment &;
-      auto get = [](auto &pair) -> const_ref { return *pair.second; };
-      return MakeListView(
-          boost::make_transform_iterator(_elements.begin(), get),
-          boost::make_transform_iterator(_elements.end(), get));
+    /// Roads sorted by id.
+    const std::vector<element::RoadSegment> &GetRoadSegments() const {
+      return _roads;
     }
 
   private:
@@ -99,9 +110,11 @@ namespace road {
 
     std::vector<lane_junction_t> _junction_information;
 
-    std::unordered_map<
-        element::id_type,
-        std::unique_ptr<element::RoadSegment>> _elements;
+    /// Owns the geometries and information of the roads. Declared before
+    /// the roads, which point to them, so it is destroyed after the roads.
+    MapArena _arena;
+
+    std::vector<element::RoadSegment> _roads;
 
     std::vector<opendrive::types::TrafficLightGroup> _traffic_groups;
 
@@ -0,0 +1,712 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/road/RoutePlanner.h"
+
+#include "carla/Debug.h"
+#include "carla/ThreadGroup.h"
+#include "carla/geom/Math.h"
+#include "carla/road/Map.h"
+#include "carla/road/WaypointGenerator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <thread>
+#include <tuple>
+
+namespace carla {
+namespace road {
+
+  using namespace carla::road::element;
+
+  // ===========================================================================
+  // -- Static local methods ---------------------------------------------------
+  // ===========================================================================
+
+  static constexpr double INFINITE_COST = std::numeric_limits<double>::infinity();
+
+  static uint64_t MakeKey(uint64_t first, int32_t second) {
+    return (first << 32u) | static_cast<uint32_t>(second);
+  }
+
+  /// Whether driving along @a lane_id from @a from reaches @a to.
+  static bool IsAhead(int lane_id, double from, double to) {
+    return lane_id <= 0 ? (from <= to) : (to <= from);
+  }
+
+  /// Distance along the road from @a s to the exit of lane @a lane_id.
+  static double GetDistanceToExit(const RoadSegment &road, int lane_id, double s) {
+    return lane_id <= 0 ? road.GetLength() - s : s;
+  }
+
+  /// Add an edge to @a edges, keeping only the cheapest edge between two
+  /// nodes.
+  template <typename EdgeT>
+  static void AddEdge(std::vector<std::vector<EdgeT>> &edges, EdgeT edge, uint32_t from) {
+    auto &node_edges = edges[from];
+    auto it = std::find_if(node_edges.begin(), node_edges.end(), [&](const EdgeT &item) {
+      return item.node == edge.node;
+    });
+    if (it == node_edges.end()) {
+      node_edges.emplace_back(edge);
+    } else if (edge.cost < it->cost) {
+      *it = edge;
+    }
+  }
+
+  template <typename T>
+  using MinQueue = std::priority_queue<T, std::vector<T>, std::greater<T>>;
+
+  // ===========================================================================
+  // -- RoutePlanner::SearchState ----------------------------------------------
+  // ===========================================================================
+
+  /// Scratch memory of a query, reused between queries by the same thread.
+  struct RoutePlanner::SearchState {
+
+    struct Labels {
+
+      std::vector<double> cost;
+
+      std::vector<node_type> parent;
+
+      /// Index of the source each node was reached from.
+      std::vector<int> source;
+
+      std::vector<node_type> touched;
+
+      explicit Labels(size_t number_of_nodes)
+        : cost(number_of_nodes, INFINITE_COST),
+          parent(number_of_nodes, INVALID_NODE),
+          source(number_of_nodes, -1) {}
+
+      void Reset() {
+        for (auto node : touched) {
+          cost[node] = INFINITE_COST;
+          parent[node] = INVALID_NODE;
+          source[node] = -1;
+        }
+        touched.clear();
+      }
+
+      bool Relax(node_type node, double new_cost, node_type new_parent, int new_source) {
+        if (new_cost < cost[node]) {
+          if (cost[node] == INFINITE_COST) {
+            touched.emplace_back(node);
+          }
+          cost[node] = new_cost;
+          parent[node] = new_parent;
+          source[node] = new_source;
+          return true;
+        }
+        return false;
+      }
+    };
+
+    /// A node where the search starts, reached from the origin by changing
+    /// lanes along the origin road and then driving to its end.
+    struct Source {
+      node_type node;
+      double cost;
+      /// Lanes driven on the origin road, the last one is left at its exit.
+      std::vector<node_type> lanes;
+    };
+
+    explicit SearchState(size_t number_of_nodes)
+      : forward(number_of_nodes),
+        backward(number_of_nodes) {}
+
+    Labels forward;
+
+    Labels backward;
+
+    std::vector<Source> sources;
+
+    /// Cost to the entrance of the goal lane of the last search.
+    double cost = INFINITE_COST;
+
+    /// Node where the forward and backward searches met, only used by the
+    /// contraction hierarchy.
+    node_type meeting = INVALID_NODE;
+  };
+
+  // ===========================================================================
+  // -- RoutePlanner::Hierarchy ------------------------------------------------
+  // ===========================================================================
+
+  struct RoutePlanner::Hierarchy {
+
+    /// Upward edges, for the forward search.
+    std::vector<uint32_t> up_offsets;
+
+    std::vector<Edge> up_edges;
+
+    /// Reversed upward edges, for the backward search.
+    std::vector<uint32_t> down_offsets;
+
+    std::vector<Edge> down_edges;
+
+    /// Node contracted by each shortcut, indexed by (from, to).
+    std::unordered_map<uint64_t, node_type> shortcuts;
+  };
+
+  // ===========================================================================
+  // -- RoutePlanner -----------------------------------------------------------
+  // ===========================================================================
+
+  RoutePlanner::RoutePlanner(SharedPtr<const Map> map, double lane_change_cost)
+    : _map(std::move(map)),
+      _lane_change_cost(lane_change_cost) {
+    DEBUG_ASSERT(_map != nullptr);
+    const auto &data = _map->GetData();
+
+    // One node per drivable lane.
+    for (auto &&road : data.GetRoadSegments()) {
+      const auto info = road.GetInfo<RoadInfoLane>(0.0);
+      if (info == nullptr) {
+        continue;
+      }
+      info->ForEachLane(static_cast<LaneTypeMask>(LaneType::Driving), [&](int lane_id) {
+        const WaypointHandle entrance{road.GetId(), lane_id, lane_id <= 0 ? 0.0 : road.GetLength()};
+        _node_index.emplace(MakeKey(entrance.road_id, lane_id), static_cast<node_type>(_lanes.size()));
+        _lanes.emplace_back(entrance);
+        _positions.emplace_back(_map->ComputeTransform(entrance).location);
+      });
+    }
+
+    // Edges to the successor lanes and to the adjacent lanes.
+    std::vector<std::vector<Edge>> edges(_lanes.size());
+    for (node_type node = 0u; node < _lanes.size(); ++node) {
+      const auto &lane = _lanes[node];
+      const auto &road = *data.GetRoad(lane.road_id);
+      for (auto &&successor : _map->GetSuccessorTable().GetSuccessors(lane.road_id, lane.lane_id)) {
+        const auto next = FindNode(successor.road_id, successor.lane_id);
+        if (next != INVALID_NODE) {
+          const double distance = geom::Math::Distance(_positions[node], _positions[next]);
+          AddEdge(edges, Edge{next, std::max(road.GetLength(), distance), INVALID_NODE}, node);
+        }
+      }
+      const auto waypoint = _map->MakeWaypoint(lane);
+      for (auto &&adjacent : {WaypointGenerator::GetLeft(waypoint), WaypointGenerator::GetRight(waypoint)}) {
+        // Only change to lanes that go in the same direction.
+        if (adjacent && ((adjacent->GetLaneId() < 0) == (lane.lane_id < 0))) {
+          const auto next = FindNode(lane.road_id, adjacent->GetLaneId());
+          if ((next != INVALID_NODE) && (next != node)) {
+            const double distance = geom::Math::Distance(_positions[node], _positions[next]);
+            AddEdge(edges, Edge{next, std::max(_lane_change_cost, distance), INVALID_NODE}, node);
+          }
+        }
+      }
+    }
+
+    _offsets.reserve(edges.size() + 1u);
+    _offsets.emplace_back(0u);
+    for (auto &&node_edges : edges) {
+      for (auto &&edge : node_edges) {
+        _targets.emplace_back(edge.node);
+        _costs.emplace_back(edge.cost);
+      }
+      _offsets.emplace_back(static_cast<uint32_t>(_targets.size()));
+    }
+  }
+
+  RoutePlanner::~RoutePlanner() = default;
+
+  RoutePlanner::node_type RoutePlanner::FindNode(id_type road_id, int lane_id) const {
+    const auto it = _node_index.find(MakeKey(road_id, lane_id));
+    return it != _node_index.end() ? it->second : INVALID_NODE;
+  }
+
+  // ===========================================================================
+  // -- RoutePlanner contraction hierarchy -------------------------------------
+  // ===========================================================================
+
+  void RoutePlanner::BuildContractionHierarchy() {
+    // Queries only read the hierarchy once published, a concurrent call waits
+    // for this one and returns.
+    std::lock_guard<std::mutex> lock(_hierarchy_mutex);
+    if (HasContractionHierarchy()) {
+      return;
+    }
+    /// Maximum number of nodes settled by each witness search, a witness not
+    /// found only results in an unnecessary shortcut. Estimating the priority
+    /// of a node uses a smaller limit than actually contracting it.
+    constexpr size_t max_settled_nodes = 500u;
+    constexpr size_t max_settled_nodes_estimate = 50u;
+
+    const auto number_of_nodes = _lanes.size();
+    std::vector<std::vector<Edge>> out(number_of_nodes);
+    std::vector<std::vector<Edge>> in(number_of_nodes);
+
+    auto add_edge = [&](node_type from, node_type to, double cost, node_type middle) {
+      AddEdge(out, Edge{to, cost, middle}, from);
+      AddEdge(in, Edge{from, cost, middle}, to);
+    };
+    for (node_type node = 0u; node < number_of_nodes; ++node) {
+      for (auto i = _offsets[node]; i < _offsets[node + 1u]; ++i) {
+        if (_targets[i] != node) {
+          add_edge(node, _targets[i], _costs[i], INVALID_NODE);
+        }
+      }
+    }
+
+    // Edges of each node to the nodes contracted after it.
+    std::vector<std::vector<Edge>> up(number_of_nodes);
+    std::vector<std::vector<Edge>> down(number_of_nodes);
+
+    std::vector<bool> contracted(number_of_nodes, false);
+    std::vector<int> deleted_neighbors(number_of_nodes, 0);
+
+    // Bounded Dijkstra from @a from ignoring @a ignored and the nodes already
+    // contracted.
+    SearchState::Labels witness(number_of_nodes);
+    auto search_witnesses = [&](node_type from, node_type ignored, double max_cost, size_t limit) {
+      witness.Reset();
+      MinQueue<std::pair<double, node_type>> queue;
+      witness.Relax(from, 0.0, INVALID_NODE, 0);
+      queue.emplace(0.0, from);
+      size_t settled = 0u;
+      while (!queue.empty() && (settled < limit)) {
+        const auto item = queue.top();
+        queue.pop();
+        if (item.first > witness.cost[item.second]) {
+          continue;
+        }
+        if (item.first > max_cost) {
+          break;
+        }
+        ++settled;
+        for (auto &&edge : out[item.second]) {
+          if (!contracted[edge.node] && (edge.node != ignored) &&
+              witness.Relax(edge.node, item.first + edge.cost, item.second, 0)) {
+            queue.emplace(witness.cost[edge.node], edge.node);
+          }
+        }
+      }
+    };
+
+    // Number of shortcuts needed to contract @a node, added if @a apply.
+    auto contract = [&](node_type node, bool apply) {
+      int number_of_shortcuts = 0;
+      std::vector<Edge> incoming;
+      for (auto &&edge : in[node]) {
+        if (!contracted[edge.node] && (edge.node != node)) {
+          incoming.emplace_back(edge);
+        }
+      }
+      std::vector<Edge> outgoing;
+      for (auto &&edge : out[node]) {
+        if (!contracted[edge.node] && (edge.node != node)) {
+          outgoing.emplace_back(edge);
+        }
+      }
+      for (auto &&from : incoming) {
+        double max_cost = 0.0;
+        for (auto &&to : outgoing) {
+          max_cost = std::max(max_cost, from.cost + to.cost);
+        }
+        search_witnesses(
+            from.node,
+            node,
+            max_cost,
+            apply ? max_settled_nodes : max_settled_nodes_estimate);
+        for (auto &&to : outgoing) {
+          const auto cost = from.cost + to.cost;
+          if ((to.node != from.node) && (witness.cost[to.node] > cost)) {
+            ++number_of_shortcuts;
+            if (apply) {
+              add_edge(from.node, to.node, cost, node);
+            }
+          }
+        }
+      }
+      const auto degree = static_cast<int>(incoming.size() + outgoing.size());
+      return std::make_pair(number_of_shortcuts, degree);
+    };
+
+    auto priority = [&](node_type node) {
+      const auto result = contract(node, false);
+      return result.first - result.second + deleted_neighbors[node];
+    };
+
+    MinQueue<std::pair<int, node_type>> queue;
+    for (node_type node = 0u; node < number_of_nodes; ++node) {
+      queue.emplace(priority(node), node);
+    }
+    while (!queue.empty()) {
+      const auto node = queue.top().second;
+      queue.pop();
+      if (contracted[node]) {
+        continue;
+      }
+      // Lazy update, the priority may have changed since it was queued.
+      const auto current_priority = priority(node);
+      if (!queue.empty() && (current_priority > queue.top().first)) {
+        queue.emplace(current_priority, node);
+        continue;
+      }
+      contract(node, true);
+      contracted[node] = true;
+      // The remaining neighbors are contracted later, so they rank higher.
+      // Move the edges of the node to the hierarchy and remove them from the
+      // graph left to contract.
+      auto is_node = [node](const Edge &edge) { return edge.node == node; };
+      for (auto &&edge : out[node]) {
+        ++deleted_neighbors[edge.node];
+        auto &edges = in[edge.node];
+        edges.erase(std::remove_if(edges.begin(), edges.end(), is_node), edges.end());
+      }
+      for (auto &&edge : in[node]) {
+        ++deleted_neighbors[edge.node];
+        auto &edges = out[edge.node];
+        edges.erase(std::remove_if(edges.begin(), edges.end(), is_node), edges.end());
+      }
+      up[node] = std::move(out[node]);
+      down[node] = std::move(in[node]);
+      out[node].clear();
+      in[node].clear();
+    }
+
+    auto hierarchy = std::make_shared<Hierarchy>();
+    hierarchy->up_offsets.emplace_back(0u);
+    hierarchy->down_offsets.emplace_back(0u);
+    for (node_type node = 0u; node < number_of_nodes; ++node) {
+      for (auto &&edge : up[node]) {
+        if (edge.middle != INVALID_NODE) {
+          hierarchy->shortcuts.emplace(MakeKey(node, static_cast<int32_t>(edge.node)), edge.middle);
+        }
+      }
+      for (auto &&edge : down[node]) {
+        if (edge.middle != INVALID_NODE) {
+          hierarchy->shortcuts.emplace(MakeKey(edge.node, static_cast<int32_t>(node)), edge.middle);
+        }
+      }
+      auto &up_edges = hierarchy->up_edges;
+      auto &down_edges = hierarchy->down_edges;
+      up_edges.insert(up_edges.end(), up[node].begin(), up[node].end());
+      down_edges.insert(down_edges.end(), down[node].begin(), down[node].end());
+      hierarchy->up_offsets.emplace_back(static_cast<uint32_t>(up_edges.size()));
+      hierarchy->down_offsets.emplace_back(static_cast<uint32_t>(down_edges.size()));
+    }
+    _hierarchy.store(std::move(hierarchy));
+  }
+
+  void RoutePlanner::UnpackEdge(
+      const Hierarchy &hierarchy,
+      node_type from,
+      node_type to,
+      std::vector<node_type> &path) const {
+    const auto it = hierarchy.shortcuts.find(MakeKey(from, static_cast<int32_t>(to)));
+    if (it == hierarchy.shortcuts.end()) {
+      path.emplace_back(to);
+    } else {
+      UnpackEdge(hierarchy, from, it->second, path);
+      UnpackEdge(hierarchy, it->second, to, path);
+    }
+  }
+
+  // ===========================================================================
+  // -- RoutePlanner searches --------------------------------------------------
+  // ===========================================================================
+
+  int RoutePlanner::SearchAStar(SearchState &state, node_type goal) const {
+    auto &labels = state.forward;
+    labels.Reset();
+    const auto &goal_position = _positions[goal];
+    auto heuristic = [&](node_type node) {
+      return geom::Math::Distance(_positions[node], goal_position);
+    };
+    // (estimated total cost, cost, node)
+    MinQueue<std::tuple<double, double, node_type>> queue;
+    for (auto i = 0u; i < state.sources.size(); ++i) {
+      const auto &source = state.sources[i];
+      if (labels.Relax(source.node, source.cost, INVALID_NODE, static_cast<int>(i))) {
+        queue.emplace(source.cost + heuristic(source.node), source.cost, source.node);
+      }
+    }
+    while (!queue.empty()) {
+      const auto cost = std::get<1>(queue.top());
+      const auto node = std::get<2>(queue.top());
+      queue.pop();
+      if (cost > labels.cost[node]) {
+        continue;
+      }
+      if (node == goal) {
+        state.cost = cost;
+        return labels.source[node];
+      }
+      for (auto i = _offsets[node]; i < _offsets[node + 1u]; ++i) {
+        const auto next = _targets[i];
+        if (labels.Relax(next, cost + _costs[i], node, labels.source[node])) {
+          queue.emplace(labels.cost[next] + heuristic(next), labels.cost[next], next);
+        }
+      }
+    }
+    return -1;
+  }
+
+  int RoutePlanner::SearchContractionHierarchy(
+      const Hierarchy &hierarchy,
+      SearchState &state,
+      node_type goal) const {
+    auto &forward = state.forward;
+    auto &backward = state.backward;
+    forward.Reset();
+    backward.Reset();
+    MinQueue<std::pair<double, node_type>> forward_queue;
+    MinQueue<std::pair<double, node_type>> backward_queue;
+    for (auto i = 0u; i < state.sources.size(); ++i) {
+      const auto &source = state.sources[i];
+      if (forward.Relax(source.node, source.cost, INVALID_NODE, static_cast<int>(i))) {
+        forward_queue.emplace(source.cost, source.node);
+      }
+    }
+    backward.Relax(goal, 0.0, INVALID_NODE, 0);
+    backward_queue.emplace(0.0, goal);
+
+    auto top = [](const auto &queue) {
+      return queue.empty() ? INFINITE_COST : queue.top().first;
+    };
+
+    state.cost = INFINITE_COST;
+    state.meeting = INVALID_NODE;
+    while (std::min(top(forward_queue), top(backward_queue)) < state.cost) {
+      const bool is_forward = top(forward_queue) <= top(backward_queue);
+      auto &queue = is_forward ? forward_queue : backward_queue;
+      auto &labels = is_forward ? forward : backward;
+      const auto &other = is_forward ? backward : forward;
+      const auto &offsets = is_forward ? hierarchy.up_offsets : hierarchy.down_offsets;
+      const auto &edges = is_forward ? hierarchy.up_edges : hierarchy.down_edges;
+
+      const auto item = queue.top();
+      queue.pop();
+      const auto node = item.second;
+      if (item.first > labels.cost[node]) {
+        continue;
+      }
+      if (item.first + other.cost[node] < state.cost) {
+        state.cost = item.first + other.cost[node];
+        state.meeting = node;
+      }
+      // Stall-on-demand, a node reached cheaper through a higher node is not
+      // on a shortest path and its edges need not be relaxed.
+      const auto &stall_offsets = is_forward ? hierarchy.down_offsets : hierarchy.up_offsets;
+      const auto &stall_edges = is_forward ? hierarchy.down_edges : hierarchy.up_edges;
+      bool stalled = false;
+      for (auto i = stall_offsets[node]; !stalled && (i < stall_offsets[node + 1u]); ++i) {
+        const auto &edge = stall_edges[i];
+        stalled = labels.cost[edge.node] + edge.cost < item.first;
+      }
+      if (stalled) {
+        continue;
+      }
+      for (auto i = offsets[node]; i < offsets[node + 1u]; ++i) {
+        const auto &edge = edges[i];
+        if (labels.Relax(edge.node, item.first + edge.cost, node, labels.source[node])) {
+          queue.emplace(labels.cost[edge.node], edge.node);
+        }
+      }
+    }
+    return state.meeting == INVALID_NODE ? -1 : forward.source[state.meeting];
+  }
+
+  // ===========================================================================
+  // -- RoutePlanner queries ---------------------------------------------------
+  // ===========================================================================
+
+  Route RoutePlanner::ComputeRoute(
+      const geom::Location &origin,
+      const geom::Location &destination,
+      const double step) const {
+    SearchState state(_lanes.size());
+    return ComputeRoute(
+        state,
+        _map->GetClosestWaypointOnRoad(origin).GetHandle(),
+        _map->GetClosestWaypointOnRoad(destination).GetHandle(),
+        step);
+  }
+
+  Route RoutePlanner::ComputeRoute(
+      const WaypointHandle &origin,
+      const WaypointHandle &destination,
+      const double step) const {
+    SearchState state(_lanes.size());
+    return ComputeRoute(state, origin, destination, step);
+  }
+
+  std::vector<Route> RoutePlanner::ComputeRoutes(
+      const std::vector<std::pair<geom::Location, geom::Location>> &queries,
+      const double step,
+      size_t number_of_threads) const {
+    std::vector<Route> result(queries.size());
+    std::atomic_size_t next_query{0u};
+    auto worker = [&]() {
+      SearchState state(_lanes.size());
+      for (auto i = next_query++; i < queries.size(); i = next_query++) {
+        result[i] = ComputeRoute(
+            state,
+            _map->GetClosestWaypointOnRoad(queries[i].first).GetHandle(),
+            _map->GetClosestWaypointOnRoad(queries[i].second).GetHandle(),
+            step);
+      }
+    };
+
+    if (number_of_threads == 0u) {
+      number_of_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    number_of_threads = std::min(number_of_threads, queries.size());
+    if (number_of_threads <= 1u) {
+      worker();
+    } else {
+      ThreadGroup workers;
+      workers.CreateThreads(number_of_threads - 1u, worker);
+      worker();
+    }
+    return result;
+  }
+
+  Route RoutePlanner::ComputeRoute(
+      SearchState &state,
+      const WaypointHandle &origin,
+      const WaypointHandle &destination,
+      const double step) const {
+    DEBUG_ASSERT(step > 0.0);
+    const auto &data = _map->GetData();
+    const auto origin_node = FindNode(origin.road_id, origin.lane_id);
+    const auto goal = FindNode(destination.road_id, destination.lane_id);
+    if ((origin_node == INVALID_NODE) || (goal == INVALID_NODE)) {
+      return {};
+    }
+    const auto &origin_road = *data.GetRoad(origin.road_id);
+    const auto &goal_road = *data.GetRoad(destination.road_id);
+
+    // Lanes reachable from the origin changing lanes along the origin road.
+    // If one of them is the goal lane and the destination is ahead, that is
+    // a candidate route; otherwise the search starts at their successors.
+    state.sources.clear();
+    double best_direct_cost = INFINITE_COST;
+    std::vector<node_type> best_direct_lanes;
+    {
+      std::vector<std::pair<std::vector<node_type>, double>> pending{{{origin_node}, 0.0}};
+      std::vector<node_type> visited{origin_node};
+      for (size_t i = 0u; i < pending.size(); ++i) {
+        const auto lanes = pending[i].first;
+        const auto cost = pending[i].second;
+        const auto node = lanes.back();
+        const auto lane_id = _lanes[node].lane_id;
+        if ((node == goal) && IsAhead(lane_id, origin.s, destination.s)) {
+          const auto direct_cost = cost + std::abs(destination.s - origin.s);
+          if (direct_cost < best_direct_cost) {
+            best_direct_cost = direct_cost;
+            best_direct_lanes = lanes;
+          }
+        }
+        const auto exit_cost = cost + GetDistanceToExit(origin_road, lane_id, origin.s);
+        for (auto j = _offsets[node]; j < _offsets[node + 1u]; ++j) {
+          const auto next = _targets[j];
+          const bool is_lane_change =
+              (_lanes[next].road_id == origin.road_id) &&
+              (_lanes[next].lane_id != lane_id);
+          if (!is_lane_change) {
+            state.sources.push_back({next, exit_cost, lanes});
+          } else if (std::find(visited.begin(), visited.end(), next) == visited.end()) {
+            visited.emplace_back(next);
+            auto next_lanes = lanes;
+            next_lanes.emplace_back(next);
+            pending.emplace_back(std::move(next_lanes), cost + _costs[j]);
+          }
+        }
+      }
+    }
+
+    // Search the lane graph, with the hierarchy if it was already published.
+    const auto hierarchy = _hierarchy.load();
+    std::vector<node_type> origin_lanes;
+    std::vector<node_type> path;
+    const int source = state.sources.empty() ? -1 : (hierarchy != nullptr ?
+        SearchContractionHierarchy(*hierarchy, state, goal) :
+        SearchAStar(state, goal));
+    const auto along_goal = destination.lane_id <= 0 ?
+        destination.s :
+        goal_road.GetLength() - destination.s;
+    if ((source >= 0) && (state.cost + along_goal < best_direct_cost)) {
+      origin_lanes = state.sources[static_cast<size_t>(source)].lanes;
+      if (hierarchy != nullptr) {
+        std::vector<node_type> up;
+        for (auto node = state.meeting; node != INVALID_NODE; node = state.forward.parent[node]) {
+          up.emplace_back(node);
+        }
+        std::reverse(up.begin(), up.end());
+        path.emplace_back(up.front());
+        for (size_t i = 1u; i < up.size(); ++i) {
+          UnpackEdge(*hierarchy, up[i - 1u], up[i], path);
+        }
+        for (auto node = state.meeting; state.backward.parent[node] != INVALID_NODE;) {
+          const auto next = state.backward.parent[node];
+          UnpackEdge(*hierarchy, node, next, path);
+          node = next;
+        }
+      } else {
+        for (auto node = goal; node != INVALID_NODE; node = state.forward.parent[node]) {
+          path.emplace_back(node);
+        }
+        std::reverse(path.begin(), path.end());
+      }
+    } else if (best_direct_cost < INFINITE_COST) {
+      origin_lanes = best_direct_lanes;
+    } else {
+      return {};
+    }
+
+    // Sample the route. The origin lanes are driven from the origin, the
+    // lanes of the path from their entrance, and each lane is driven to its
+    // exit unless the next lane is an adjacent lane of the same road.
+    Route route;
+    auto drive = [&](node_type node, double from, double to) {
+      const auto &lane = _lanes[node];
+      const double direction = lane.lane_id <= 0 ? 1.0 : -1.0;
+      const auto length = std::abs(to - from);
+      for (double ds = 0.0; ds < length; ds += step) {
+        const WaypointHandle waypoint{lane.road_id, lane.lane_id, from + direction * ds};
+        route.waypoints.push_back(waypoint, _map->ComputeTransform(waypoint));
+      }
+      route.length += length;
+    };
+    auto exit_of = [&](node_type node) {
+      const auto &lane = _lanes[node];
+      return lane.lane_id <= 0 ? data.GetRoad(lane.road_id)->GetLength() : 0.0;
+    };
+    auto is_lane_change = [&](node_type from, node_type to) {
+      return (_lanes[from].road_id == _lanes[to].road_id) &&
+             (_lanes[from].lane_id != _lanes[to].lane_id);
+    };
+
+    if (origin_lanes.size() > 1u) {
+      // Changes lanes right at the origin.
+      route.waypoints.push_back(origin, _map->ComputeTransform(origin));
+    }
+    if (path.empty()) {
+      drive(origin_lanes.back(), origin.s, destination.s);
+    } else {
+      drive(origin_lanes.back(), origin.s, exit_of(origin_lanes.back()));
+      for (size_t i = 0u; i + 1u < path.size(); ++i) {
+        if (!is_lane_change(path[i], path[i + 1u])) {
+          drive(path[i], _lanes[path[i]].s, exit_of(path[i]));
+        }
+      }
+      drive(path.back(), _lanes[path.back()].s, destination.s);
+    }
+    route.waypoints.push_back(destination, _map->ComputeTransform(destination));
+    return route;
+  }
+
+} // namespace road
+} // namespace carla
@@ -0,0 +1,174 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/AtomicSharedPtr.h"
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+#include "carla/geom/Location.h"
+#include "carla/road/WaypointArrays.h"
+#include "carla/road/element/WaypointHandle.h"
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace carla {
+namespace road {
+
+  class Map;
+
+  /// A route over the lanes of a map, sampled as a dense polyline.
+  class Route {
+  public:
+
+    /// Waypoints along the route, in driving order. Consecutive waypoints are
+    /// at most the sampling step apart along the lane, except at lane changes.
+    WaypointArrays waypoints;
+
+    /// Distance driven along the lanes, lane changes are not counted.
+    double length = 0.0;
+
+    /// Whether no route was found.
+    bool empty() const {
+      return waypoints.empty();
+    }
+  };
+
+  /// Computes routes over the graph of drivable lanes of a map.
+  ///
+  /// Each node of the graph is a drivable lane of a road segment, placed at
+  /// the entrance of the lane. Lanes are connected to their successor lanes,
+  /// with the length of the road as cost, and to the adjacent lanes in the
+  /// same direction, with a fixed lane change cost. The graph is stored in
+  /// compressed sparse row format.
+  ///
+  /// Queries are answered with A* using the Euclidean distance between lane
+  /// entrances as heuristic. BuildContractionHierarchy can be called once to
+  /// preprocess the graph, after which queries run a bidirectional search
+  /// over the hierarchy instead.
+  ///
+  /// All the methods are thread-safe.
+  class RoutePlanner : private NonCopyable {
+  public:
+
+    explicit RoutePlanner(SharedPtr<const Map> map, double lane_change_cost = 10.0);
+
+    ~RoutePlanner();
+
+    size_t GetNumberOfNodes() const {
+      return _positions.size();
+    }
+
+    size_t GetNumberOfEdges() const {
+      return _targets.size();
+    }
+
+    /// Contract the lane graph into a contraction hierarchy. It only needs to
+    /// be called once; the routes computed are as short as without it.
+    ///
+    /// Preprocessing is expensive and only pays off for many queries on large
+    /// maps: on a grid city of 11696 lanes it takes about 3 seconds and makes
+    /// queries about 1.5 times faster, so it takes tens of thousands of
+    /// queries to make up for it.
+    ///
+    /// The queries running meanwhile use A*, the hierarchy is used by the
+    /// queries started once it is complete.
+    void BuildContractionHierarchy();
+
+    bool HasContractionHierarchy() const {
+      return _hierarchy.load() != nullptr;
+    }
+
+    /// Compute the route between the waypoints nearest to @a origin and
+    /// @a destination, sampled every @a step meters. Returns an empty route
+    /// if @a destination cannot be reached.
+    Route ComputeRoute(
+        const geom::Location &origin,
+        const geom::Location &destination,
+        double step = 2.0) const;
+
+    Route ComputeRoute(
+        const element::WaypointHandle &origin,
+        const element::WaypointHandle &destination,
+        double step = 2.0) const;
+
+    /// Compute the route of each (origin, destination) pair using
+    /// @a number_of_threads threads, zero uses one thread per hardware core.
+    std::vector<Route> ComputeRoutes(
+        const std::vector<std::pair<geom::Location, geom::Location>> &queries,
+        double step = 2.0,
+        size_t number_of_threads = 0u) const;
+
+  private:
+
+    using node_type = uint32_t;
+
+    static constexpr node_type INVALID_NODE = UINT32_MAX;
+
+    struct SearchState;
+
+    struct Hierarchy;
+
+    struct Edge {
+      node_type node;
+      double cost;
+      /// Node contracted by this shortcut, INVALID_NODE for original edges.
+      node_type middle;
+    };
+
+    node_type FindNode(element::id_type road_id, int lane_id) const;
+
+    /// Search the sequence of nodes from one of @a state's sources to
+    /// @a goal. Returns the index of the source or -1 if not found.
+    int SearchAStar(SearchState &state, node_type goal) const;
+
+    int SearchContractionHierarchy(
+        const Hierarchy &hierarchy,
+        SearchState &state,
+        node_type goal) const;
+
+    void UnpackEdge(
+        const Hierarchy &hierarchy,
+        node_type from,
+        node_type to,
+        std::vector<node_type> &path) const;
+
+    Route ComputeRoute(
+        SearchState &state,
+        const element::WaypointHandle &origin,
+        const element::WaypointHandle &destination,
+        double step) const;
+
+    SharedPtr<const Map> _map;
+
+    const double _lane_change_cost;
+
+    /// Road, lane and entrance location of each node.
+    std::vector<element::WaypointHandle> _lanes;
+
+    std::vector<geom::Location> _positions;
+
+    std::unordered_map<uint64_t, node_type> _node_index;
+
+    /// Lane graph, edges of node i are [_offsets[i], _offsets[i+1]).
+    std::vector<uint32_t> _offsets;
+
+    std::vector<node_type> _targets;
+
+    std::vector<double> _costs;
+
+    /// Published once completely built, never modified afterwards.
+    AtomicSharedPtr<const Hierarchy> _hierarchy;
+
+    std::mutex _hierarchy_mutex;
+  };
+
+} // namespace road
+} // namespace carla
@@ -0,0 +1,249 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/road/SpatialIndex.h"
+
+#include "carla/road/MapData.h"
+#include "carla/road/element/RoadSegment.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace carla {
+namespace road {
+
+  using namespace element;
+
+  // ===========================================================================
+  // -- Static local methods ---------------------------------------------------
+  // ===========================================================================
+
+  /// Maximum number of children per node of the tree.
+  static constexpr size_t NODE_CAPACITY = 8u;
+
+  /// Padding added to every bounding box to absorb the rounding errors of the
+  /// single precision locations, an absolute term plus a term relative to the
+  /// magnitude of the coordinates.
+  static constexpr double BOX_PADDING = 1e-2;
+  static constexpr double BOX_RELATIVE_PADDING = 1e-6;
+
+  /// Sort @a elements following the sort-tile-recursive algorithm, consecutive
+  /// groups of NODE_CAPACITY elements are then close to each other.
+  template <typename T, typename GetBoxT>
+  static void SortTileRecursive(std::vector<T> &elements, GetBoxT get_box) {
+    auto center_x = [&](const T &e) { return get_box(e).min_x + get_box(e).max_x; };
+    auto center_y = [&](const T &e) { return get_box(e).min_y + get_box(e).max_y; };
+    std::sort(elements.begin(), elements.end(), [&](const T &lhs, const T &rhs) {
+      return center_x(lhs) < center_x(rhs);
+    });
+    const auto node_count = (elements.size() + NODE_CAPACITY - 1u) / NODE_CAPACITY;
+    const auto slice_count = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(node_count))));
+    const auto slice_size = slice_count * NODE_CAPACITY;
+    for (size_t i = 0u; i < elements.size(); i += slice_size) {
+      const auto end = std::min(i + slice_size, elements.size());
+      std::sort(elements.begin() + i, elements.begin() + end, [&](const T &lhs, const T &rhs) {
+        return center_y(lhs) < center_y(rhs);
+      });
+    }
+  }
+
+  // ===========================================================================
+  // -- SpatialIndex::Box ------------------------------------------------------
+  // ===========================================================================
+
+  double SpatialIndex::Box::DistanceSquared(const double x, const double y) const {
+    const double dx = std::max(0.0, std::max(min_x - x, x - max_x));
+    const double dy = std::max(0.0, std::max(min_y - y, y - max_y));
+    return dx * dx + dy * dy;
+  }
+
+  void SpatialIndex::Box::Extend(const Box &rhs) {
+    min_x = std::min(min_x, rhs.min_x);
+    min_y = std::min(min_y, rhs.min_y);
+    max_x = std::max(max_x, rhs.max_x);
+    max_y = std::max(max_y, rhs.max_y);
+  }
+
+  /// Compute a box containing every point of @a geometry, return false if the
+  /// bounds of the geometry cannot be computed.
+  template <typename BoxT>
+  static bool ComputeBounds(const Geometry &geometry, BoxT &box) {
+    const auto &tessellation = geometry.GetTessellation();
+    if (tessellation.size() == 0u) {
+      return false;
+    }
+    const auto x = std::minmax_element(tessellation.x.begin(), tessellation.x.end());
+    const auto y = std::minmax_element(tessellation.y.begin(), tessellation.y.end());
+    const double min_x = *x.first, max_x = *x.second;
+    const double min_y = *y.first, max_y = *y.second;
+    // The geometry is at most max_error away from the tessellation.
+    const double padding =
+        BOX_PADDING +
+        2.0 * tessellation.max_error +
+        BOX_RELATIVE_PADDING * std::max(
+            std::max(std::abs(min_x), std::abs(max_x)),
+            std::max(std::abs(min_y), std::abs(max_y)));
+    if (!std::isfinite(padding)) {
+      return false;
+    }
+    box = BoxT{min_x - padding, min_y - padding, max_x + padding, max_y + padding};
+    return true;
+  }
+
+  // ===========================================================================
+  // -- SpatialIndex -----------------------------------------------------------
+  // ===========================================================================
+
+  SpatialIndex::SpatialIndex(const MapData &data) {
+    _roads.reserve(data.GetRoadCount());
+    for (auto &&road : data.GetRoadSegments()) {
+      const auto index = static_cast<uint32_t>(_roads.size());
+      _roads.emplace_back(&road);
+      bool is_bounded = true;
+      for (auto &&geometry : road.GetGeometries()) {
+        Item item;
+        item.road = index;
+        if (ComputeBounds(*geometry, item.box)) {
+          _items.emplace_back(item);
+        } else {
+          is_bounded = false;
+        }
+      }
+      if (!is_bounded) {
+        _unbounded_roads.emplace_back(index);
+      }
+    }
+    BuildTree();
+  }
+
+  void SpatialIndex::BuildTree() {
+    if (_items.empty()) {
+      return;
+    }
+
+    auto make_parents = [](const auto &children, size_t offset, bool is_leaf) {
+      std::vector<Node> parents;
+      parents.reserve((children.size() + NODE_CAPACITY - 1u) / NODE_CAPACITY);
+      for (size_t i = 0u; i < children.size(); i += NODE_CAPACITY) {
+        const auto end = std::min(i + NODE_CAPACITY, children.size());
+        Node node;
+        node.box = children[i].box;
+        for (auto j = i + 1u; j < end; ++j) {
+          node.box.Extend(children[j].box);
+        }
+        node.begin = static_cast<uint32_t>(offset + i);
+        node.end = static_cast<uint32_t>(offset + end);
+        node.is_leaf = is_leaf;
+        parents.emplace_back(node);
+      }
+      return parents;
+    };
+
+    SortTileRecursive(_items, [](const Item &item) -> const Box & { return item.box; });
+    auto level = make_parents(_items, 0u, true);
+    while (level.size() > 1u) {
+      SortTileRecursive(level, [](const Node &node) -> const Box & { return node.box; });
+      const auto offset = _nodes.size();
+      _nodes.insert(_nodes.end(), level.begin(), level.end());
+      level = make_parents(level, offset, false);
+    }
+    // The root is always the last node.
+    _nodes.emplace_back(level.front());
+  }
+
+  std::vector<SpatialIndex::NearestRoad> SpatialIndex::GetNearestRoads(
+      const geom::Location &location,
+      const size_t count) const {
+    struct Candidate {
+      NearestRoad road;
+      uint32_t rank;
+    };
+
+    auto is_nearer = [](const Candidate &lhs, const Candidate &rhs) {
+      return (lhs.road.distance < rhs.road.distance) ||
+             ((lhs.road.distance == rhs.road.distance) && (lhs.rank < rhs.rank));
+    };
+
+    std::vector<Candidate> candidates;
+    std::vector<uint32_t> evaluated;
+    candidates.reserve(count + 1u);
+
+    auto evaluate = [&](uint32_t index) {
+      if (std::find(evaluated.begin(), evaluated.end(), index) != evaluated.end()) {
+        return;
+      }
+      evaluated.emplace_back(index);
+      const auto *road = _roads[index];
+      const auto nearest = road->GetNearestPoint(location);
+      Candidate candidate{{road, nearest.first, nearest.second}, index};
+      if ((candidates.size() == count) && !is_nearer(candidate, candidates.back())) {
+        return;
+      }
+      candidates.insert(
+          std::upper_bound(candidates.begin(), candidates.end(), candidate, is_nearer),
+          candidate);
+      if (candidates.size() > count) {
+        candidates.pop_back();
+      }
+    };
+
+    if (count > 0u) {
+      for (auto index : _unbounded_roads) {
+        evaluate(index);
+      }
+    }
+
+    if ((count > 0u) && !_nodes.empty()) {
+      const double x = location.x;
+      const double y = location.y;
+
+      struct Entry {
+        double distance;
+        uint32_t index;
+        bool is_item;
+
+        bool operator>(const Entry &rhs) const {
+          return distance > rhs.distance;
+        }
+      };
+
+      std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+      const auto &root = _nodes.back();
+      queue.push(Entry{std::sqrt(root.box.DistanceSquared(x, y)), static_cast<uint32_t>(_nodes.size() - 1u), false});
+
+      while (!queue.empty()) {
+        const auto entry = queue.top();
+        // A road is never nearer than the box of any of its geometries, we can
+        // stop once every box left is farther than the worst candidate.
+        if ((candidates.size() == count) && (entry.distance > candidates.back().road.distance)) {
+          break;
+        }
+        queue.pop();
+        if (entry.is_item) {
+          evaluate(_items[entry.index].road);
+          continue;
+        }
+        const auto &node = _nodes[entry.index];
+        for (auto i = node.begin; i < node.end; ++i) {
+          const auto &box = node.is_leaf ? _items[i].box : _nodes[i].box;
+          queue.push(Entry{std::sqrt(box.DistanceSquared(x, y)), i, node.is_leaf});
+        }
+      }
+    }
+
+    std::vector<NearestRoad> result;
+    result.reserve(candidates.size());
+    for (auto &&candidate : candidates) {
+      result.emplace_back(candidate.road);
+    }
+    return result;
+  }
+
+} // namespace road
+} // namespace carla
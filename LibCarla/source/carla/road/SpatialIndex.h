@@ -0,0 +1,109 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/geom/Location.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace carla {
+namespace road {
+
+  class MapData;
+
+namespace element {
+
+  class RoadSegment;
+
+} // namespace element
+
+  /// Static 2D index over the bounding boxes of the road geometries, used to
+  /// find the roads nearest to a location without visiting every road of the
+  /// map.
+  ///
+  /// The index is a bulk-loaded (sort-tile-recursive) R-tree built once when
+  /// the map is created.
+  class SpatialIndex : private MovableNonCopyable {
+  public:
+
+    struct NearestRoad {
+
+      const element::RoadSegment *road;
+
+      /// Distance along the road to the nearest point of its center line.
+      double s;
+
+      /// Euclidean distance from the location to the center line.
+      double distance;
+    };
+
+    SpatialIndex() = default;
+
+    explicit SpatialIndex(const MapData &data);
+
+    /// Return the @a count roads nearest to @a location sorted by distance,
+    /// ties are sorted in the order the roads are iterated in MapData.
+    ///
+    /// The result is exactly the same as computing
+    /// RoadSegment::GetNearestPoint for every road and keeping the @a count
+    /// nearest ones.
+    std::vector<NearestRoad> GetNearestRoads(
+        const geom::Location &location,
+        size_t count) const;
+
+  private:
+
+    struct Box {
+
+      double min_x;
+      double min_y;
+      double max_x;
+      double max_y;
+
+      double DistanceSquared(double x, double y) const;
+
+      void Extend(const Box &rhs);
+    };
+
+    struct Node {
+
+      Box box;
+
+      /// Range of children, in _nodes or _items depending on is_leaf.
+      uint32_t begin;
+      uint32_t end;
+
+      bool is_leaf;
+    };
+
+    struct Item {
+
+      Box box;
+
+      /// Index of the road in _roads.
+      uint32_t road;
+    };
+
+    void BuildTree();
+
+    /// Roads in the order they are iterated in MapData, the index in this
+    /// vector is used to break ties.
+    std::vector<const element::RoadSegment *> _roads;
+
+    /// Roads with geometries whose bounds cannot be computed, these are
+    /// always evaluated.
+    std::vector<uint32_t> _unbounded_roads;
+
+    std::vector<Item> _items;
+
+    std::vector<Node> _nodes;
+  };
+
+} // namespace road
+} // namespace carla
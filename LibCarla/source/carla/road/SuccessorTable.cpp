@@ -0,0 +1,68 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/road/SuccessorTable.h"
+
+#include "carla/Debug.h"
+#include "carla/road/MapData.h"
+#include "carla/road/element/RoadSegment.h"
+
+#include <algorithm>
+
+namespace carla {
+namespace road {
+
+  using namespace element;
+
+  SuccessorTable::SuccessorTable(const MapData &data) {
+    // (successor lane, exit of the predecessor) of every lane link.
+    std::vector<std::pair<uint64_t, WaypointHandle>> predecessors;
+    auto add_lanes = [&](const RoadSegment &road, const auto &lane_links, bool forward) {
+      for (auto &&item : lane_links) {
+        const auto lane_id = item.first;
+        // Lanes with negative id go forward and leave the road at its end,
+        // lanes with positive id go backward and leave it at its start.
+        if ((lane_id <= 0) != forward) {
+          continue;
+        }
+        const auto begin = static_cast<uint32_t>(_successors.size());
+        const WaypointHandle exit{road.GetId(), lane_id, lane_id <= 0 ? road.GetLength() : 0.0};
+        for (auto &&link : item.second) {
+          const auto next_lane_id = link.first;
+          const auto next_road = data.GetRoad(static_cast<id_type>(link.second));
+          DEBUG_ASSERT(next_lane_id != 0);
+          DEBUG_ASSERT(next_road != nullptr);
+          _successors.push_back({
+              next_road->GetId(),
+              next_lane_id,
+              next_lane_id < 0 ? 0.0 : next_road->GetLength()});
+          predecessors.emplace_back(MakeKey(next_road->GetId(), next_lane_id), exit);
+        }
+        _index.emplace(
+            MakeKey(road.GetId(), lane_id),
+            std::make_pair(begin, static_cast<uint32_t>(_successors.size())));
+      }
+    };
+    for (auto &&road : data.GetRoadSegments()) {
+      add_lanes(road, road.GetNextLanes(), true);
+      add_lanes(road, road.GetPrevLanes(), false);
+    }
+
+    // Same layout for the predecessors, keeping the order of the lane links.
+    std::stable_sort(predecessors.begin(), predecessors.end(), [](const auto &lhs, const auto &rhs) {
+      return lhs.first < rhs.first;
+    });
+    _predecessors.reserve(predecessors.size());
+    for (auto &&item : predecessors) {
+      const auto index = static_cast<uint32_t>(_predecessors.size());
+      auto result = _predecessor_index.emplace(item.first, std::make_pair(index, index));
+      result.first->second.second = index + 1u;
+      _predecessors.emplace_back(item.second);
+    }
+  }
+
+} // namespace road
+} // namespace carla
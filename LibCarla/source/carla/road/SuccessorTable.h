@@ -0,0 +1,85 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/ListView.h"
+#include "carla/NonCopyable.h"
+#include "carla/road/element/WaypointHandle.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace carla {
+namespace road {
+
+  class MapData;
+
+  /// Table with the successors and predecessors of every lane of a map, built
+  /// once when the map is created so that following lanes does not need to
+  /// look up the lane links of each road again.
+  ///
+  /// The successors of all the lanes are stored contiguously, each lane
+  /// indexes the range holding its own; the same for the predecessors.
+  class SuccessorTable : private MovableNonCopyable {
+  public:
+
+    using const_iterator = std::vector<element::WaypointHandle>::const_iterator;
+
+    SuccessorTable() = default;
+
+    explicit SuccessorTable(const MapData &data);
+
+    /// Waypoints at the entrance of each lane a vehicle can drive to from the
+    /// exit of lane @a lane_id of road @a road_id, in the order the lane
+    /// links are defined.
+    ListView<const_iterator> GetSuccessors(element::id_type road_id, int lane_id) const {
+      return GetRange(_index, _successors, road_id, lane_id);
+    }
+
+    /// Waypoints at the exit of each lane from which a vehicle can drive to
+    /// the entrance of lane @a lane_id of road @a road_id.
+    ListView<const_iterator> GetPredecessors(element::id_type road_id, int lane_id) const {
+      return GetRange(_predecessor_index, _predecessors, road_id, lane_id);
+    }
+
+    /// Total number of lane links in the table.
+    size_t size() const {
+      return _successors.size();
+    }
+
+  private:
+
+    /// Range [first, second) of the handles of each lane.
+    using Index = std::unordered_map<uint64_t, std::pair<uint32_t, uint32_t>>;
+
+    static uint64_t MakeKey(element::id_type road_id, int lane_id) {
+      return (static_cast<uint64_t>(road_id) << 32u) | static_cast<uint32_t>(lane_id);
+    }
+
+    static ListView<const_iterator> GetRange(
+        const Index &index,
+        const std::vector<element::WaypointHandle> &handles,
+        element::id_type road_id,
+        int lane_id) {
+      const auto it = index.find(MakeKey(road_id, lane_id));
+      return it == index.end() ?
+          MakeListView(handles.end(), handles.end()) :
+          MakeListView(handles.begin() + it->second.first, handles.begin() + it->second.second);
+    }
+
+    Index _index;
+
+    std::vector<element::WaypointHandle> _successors;
+
+    Index _predecessor_index;
+
+    std::vector<element::WaypointHandle> _predecessors;
+  };
+
+} // namespace road
+} // namespace carla
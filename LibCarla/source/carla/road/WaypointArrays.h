@@ -0,0 +1,108 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/geom/Transform.h"
+#include "carla/road/element/WaypointHandle.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace carla {
+namespace road {
+
+  /// List of waypoints stored as a structure of arrays. Each array holds the
+  /// values of every waypoint contiguously, e.g. locations are stored as
+  /// [x0, y0, z0, x1, y1, z1, ...].
+  class WaypointArrays {
+  public:
+
+    std::vector<uint32_t> road_ids;
+
+    std::vector<int32_t> lane_ids;
+
+    /// Distance along the road of each waypoint.
+    std::vector<double> s;
+
+    /// [x, y, z] per waypoint.
+    std::vector<float> locations;
+
+    /// [pitch, yaw, roll] per waypoint.
+    std::vector<float> rotations;
+
+    size_t size() const {
+      return road_ids.size();
+    }
+
+    bool empty() const {
+      return road_ids.empty();
+    }
+
+    element::WaypointHandle GetHandle(size_t index) const {
+      return {road_ids[index], lane_ids[index], s[index]};
+    }
+
+    void reserve(size_t count) {
+      road_ids.reserve(count);
+      lane_ids.reserve(count);
+      s.reserve(count);
+      locations.reserve(3u * count);
+      rotations.reserve(3u * count);
+    }
+
+    void push_back(const element::WaypointHandle &waypoint, const geom::Transform &transform) {
+      road_ids.emplace_back(static_cast<uint32_t>(waypoint.road_id));
+      lane_ids.emplace_back(static_cast<int32_t>(waypoint.lane_id));
+      s.emplace_back(waypoint.s);
+      locations.insert(locations.end(), {
+          transform.location.x,
+          transform.location.y,
+          transform.location.z});
+      rotations.insert(rotations.end(), {
+          transform.rotation.pitch,
+          transform.rotation.yaw,
+          transform.rotation.roll});
+    }
+
+    /// Append the waypoints of @a rhs at the end of this list.
+    void Append(const WaypointArrays &rhs) {
+      Append(road_ids, rhs.road_ids);
+      Append(lane_ids, rhs.lane_ids);
+      Append(s, rhs.s);
+      Append(locations, rhs.locations);
+      Append(rotations, rhs.rotations);
+    }
+
+  private:
+
+    template <typename T>
+    static void Append(std::vector<T> &dst, const std::vector<T> &src) {
+      dst.insert(dst.end(), src.begin(), src.end());
+    }
+  };
+
+  /// Edges of the topology of a map, the i-th edge goes from waypoint @a i of
+  /// @a from to waypoint @a i of @a to.
+  class TopologyArrays {
+  public:
+
+    WaypointArrays from;
+
+    WaypointArrays to;
+
+    size_t size() const {
+      return from.size();
+    }
+
+    void Append(const TopologyArrays &rhs) {
+      from.Append(rhs.from);
+      to.Append(rhs.to);
+    }
+  };
+
+} // namespace road
+} // namespace carla
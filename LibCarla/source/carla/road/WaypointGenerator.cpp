@@ -6,8 +6,14 @@
 
 #include "carla/road/WaypointGenerator.h"
 
+#include "carla/ThreadGroup.h"
 #include "carla/road/Map.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <tuple>
+
 namespace carla {
 namespace road {
 
@@ -17,57 +23,143 @@ namespace road {
   // -- Static local methods ---------------------------------------------------
   // ===========================================================================
 
-  template <typename T>
-  static std::vector<T> ConcatVectors(std::vector<T> dst, std::vector<T> src) {
-    if (src.size() > dst.size()) {
-      return ConcatVectors(src, dst);
-    }
-    dst.insert(
-        dst.end(),
-        std::make_move_iterator(src.begin()),
-        std::make_move_iterator(src.end()));
-    return dst;
+  template <typename FuncT>
+  static void ForEachLane(const RoadSegment &road, double s, LaneTypeMask lane_type, FuncT &&func) {
+    const auto info = road.GetInfo<RoadInfoLane>(s);
+    DEBUG_ASSERT(info != nullptr);
+    info->ForEachLane(lane_type, std::forward<FuncT>(func));
   }
 
   template <typename FuncT>
   static void ForEachDrivableLane(const RoadSegment &road, double s, FuncT &&func) {
-    const auto info = road.GetInfo<RoadInfoLane>(s);
-    DEBUG_ASSERT(info != nullptr);
-    for (auto &&lane_id : info->getLanesIDs(RoadInfoLane::which_lane_e::Both)) {
-      if (info->getLane(lane_id)->_type == "driving") {
-        func(lane_id);
+    ForEachLane(road, s, static_cast<LaneTypeMask>(LaneType::Driving), std::forward<FuncT>(func));
+  }
+
+  /// Waypoint at the entrance of lane @a lane_id of @a road.
+  static WaypointHandle GetLaneEntrance(const RoadSegment &road, int lane_id) {
+    return {road.GetId(), lane_id, lane_id < 0 ? 0.0 : road.GetLength()};
+  }
+
+  static auto GetSuccessorLanes(const Map &map, id_type road_id, int lane_id) {
+    const auto successors = map.GetSuccessorTable().GetSuccessors(road_id, lane_id);
+    if (successors.empty()) {
+      log_error("road id =", road_id, "lane id =", lane_id, ": missing next lanes");
+    }
+    return successors;
+  }
+
+  /// Call @a func with each waypoint at @a distance ahead of @a waypoint
+  /// along its lane and the lanes following it, in depth-first order of the
+  /// successors.
+  ///
+  /// The lanes are followed iteratively; only when the lanes branch the
+  /// pending branches are kept in a stack.
+  template <typename FuncT>
+  static void ForEachNext(
+      const Map &map,
+      WaypointHandle waypoint,
+      double distance,
+      FuncT &&func) {
+    DEBUG_ASSERT(waypoint.lane_id != 0);
+    std::vector<std::pair<WaypointHandle, double>> pending;
+    for (;;) {
+      const auto road = map.GetData().GetRoad(waypoint.road_id);
+      DEBUG_ASSERT(road != nullptr);
+      double distance_on_next_segment;
+      if (waypoint.lane_id <= 0) {
+        // road goes forward.
+        const auto total_distance = waypoint.s + distance;
+        const auto road_length = road->GetLength();
+        distance_on_next_segment = total_distance - road_length;
+        waypoint.s = total_distance;
+      } else {
+        // road goes backward.
+        const auto total_distance = waypoint.s - distance;
+        distance_on_next_segment = -total_distance;
+        waypoint.s = total_distance;
+      }
+
+      if (distance_on_next_segment <= 0.0) {
+        func(waypoint);
+      } else {
+        const auto successors = GetSuccessorLanes(map, waypoint.road_id, waypoint.lane_id);
+        if (!successors.empty()) {
+          // Keep following the first successor, the others are visited
+          // afterwards in order.
+          for (auto it = successors.end() - 1; it != successors.begin(); --it) {
+            pending.emplace_back(*it, distance_on_next_segment);
+          }
+          waypoint = *successors.begin();
+          distance = distance_on_next_segment;
+          continue;
+        }
+      }
+
+      if (pending.empty()) {
+        break;
       }
+      std::tie(waypoint, distance) = pending.back();
+      pending.pop_back();
     }
   }
 
+  /// Split the road segments of @a map in chunks and call
+  /// @a func(road_segment, result) for each of them, where result is the
+  /// ResultT of the chunk the road belongs to. Chunks are processed by
+  /// @a number_of_threads threads, and appended in order to the result.
+  template <typename ResultT, typename FuncT>
+  static ResultT ParallelForEachRoad(const Map &map, size_t number_of_threads, FuncT &&func) {
+    constexpr size_t roads_per_chunk = 16u;
+
+    std::vector<const RoadSegment *> roads;
+    roads.reserve(map.GetData().GetRoadCount());
+    for (auto &&road_segment : map.GetData().GetRoadSegments()) {
+      roads.emplace_back(&road_segment);
+    }
+
+    const size_t number_of_chunks = (roads.size() + roads_per_chunk - 1u) / roads_per_chunk;
+    std::vector<ResultT> chunk_results(number_of_chunks);
+    std::atomic_size_t next_chunk{0u};
+    auto worker = [&]() {
+      for (auto chunk = next_chunk++; chunk < number_of_chunks; chunk = next_chunk++) {
+        const auto begin = chunk * roads_per_chunk;
+        const auto end = std::min(begin + roads_per_chunk, roads.size());
+        for (auto i = begin; i < end; ++i) {
+          func(*roads[i], chunk_results[chunk]);
+        }
+      }
+    };
+
+    if (number_of_threads == 0u) {
+      number_of_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    number_of_threads = std::min(number_of_threads, number_of_chunks);
+    if (number_of_threads <= 1u) {
+      worker();
+    } else {
+      ThreadGroup workers;
+      workers.CreateThreads(number_of_threads - 1u, worker);
+      worker();
+    }
+
+    ResultT result;
+    for (auto &&chunk_result : chunk_results) {
+      result.Append(chunk_result);
+    }
+    return result;
+  }
+
   // ===========================================================================
   // -- WaypointGenerator ------------------------------------------------------
   // ===========================================================================
 
   std::vector<Waypoint> WaypointGenerator::GetSuccessors(const Waypoint &waypoint) {
     auto &map = waypoint._map;
-    const auto this_lane_id = waypoint.GetLaneId();
-    const auto this_road_id = waypoint.GetRoadId();
-
-    const auto &next_lanes =
-        this_lane_id <= 0 ?
-            waypoint.GetRoadSegment().GetNextLane(this_lane_id) :
-            waypoint.GetRoadSegment().GetPrevLane(this_lane_id);
-
-    if (next_lanes.empty()) {
-      log_error("road id =", this_road_id, "lane id =", this_lane_id, ": missing next lanes");
-    }
-
+    const auto successors = GetSuccessorLanes(*map, waypoint.GetRoadId(), waypoint.GetLaneId());
     std::vector<Waypoint> result;
-    result.reserve(next_lanes.size());
-    for (auto &&pair : next_lanes) {
-      const auto lane_id = pair.first;
-      const auto road_id = pair.second;
-      const auto road = map->GetData().GetRoad(road_id);
-      DEBUG_ASSERT(lane_id != 0);
-      DEBUG_ASSERT(road != nullptr);
-      const auto distance = lane_id < 0 ? 0.0 : road->GetLength();
-      result.push_back(Waypoint(map, road_id, lane_id, distance));
+    result.reserve(static_cast<size_t>(successors.size()));
+    for (auto &&successor : successors) {
+      result.push_back(Waypoint(map, successor.road_id, successor.lane_id, successor.s));
     }
     return result;
   }
@@ -75,38 +167,31 @@ namespace road {
   std::vector<Waypoint> WaypointGenerator::GetNext(
       const Waypoint &waypoint,
       double distance) {
-    auto &map = waypoint._map;
-    const auto this_road_id = waypoint.GetRoadId();
-    const auto this_lane_id = waypoint.GetLaneId();
-
-    DEBUG_ASSERT(this_lane_id != 0);
-
-    double distance_on_next_segment;
-
-    if (this_lane_id <= 0) {
-      // road goes forward.
-      const auto total_distance = waypoint._dist + distance;
-      const auto road_length = waypoint.GetRoadSegment().GetLength();
-      if (total_distance <= road_length) {
-        return { Waypoint(map, this_road_id, this_lane_id, total_distance) };
-      }
-      distance_on_next_segment = total_distance - road_length;
-    } else {
-      // road goes backward.
-      const auto total_distance = waypoint._dist - distance;
-      if (total_distance >= 0.0) {
-        return { Waypoint(map, this_road_id, this_lane_id, total_distance) };
-      }
-      distance_on_next_segment = std::abs(total_distance);
-    }
-
     std::vector<Waypoint> result;
-    for (auto &&next_waypoint : GetSuccessors(waypoint)) {
-      result = ConcatVectors(result, GetNext(next_waypoint, distance_on_next_segment));
-    }
+    GetNext(waypoint, distance, result);
     return result;
   }
 
+  void WaypointGenerator::GetNext(
+      const Waypoint &waypoint,
+      double distance,
+      std::vector<Waypoint> &result) {
+    auto &map = waypoint._map;
+    ForEachNext(*map, waypoint.GetHandle(), distance, [&](const WaypointHandle &next) {
+      result.push_back(Waypoint(map, next.road_id, next.lane_id, next.s));
+    });
+  }
+
+  void WaypointGenerator::GetNext(
+      const Map &map,
+      const WaypointHandle &waypoint,
+      double distance,
+      std::vector<WaypointHandle> &result) {
+    ForEachNext(map, waypoint, distance, [&](const WaypointHandle &next) {
+      result.push_back(next);
+    });
+  }
+
   boost::optional<Waypoint> WaypointGenerator::GetRight(const Waypoint &waypoint) {
     auto &map = waypoint._map;
     const auto this_road_id = waypoint.GetRoadId();
@@ -158,12 +243,13 @@ namespace road {
 
   std::vector<Waypoint> WaypointGenerator::GenerateAll(
       const Map &map,
-      const double distance) {
+      const double distance,
+      const LaneTypeMask lane_type) {
     std::vector<Waypoint> result;
     for (auto &&road_segment : map.GetData().GetRoadSegments()) {
       /// @todo Should distribute them equally along the segment?
       for (double s = 0.0; s < road_segment.GetLength(); s += distance) {
-        ForEachDrivableLane(road_segment, s, [&](auto lane_id) {
+        ForEachLane(road_segment, s, lane_type, [&](auto lane_id) {
           result.push_back(Waypoint(map.shared_from_this(), road_segment.GetId(), lane_id, s));
         });
       }
@@ -224,5 +310,36 @@ namespace road {
     return result;
   }
 
+  WaypointArrays WaypointGenerator::GenerateAllArrays(
+      const Map &map,
+      const double distance,
+      const LaneTypeMask lane_type,
+      const size_t number_of_threads) {
+    DEBUG_ASSERT(distance > 0.0);
+    return ParallelForEachRoad<WaypointArrays>(map, number_of_threads, [&](const RoadSegment &road_segment, WaypointArrays &result) {
+      for (double s = 0.0; s < road_segment.GetLength(); s += distance) {
+        ForEachLane(road_segment, s, lane_type, [&](int lane_id) {
+          const WaypointHandle waypoint{road_segment.GetId(), lane_id, s};
+          result.push_back(waypoint, map.ComputeTransform(waypoint));
+        });
+      }
+    });
+  }
+
+  TopologyArrays WaypointGenerator::GenerateTopologyArrays(
+      const Map &map,
+      const size_t number_of_threads) {
+    return ParallelForEachRoad<TopologyArrays>(map, number_of_threads, [&](const RoadSegment &road_segment, TopologyArrays &result) {
+      ForEachDrivableLane(road_segment, 0.0, [&](int lane_id) {
+        const auto this_waypoint = GetLaneEntrance(road_segment, lane_id);
+        const auto this_transform = map.ComputeTransform(this_waypoint);
+        for (auto &&successor : GetSuccessorLanes(map, road_segment.GetId(), lane_id)) {
+          result.from.push_back(this_waypoint, this_transform);
+          result.to.push_back(successor, map.ComputeTransform(successor));
+        }
+      });
+    });
+  }
+
 } // namespace road
 } // namespace carla
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "carla/road/WaypointArrays.h"
 #include "carla/road/element/Waypoint.h"
 
 #include <boost/optional.hpp>
@@ -35,6 +36,21 @@ namespace road {
         const Waypoint &waypoint,
         double distance);
 
+    /// Same as GetNext, but the waypoints are appended to @a result.
+    static void GetNext(
+        const Waypoint &waypoint,
+        double distance,
+        std::vector<Waypoint> &result);
+
+    /// Same as GetNext, but works on handles of @a map and appends them to
+    /// @a result. Allocates no memory unless @a result runs out of capacity or
+    /// the lanes followed branch.
+    static void GetNext(
+        const Map &map,
+        const element::WaypointHandle &waypoint,
+        double distance,
+        std::vector<element::WaypointHandle> &result);
+
     /// Return a waypoint at the lane of @a waypoint's right lane.
     static boost::optional<Waypoint> GetRight(
         const Waypoint &waypoint);
@@ -43,10 +59,12 @@ namespace road {
     static boost::optional<Waypoint> GetLeft(
         const Waypoint &waypoint);
 
-    /// Generate all the waypoints in @a map separated by @a approx_distance.
+    /// Generate all the waypoints in @a map separated by @a approx_distance,
+    /// placed on the lanes whose type matches @a lane_type.
     static std::vector<Waypoint> GenerateAll(
         const Map &map,
-        double approx_distance);
+        double approx_distance,
+        element::LaneTypeMask lane_type = static_cast<element::LaneTypeMask>(element::LaneType::Driving));
 
     /// Returns a list of waypoints at the beginning of each lane of the map.
     static std::vector<Waypoint> GenerateLaneBegin(
@@ -61,6 +79,23 @@ namespace road {
     static std::vector<std::pair<Waypoint, Waypoint>> GenerateTopology(
         const Map &map);
 
+    /// Same as GenerateAll, but the waypoints and their transforms are written
+    /// into flat arrays instead of creating a Waypoint for each of them.
+    ///
+    /// The road segments are distributed among @a number_of_threads threads,
+    /// zero uses one thread per hardware core. The result is the same
+    /// regardless of the number of threads.
+    static WaypointArrays GenerateAllArrays(
+        const Map &map,
+        double approx_distance,
+        element::LaneTypeMask lane_type = static_cast<element::LaneTypeMask>(element::LaneType::Driving),
+        size_t number_of_threads = 0u);
+
+    /// Same as GenerateTopology, but the edges are written into flat arrays.
+    static TopologyArrays GenerateTopologyArrays(
+        const Map &map,
+        size_t number_of_threads = 0u);
+
   };
 
 } // namespace road
@@ -0,0 +1,182 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/road/element/Geometry.h"
+
+namespace carla {
+namespace road {
+namespace element {
+
+  // ===========================================================================
+  // -- Static local methods ---------------------------------------------------
+  // ===========================================================================
+
+  /// Circular arc starting at a tessellation sample with the curvature that
+  /// matches the tangents at both ends of the segment.
+  struct LocalArc {
+
+    LocalArc(const GeometryTessellation &tessellation, size_t i)
+      : x(tessellation.x[i]),
+        y(tessellation.y[i]),
+        end_x(tessellation.x[i + 1u]),
+        end_y(tessellation.y[i + 1u]),
+        heading(tessellation.heading[i]),
+        tx(tessellation.tangent_x[i]),
+        ty(tessellation.tangent_y[i]),
+        length(tessellation.s[i + 1u] - tessellation.s[i]),
+        curvature(length > 0.0 ? (tessellation.heading[i + 1u] - heading) / length : 0.0) {}
+
+    /// Point at @a u meters from the beginning of the segment.
+    DirectedPoint PosFromDist(double u) const {
+      const double angle = curvature * u;
+      double forward, left;
+      if (std::fabs(angle) < 1e-6) {
+        forward = u;
+        left = 0.5 * angle * u;
+      } else {
+        forward = std::sin(angle) / curvature;
+        left = (1.0 - std::cos(angle)) / curvature;
+      }
+      return DirectedPoint(
+          x + forward * tx - left * ty,
+          y + forward * ty + left * tx,
+          0.0,
+          heading + angle);
+    }
+
+    /// Distance along the segment and Euclidean distance to the nearest
+    /// point of the segment to (@a px, @a py).
+    std::pair<double, double> DistanceTo(double px, double py) const {
+      const double dx = px - x;
+      const double dy = py - y;
+      if (std::fabs(curvature * length) < 1e-9) {
+        const double u = std::min(length, std::max(0.0, dx * tx + dy * ty));
+        return {u, Norm(dx - u * tx, dy - u * ty)};
+      }
+      // Vectors from the center of the circle to the start and to p.
+      const double radius = 1.0 / curvature;
+      const double ax = radius * ty;
+      const double ay = -radius * tx;
+      const double vx = dx + ax;
+      const double vy = dy + ay;
+      const double angle = std::atan2(ax * vy - ay * vx, ax * vx + ay * vy);
+      const double u = angle / curvature;
+      if ((u >= 0.0) && (u <= length)) {
+        return {u, std::fabs(Norm(vx, vy) - std::fabs(radius))};
+      }
+      const double start_distance = Norm(dx, dy);
+      const double end_distance = Norm(px - end_x, py - end_y);
+      return (start_distance <= end_distance) ?
+          std::make_pair(0.0, start_distance) :
+          std::make_pair(length, end_distance);
+    }
+
+    static double Norm(double x, double y) {
+      return std::sqrt(x * x + y * y);
+    }
+
+    double x;
+    double y;
+    double end_x;
+    double end_y;
+    double heading;
+    double tx;
+    double ty;
+    double length;
+    double curvature;
+  };
+
+  static double DistanceSquaredToSegment(
+      const GeometryTessellation &tessellation,
+      size_t i,
+      double px,
+      double py) {
+    const double x0 = tessellation.x[i];
+    const double y0 = tessellation.y[i];
+    const double sx = tessellation.x[i + 1u] - x0;
+    const double sy = tessellation.y[i + 1u] - y0;
+    const double l2 = sx * sx + sy * sy;
+    const double dx = px - x0;
+    const double dy = py - y0;
+    const double t = l2 > 0.0 ? std::min(1.0, std::max(0.0, (dx * sx + dy * sy) / l2)) : 0.0;
+    const double ex = dx - t * sx;
+    const double ey = dy - t * sy;
+    return ex * ex + ey * ey;
+  }
+
+  // ===========================================================================
+  // -- Geometry ---------------------------------------------------------------
+  // ===========================================================================
+
+  double Geometry::MaxTessellationStep(double curvature) {
+    curvature = std::fabs(curvature);
+    if (curvature <= 1e-15) {
+      return std::numeric_limits<double>::infinity();
+    }
+    const double radius = 1.0 / curvature;
+    const double error = std::min(max_tessellation_error(), radius);
+    // The sagitta of a chord spanning an angle a is r * (1 - cos(a / 2)).
+    return 2.0 * radius * std::acos(1.0 - error * curvature);
+  }
+
+  std::pair<double, double> Geometry::DistanceToTessellation(const geom::Location &p) const {
+    const auto &t = _tessellation;
+    const double px = p.x;
+    const double py = p.y;
+    if (t.size() < 2u) {
+      return {0.0, geom::Math::Distance2D(_start_position, p)};
+    }
+
+    // Find the nearest chord, the curve is at most max_error away from it.
+    const size_t segments = t.size() - 1u;
+    size_t nearest = 0u;
+    double nearest_chord = std::numeric_limits<double>::max();
+    for (size_t i = 0u; i < segments; ++i) {
+      const double d2 = DistanceSquaredToSegment(t, i, px, py);
+      if (d2 < nearest_chord) {
+        nearest_chord = d2;
+        nearest = i;
+      }
+    }
+
+    auto result = LocalArc(t, nearest).DistanceTo(px, py);
+    result.first += t.s[nearest];
+
+    // Refine any other segment that may still contain a nearer point.
+    const double threshold = result.second + t.max_error;
+    const double threshold2 = threshold * threshold;
+    for (size_t i = 0u; i < segments; ++i) {
+      if ((i == nearest) || (DistanceSquaredToSegment(t, i, px, py) > threshold2)) {
+        continue;
+      }
+      auto candidate = LocalArc(t, i).DistanceTo(px, py);
+      if (candidate.second < result.second) {
+        result = {t.s[i] + candidate.first, candidate.second};
+      }
+    }
+    return result;
+  }
+
+  DirectedPoint Geometry::PosFromTessellation(double dist) const {
+    const auto &t = _tessellation;
+    DirectedPoint point(_start_position, _heading);
+    if (t.size() < 2u) {
+      return point;
+    }
+    dist = std::min(t.s.back(), std::max(0.0, dist));
+    // Segment containing dist.
+    auto it = std::upper_bound(t.s.begin() + 1, t.s.end() - 1, dist);
+    const auto i = static_cast<size_t>(std::distance(t.s.begin(), it) - 1);
+    const auto local = LocalArc(t, i).PosFromDist(dist - t.s[i]);
+    point.location.x = static_cast<float>(local.location.x);
+    point.location.y = static_cast<float>(local.location.y);
+    point.tangent = local.tangent;
+    return point;
+  }
+
+} // namespace element
+} // namespace road
+} // namespace carla
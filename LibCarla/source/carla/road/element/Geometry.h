@@ -11,7 +11,10 @@
 #include "carla/geom/Math.h"
 #include "carla/road/element/cephes/fresnel.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <vector>
 
 namespace carla {
 namespace road {
@@ -59,9 +62,41 @@ namespace element {
     }
   };
 
+  /// Polyline approximation of a geometry, samples are stored as flat arrays.
+  /// The curve between two consecutive samples deviates at most max_error
+  /// from the chord joining them.
+  struct GeometryTessellation {
+
+    /// Distance from the beginning of the geometry.
+    std::vector<double> s;
+
+    std::vector<double> x;
+
+    std::vector<double> y;
+
+    /// Tangent of the geometry at each sample [radians].
+    std::vector<double> heading;
+
+    /// Unit vector of the tangent at each sample.
+    std::vector<double> tangent_x;
+
+    std::vector<double> tangent_y;
+
+    double max_error = 0.0;
+
+    size_t size() const {
+      return s.size();
+    }
+  };
+
   class Geometry {
   public:
 
+    /// Maximum distance between a geometry and its tessellation [meters].
+    static constexpr double max_tessellation_error() {
+      return 0.1;
+    }
+
     GeometryType GetType() const {
       return _type;
     }
@@ -75,7 +110,7 @@ namespace element {
       return _heading;
     }
 
-    const geom::Location &GetStartPosition() {
+    const geom::Location &GetStartPosition() const {
       return _start_position;
     }
 
@@ -85,6 +120,10 @@ namespace element {
 
     virtual std::pair<double, double> DistanceTo(const geom::Location &p) const = 0;
 
+    const GeometryTessellation &GetTessellation() const {
+      return _tessellation;
+    }
+
   protected:
 
     Geometry(
@@ -100,6 +139,24 @@ namespace element {
         _start_position(start_pos)
     {}
 
+    /// Arc length of the longest chord whose distance to a curve of
+    /// @a curvature is below max_tessellation_error().
+    static double MaxTessellationStep(double curvature);
+
+    /// Sample the geometry at most every @a max_step meters using
+    /// @a pos_from_dist to compute the points, called from the constructors.
+    template <typename PosFromDistT>
+    void Tessellate(double max_step, PosFromDistT &&pos_from_dist);
+
+    /// Nearest point to @a p computed with the tessellation. The candidate
+    /// segments are refined with the circular arc matching the tangents at
+    /// both ends of each segment.
+    std::pair<double, double> DistanceToTessellation(const geom::Location &p) const;
+
+    /// Point at @a dist computed interpolating the tessellation with the
+    /// circular arc matching the tangents at both ends of each segment.
+    DirectedPoint PosFromTessellation(double dist) const;
+
   protected:
 
     GeometryType _type;             // geometry type
@@ -109,8 +166,36 @@ namespace element {
     double _heading;                // start orientation [radians]
 
     geom::Location _start_position; // [meters]
+
+    GeometryTessellation _tessellation;
   };
 
+  template <typename PosFromDistT>
+  inline void Geometry::Tessellate(double max_step, PosFromDistT &&pos_from_dist) {
+    constexpr double max_segments = 1e5;
+    const auto segments = (_length > 0.0) ?
+        static_cast<size_t>(std::min(max_segments, std::max(1.0, std::ceil(_length / max_step)))) :
+        0u;
+    _tessellation = GeometryTessellation{};
+    _tessellation.max_error = max_tessellation_error();
+    _tessellation.s.reserve(segments + 1u);
+    _tessellation.x.reserve(segments + 1u);
+    _tessellation.y.reserve(segments + 1u);
+    _tessellation.heading.reserve(segments + 1u);
+    _tessellation.tangent_x.reserve(segments + 1u);
+    _tessellation.tangent_y.reserve(segments + 1u);
+    for (size_t i = 0u; i <= segments; ++i) {
+      const double s = (i == segments) ? _length : _length * static_cast<double>(i) / static_cast<double>(segments);
+      const DirectedPoint point = (i == 0u) ? DirectedPoint(_start_position, _heading) : pos_from_dist(s);
+      _tessellation.s.emplace_back(i == 0u ? 0.0 : s);
+      _tessellation.x.emplace_back(point.location.x);
+      _tessellation.y.emplace_back(point.location.y);
+      _tessellation.heading.emplace_back(point.tangent);
+      _tessellation.tangent_x.emplace_back(std::cos(point.tangent));
+      _tessellation.tangent_y.emplace_back(std::sin(point.tangent));
+    }
+  }
+
   class GeometryLine : public Geometry {
   public:
 
@@ -119,7 +204,11 @@ namespace element {
         double length,
         double heading,
         const geom::Location &start_pos)
-      : Geometry(GeometryType::LINE, start_offset, length, heading, start_pos) {}
+      : Geometry(GeometryType::LINE, start_offset, length, heading, start_pos) {
+      Tessellate(
+          std::numeric_limits<double>::infinity(),
+          [this](double dist) { return PosFromDist(dist); });
+    }
 
     const DirectedPoint PosFromDist(const double dist) const override {
       assert(dist > 0);
@@ -154,14 +243,22 @@ namespace element {
         const geom::Location &start_pos,
         double curv)
       : Geometry(GeometryType::ARC, start_offset, length, heading, start_pos),
-        _curvature(curv) {}
+        _curvature(curv) {
+      Tessellate(
+          MaxTessellationStep(_curvature),
+          [this](double dist) { return PosFromDist(dist); });
+    }
 
     const DirectedPoint PosFromDist(double dist) const override {
       assert(dist > 0);
       assert(_length > 0.0);
-      assert(std::fabs(_curvature) > 1e-15);
-      const double radius = 1.0 / _curvature;
       DirectedPoint p(_start_position, _heading);
+      if (std::fabs(_curvature) <= 1e-15) {
+        p.location.x += dist * std::cos(p.tangent);
+        p.location.y += dist * std::sin(p.tangent);
+        return p;
+      }
+      const double radius = 1.0 / _curvature;
       p.location.x -= radius * std::cos(p.tangent + geom::Math::pi_half());
       p.location.y -= radius * std::sin(p.tangent + geom::Math::pi_half());
       p.tangent -= dist * _curvature;
@@ -184,7 +281,7 @@ namespace element {
           _curvature);
     }
 
-    double GetCurvature() {
+    double GetCurvature() const {
       return _curvature;
     }
 
@@ -205,47 +302,58 @@ namespace element {
         double curv_e)
       : Geometry(GeometryType::SPIRAL, start_offset, length, heading, start_pos),
         _curve_start(curv_s),
-        _curve_end(curv_e) {}
+        _curve_end(curv_e) {
+      Tessellate(
+          MaxTessellationStep(std::max(std::abs(_curve_start), std::abs(_curve_end))),
+          [this](double dist) { return PosFromFresnel(dist); });
+    }
 
-    double GetCurveStart() {
+    double GetCurveStart() const {
       return _curve_start;
     }
 
-    double GetCurveEnd() {
+    double GetCurveEnd() const {
       return _curve_end;
     }
 
+    /// Evaluating the Fresnel integrals is expensive, the spiral is sampled
+    /// once on construction and interpolated afterwards.
     const DirectedPoint PosFromDist(double dist) const override {
-      // not working yet with negative values
-      assert(dist > 0);
-      assert(_length > 0.0);
-      assert(std::fabs(_curve_end) > 1e-15);
-      const double radius = 1.0 / _curve_end;
+      return PosFromTessellation(dist);
+    }
+
+    std::pair<double, double> DistanceTo(const geom::Location &p) const override {
+      return DistanceToTessellation(p);
+    }
+
+  private:
+
+    /// @todo Spirals starting with a non-zero curvature are not supported.
+    DirectedPoint PosFromFresnel(double dist) const {
+      DirectedPoint p(_start_position, _heading);
+      if (std::fabs(_curve_end) <= 1e-15) {
+        p.location.x += dist * std::cos(p.tangent);
+        p.location.y += dist * std::sin(p.tangent);
+        return p;
+      }
+      // Computed for a positive curvature and mirrored if negative.
+      const double sign = _curve_end < 0.0 ? -1.0 : 1.0;
+      const double radius = 1.0 / std::fabs(_curve_end);
       const double extra_norm = 1.0 / std::sqrt(geom::Math::pi_half());
       const double norm = 1.0 / std::sqrt(2.0 * radius * _length);
       const double length = dist * norm;
       double S, C;
       fresnl(length * extra_norm, &S, &C);
-      S /= (norm * extra_norm);
+      S *= sign / (norm * extra_norm);
       C /= (norm * extra_norm);
-      DirectedPoint p(_start_position, _heading);
       const double cos_a = std::cos(p.tangent);
       const double sin_a = std::sin(p.tangent);
       p.location.x += C * cos_a - S * sin_a;
       p.location.y += S * cos_a + C * sin_a;
-      p.tangent += length * length;
-
+      p.tangent += sign * length * length;
       return p;
     }
 
-    /// @todo
-    std::pair<double, double> DistanceTo(const geom::Location &) const override {
-      DEBUG_ERROR;
-      return {0.0, 0.0};
-    }
-
-  private:
-
     double _curve_start;
     double _curve_end;
   };
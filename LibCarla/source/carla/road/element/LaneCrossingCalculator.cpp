@@ -33,16 +33,30 @@ namespace element {
     }
   }
 
-  static bool IsOffRoad(const Map &map, const geom::Location &location) {
-    return !map.GetWaypoint(location).has_value();
+  /// Same check as Map::GetWaypoint, given the waypoint nearest to
+  /// @a location.
+  static bool IsOffRoad(const Map &map, const Waypoint &waypoint, const geom::Location &location) {
+    return !map.IsInsideLane(waypoint.GetHandle(), location);
   }
 
   std::vector<LaneMarking> LaneCrossingCalculator::Calculate(
       const Map &map,
       const geom::Location &origin,
       const geom::Location &destination) {
-    auto w0 = map.GetClosestWaypointOnRoad(origin);
-    auto w1 = map.GetClosestWaypointOnRoad(destination);
+    return Calculate(
+        map,
+        map.GetClosestWaypointOnRoad(origin),
+        origin,
+        map.GetClosestWaypointOnRoad(destination),
+        destination);
+  }
+
+  std::vector<LaneMarking> LaneCrossingCalculator::Calculate(
+      const Map &map,
+      const Waypoint &w0,
+      const geom::Location &origin,
+      const Waypoint &w1,
+      const geom::Location &destination) {
     if (w0.GetRoadId() != w1.GetRoadId()) {
       /// @todo This case should also be handled.
       return {};
@@ -53,8 +67,8 @@ namespace element {
     return CrossingAtSameSection(
         w0.GetLaneId(),
         w1.GetLaneId(),
-        IsOffRoad(map, origin),
-        IsOffRoad(map, destination));
+        IsOffRoad(map, w0, origin),
+        IsOffRoad(map, w1, destination));
   }
 
 } // namespace element
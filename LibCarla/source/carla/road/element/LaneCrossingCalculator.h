@@ -18,6 +18,8 @@ namespace road {
 
 namespace element {
 
+  class Waypoint;
+
   class LaneCrossingCalculator {
   public:
 
@@ -25,6 +27,15 @@ namespace element {
         const Map &map,
         const geom::Location &origin,
         const geom::Location &destination);
+
+    /// Same as above with the waypoints nearest to @a origin and
+    /// @a destination already computed, no search in the map is done.
+    static std::vector<LaneMarking> Calculate(
+        const Map &map,
+        const Waypoint &origin_waypoint,
+        const geom::Location &origin,
+        const Waypoint &destination_waypoint,
+        const geom::Location &destination);
   };
 
 } // namespace element
@@ -0,0 +1,59 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/road/element/LaneType.h"
+
+#include <utility>
+
+namespace carla {
+namespace road {
+namespace element {
+
+  static const std::pair<LaneType, std::string> LANE_TYPE_NAMES[] = {
+    {LaneType::Driving,       "driving"},
+    {LaneType::Stop,          "stop"},
+    {LaneType::Shoulder,      "shoulder"},
+    {LaneType::Biking,        "biking"},
+    {LaneType::Sidewalk,      "sidewalk"},
+    {LaneType::Border,        "border"},
+    {LaneType::Restricted,    "restricted"},
+    {LaneType::Parking,       "parking"},
+    {LaneType::Bidirectional, "bidirectional"},
+    {LaneType::Median,        "median"},
+    {LaneType::Special1,      "special1"},
+    {LaneType::Special2,      "special2"},
+    {LaneType::Special3,      "special3"},
+    {LaneType::RoadWorks,     "roadWorks"},
+    {LaneType::Tram,          "tram"},
+    {LaneType::Rail,          "rail"},
+    {LaneType::Entry,         "entry"},
+    {LaneType::Exit,          "exit"},
+    {LaneType::OffRamp,       "offRamp"},
+    {LaneType::OnRamp,        "onRamp"},
+    {LaneType::None,          "none"}
+  };
+
+  LaneType ParseLaneType(const std::string &name) {
+    for (auto &&item : LANE_TYPE_NAMES) {
+      if (item.second == name) {
+        return item.first;
+      }
+    }
+    return LaneType::None;
+  }
+
+  const std::string &ToString(LaneType type) {
+    for (auto &&item : LANE_TYPE_NAMES) {
+      if (item.first == type) {
+        return item.second;
+      }
+    }
+    return ToString(LaneType::None);
+  }
+
+} // namespace element
+} // namespace road
+} // namespace carla
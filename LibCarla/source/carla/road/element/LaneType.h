@@ -0,0 +1,70 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace carla {
+namespace road {
+namespace element {
+
+  /// Lane types defined by OpenDRIVE. Each type is a bit flag so they can be
+  /// combined in a LaneTypeMask, e.g. (Driving | Parking).
+  enum class LaneType : uint32_t {
+    None          = 0x0u,
+    Driving       = 0x1u << 0u,
+    Stop          = 0x1u << 1u,
+    Shoulder      = 0x1u << 2u,
+    Biking        = 0x1u << 3u,
+    Sidewalk      = 0x1u << 4u,
+    Border        = 0x1u << 5u,
+    Restricted    = 0x1u << 6u,
+    Parking       = 0x1u << 7u,
+    Bidirectional = 0x1u << 8u,
+    Median        = 0x1u << 9u,
+    Special1      = 0x1u << 10u,
+    Special2      = 0x1u << 11u,
+    Special3      = 0x1u << 12u,
+    RoadWorks     = 0x1u << 13u,
+    Tram          = 0x1u << 14u,
+    Rail          = 0x1u << 15u,
+    Entry         = 0x1u << 16u,
+    Exit          = 0x1u << 17u,
+    OffRamp       = 0x1u << 18u,
+    OnRamp        = 0x1u << 19u,
+    Any           = 0xFFFFFFFFu
+  };
+
+  using LaneTypeMask = uint32_t;
+
+  constexpr LaneTypeMask operator|(LaneType lhs, LaneType rhs) {
+    return static_cast<LaneTypeMask>(lhs) | static_cast<LaneTypeMask>(rhs);
+  }
+
+  constexpr LaneTypeMask operator|(LaneTypeMask lhs, LaneType rhs) {
+    return lhs | static_cast<LaneTypeMask>(rhs);
+  }
+
+  /// Whether @a type is one of the types in @a mask. Lanes of type None only
+  /// match a mask equal to None.
+  constexpr bool MatchesLaneType(LaneType type, LaneTypeMask mask) {
+    return type == LaneType::None ?
+        mask == static_cast<LaneTypeMask>(LaneType::None) :
+        (static_cast<LaneTypeMask>(type) & mask) != 0u;
+  }
+
+  /// Convert the OpenDRIVE name of a lane type, unknown names are parsed as
+  /// LaneType::None.
+  LaneType ParseLaneType(const std::string &name);
+
+  /// Return the OpenDRIVE name of @a type.
+  const std::string &ToString(LaneType type);
+
+} // namespace element
+} // namespace road
+} // namespace carla
@@ -6,14 +6,17 @@
 
 #pragma once
 
+#include "carla/road/element/LaneType.h"
 #include "carla/road/element/RoadInfoVisitor.h"
 
-#include <map>
+#include <algorithm>
+#include <limits>
 #include <string>
 #include <vector>
 
 namespace carla {
 namespace road {
+  class CompiledMap;
   class MapBuilder;
 namespace element {
 
@@ -157,16 +160,17 @@ namespace element {
     double _width;
     double _lane_center_offset;
 
-    std::string _type;
+    LaneType _type;
     std::vector<int> _successor;
     std::vector<int> _predecessor;
 
     LaneInfo()
       : _id(0),
         _width(0.0),
-        _lane_center_offset(0.0) {}
+        _lane_center_offset(0.0),
+        _type(LaneType::None) {}
 
-    LaneInfo(int id, double width, const std::string &type)
+    LaneInfo(int id, double width, LaneType type)
       : _id(id),
         _width(width),
         _lane_center_offset(0.0),
@@ -177,10 +181,19 @@ namespace element {
   private:
 
     friend MapBuilder;
+    friend CompiledMap;
+
+    /// Lanes stored contiguously, indexed by (lane id - _min_lane_id). Ids
+    /// not defined are filled with lanes with id INVALID_LANE_ID.
+    std::vector<LaneInfo> _lanes;
 
-    // int is the lane id (-inf, inf)
-    using lane_t = std::map<int, LaneInfo>;
-    lane_t _lanes;
+    int _min_lane_id = 0;
+
+    static constexpr int INVALID_LANE_ID = std::numeric_limits<int>::min();
+
+    LaneInfo *getMutableLane(int id) {
+      return const_cast<LaneInfo *>(static_cast<const RoadInfoLane *>(this)->getLane(id));
+    }
 
   public:
 
@@ -194,41 +207,64 @@ namespace element {
       Both
     };
 
-    void addLaneInfo(int id, double width, const std::string &type) {
-      _lanes[id] = LaneInfo(id, width, type);
+    void addLaneInfo(int id, double width, LaneType type) {
+      if (_lanes.empty()) {
+        _min_lane_id = id;
+      } else if (id < _min_lane_id) {
+        _lanes.insert(_lanes.begin(), static_cast<size_t>(_min_lane_id - id), LaneInfo(INVALID_LANE_ID, 0.0, LaneType::None));
+        _min_lane_id = id;
+      }
+      const auto index = static_cast<size_t>(id - _min_lane_id);
+      if (index >= _lanes.size()) {
+        _lanes.resize(index + 1u, LaneInfo(INVALID_LANE_ID, 0.0, LaneType::None));
+      }
+      _lanes[index] = LaneInfo(id, width, type);
     }
 
     int size() const {
-      return (int) _lanes.size();
+      return static_cast<int>(std::count_if(_lanes.begin(), _lanes.end(), [](const LaneInfo &lane) {
+        return lane._id != INVALID_LANE_ID;
+      }));
+    }
+
+    /// Call @a func with the id of each lane whose type matches @a mask, in
+    /// ascending order of lane id.
+    template <typename FuncT>
+    void ForEachLane(LaneTypeMask mask, FuncT &&func) const {
+      for (auto &&lane : _lanes) {
+        if ((lane._id != INVALID_LANE_ID) && MatchesLaneType(lane._type, mask)) {
+          func(lane._id);
+        }
+      }
     }
 
     std::vector<int> getLanesIDs(which_lane_e whichLanes = which_lane_e::Both) const {
       std::vector<int> lanes_id;
 
-      for (lane_t::const_iterator it = _lanes.begin(); it != _lanes.end(); ++it) {
+      // Lanes are stored in ascending order of id, going from -n to n.
+      for (auto &&lane : _lanes) {
+        if (lane._id == INVALID_LANE_ID) {
+          continue;
+        }
         switch (whichLanes) {
           case which_lane_e::Both: {
-              lanes_id.emplace_back(it->first);
+              lanes_id.emplace_back(lane._id);
           } break;
 
           case which_lane_e::Left: {
-            if (it->first > 0) {
-              lanes_id.emplace_back(it->first);
+            if (lane._id > 0) {
+              lanes_id.emplace_back(lane._id);
             }
           } break;
 
           case which_lane_e::Right: {
-            if (it->first < 0) {
-              lanes_id.emplace_back(it->first);
+            if (lane._id < 0) {
+              lanes_id.emplace_back(lane._id);
             }
           } break;
         }
       }
 
-      // Sort the lanes IDs ascendent,
-      // going from 1 to n
-      std::sort(lanes_id.begin(), lanes_id.end());
-
       // For right lane the IDs are negative,
       // so reverse so sort order to haven them going
       // from -1 to -n
@@ -240,8 +276,11 @@ namespace element {
     }
 
     const LaneInfo *getLane(int id) const {
-      lane_t::const_iterator it = _lanes.find(id);
-      return it == _lanes.end() ? nullptr : &it->second;
+      if (id < _min_lane_id) {
+        return nullptr;
+      }
+      const auto index = static_cast<size_t>(id - _min_lane_id);
+      return (index < _lanes.size()) && (_lanes[index]._id == id) ? &_lanes[index] : nullptr;
     }
   };
 
@@ -35,6 +35,10 @@ namespace element {
       : RoadInfo(s),
         _offset(a, b, c, d, s) {}
 
+    RoadInfoLaneOffset(double s, const geom::CubicPolynomial &offset)
+      : RoadInfo(s),
+        _offset(offset) {}
+
     const geom::CubicPolynomial &GetPolynomial() const {
       return _offset;
     }
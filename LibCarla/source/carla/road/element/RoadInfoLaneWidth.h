@@ -36,6 +36,11 @@ namespace element {
         _lane_id(lane_id),
         _width(a, b, c, d, s) {}
 
+    RoadInfoLaneWidth(double s, int lane_id, const geom::CubicPolynomial &width)
+      : RoadInfo(s),
+        _lane_id(lane_id),
+        _width(width) {}
+
     int GetLaneId() const {
       return _lane_id;
     }
@@ -14,11 +14,11 @@ namespace road {
 namespace element {
 
   class RoadInfoList {
-    using SharedPtrList = std::vector<std::shared_ptr<const RoadInfo>>;
+    using PtrList = std::vector<RoadInfo *>;
 
   public:
 
-    RoadInfoList(const SharedPtrList &l) : _list(l) {}
+    RoadInfoList(const PtrList &l) : _list(l) {}
 
     template <typename T>
     auto Get() const {
@@ -29,7 +29,7 @@ namespace element {
 
   private:
 
-    SharedPtrList _list;
+    PtrList _list;
   };
 
 } // namespace element
@@ -0,0 +1,140 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Debug.h"
+#include "carla/road/element/RoadInfo.h"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <vector>
+
+namespace carla {
+namespace road {
+namespace element {
+
+  /// Road information stored in one flat array per type, each sorted by the
+  /// distance from the start of the road, so looking up the information of a
+  /// type at a given distance is a single binary search. Information at the
+  /// same distance keeps the order of insertion.
+  class RoadInfoTable {
+  public:
+
+    /// Add @a info, owned by the arena of the map.
+    void Insert(RoadInfo *info);
+
+    /// Last information of type @a T at or before @a dist, null if none.
+    template <typename T>
+    T *GetInfo(double dist) const {
+      const auto &list = GetList<T>();
+      const auto it = std::upper_bound(list.d.begin(), list.d.end(), dist);
+      return it == list.d.begin() ? nullptr : Cast<T>(list, it - list.d.begin() - 1);
+    }
+
+    /// First information of type @a T at or after @a dist, null if none.
+    template <typename T>
+    T *GetInfoReverse(double dist) const {
+      const auto &list = GetList<T>();
+      const auto it = std::lower_bound(list.d.begin(), list.d.end(), dist);
+      return it == list.d.end() ? nullptr : Cast<T>(list, it - list.d.begin());
+    }
+
+    /// Every information of type @a T at or before @a dist, nearest first.
+    template <typename T>
+    std::vector<T *> GetInfos(double dist) const {
+      const auto &list = GetList<T>();
+      auto i = std::upper_bound(list.d.begin(), list.d.end(), dist) - list.d.begin();
+      std::vector<T *> result;
+      result.reserve(static_cast<size_t>(i));
+      while (i > 0) {
+        result.emplace_back(Cast<T>(list, --i));
+      }
+      return result;
+    }
+
+    /// Every information of type @a T at or after @a dist, nearest first.
+    template <typename T>
+    std::vector<T *> GetInfosReverse(double dist) const {
+      const auto &list = GetList<T>();
+      auto i = std::lower_bound(list.d.begin(), list.d.end(), dist) - list.d.begin();
+      std::vector<T *> result;
+      result.reserve(list.d.size() - static_cast<size_t>(i));
+      for (; static_cast<size_t>(i) < list.d.size(); ++i) {
+        result.emplace_back(Cast<T>(list, i));
+      }
+      return result;
+    }
+
+    /// Call @a func with every information, grouped by type and sorted by
+    /// distance within each type.
+    template <typename FuncT>
+    void ForEach(FuncT &&func) const {
+      for (auto &&list : _lists) {
+        for (auto &&info : list.infos) {
+          func(*info);
+        }
+      }
+    }
+
+  private:
+
+    struct List {
+      /// Distances kept apart from the information for a faster search.
+      std::vector<double> d;
+      std::vector<RoadInfo *> infos;
+    };
+
+    static constexpr size_t IndexOf(const RoadInfoLane *) { return 0u; }
+    static constexpr size_t IndexOf(const RoadGeneralInfo *) { return 1u; }
+    static constexpr size_t IndexOf(const RoadInfoVelocity *) { return 2u; }
+    static constexpr size_t IndexOf(const RoadElevationInfo *) { return 3u; }
+    static constexpr size_t IndexOf(const RoadInfoLaneWidth *) { return 4u; }
+    static constexpr size_t IndexOf(const RoadInfoMarkRecord *) { return 5u; }
+    static constexpr size_t IndexOf(const RoadInfoLaneOffset *) { return 6u; }
+
+    static constexpr size_t NUMBER_OF_TYPES = 7u;
+
+    template <typename T>
+    const List &GetList() const {
+      return _lists[IndexOf(static_cast<const T *>(nullptr))];
+    }
+
+    template <typename T, typename IndexT>
+    static T *Cast(const List &list, IndexT index) {
+      return static_cast<T *>(list.infos[static_cast<size_t>(index)]);
+    }
+
+    std::array<List, NUMBER_OF_TYPES> _lists;
+  };
+
+  inline void RoadInfoTable::Insert(RoadInfo *info) {
+    DEBUG_ASSERT(info != nullptr);
+
+    struct Classifier : RoadInfoVisitor {
+      void Visit(RoadInfoLane &i) final { index = IndexOf(&i); }
+      void Visit(RoadGeneralInfo &i) final { index = IndexOf(&i); }
+      void Visit(RoadInfoVelocity &i) final { index = IndexOf(&i); }
+      void Visit(RoadElevationInfo &i) final { index = IndexOf(&i); }
+      void Visit(RoadInfoLaneWidth &i) final { index = IndexOf(&i); }
+      void Visit(RoadInfoMarkRecord &i) final { index = IndexOf(&i); }
+      void Visit(RoadInfoLaneOffset &i) final { index = IndexOf(&i); }
+      size_t index = NUMBER_OF_TYPES;
+    } classifier;
+
+    info->AcceptVisitor(classifier);
+    DEBUG_ASSERT(classifier.index < NUMBER_OF_TYPES);
+    auto &list = _lists[classifier.index];
+    const auto it = std::upper_bound(list.d.begin(), list.d.end(), info->d);
+    const auto position = it - list.d.begin();
+    list.d.insert(it, info->d);
+    list.infos.insert(list.infos.begin() + position, info);
+  }
+
+} // namespace element
+} // namespace road
+} // namespace carla
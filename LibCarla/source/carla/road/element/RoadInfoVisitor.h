@@ -7,7 +7,7 @@
 #pragma once
 
 #include <iterator>
-#include <memory>
+#include <type_traits>
 
 namespace carla {
 namespace road {
@@ -44,7 +44,7 @@ namespace element {
   class RoadInfoIterator : private RoadInfoVisitor {
   public:
 
-    static_assert(std::is_same<std::shared_ptr<RoadInfo>, typename IT::value_type>::value, "Not compatible.");
+    static_assert(std::is_same<RoadInfo *, typename IT::value_type>::value, "Not compatible.");
 
     RoadInfoIterator(IT begin, IT end)
       : _it(begin),
@@ -70,13 +70,12 @@ namespace element {
       return *this;
     }
 
-    /// @todo to fix
-    std::shared_ptr<T> operator*() const {
-      return std::static_pointer_cast<T>(*_it);
+    T *operator*() const {
+      return static_cast<T *>(*_it);
     }
 
-    std::shared_ptr<T> operator->() const {
-      return std::static_pointer_cast<T>(*_it);
+    T *operator->() const {
+      return static_cast<T *>(*_it);
     }
 
     bool operator!=(const RoadInfoIterator &rhs) const {
@@ -12,11 +12,12 @@
 #include "carla/road/element/RoadInfoLaneWidth.h"
 #include "carla/road/element/RoadInfoLaneOffset.h"
 #include "carla/road/element/RoadInfo.h"
+#include "carla/road/element/RoadInfoTable.h"
 #include "carla/road/element/Types.h"
 
 #include <limits>
-#include <memory>
-#include <set>
+#include <map>
+#include <unordered_set>
 #include <vector>
 #include <algorithm>
 
@@ -27,7 +28,9 @@ namespace road {
 
 namespace element {
 
-  class RoadSegment : private NonCopyable {
+  /// A road of the map. Its geometries and information are owned by the
+  /// arena of the map and live as long as the map does.
+  class RoadSegment : private MovableNonCopyable {
   public:
 
     RoadSegment(id_type id) : _id(id) {}
@@ -36,11 +39,18 @@ namespace element {
       : _id(def.GetId()),
         _successors_is_start(std::move(def._successor_is_start)),
         _predecessors_is_start(std::move(def._predecessors_is_start)),
-        _geom(std::move(def._geom)),
+        _geom(def._geom.begin(), def._geom.end()),
         _next_lane(std::move(def._next_lane)),
         _prev_lane(std::move(def._prev_lane)) {
-      for (auto &&a : def._info) {
-        _info.insert(std::move(a));
+      for (auto *info : def._info) {
+        _info.Insert(info);
+      }
+      std::stable_sort(_geom.begin(), _geom.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs->GetStartOffset() < rhs->GetStartOffset();
+      });
+      _geom_start_offsets.reserve(_geom.size());
+      for (auto &&g : _geom) {
+        _geom_start_offsets.emplace_back(g->GetStartOffset());
       }
     }
 
@@ -51,56 +61,44 @@ namespace element {
     /// Returns single info given a type and a distance from
     /// the start of the road (negative lanes)
     template <typename T>
-    std::shared_ptr<const T> GetInfo(double dist) const {
-      auto up_bound = decltype(_info)::reverse_iterator(_info.upper_bound(dist));
-      auto it = MakeRoadInfoIterator<T>(up_bound, _info.rend());
-      return it.IsAtEnd() ? nullptr : *it;
+    const T *GetInfo(double dist) const {
+      return _info.GetInfo<const T>(dist);
     }
 
     /// Returns single info given a type and a distance from
     /// the end of the road (positive lanes)
     template <typename T>
-    std::shared_ptr<const T> GetInfoReverse(double dist) const {
-      auto lo_bound = _info.lower_bound(dist);
-      auto it = MakeRoadInfoIterator<T>(lo_bound, _info.end());
-      return it.IsAtEnd() ? nullptr : *it;
+    const T *GetInfoReverse(double dist) const {
+      return _info.GetInfoReverse<const T>(dist);
     }
 
     /// Returns info vector given a type and a distance from
     /// the start of the road (negative lanes)
     template <typename T>
-    std::vector<std::shared_ptr<const T>> GetInfos(double dist) const {
-      auto up_bound = decltype(_info)::reverse_iterator(_info.upper_bound(dist));
-      auto it = MakeRoadInfoIterator<T>(up_bound, _info.rend());
-
-      std::vector<std::shared_ptr<const T>> result;
-      for (; !it.IsAtEnd(); ++it) {
-        result.emplace_back(*it);
-      }
-      return result;
+    std::vector<const T *> GetInfos(double dist) const {
+      return _info.GetInfos<const T>(dist);
     }
 
     /// Returns info vector given a type and a distance from
     /// the end of the road (positive lanes)
     template <typename T>
-    std::vector<std::shared_ptr<const T>> GetInfosReverse(double dist) const {
-      auto lo_bound = _info.lower_bound(dist);
-      auto it = MakeRoadInfoIterator<T>(lo_bound, _info.end());
+    std::vector<const T *> GetInfosReverse(double dist) const {
+      return _info.GetInfosReverse<const T>(dist);
+    }
 
-      std::vector<std::shared_ptr<const T>> result;
-      for (; !it.IsAtEnd(); ++it) {
-        result.emplace_back(*it);
-      }
-      return result;
+    /// Call @a func with every information of this road.
+    template <typename FuncT>
+    void ForEachInfo(FuncT &&func) const {
+      _info.ForEach(std::forward<FuncT>(func));
     }
 
     /// Workaround where we must find a specific (RoadInfoMarkRecord) RoadInfo
     /// that must have lane_id info. In this case this info is used for selecting
     /// only the nearest RoadInfos to the "dist" input.
-    std::vector<std::shared_ptr<const RoadInfoMarkRecord>> GetRoadInfoMarkRecord(
+    std::vector<const RoadInfoMarkRecord *> GetRoadInfoMarkRecord(
         double dist) const {
       auto mark_record_info = GetInfos<RoadInfoMarkRecord>(dist);
-      std::vector<std::shared_ptr<const RoadInfoMarkRecord>> result;
+      std::vector<const RoadInfoMarkRecord *> result;
       std::unordered_set<int> inserted_lanes;
 
       for (auto &&mark_record : mark_record_info) {
@@ -116,10 +114,10 @@ namespace element {
     /// Workaround where we must find a specific (RoadInfoMarkRecord) RoadInfo
     /// that must have lane_id info. In this case this info is used for selecting
     /// only the nearest RoadInfos to the "dist" input. But reversed!
-    std::vector<std::shared_ptr<const RoadInfoMarkRecord>> GetRoadInfoMarkRecordReverse(
+    std::vector<const RoadInfoMarkRecord *> GetRoadInfoMarkRecordReverse(
         double dist) const {
       auto mark_record_info = GetInfosReverse<RoadInfoMarkRecord>(dist);
-      std::vector<std::shared_ptr<const RoadInfoMarkRecord>> result;
+      std::vector<const RoadInfoMarkRecord *> result;
       std::unordered_set<int> inserted_lanes;
 
       for (auto &&mark_record : mark_record_info) {
@@ -135,10 +133,10 @@ namespace element {
     /// Workaround where we must find a specific (RoadInfoLaneWidth) RoadInfo
     /// that must have lane_id info. In this case this info is used for selecting
     /// only the nearest RoadInfos to the "dist" input.
-    std::vector<std::shared_ptr<const RoadInfoLaneWidth>> GetRoadInfoLaneWidth(
+    std::vector<const RoadInfoLaneWidth *> GetRoadInfoLaneWidth(
         double dist) const {
       auto lane_offset_info = GetInfos<RoadInfoLaneWidth>(dist);
-      std::vector<std::shared_ptr<const RoadInfoLaneWidth>> result;
+      std::vector<const RoadInfoLaneWidth *> result;
       std::unordered_set<int> inserted_lanes;
 
       for (auto &&lane_offset : lane_offset_info) {
@@ -208,12 +206,11 @@ namespace element {
     /// OUTPUT:
     ///    std::vector<std::pair<int, int>>   return a pair with lane id (first
     ///                                       int) and the road id (second int),
-    ///                                       if no lane has been found the given
-    ///                                       pair it will be (0, 0) as lane id
-    ///                                       zero used for the reference line
-    std::vector<std::pair<int, int>> GetNextLane(int current_lane_id) const {
+    ///                                       empty if no lane has been found
+    const std::vector<std::pair<int, int>> &GetNextLane(int current_lane_id) const {
+      static const std::vector<std::pair<int, int>> empty;
       std::map<int, std::vector<std::pair<int, int>>>::const_iterator it = _next_lane.find(current_lane_id);
-      return it == _next_lane.end() ? std::vector<std::pair<int, int>>() : it->second;
+      return it == _next_lane.end() ? empty : it->second;
     }
 
     /// Given the current lane it gives an std::pair vector with the lane id and road
@@ -225,12 +222,23 @@ namespace element {
     /// OUTPUT:
     ///    std::vector<std::pair<int, int>>   return a pair with lane id (first
     ///                                       int) and the road id (second int),
-    ///                                       if no lane has been found the given
-    ///                                       pair it will be (0, 0) as lane id
-    ///                                       zero used for the reference line
-    std::vector<std::pair<int, int>> GetPrevLane(int current_lane_id) const {
+    ///                                       empty if no lane has been found
+    const std::vector<std::pair<int, int>> &GetPrevLane(int current_lane_id) const {
+      static const std::vector<std::pair<int, int>> empty;
       std::map<int, std::vector<std::pair<int, int>>>::const_iterator it = _prev_lane.find(current_lane_id);
-      return it == _prev_lane.end() ? std::vector<std::pair<int, int>>() : it->second;
+      return it == _prev_lane.end() ? empty : it->second;
+    }
+
+    /// Lanes connected to the end of each lane of this road, indexed by lane
+    /// id.
+    const std::map<int, std::vector<std::pair<int, int>>> &GetNextLanes() const {
+      return _next_lane;
+    }
+
+    /// Lanes connected to the start of each lane of this road, indexed by
+    /// lane id.
+    const std::map<int, std::vector<std::pair<int, int>>> &GetPrevLanes() const {
+      return _prev_lane;
     }
 
     // Search for the last geometry with less start_offset before 'dist'
@@ -249,6 +257,19 @@ namespace element {
             _geom.back()->PosFromDist(_length - _geom.back()->GetStartOffset()));
       }
 
+      // Geometries are sorted by start offset, the candidate is the last one
+      // starting before dist.
+      const auto it = std::lower_bound(_geom_start_offsets.begin(), _geom_start_offsets.end(), dist);
+      if (it != _geom_start_offsets.begin()) {
+        const auto &g = _geom[static_cast<size_t>(std::distance(_geom_start_offsets.begin(), it) - 1)];
+        if (dist <= (g->GetStartOffset() + g->GetLength())) {
+          return DirectedPointWithElevation(
+            dist,
+            g->PosFromDist(dist - g->GetStartOffset()));
+        }
+      }
+
+      // Only reached if the geometries overlap or leave gaps.
       for (auto &&g : _geom) {
         if ((g->GetStartOffset() < dist) && (dist <= (g->GetStartOffset() + g->GetLength()))) {
           return DirectedPointWithElevation(
@@ -298,21 +319,16 @@ namespace element {
       int nearest_lane_id = 0;
       double nearest_dist = std::numeric_limits<double>::max();
 
-      for (auto &&current_lane_id :
-          info->getLanesIDs(carla::road::element::RoadInfoLane::which_lane_e::Both)) {
-        const auto current_lane_info = info->getLane(current_lane_id);
-
-        if (current_lane_info->_type == "driving") {
-          DirectedPoint dp_center_lane = dp_center_road;
-          dp_center_lane.ApplyLateralOffset(current_lane_info->_lane_center_offset);
+      info->ForEachLane(static_cast<LaneTypeMask>(LaneType::Driving), [&](int current_lane_id) {
+        DirectedPoint dp_center_lane = dp_center_road;
+        dp_center_lane.ApplyLateralOffset(info->getLane(current_lane_id)->_lane_center_offset);
 
-          const double current_dist = geom::Math::Distance2D(dp_center_lane.location, loc);
-          if (current_dist < nearest_dist) {
-            nearest_dist = current_dist;
-            nearest_lane_id = current_lane_id;
-          }
+        const double current_dist = geom::Math::Distance2D(dp_center_lane.location, loc);
+        if (current_dist < nearest_dist) {
+          nearest_dist = current_dist;
+          nearest_lane_id = current_lane_id;
         }
-      }
+      });
       return std::pair<int, double>(nearest_lane_id, nearest_dist);
     }
 
@@ -320,6 +336,10 @@ namespace element {
       return _length;
     }
 
+    const std::vector<const Geometry *> &GetGeometries() const {
+      return _geom;
+    }
+
     void SetLength(double d) {
       _length = d;
     }
@@ -336,25 +356,6 @@ namespace element {
 
     friend class carla::road::MapBuilder;
 
-    struct LessComp {
-      using is_transparent = void;
-      bool operator()(
-          const std::shared_ptr<RoadInfo> &a,
-          const std::shared_ptr<RoadInfo> &b) const {
-        return a->d < b->d;
-      }
-      bool operator()(
-          const double &a,
-          const std::shared_ptr<RoadInfo> &b) const {
-        return a < b->d;
-      }
-      bool operator()(
-          const std::shared_ptr<RoadInfo> &a,
-          const double &b) const {
-        return a->d < b;
-      }
-    };
-
   private:
 
     friend class MapBuilder;
@@ -364,8 +365,9 @@ namespace element {
     std::vector<RoadSegment *> _successors;
     std::vector<bool> _successors_is_start;
     std::vector<bool> _predecessors_is_start;
-    std::vector<std::unique_ptr<Geometry>> _geom;
-    std::multiset<std::shared_ptr<RoadInfo>, LessComp> _info;
+    std::vector<const Geometry *> _geom;
+    std::vector<double> _geom_start_offsets;
+    RoadInfoTable _info;
     double _length = -1.0;
 
     // first  int     current lane
@@ -6,11 +6,13 @@
 
 #pragma once
 
+#include "carla/road/MapArena.h"
 #include "carla/road/element/Geometry.h"
 #include "carla/road/element/RoadInfo.h"
 
 #include <cstdio>
-#include <memory>
+#include <map>
+#include <vector>
 
 namespace carla {
 namespace road {
@@ -27,12 +29,19 @@ namespace element {
         _predecessor_id(std::move(rsd._predecessor_id)),
         _successor_is_start(std::move(rsd._successor_is_start)),
         _predecessors_is_start(std::move(rsd._predecessors_is_start)),
+        _arena(std::move(rsd._arena)),
+        _shared_arena(rsd._shared_arena),
         _geom(std::move(rsd._geom)),
         _info(std::move(rsd._info)),
         _next_lane(std::move(rsd._next_lane)),
         _prev_lane(std::move(rsd._prev_lane)) {}
 
-    RoadSegmentDefinition(id_type id) {
+    /// Definition of road @a id. Its geometries and information are
+    /// allocated from @a arena if given, usually the arena of the
+    /// MapBuilder the definition is for, or from an arena of its own
+    /// otherwise.
+    RoadSegmentDefinition(id_type id, MapArena *arena = nullptr)
+      : _shared_arena(arena) {
       assert(id >= 0);
       _id = id;
     }
@@ -62,14 +71,15 @@ namespace element {
     // usage MakeGeometry<GeometryArc>(len, st_pos_offs, head, st_pos, curv)
     template <typename T, typename ... Args>
     void MakeGeometry(Args && ... args) {
-      _geom.emplace_back(std::make_unique<T>(std::forward<Args>(args) ...));
+      _geom.emplace_back(GetArena().Make<T>(std::forward<Args>(args) ...));
     }
 
     // usage MakeInfo<SpeedLimit>(30.0)
     template <typename T, typename ... Args>
     T *MakeInfo(Args && ... args) {
-      _info.emplace_back(std::make_shared<T>(std::forward<Args>(args) ...));
-      return static_cast<T *>(_info.back().get());
+      T *info = GetArena().Make<T>(std::forward<Args>(args) ...);
+      _info.emplace_back(info);
+      return info;
     }
 
     const std::vector<id_type> &GetPredecessorID() const {
@@ -78,23 +88,33 @@ namespace element {
     const std::vector<id_type> &GetSuccessorID() const {
       return _successor_id;
     }
-    const std::vector<std::unique_ptr<Geometry>> &GetGeometry() const {
+    const std::vector<Geometry *> &GetGeometry() const {
       return _geom;
     }
-    const std::vector<std::shared_ptr<RoadInfo>> &GetInfo() const {
+    const std::vector<RoadInfo *> &GetInfo() const {
       return _info;
     }
 
   private:
 
+    MapArena &GetArena() {
+      return _shared_arena != nullptr ? *_shared_arena : _arena;
+    }
+
     friend class RoadSegment;
+    friend class carla::road::MapBuilder;
     id_type _id;
     std::vector<id_type> _successor_id;
     std::vector<id_type> _predecessor_id;
     std::vector<bool> _successor_is_start;
     std::vector<bool> _predecessors_is_start;
-    std::vector<std::unique_ptr<Geometry>> _geom;
-    std::vector<std::shared_ptr<RoadInfo>> _info;
+    /// Owns the geometries and information of the road, if not allocated
+    /// from a shared arena, until the map is built, then it is spliced into
+    /// the arena of the map.
+    MapArena _arena;
+    MapArena *_shared_arena = nullptr;
+    std::vector<Geometry *> _geom;
+    std::vector<RoadInfo *> _info;
 
     // first  int     current lane
     // second int     to which lane
@@ -8,9 +8,11 @@
 
 #include "carla/geom/Transform.h"
 #include "carla/Memory.h"
+#include "carla/road/element/LaneType.h"
 #include "carla/road/element/RoadInfoMarkRecord.h"
 #include "carla/road/element/RoadInfoList.h"
 #include "carla/road/element/Types.h"
+#include "carla/road/element/WaypointHandle.h"
 
 namespace carla {
 namespace road {
@@ -41,6 +43,12 @@ namespace element {
       return _dist;
     }
 
+    WaypointHandle GetHandle() const {
+      return {_road_id, _lane_id, _dist};
+    }
+
+    LaneType GetLaneType() const;
+
     const std::string &GetType() const;
 
     const RoadSegment &GetRoadSegment() const;
@@ -0,0 +1,36 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/road/element/Types.h"
+
+namespace carla {
+namespace road {
+namespace element {
+
+  /// Identifies a waypoint by its position along a lane. Unlike Waypoint it
+  /// does not keep the map alive, so it is cheap to copy and store in bulk,
+  /// but it is only meaningful together with the map that generated it.
+  struct WaypointHandle {
+    id_type road_id = 0u;
+
+    int lane_id = 0;
+
+    double s = 0.0;
+
+    bool operator==(const WaypointHandle &rhs) const {
+      return (road_id == rhs.road_id) && (lane_id == rhs.lane_id) && (s == rhs.s);
+    }
+
+    bool operator!=(const WaypointHandle &rhs) const {
+      return !(*this == rhs);
+    }
+  };
+
+} // namespace element
+} // namespace road
+} // namespace carla
@@ -9,15 +9,23 @@
 #include "carla/MsgPack.h"
 #include "carla/MsgPackAdaptors.h"
 #include "carla/geom/Transform.h"
+#include "carla/rpc/ActorDescription.h"
 #include "carla/rpc/ActorId.h"
 #include "carla/rpc/VehicleControl.h"
 #include "carla/rpc/WalkerControl.h"
 
+#include <boost/optional.hpp>
 #include <boost/variant.hpp>
 
+#include <vector>
+
 namespace carla {
 namespace rpc {
 
+  /// Id that, in the commands executed after a SpawnActor command, refers to
+  /// the actor spawned by it.
+  constexpr ActorId FutureActor = 0u;
+
   class Command {
   private:
 
@@ -30,6 +38,24 @@ namespace rpc {
 
   public:
 
+    /// Spawn an actor, optionally attached to @a parent, and then execute
+    /// @a do_after with FutureActor replaced by the id of the new actor.
+    struct SpawnActor : CommandBase<SpawnActor> {
+      SpawnActor() = default;
+      SpawnActor(ActorDescription description, const geom::Transform &transform)
+        : description(std::move(description)),
+          transform(transform) {}
+      SpawnActor(ActorDescription description, const geom::Transform &transform, ActorId parent)
+        : description(std::move(description)),
+          transform(transform),
+          parent(parent) {}
+      ActorDescription description;
+      geom::Transform transform;
+      boost::optional<ActorId> parent;
+      std::vector<Command> do_after;
+      MSGPACK_DEFINE_ARRAY(description, transform, parent, do_after);
+    };
+
     struct DestroyActor : CommandBase<DestroyActor> {
       DestroyActor() = default;
       DestroyActor(ActorId id) : actor(id) {}
@@ -102,6 +128,7 @@ namespace rpc {
     };
 
     using CommandType = boost::variant<
+        SpawnActor,
         DestroyActor,
         ApplyVehicleControl,
         ApplyWalkerControl,
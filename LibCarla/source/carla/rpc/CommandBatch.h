@@ -0,0 +1,157 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/rpc/Command.h"
+#include "carla/rpc/CommandResponse.h"
+
+#include <boost/optional.hpp>
+#include <boost/variant/apply_visitor.hpp>
+#include <boost/variant/static_visitor.hpp>
+
+#include <vector>
+
+namespace carla {
+namespace rpc {
+namespace detail {
+
+  /// Whether a command refers to the actor spawned by the parent command.
+  struct UsesFutureActor : public boost::static_visitor<bool> {
+
+    bool operator()(const Command::SpawnActor &command) const {
+      return command.parent.has_value() && (*command.parent == FutureActor);
+    }
+
+    template <typename T>
+    bool operator()(const T &command) const {
+      return command.actor == FutureActor;
+    }
+  };
+
+  /// Replace FutureActor by the id of the actor spawned by the parent
+  /// command. The commands executed after a nested SpawnActor refer to the
+  /// actor spawned by that one, they are left untouched.
+  class ReplaceFutureActor : public boost::static_visitor<void> {
+  public:
+
+    explicit ReplaceFutureActor(ActorId id) : _id(id) {}
+
+    void operator()(Command::SpawnActor &command) const {
+      if (command.parent.has_value() && (*command.parent == FutureActor)) {
+        command.parent = _id;
+      }
+    }
+
+    template <typename T>
+    void operator()(T &command) const {
+      if (command.actor == FutureActor) {
+        command.actor = _id;
+      }
+    }
+
+  private:
+
+    ActorId _id;
+  };
+
+  /// Id of the actor a command, other than SpawnActor, is applied to.
+  struct GetCommandActor : public boost::static_visitor<ActorId> {
+
+    ActorId operator()(const Command::SpawnActor &) const {
+      return FutureActor;
+    }
+
+    template <typename T>
+    ActorId operator()(const T &command) const {
+      return command.actor;
+    }
+  };
+
+  /// Respond an error for every one of @a commands and the commands executed
+  /// after them.
+  inline void SkipCommands(
+      const std::vector<Command> &commands,
+      std::vector<CommandResponse> &responses) {
+    for (auto &command : commands) {
+      responses.emplace_back(ResponseError("not executed: parent command failed"));
+      const auto *spawn = boost::get<Command::SpawnActor>(&command.command);
+      if (spawn != nullptr) {
+        SkipCommands(spawn->do_after, responses);
+      }
+    }
+  }
+
+  template <typename SpawnF, typename ApplyF>
+  void ExecuteCommands(
+      const std::vector<Command> &commands,
+      boost::optional<ActorId> future_actor,
+      SpawnF &spawn,
+      ApplyF &apply,
+      std::vector<CommandResponse> &responses) {
+    for (auto &command : commands) {
+      // Commands are copied only to replace FutureActor.
+      const bool replace =
+          future_actor.has_value() &&
+          boost::apply_visitor(UsesFutureActor{}, command.command);
+      const auto *spawn_command = boost::get<Command::SpawnActor>(&command.command);
+      if (spawn_command != nullptr) {
+        // The commands executed after it refer to the new actor, they are not
+        // copied.
+        Response<ActorId> result = replace ?
+            spawn(Command::SpawnActor{
+                spawn_command->description,
+                spawn_command->transform,
+                *future_actor}) :
+            spawn(*spawn_command);
+        const bool success = result;
+        responses.emplace_back(std::move(result));
+        if (success) {
+          const ActorId id = responses.back().Get();
+          ExecuteCommands(spawn_command->do_after, id, spawn, apply, responses);
+        } else {
+          SkipCommands(spawn_command->do_after, responses);
+        }
+      } else {
+        boost::optional<Command> replaced;
+        if (replace) {
+          replaced = command;
+          boost::apply_visitor(ReplaceFutureActor{*future_actor}, replaced->command);
+        }
+        const Command &current = replaced.has_value() ? *replaced : command;
+        Response<void> result = apply(current);
+        if (result) {
+          responses.emplace_back(boost::apply_visitor(GetCommandActor{}, current.command));
+        } else {
+          responses.emplace_back(result.GetError());
+        }
+      }
+    }
+  }
+
+} // namespace detail
+
+  /// Execute a batch of @a commands in order and return the response to each
+  /// of them. The commands executed after a SpawnActor command follow it in
+  /// the responses, in depth-first order, and fail without being executed if
+  /// the actor could not be spawned.
+  ///
+  /// @a spawn is called with every SpawnActor command and returns a
+  /// Response<ActorId> with the id of the new actor; @a apply is called with
+  /// every other Command and returns a Response<void>.
+  template <typename SpawnF, typename ApplyF>
+  std::vector<CommandResponse> ExecuteCommandBatch(
+      const std::vector<Command> &commands,
+      SpawnF &&spawn,
+      ApplyF &&apply) {
+    std::vector<CommandResponse> responses;
+    responses.reserve(commands.size());
+    detail::ExecuteCommands(commands, boost::none, spawn, apply, responses);
+    return responses;
+  }
+
+} // namespace rpc
+} // namespace carla
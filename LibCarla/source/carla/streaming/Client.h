@@ -9,11 +9,15 @@
 #include "carla/Logging.h"
 #include "carla/streaming/Token.h"
 #include "carla/streaming/detail/AsioThreadPool.h"
+#include "carla/streaming/detail/DeserializationExecutor.h"
 #include "carla/streaming/detail/tcp/Client.h"
 #include "carla/streaming/low_level/Client.h"
 
 #include <boost/asio/io_service.hpp>
 
+#include <memory>
+#include <mutex>
+
 namespace carla {
 namespace streaming {
 
@@ -31,13 +35,45 @@ namespace streaming {
 
     ~Client() {
       _service.Stop();
+      if (_executor != nullptr) {
+        _executor->Stop();
+      }
+    }
+
+    /// Execute the callbacks of the streams in @a worker_threads dedicated
+    /// threads instead of in the io threads, see DeserializationExecutor.
+    /// Only affects the streams subscribed afterwards, and can be set only
+    /// once. Safe to call while other threads subscribe.
+    void SetDeserializationWorkerThreads(size_t worker_threads) {
+      std::lock_guard<std::mutex> lock(_executor_mutex);
+      if (_executor != nullptr) {
+        log_warning("streaming client: deserialization worker threads already set");
+        return;
+      }
+      if (worker_threads > 0u) {
+        _executor = std::make_unique<detail::DeserializationExecutor>(worker_threads);
+      }
     }
 
     /// @warning cannot subscribe twice to the same stream (even if it's a
     /// MultiStream).
     template <typename Functor>
     void Subscribe(const Token &token, Functor &&callback) {
-      _client.Subscribe(_service.service(), token, std::forward<Functor>(callback));
+      detail::DeserializationExecutor *executor = nullptr;
+      {
+        // Once set, the executor is never replaced until destruction.
+        std::lock_guard<std::mutex> lock(_executor_mutex);
+        executor = _executor.get();
+      }
+      if (executor != nullptr) {
+        const detail::token_type stream_token{token};
+        _client.Subscribe(
+            _service.service(),
+            stream_token,
+            executor->Wrap(stream_token.get_stream_id(), std::forward<Functor>(callback)));
+      } else {
+        _client.Subscribe(_service.service(), token, std::forward<Functor>(callback));
+      }
     }
 
     void UnSubscribe(const Token &token) {
@@ -54,7 +90,12 @@ namespace streaming {
 
   private:
 
-    // The order of these two arguments is very important.
+    // The order of these arguments is very important, the executor must
+    // outlive the io threads posting to it.
+
+    std::mutex _executor_mutex;
+
+    std::unique_ptr<detail::DeserializationExecutor> _executor;
 
     detail::AsioThreadPool _service;
 
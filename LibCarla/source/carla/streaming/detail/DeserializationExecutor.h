@@ -0,0 +1,111 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Buffer.h"
+#include "carla/Debug.h"
+#include "carla/Logging.h"
+#include "carla/NonCopyable.h"
+#include "carla/ThreadGroup.h"
+#include "carla/streaming/detail/Types.h"
+
+#include <boost/asio/io_service.hpp>
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+
+  /// Pool of workers that execute the callbacks of the streams, so the io
+  /// threads of the streaming client only read from the sockets while the
+  /// received messages are deserialized elsewhere.
+  ///
+  /// Every worker has its own queue and a single thread, and each stream is
+  /// always assigned to the same worker. Therefore the messages of a stream
+  /// are processed serially and in the order they were received, and the
+  /// data of each sensor stays in the caches of the same core. The buffers
+  /// passed to the callbacks are the pooled buffers the messages were read
+  /// into, they return to the pool of the stream once released.
+  class DeserializationExecutor : private NonCopyable {
+  public:
+
+    using callback_function_type = std::function<void(Buffer)>;
+
+    explicit DeserializationExecutor(size_t worker_threads) {
+      DEBUG_ASSERT(worker_threads > 0u);
+      _workers.reserve(worker_threads);
+      for (size_t i = 0u; i < worker_threads; ++i) {
+        _workers.emplace_back(std::make_unique<Worker>());
+      }
+      for (auto &worker : _workers) {
+        auto *io_service = &worker->io_service;
+        _threads.CreateThread([io_service]() { io_service->run(); });
+      }
+    }
+
+    ~DeserializationExecutor() {
+      Stop();
+    }
+
+    size_t size() const {
+      return _workers.size();
+    }
+
+    /// Index of the worker that executes the callback of @a stream_id.
+    size_t GetWorkerIndex(stream_id_type stream_id) const {
+      return stream_id % _workers.size();
+    }
+
+    /// Return a function that executes @a callback in the worker assigned to
+    /// @a stream_id.
+    callback_function_type Wrap(stream_id_type stream_id, callback_function_type callback) {
+      auto *io_service = &_workers[GetWorkerIndex(stream_id)]->io_service;
+      auto cb = std::make_shared<callback_function_type>(std::move(callback));
+      return [io_service, cb](Buffer buffer) {
+        // Asio handlers must be copyable, the buffer is moved into a shared
+        // pointer to cross the queue.
+        auto message = std::make_shared<Buffer>(std::move(buffer));
+        io_service->post([cb, message]() {
+          try {
+            (*cb)(std::move(*message));
+          } catch (const std::exception &e) {
+            log_error("streaming client: exception thrown deserializing a message:", e.what());
+          }
+        });
+      };
+    }
+
+    /// Stop the workers, messages not yet processed are discarded.
+    void Stop() {
+      for (auto &worker : _workers) {
+        worker->io_service.stop();
+      }
+      _threads.JoinAll();
+    }
+
+  private:
+
+    struct Worker {
+      Worker() : work_to_do(io_service) {}
+
+      boost::asio::io_service io_service;
+
+      boost::asio::io_service::work work_to_do;
+    };
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+
+    ThreadGroup _threads;
+  };
+
+} // namespace detail
+} // namespace streaming
+} // namespace carla
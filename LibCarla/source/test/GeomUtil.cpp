@@ -0,0 +1,53 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "GeomUtil.h"
+
+#include <random>
+
+namespace util {
+namespace geom {
+
+  using carla::geom::Location;
+  using carla::geom::PointArrays;
+  using carla::geom::Rotation;
+  using carla::geom::Transform;
+
+  std::vector<Location> make_random_locations(size_t count, float extent) {
+    std::mt19937_64 rng(count);
+    std::uniform_real_distribution<float> distribution(-extent, extent);
+    std::vector<Location> result;
+    for (auto i = 0u; i < count; ++i) {
+      result.emplace_back(distribution(rng), distribution(rng), 0.01f * distribution(rng));
+    }
+    return result;
+  }
+
+  std::vector<Transform> make_random_transforms(size_t count, float extent) {
+    std::mt19937_64 rng(count);
+    std::uniform_real_distribution<float> location(-extent, extent);
+    // Away from a pitch of 90 degrees, where yaw and roll are not unique.
+    std::uniform_real_distribution<float> pitch(-80.0f, 80.0f);
+    std::uniform_real_distribution<float> angle(-540.0f, 540.0f);
+    std::vector<Transform> result;
+    for (auto i = 0u; i < count; ++i) {
+      result.emplace_back(
+          Location(location(rng), location(rng), location(rng)),
+          Rotation(pitch(rng), angle(rng), angle(rng)));
+    }
+    return result;
+  }
+
+  PointArrays make_point_arrays(const std::vector<Location> &locations) {
+    PointArrays result;
+    for (auto &&location : locations) {
+      result.push_back(location);
+    }
+    return result;
+  }
+
+} // namespace geom
+} // namespace util
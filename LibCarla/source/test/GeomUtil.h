@@ -0,0 +1,33 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <carla/geom/PointArrays.h>
+#include <carla/geom/Location.h>
+#include <carla/geom/Transform.h>
+
+#include <cstddef>
+#include <vector>
+
+/// Random geometry shared by the geom tests and benchmarks.
+namespace util {
+namespace geom {
+
+  /// @a count locations inside a square of @a extent meters around the
+  /// origin, nearly at ground level. Always the same ones for the same
+  /// @a count.
+  std::vector<carla::geom::Location> make_random_locations(size_t count, float extent);
+
+  /// @a count transforms inside a cube of @a extent meters around the origin,
+  /// with a pitch away from 90 degrees. Always the same ones for the same
+  /// @a count.
+  std::vector<carla::geom::Transform> make_random_transforms(size_t count, float extent);
+
+  carla::geom::PointArrays make_point_arrays(const std::vector<carla::geom::Location> &locations);
+
+} // namespace geom
+} // namespace util
@@ -0,0 +1,451 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "OpenDriveGenerator.h"
+
+#include <carla/opendrive/OpenDrive.h>
+
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <locale>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace util {
+namespace opendrive {
+
+  static constexpr double PI = 3.14159265358979323846;
+
+  // ===========================================================================
+  // -- Document description ---------------------------------------------------
+  // ===========================================================================
+
+  namespace {
+
+    enum class geometry_type { line, arc, spiral };
+
+    struct geometry {
+      geometry_type type;
+      double x, y, heading, length;
+      /// Curvature of the arc, or at the end of the spiral.
+      double curvature = 0.0;
+    };
+
+    struct lane {
+      int id;
+      const char *type;
+      double width;
+      /// Lane ids in the previous and next road or lane section, 0 if none.
+      int predecessor = 0;
+      int successor = 0;
+    };
+
+    struct lane_section {
+      double s;
+      std::vector<lane> lanes;
+    };
+
+    struct road_link {
+      const char *element_type = nullptr;
+      int id = 0;
+      const char *contact_point = "";
+    };
+
+    struct road {
+      int id;
+      int junction = -1;
+      road_link predecessor;
+      road_link successor;
+      std::vector<geometry> geometries;
+      double elevation = 0.0;
+      double slope = 0.0;
+      double lane_offset = 0.0;
+      std::vector<lane_section> lane_sections;
+
+      double length() const {
+        double result = 0.0;
+        for (auto &&g : geometries) {
+          result += g.length;
+        }
+        return result;
+      }
+    };
+
+    struct junction_connection {
+      int incoming_road;
+      int connecting_road;
+      std::vector<std::pair<int, int>> lane_links;
+    };
+
+    struct junction {
+      int id;
+      std::vector<junction_connection> connections;
+    };
+
+    struct pose {
+      double x, y, heading;
+    };
+
+  } // namespace
+
+  /// Pose at the end of @a g.
+  static pose end_of(const geometry &g) {
+    switch (g.type) {
+      case geometry_type::line:
+        return {g.x + g.length * std::cos(g.heading), g.y + g.length * std::sin(g.heading), g.heading};
+      case geometry_type::arc: {
+        const double heading = g.heading + g.curvature * g.length;
+        return {
+            g.x + (std::sin(heading) - std::sin(g.heading)) / g.curvature,
+            g.y - (std::cos(heading) - std::cos(g.heading)) / g.curvature,
+            heading};
+      }
+      case geometry_type::spiral:
+      default: {
+        // Simpson's rule on the heading, that grows quadratically from the
+        // start heading for a spiral starting with zero curvature.
+        constexpr int steps = 64;
+        auto heading_at = [&](double s) {
+          return g.heading + 0.5 * g.curvature * s * s / g.length;
+        };
+        double x = 0.0;
+        double y = 0.0;
+        const double h = g.length / steps;
+        for (int i = 0; i <= steps; ++i) {
+          const double weight = (i == 0 || i == steps) ? 1.0 : (i % 2 == 1 ? 4.0 : 2.0);
+          x += weight * std::cos(heading_at(i * h));
+          y += weight * std::sin(heading_at(i * h));
+        }
+        return {g.x + x * h / 3.0, g.y + y * h / 3.0, heading_at(g.length)};
+      }
+    }
+  }
+
+  static geometry make_geometry(geometry_type type, const pose &start, double length, double curvature = 0.0) {
+    return {type, start.x, start.y, start.heading, length, curvature};
+  }
+
+  // ===========================================================================
+  // -- Writing ----------------------------------------------------------------
+  // ===========================================================================
+
+  static void write_header(std::ostream &out) {
+    out << "<?xml version=\"1.0\" standalone=\"yes\"?>\n<OpenDRIVE>\n";
+    out << "  <header revMajor=\"1\" revMinor=\"4\" name=\"\" version=\"1\">\n";
+    out << "    <geoReference><![CDATA[+lat_0=4.9e+1 +lon_0=8.0e+0]]></geoReference>\n";
+    out << "  </header>\n";
+  }
+
+  static void write_link(std::ostream &out, const char *tag, const road_link &link) {
+    if (link.element_type != nullptr) {
+      out << "      <" << tag << " elementType=\"" << link.element_type << "\" elementId=\"" << link.id << '"';
+      if (*link.contact_point != '\0') {
+        out << " contactPoint=\"" << link.contact_point << '"';
+      }
+      out << "/>\n";
+    }
+  }
+
+  static void write_lane(std::ostream &out, const lane &l) {
+    out << "            <lane id=\"" << l.id << "\" type=\"" << l.type << "\" level=\"false\">\n";
+    if ((l.predecessor != 0) || (l.successor != 0)) {
+      out << "              <link>";
+      if (l.predecessor != 0) {
+        out << "<predecessor id=\"" << l.predecessor << "\"/>";
+      }
+      if (l.successor != 0) {
+        out << "<successor id=\"" << l.successor << "\"/>";
+      }
+      out << "</link>\n";
+    }
+    out << "              <width sOffset=\"0\" a=\"" << l.width << "\" b=\"0\" c=\"0\" d=\"0\"/>\n";
+    out << "              <roadMark sOffset=\"0\" type=\"" << (std::abs(l.id) == 1 ? "solid" : "broken")
+        << "\" weight=\"standard\" color=\"standard\" width=\"0.15\" laneChange=\""
+        << (std::abs(l.id) == 1 ? "none" : "both") << "\"/>\n";
+    out << "            </lane>\n";
+  }
+
+  static void write_road(std::ostream &out, const road &r) {
+    const double length = r.length();
+    out << "  <road name=\"Road " << r.id << "\" length=\"" << length << "\" id=\"" << r.id
+        << "\" junction=\"" << r.junction << "\">\n";
+    out << "    <link>\n";
+    write_link(out, "predecessor", r.predecessor);
+    write_link(out, "successor", r.successor);
+    out << "    </link>\n";
+
+    out << "    <planView>\n";
+    double s = 0.0;
+    for (auto &&g : r.geometries) {
+      out << "      <geometry s=\"" << s << "\" x=\"" << g.x << "\" y=\"" << g.y << "\" hdg=\"" << g.heading
+          << "\" length=\"" << g.length << "\">";
+      switch (g.type) {
+        case geometry_type::line:
+          out << "<line/>";
+          break;
+        case geometry_type::arc:
+          out << "<arc curvature=\"" << g.curvature << "\"/>";
+          break;
+        case geometry_type::spiral:
+          out << "<spiral curvStart=\"0\" curvEnd=\"" << g.curvature << "\"/>";
+          break;
+      }
+      out << "</geometry>\n";
+      s += g.length;
+    }
+    out << "    </planView>\n";
+
+    out << "    <elevationProfile>\n";
+    out << "      <elevation s=\"0\" a=\"" << r.elevation << "\" b=\"" << r.slope << "\" c=\"0\" d=\"0\"/>\n";
+    out << "    </elevationProfile>\n";
+
+    out << "    <lanes>\n";
+    out << "      <laneOffset s=\"0\" a=\"" << r.lane_offset << "\" b=\"0\" c=\"0\" d=\"0\"/>\n";
+    for (auto &&section : r.lane_sections) {
+      out << "      <laneSection s=\"" << section.s << "\">\n";
+      out << "        <left>\n";
+      for (auto it = section.lanes.rbegin(); it != section.lanes.rend(); ++it) {
+        if (it->id > 0) {
+          write_lane(out, *it);
+        }
+      }
+      out << "        </left>\n";
+      out << "        <center>\n";
+      out << "          <lane id=\"0\" type=\"driving\" level=\"false\">\n";
+      out << "            <roadMark sOffset=\"0\" type=\"solid\" weight=\"standard\" color=\"standard\" width=\"0.15\" laneChange=\"none\"/>\n";
+      out << "          </lane>\n";
+      out << "        </center>\n";
+      out << "        <right>\n";
+      for (auto &&l : section.lanes) {
+        if (l.id < 0) {
+          write_lane(out, l);
+        }
+      }
+      out << "        </right>\n";
+      out << "      </laneSection>\n";
+    }
+    out << "    </lanes>\n";
+    out << "  </road>\n";
+  }
+
+  static void write_junction(std::ostream &out, const junction &j) {
+    out << "  <junction id=\"" << j.id << "\" name=\"Junction " << j.id << "\">\n";
+    int id = 0;
+    for (auto &&connection : j.connections) {
+      out << "    <connection id=\"" << id++ << "\" incomingRoad=\"" << connection.incoming_road
+          << "\" connectingRoad=\"" << connection.connecting_road << "\" contactPoint=\"start\">\n";
+      for (auto &&link : connection.lane_links) {
+        out << "      <laneLink from=\"" << link.first << "\" to=\"" << link.second << "\"/>\n";
+      }
+      out << "    </connection>\n";
+    }
+    out << "  </junction>\n";
+  }
+
+  static std::string write_document(const std::vector<road> &roads, const std::vector<junction> &junctions) {
+    std::ostringstream out;
+    out.imbue(std::locale::classic());
+    out << std::setprecision(12);
+    write_header(out);
+    for (auto &&r : roads) {
+      write_road(out, r);
+    }
+    for (auto &&j : junctions) {
+      write_junction(out, j);
+    }
+    out << "</OpenDRIVE>\n";
+    return out.str();
+  }
+
+  /// Driving lanes 1..n on each side, linked to the same lane id before and
+  /// after, optionally with a sidewalk on the outside of each side.
+  static std::vector<lane> make_lanes(int lanes_per_direction, double width, bool sidewalks, bool linked) {
+    std::vector<lane> lanes;
+    for (int side : {-1, 1}) {
+      for (int i = 1; i <= lanes_per_direction; ++i) {
+        const int id = side * i;
+        lanes.push_back({id, "driving", width, linked ? id : 0, linked ? id : 0});
+      }
+      if (sidewalks) {
+        lanes.push_back({side * (lanes_per_direction + 1), "sidewalk", 2.0});
+      }
+    }
+    return lanes;
+  }
+
+  // ===========================================================================
+  // -- Grid city --------------------------------------------------------------
+  // ===========================================================================
+
+  std::string make_grid_city(const grid_city_options &options) {
+    const size_t rows = options.rows;
+    const size_t columns = options.columns;
+    const int n = options.lanes_per_direction;
+    const double margin = 0.5 * options.junction_size;
+    std::mt19937_64 rng(options.seed);
+    std::uniform_real_distribution<double> random_height(0.0, 3.0);
+
+    std::vector<double> heights(rows * columns);
+    for (auto &height : heights) {
+      height = random_height(rng);
+    }
+    auto center_of = [&](size_t junction) {
+      return pose{
+          static_cast<double>(junction % columns) * options.block_size,
+          static_cast<double>(junction / columns) * options.block_size,
+          0.0};
+    };
+
+    // The street leaving each junction in each direction (east, north, west,
+    // south), if any, and whether the street starts at the junction.
+    struct arm {
+      int road = -1;
+      bool starts_here = false;
+    };
+    std::vector<std::array<arm, 4u>> arms(rows * columns);
+
+    std::vector<road> roads;
+    auto add_street = [&](size_t from, size_t to, int direction) {
+      road r;
+      r.id = static_cast<int>(roads.size());
+      const double heading = direction * 0.5 * PI;
+      const auto center = center_of(from);
+      const pose start{center.x + margin * std::cos(heading), center.y + margin * std::sin(heading), heading};
+      const double length = options.block_size - 2.0 * margin;
+      r.geometries.push_back(make_geometry(geometry_type::line, start, length));
+      r.predecessor = {"junction", static_cast<int>(from)};
+      r.successor = {"junction", static_cast<int>(to)};
+      r.elevation = heights[from];
+      r.slope = (heights[to] - heights[from]) / length;
+      r.lane_sections.push_back({0.0, make_lanes(n, 3.5, options.sidewalks, true)});
+      r.lane_sections.push_back({0.5 * length, make_lanes(n, 3.25, options.sidewalks, true)});
+      arms[from][static_cast<size_t>(direction)] = {r.id, true};
+      arms[to][static_cast<size_t>((direction + 2) % 4)] = {r.id, false};
+      roads.emplace_back(std::move(r));
+    };
+    for (size_t i = 0u; i < rows * columns; ++i) {
+      if ((i % columns) + 1u < columns) {
+        add_street(i, i + 1u, 0);
+      }
+      if (i + columns < rows * columns) {
+        add_street(i, i + columns, 1);
+      }
+    }
+
+    std::vector<junction> junctions;
+    for (size_t j = 0u; j < rows * columns; ++j) {
+      junction result;
+      result.id = static_cast<int>(j);
+      const auto center = center_of(j);
+      for (int in = 0; in < 4; ++in) {
+        const auto &incoming = arms[j][static_cast<size_t>(in)];
+        if (incoming.road < 0) {
+          continue;
+        }
+        for (int turn : {0, 1, -1}) {
+          // Arriving from arm "in" and going straight, left or right.
+          const int out = (in + 2 + turn + 4) % 4;
+          const auto &outgoing = arms[j][static_cast<size_t>(out)];
+          if (outgoing.road < 0) {
+            continue;
+          }
+          const double in_direction = in * 0.5 * PI;
+          const pose start{
+              center.x + margin * std::cos(in_direction),
+              center.y + margin * std::sin(in_direction),
+              in_direction + PI};
+          road r;
+          r.id = static_cast<int>(roads.size());
+          r.junction = result.id;
+          if (turn == 0) {
+            r.geometries.push_back(make_geometry(geometry_type::line, start, 2.0 * margin));
+          } else {
+            r.geometries.push_back(make_geometry(geometry_type::arc, start, 0.5 * PI * margin, turn / margin));
+          }
+          r.predecessor = {"road", incoming.road, incoming.starts_here ? "start" : "end"};
+          r.successor = {"road", outgoing.road, outgoing.starts_here ? "start" : "end"};
+          r.elevation = heights[j];
+
+          junction_connection connection{incoming.road, r.id, {}};
+          std::vector<lane> lanes;
+          for (int i = 1; i <= n; ++i) {
+            // Lanes driving towards the junction are the left ones of a road
+            // starting here, and the right ones of a road ending here.
+            const int from = incoming.starts_here ? i : -i;
+            const int to = outgoing.starts_here ? -i : i;
+            lanes.push_back({-i, "driving", 3.5, from, to});
+            connection.lane_links.emplace_back(from, -i);
+          }
+          r.lane_sections.push_back({0.0, std::move(lanes)});
+          result.connections.emplace_back(std::move(connection));
+          roads.emplace_back(std::move(r));
+        }
+      }
+      junctions.emplace_back(std::move(result));
+    }
+    return write_document(roads, junctions);
+  }
+
+  // ===========================================================================
+  // -- Highway ----------------------------------------------------------------
+  // ===========================================================================
+
+  std::string make_highway(const highway_options &options) {
+    std::mt19937_64 rng(options.seed);
+    std::uniform_real_distribution<double> random(0.0, 1.0);
+    std::vector<road> roads;
+    pose position{0.0, 0.0, 0.0};
+    double elevation = 0.0;
+    const int number_of_roads = static_cast<int>(options.number_of_roads);
+    for (int id = 0; id < number_of_roads; ++id) {
+      road r;
+      r.id = id;
+      // Alternate the direction of the curves so the highway does not turn
+      // over itself.
+      const double curvature = (id % 2 == 0 ? 1.0 : -1.0) / (150.0 + 150.0 * random(rng));
+      r.geometries.push_back(make_geometry(geometry_type::line, position, 100.0 + 100.0 * random(rng)));
+      position = end_of(r.geometries.back());
+      r.geometries.push_back(make_geometry(geometry_type::spiral, position, 40.0, curvature));
+      position = end_of(r.geometries.back());
+      r.geometries.push_back(make_geometry(geometry_type::arc, position, 50.0 + 100.0 * random(rng), curvature));
+      position = end_of(r.geometries.back());
+
+      if (id > 0) {
+        r.predecessor = {"road", id - 1, "end"};
+      }
+      if (id + 1 < number_of_roads) {
+        r.successor = {"road", id + 1, "start"};
+      }
+      const double length = r.length();
+      r.elevation = elevation;
+      r.slope = 0.04 * (random(rng) - 0.5);
+      elevation += r.slope * length;
+      r.lane_offset = 0.5;
+      r.lane_sections.push_back({0.0, make_lanes(options.lanes_per_direction, 3.75, false, true)});
+      r.lane_sections.push_back({0.5 * length, make_lanes(options.lanes_per_direction, 3.5, false, true)});
+      roads.emplace_back(std::move(r));
+    }
+    return write_document(roads, {});
+  }
+
+  // ===========================================================================
+  // -- Loading ----------------------------------------------------------------
+  // ===========================================================================
+
+  carla::SharedPtr<carla::road::Map> load_map(const std::string &xodr) {
+    std::string error;
+    auto map = carla::opendrive::OpenDrive::Load(xodr, XmlInputType::CONTENT, &error);
+    if ((map == nullptr) || !error.empty()) {
+      throw std::runtime_error("unable to load OpenDRIVE: " + error);
+    }
+    return map;
+  }
+
+} // namespace opendrive
+} // namespace util
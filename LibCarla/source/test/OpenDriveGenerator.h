@@ -0,0 +1,61 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <carla/Memory.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace carla { namespace road { class Map; } }
+
+/// Procedural OpenDRIVE documents for tests and benchmarks.
+namespace util {
+namespace opendrive {
+
+  struct grid_city_options {
+    /// Number of intersections in each direction.
+    size_t rows = 4u;
+    size_t columns = 4u;
+    /// Distance between consecutive intersections [meters].
+    double block_size = 100.0;
+    /// Size of the square occupied by each junction [meters].
+    double junction_size = 20.0;
+    /// Driving lanes in each direction of the streets.
+    int lanes_per_direction = 2;
+    bool sidewalks = true;
+    uint64_t seed = 0u;
+  };
+
+  /// A grid of streets with a junction at every intersection. Streets are
+  /// straight lines with two lane sections; every junction connects each
+  /// lane arriving to it with the lane of the same index straight ahead
+  /// (lines), to the left and to the right (arcs).
+  ///
+  /// The document has rows * (columns - 1) + (rows - 1) * columns streets plus
+  /// the connecting roads of the junctions.
+  std::string make_grid_city(const grid_city_options &options);
+
+  struct highway_options {
+    size_t number_of_roads = 50u;
+    /// Driving lanes in each direction.
+    int lanes_per_direction = 3;
+    uint64_t seed = 0u;
+  };
+
+  /// A highway made of @a number_of_roads consecutive roads, each one a line,
+  /// a spiral and an arc, with two lane sections, a lane offset and a slope.
+  std::string make_highway(const highway_options &options);
+
+  /// Build the road map of the OpenDRIVE document @a xodr.
+  ///
+  /// @throw std::runtime_error with the parser error if it cannot be built.
+  carla::SharedPtr<carla::road::Map> load_map(const std::string &xodr);
+
+} // namespace opendrive
+} // namespace util
@@ -0,0 +1,170 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "RoadMapUtil.h"
+#include "OpenDriveGenerator.h"
+
+#include <carla/geom/Math.h>
+#include <carla/road/Map.h>
+#include <carla/road/MapBuilder.h>
+#include <carla/road/WaypointGenerator.h>
+#include <carla/road/element/RoadInfo.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace util {
+namespace road_map {
+
+  using namespace carla::road;
+  using namespace carla::road::element;
+  using carla::geom::Location;
+  using carla::geom::Math;
+
+  carla::SharedPtr<Map> load_grid_city(size_t size) {
+    opendrive::grid_city_options options;
+    options.rows = size;
+    options.columns = size;
+    return opendrive::load_map(opendrive::make_grid_city(options));
+  }
+
+  std::vector<std::pair<id_type, int>> get_driving_lanes(const Map &map) {
+    std::vector<std::pair<id_type, int>> result;
+    for (auto &&road : map.GetData().GetRoadSegments()) {
+      road.GetInfo<RoadInfoLane>(0.0)->ForEachLane(
+          static_cast<LaneTypeMask>(LaneType::Driving),
+          [&](int lane_id) { result.emplace_back(road.GetId(), lane_id); });
+    }
+    return result;
+  }
+
+  std::vector<WaypointHandle> make_random_waypoints(
+      const Map &map,
+      size_t count,
+      uint64_t seed) {
+    const auto lanes = get_driving_lanes(map);
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<size_t> lane(0u, lanes.size() - 1u);
+    std::uniform_real_distribution<double> fraction(0.0, 1.0);
+    std::vector<WaypointHandle> result;
+    for (auto i = 0u; i < count; ++i) {
+      const auto &pair = lanes[lane(rng)];
+      result.push_back({pair.first, pair.second, fraction(rng) * map.GetData().GetRoad(pair.first)->GetLength()});
+    }
+    return result;
+  }
+
+  carla::SharedPtr<Map> make_synthetic_map(size_t size) {
+    constexpr double cell = 100.0;
+    std::mt19937_64 rng(42u);
+    std::uniform_real_distribution<double> heading(-Math::pi(), Math::pi());
+    std::uniform_real_distribution<double> offset(0.0, cell);
+    std::uniform_real_distribution<double> length(5.0, 80.0);
+    std::uniform_real_distribution<double> curvature(0.005, 0.1);
+    MapBuilder builder;
+    id_type id = 0u;
+    for (auto i = 0u; i < size; ++i) {
+      for (auto j = 0u; j < size; ++j) {
+        for (auto k = 0u; k < 2u; ++k, ++id) {
+          RoadSegmentDefinition def(id);
+          const Location start(
+              static_cast<float>(i * cell + offset(rng)),
+              static_cast<float>(j * cell + offset(rng)),
+              0.0f);
+          if (id % 25u == 24u) {
+            const double sign = (id % 2u == 0u) ? -1.0 : 1.0;
+            def.MakeGeometry<GeometrySpiral>(0.0, length(rng), heading(rng), start, 0.0, sign * curvature(rng));
+          } else if (k == 0u) {
+            def.MakeGeometry<GeometryLine>(0.0, length(rng), heading(rng), start);
+          } else {
+            const double sign = (id % 4u == 1u) ? -1.0 : 1.0;
+            def.MakeGeometry<GeometryArc>(0.0, length(rng), heading(rng), start, sign * curvature(rng));
+          }
+          builder.AddRoadSegmentDefinition(def);
+        }
+      }
+    }
+    return builder.Build();
+  }
+
+  std::vector<std::pair<id_type, double>> get_nearest_roads_brute_force(
+      const Map &map,
+      const Location &location,
+      size_t count) {
+    std::vector<std::pair<id_type, double>> result;
+    for (auto &&road : map.GetData().GetRoadSegments()) {
+      const auto distance = road.GetNearestPoint(location).second;
+      auto it = std::upper_bound(result.begin(), result.end(), distance,
+          [](double d, const auto &item) { return d < item.second; });
+      if (static_cast<size_t>(it - result.begin()) < count) {
+        result.insert(it, std::make_pair(road.GetId(), distance));
+        if (result.size() > count) {
+          result.pop_back();
+        }
+      }
+    }
+    return result;
+  }
+
+  std::vector<Waypoint> get_next_recursive(
+      const carla::SharedPtr<const Map> &map,
+      const Waypoint &waypoint,
+      double distance) {
+    const auto &road = waypoint.GetRoadSegment();
+    const auto lane_id = waypoint.GetLaneId();
+    double distance_on_next_segment;
+    if (lane_id <= 0) {
+      const auto total_distance = waypoint.GetDistance() + distance;
+      if (total_distance <= road.GetLength()) {
+        return { map->MakeWaypoint({road.GetId(), lane_id, total_distance}) };
+      }
+      distance_on_next_segment = total_distance - road.GetLength();
+    } else {
+      const auto total_distance = waypoint.GetDistance() - distance;
+      if (total_distance >= 0.0) {
+        return { map->MakeWaypoint({road.GetId(), lane_id, total_distance}) };
+      }
+      distance_on_next_segment = std::abs(total_distance);
+    }
+    std::vector<Waypoint> result;
+    for (auto &&next_waypoint : WaypointGenerator::GetSuccessors(waypoint)) {
+      auto next = get_next_recursive(map, next_waypoint, distance_on_next_segment);
+      result.insert(result.end(), next.begin(), next.end());
+    }
+    return result;
+  }
+
+  std::vector<std::vector<Location>> make_trajectories(
+      const Map &map,
+      const std::vector<WaypointHandle> &origins,
+      size_t number_of_steps,
+      double step,
+      float lateral_offset) {
+    std::vector<std::vector<Location>> result;
+    std::vector<WaypointHandle> next;
+    for (auto handle : origins) {
+      result.emplace_back();
+      for (auto i = 0u; i < number_of_steps; ++i) {
+        const auto transform = map.ComputeTransform(handle);
+        const auto yaw = Math::to_radians(transform.rotation.yaw);
+        result.back().emplace_back(transform.location + Location(
+            lateral_offset * std::sin(yaw),
+            -lateral_offset * std::cos(yaw),
+            0.0f));
+        next.clear();
+        WaypointGenerator::GetNext(map, handle, step, next);
+        if (next.empty()) {
+          break;
+        }
+        handle = next.front();
+      }
+    }
+    return result;
+  }
+
+} // namespace road_map
+} // namespace util
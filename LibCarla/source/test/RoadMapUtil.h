@@ -0,0 +1,72 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <carla/Memory.h>
+#include <carla/geom/Location.h>
+#include <carla/road/element/Types.h>
+#include <carla/road/element/Waypoint.h>
+#include <carla/road/element/WaypointHandle.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace carla { namespace road { class Map; } }
+
+/// Synthetic road maps and reference queries shared by the road tests and
+/// benchmarks.
+namespace util {
+namespace road_map {
+
+  /// A grid city of @a size x @a size junctions, with two driving lanes in
+  /// each direction and sidewalks.
+  carla::SharedPtr<carla::road::Map> load_grid_city(size_t size);
+
+  /// (road, lane) of every driving lane of @a map.
+  std::vector<std::pair<carla::road::element::id_type, int>> get_driving_lanes(
+      const carla::road::Map &map);
+
+  /// @a count waypoints at a random distance of random driving lanes of
+  /// @a map, always the same ones for the same @a seed.
+  std::vector<carla::road::element::WaypointHandle> make_random_waypoints(
+      const carla::road::Map &map,
+      size_t count,
+      uint64_t seed);
+
+  /// A grid of @a size x @a size cells of 100 meters, each cell with a
+  /// straight road and an arc at random. Every 25th road is a spiral.
+  carla::SharedPtr<carla::road::Map> make_synthetic_map(size_t size);
+
+  /// (road id, distance) of the @a count roads nearest to @a location,
+  /// computed visiting every road of @a map.
+  std::vector<std::pair<carla::road::element::id_type, double>> get_nearest_roads_brute_force(
+      const carla::road::Map &map,
+      const carla::geom::Location &location,
+      size_t count);
+
+  /// The recursive implementation WaypointGenerator::GetNext used to have,
+  /// kept as reference. The results are concatenated in order of the
+  /// successors.
+  std::vector<carla::road::element::Waypoint> get_next_recursive(
+      const carla::SharedPtr<const carla::road::Map> &map,
+      const carla::road::element::Waypoint &waypoint,
+      double distance);
+
+  /// Drive @a number_of_steps steps of @a step meters from each of
+  /// @a origins, following the first successor, and return the location of
+  /// each step shifted @a lateral_offset meters to the left of the lane.
+  std::vector<std::vector<carla::geom::Location>> make_trajectories(
+      const carla::road::Map &map,
+      const std::vector<carla::road::element::WaypointHandle> &origins,
+      size_t number_of_steps,
+      double step,
+      float lateral_offset);
+
+} // namespace road_map
+} // namespace util
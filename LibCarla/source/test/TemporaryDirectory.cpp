@@ -0,0 +1,47 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "TemporaryDirectory.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+#include <dirent.h>
+#include <unistd.h>
+
+namespace util {
+namespace filesystem {
+
+  temporary_directory::temporary_directory() {
+    const char *tmp = std::getenv("TMPDIR");
+    std::string pattern = ((tmp != nullptr) && (*tmp != '\0')) ? tmp : "/tmp";
+    pattern += "/libcarla-test-XXXXXX";
+    std::vector<char> buffer(pattern.begin(), pattern.end());
+    buffer.push_back('\0');
+    if (::mkdtemp(buffer.data()) == nullptr) {
+      throw std::runtime_error("unable to create temporary directory " + pattern);
+    }
+    _path = buffer.data();
+  }
+
+  temporary_directory::~temporary_directory() {
+    DIR *dir = ::opendir(_path.c_str());
+    if (dir != nullptr) {
+      while (const auto *entry = ::readdir(dir)) {
+        const std::string name = entry->d_name;
+        if ((name != ".") && (name != "..")) {
+          std::remove(path(name).c_str());
+        }
+      }
+      ::closedir(dir);
+    }
+    ::rmdir(_path.c_str());
+  }
+
+} // namespace filesystem
+} // namespace util
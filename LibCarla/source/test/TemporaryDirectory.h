@@ -0,0 +1,40 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <carla/NonCopyable.h>
+
+#include <string>
+
+namespace util {
+namespace filesystem {
+
+  /// A new empty directory in the temporary directory of the system, removed
+  /// together with the files in it on destruction.
+  class temporary_directory : private carla::NonCopyable {
+  public:
+
+    temporary_directory();
+
+    ~temporary_directory();
+
+    const std::string &path() const {
+      return _path;
+    }
+
+    /// Path of the file @a filename inside this directory.
+    std::string path(const std::string &filename) const {
+      return _path + '/' + filename;
+    }
+
+  private:
+
+    std::string _path;
+  };
+
+} // namespace filesystem
+} // namespace util
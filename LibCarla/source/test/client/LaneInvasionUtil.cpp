@@ -0,0 +1,63 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "LaneInvasionUtil.h"
+#include "OpenDriveGenerator.h"
+
+#include <carla/client/Map.h>
+#include <carla/client/Waypoint.h>
+
+#include <cmath>
+#include <random>
+
+namespace util {
+namespace lane_invasion {
+
+  using carla::client::Map;
+  using carla::geom::Transform;
+
+  carla::SharedPtr<Map> make_street() {
+    opendrive::grid_city_options options;
+    options.rows = 1u;
+    options.columns = 2u;
+    options.block_size = 1000.0;
+    options.lanes_per_direction = 2;
+    const auto xodr = opendrive::make_grid_city(options);
+    // Throws with the parser error, the client map would only report that it
+    // failed.
+    opendrive::load_map(xodr);
+    return carla::MakeShared<Map>(carla::rpc::MapInfo{"street", xodr, {}});
+  }
+
+  Transform get_transform(const Map &map, double s, float lateral) {
+    const auto lane_1 = map.MakeWaypoint({0u, -1, s})->GetTransform();
+    const auto lane_2 = map.MakeWaypoint({0u, -2, s})->GetTransform();
+    auto transform = lane_1;
+    transform.location = lane_1.location + lateral * (lane_2.location - lane_1.location);
+    return transform;
+  }
+
+  std::vector<std::vector<Transform>> make_weaving_vehicles(
+      const Map &map,
+      size_t number_of_vehicles,
+      size_t number_of_frames) {
+    std::mt19937_64 rng(11u);
+    std::uniform_real_distribution<double> start(10.0, 800.0);
+    std::uniform_real_distribution<float> phase(0.0f, 6.0f);
+    std::vector<std::vector<Transform>> result(number_of_frames);
+    for (auto i = 0u; i < number_of_vehicles; ++i) {
+      const auto s = start(rng);
+      const auto p = phase(rng);
+      for (auto frame = 0u; frame < number_of_frames; ++frame) {
+        const auto lateral = 0.5f + 0.7f * std::sin(p + 0.1f * static_cast<float>(frame));
+        result[frame].emplace_back(get_transform(map, s + 0.7 * frame, lateral));
+      }
+    }
+    return result;
+  }
+
+} // namespace lane_invasion
+} // namespace util
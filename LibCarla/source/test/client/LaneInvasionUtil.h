@@ -0,0 +1,45 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <carla/Memory.h>
+#include <carla/geom/BoundingBox.h>
+#include <carla/geom/Transform.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace carla { namespace client { class Map; } }
+
+/// Vehicles driving along a street, shared by the lane invasion tests and
+/// benchmarks.
+namespace util {
+namespace lane_invasion {
+
+  /// Bounding box of the vehicles.
+  const carla::geom::BoundingBox vehicle_box{carla::geom::Vector3D{2.0f, 0.9f, 0.7f}};
+
+  /// A single straight street, 980 meters long, with two lanes in each
+  /// direction.
+  ///
+  /// @throw std::runtime_error with the parser error if it cannot be built.
+  carla::SharedPtr<carla::client::Map> make_street();
+
+  /// Transform of a vehicle at @a s meters along the street, between the
+  /// center of lane -1 (@a lateral = 0) and the center of lane -2
+  /// (@a lateral = 1).
+  carla::geom::Transform get_transform(const carla::client::Map &map, double s, float lateral);
+
+  /// Transforms of @a number_of_vehicles vehicles weaving between both lanes
+  /// of the street, for each of @a number_of_frames frames.
+  std::vector<std::vector<carla::geom::Transform>> make_weaving_vehicles(
+      const carla::client::Map &map,
+      size_t number_of_vehicles,
+      size_t number_of_frames);
+
+} // namespace lane_invasion
+} // namespace util
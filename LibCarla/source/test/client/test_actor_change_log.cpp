@@ -0,0 +1,96 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/client/detail/ActorChangeLog.h>
+
+using carla::client::detail::ActorChangeLog;
+using carla::client::detail::ActorIdChanges;
+
+using Ids = std::vector<carla::ActorId>;
+
+TEST(actor_change_log, changes_since) {
+  ActorChangeLog log;
+  log.Record(1u, {1u, 2u, 3u}, {});
+  log.Record(2u, {}, {});
+  log.Record(3u, {4u}, {2u});
+  log.Record(5u, {5u}, {4u});
+
+  auto changes = log.GetChangesSince(0u);
+  ASSERT_EQ(changes.frame_count, 5u);
+  ASSERT_EQ(changes.spawned, (Ids{1u, 3u, 5u}));
+  ASSERT_TRUE(changes.destroyed.empty());
+  ASSERT_FALSE(changes.truncated);
+
+  changes = log.GetChangesSince(1u);
+  ASSERT_EQ(changes.spawned, (Ids{5u}));
+  ASSERT_EQ(changes.destroyed, (Ids{2u}));
+
+  changes = log.GetChangesSince(3u);
+  ASSERT_EQ(changes.spawned, (Ids{5u}));
+  ASSERT_EQ(changes.destroyed, (Ids{4u}));
+
+  changes = log.GetChangesSince(5u);
+  ASSERT_TRUE(changes.empty());
+  ASSERT_EQ(changes.frame_count, 5u);
+}
+
+TEST(actor_change_log, out_of_order_frames) {
+  ActorChangeLog log;
+  log.Record(2u, {2u}, {});
+  log.Record(1u, {1u}, {});
+  auto changes = log.GetChangesSince(1u);
+  ASSERT_EQ(changes.frame_count, 2u);
+  ASSERT_EQ(changes.spawned, (Ids{2u}));
+}
+
+TEST(actor_change_log, truncated_history) {
+  ActorChangeLog log;
+  const size_t frames = ActorChangeLog::max_size() + 10u;
+  for (size_t i = 1u; i <= frames; ++i) {
+    log.Record(i, {static_cast<carla::ActorId>(i)}, {});
+  }
+  log.Record(frames + 1u, {}, {1u, 2u, 20u});
+
+  // The actors spawned in the frames dropped from the history are missing,
+  // and so is their destruction.
+  auto changes = log.GetChangesSince(0u);
+  ASSERT_TRUE(changes.truncated);
+  ASSERT_EQ(changes.spawned.size(), ActorChangeLog::max_size() - 2u);
+  ASSERT_EQ(changes.destroyed, (Ids{1u, 2u}));
+
+  // Actors spawned before the given frame are still reported as destroyed.
+  changes = log.GetChangesSince(11u);
+  ASSERT_FALSE(changes.truncated);
+  ASSERT_EQ(changes.destroyed, (Ids{1u, 2u}));
+}
+
+TEST(actor_change_log, reset) {
+  ActorChangeLog log;
+  log.Record(10u, {1u, 2u}, {});
+  log.Record(11u, {}, {1u});
+
+  // A new episode starts at frame 20.
+  log.Reset(20u);
+  log.Record(21u, {7u}, {});
+
+  auto changes = log.GetChangesSince(10u);
+  ASSERT_TRUE(changes.truncated);
+  ASSERT_EQ(changes.frame_count, 21u);
+  ASSERT_EQ(changes.spawned, (Ids{7u}));
+  ASSERT_TRUE(changes.destroyed.empty());
+
+  changes = log.GetChangesSince(20u);
+  ASSERT_FALSE(changes.truncated);
+  ASSERT_EQ(changes.spawned, (Ids{7u}));
+
+  log.Clear();
+  changes = log.GetChangesSince(0u);
+  ASSERT_FALSE(changes.truncated);
+  ASSERT_EQ(changes.frame_count, 0u);
+  ASSERT_TRUE(changes.empty());
+}
@@ -0,0 +1,96 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/client/ActorStateArrays.h>
+#include <carla/client/detail/EpisodeState.h>
+
+using carla::client::ActorStateArrays;
+using carla::client::detail::EpisodeState;
+using carla::client::detail::PackActorStates;
+
+using Floats = std::vector<float>;
+
+static std::shared_ptr<const EpisodeState> MakeEpisodeState() {
+  std::unordered_map<carla::ActorId, EpisodeState::ActorState> actors;
+
+  EpisodeState::ActorState vehicle{};
+  vehicle.transform = carla::geom::Transform{
+      carla::geom::Location{1.0f, 2.0f, 3.0f},
+      carla::geom::Rotation{10.0f, 20.0f, 30.0f}};
+  vehicle.velocity = {4.0f, 5.0f, 6.0f};
+  vehicle.angular_velocity = {7.0f, 8.0f, 9.0f};
+  vehicle.acceleration = {-1.0f, -2.0f, -3.0f};
+  vehicle.state.vehicle_data.control =
+      carla::rpc::VehicleControl{0.5f, -0.25f, 0.75f, true, false, false, 3};
+  actors.emplace(1u, vehicle);
+
+  EpisodeState::ActorState walker{};
+  walker.transform.location = {11.0f, 12.0f, 13.0f};
+  actors.emplace(2u, walker);
+
+  return std::make_shared<const EpisodeState>(
+      7u,
+      carla::client::Timestamp{42u, 1.0, 0.1, 0.0},
+      std::move(actors));
+}
+
+TEST(actor_state_arrays, pack_all_fields) {
+  const auto state = MakeEpisodeState();
+  const auto arrays = PackActorStates(*state, {2u, 3u, 1u}, ActorStateArrays::All, {1u});
+
+  ASSERT_EQ(arrays.frame_count, 42u);
+  ASSERT_EQ(arrays.ids, (std::vector<carla::ActorId>{2u, 3u, 1u}));
+  ASSERT_EQ(arrays.valid, (std::vector<uint8_t>{1u, 0u, 1u}));
+
+  // Values in the order the ids were requested, zero for missing actors.
+  ASSERT_EQ(arrays.locations, (Floats{11.0f, 12.0f, 13.0f, 0.0f, 0.0f, 0.0f, 1.0f, 2.0f, 3.0f}));
+  ASSERT_EQ(arrays.rotations, (Floats{0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 10.0f, 20.0f, 30.0f}));
+  ASSERT_EQ(arrays.velocities, (Floats{0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 4.0f, 5.0f, 6.0f}));
+  ASSERT_EQ(arrays.angular_velocities, (Floats{0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 7.0f, 8.0f, 9.0f}));
+  ASSERT_EQ(arrays.accelerations, (Floats{0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, -1.0f, -2.0f, -3.0f}));
+
+  // Only vehicles get a control.
+  ASSERT_EQ(arrays.vehicle_controls.size(), 18u);
+  ASSERT_EQ(
+      Floats(arrays.vehicle_controls.begin(), arrays.vehicle_controls.begin() + 12u),
+      Floats(12u, 0.0f));
+  ASSERT_EQ(
+      Floats(arrays.vehicle_controls.begin() + 12u, arrays.vehicle_controls.end()),
+      (Floats{0.5f, -0.25f, 0.75f, 1.0f, 0.0f, 3.0f}));
+}
+
+TEST(actor_state_arrays, field_mask) {
+  const auto state = MakeEpisodeState();
+
+  auto arrays = PackActorStates(*state, {1u, 2u}, ActorStateArrays::None, {1u});
+  ASSERT_EQ(arrays.ids.size(), 2u);
+  ASSERT_EQ(arrays.valid.size(), 2u);
+  ASSERT_TRUE(arrays.locations.empty());
+  ASSERT_TRUE(arrays.rotations.empty());
+  ASSERT_TRUE(arrays.velocities.empty());
+  ASSERT_TRUE(arrays.angular_velocities.empty());
+  ASSERT_TRUE(arrays.accelerations.empty());
+  ASSERT_TRUE(arrays.vehicle_controls.empty());
+
+  arrays = PackActorStates(
+      *state,
+      {1u, 2u},
+      ActorStateArrays::Location | ActorStateArrays::Velocity,
+      {1u});
+  ASSERT_EQ(arrays.locations.size(), 6u);
+  ASSERT_EQ(arrays.velocities.size(), 6u);
+  ASSERT_TRUE(arrays.rotations.empty());
+  ASSERT_TRUE(arrays.angular_velocities.empty());
+  ASSERT_TRUE(arrays.accelerations.empty());
+  ASSERT_TRUE(arrays.vehicle_controls.empty());
+
+  arrays = PackActorStates(*state, {}, ActorStateArrays::All, {});
+  ASSERT_TRUE(arrays.ids.empty());
+  ASSERT_TRUE(arrays.locations.empty());
+  ASSERT_EQ(arrays.frame_count, 42u);
+}
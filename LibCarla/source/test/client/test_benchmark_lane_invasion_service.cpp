@@ -0,0 +1,58 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+#include "LaneInvasionUtil.h"
+
+#include <carla/StopWatch.h>
+#include <carla/client/Map.h>
+#include <carla/client/detail/LaneInvasionService.h>
+
+#include <vector>
+
+using carla::client::Timestamp;
+using carla::client::detail::LaneInvasionService;
+using carla::geom::Transform;
+using carla::road::element::LaneMarking;
+
+/// Run @a service over @a frames, return the number of lane markings crossed
+/// by each vehicle.
+static std::vector<size_t> RunService(
+    LaneInvasionService &service,
+    const std::vector<std::vector<Transform>> &frames) {
+  const auto number_of_vehicles = frames.front().size();
+  std::vector<size_t> result(number_of_vehicles, 0u);
+  for (auto i = 0u; i < number_of_vehicles; ++i) {
+    service.Subscribe(static_cast<carla::ActorId>(i), util::lane_invasion::vehicle_box, [&result, i](
+        const Timestamp &,
+        const Transform &,
+        std::vector<LaneMarking> lanes) {
+      result[i] += lanes.size();
+    });
+  }
+  for (auto frame = 0u; frame < frames.size(); ++frame) {
+    service.Tick(Timestamp(frame, 0.05 * frame, 0.05, 0.0), [&](carla::ActorId id) {
+      return &frames[frame][id];
+    });
+  }
+  return result;
+}
+
+TEST(benchmark_lane_invasion_service, tick) {
+  auto map = util::lane_invasion::make_street();
+  constexpr size_t number_of_frames = 100u;
+  for (auto number_of_vehicles : {50u, 200u}) {
+    const auto frames = util::lane_invasion::make_weaving_vehicles(*map, number_of_vehicles, number_of_frames);
+    LaneInvasionService service(map);
+    carla::StopWatch stop_watch;
+    const auto crossed_lanes = RunService(service, frames);
+    stop_watch.Stop();
+    ASSERT_EQ(crossed_lanes.size(), number_of_vehicles);
+    carla::logging::log(
+        "Benchmark:", number_of_vehicles, "vehicles:",
+        stop_watch.GetElapsedTime<std::chrono::microseconds>() / number_of_frames, "us per tick");
+  }
+}
@@ -0,0 +1,73 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+#include "RoadMapUtil.h"
+
+#include <carla/StopWatch.h>
+#include <carla/client/LaneOccupancyIndex.h>
+#include <carla/road/Map.h>
+#include <carla/road/WaypointGenerator.h>
+
+#include <vector>
+
+using carla::ActorId;
+using carla::client::LaneOccupancyIndex;
+using carla::geom::Location;
+using carla::road::WaypointGenerator;
+using carla::road::element::WaypointHandle;
+
+TEST(benchmark_lane_occupancy_index, update) {
+  constexpr size_t number_of_actors = 2000u;
+  constexpr size_t number_of_frames = 50u;
+  auto map = util::road_map::load_grid_city(12u);
+  auto waypoints = util::road_map::make_random_waypoints(*map, number_of_actors, 5u);
+  std::vector<ActorId> ids;
+  for (auto i = 0u; i < number_of_actors; ++i) {
+    // Not consecutive ids, in no particular order.
+    ids.emplace_back(static_cast<ActorId>(7u * (number_of_actors - i)));
+  }
+
+  // A vehicle at 50 km/h ticking at 20 FPS moves about 0.7 meters per tick.
+  std::vector<std::vector<Location>> frames(number_of_frames);
+  std::vector<WaypointHandle> next;
+  for (auto &&locations : frames) {
+    for (auto &&waypoint : waypoints) {
+      locations.emplace_back(map->ComputeTransform(waypoint).location);
+      next.clear();
+      WaypointGenerator::GetNext(*map, waypoint, 0.7, next);
+      if (!next.empty()) {
+        waypoint = next.front();
+      }
+    }
+  }
+
+  LaneOccupancyIndex index(map);
+  carla::StopWatch first;
+  index.Update(0u, ids, frames.front());
+  first.Stop();
+
+  carla::StopWatch updates;
+  for (auto frame = 1u; frame < number_of_frames; ++frame) {
+    index.Update(frame, ids, frames[frame]);
+  }
+  updates.Stop();
+
+  size_t found = 0u;
+  carla::StopWatch queries;
+  for (auto id : ids) {
+    found += index.GetLeader(id).has_value() ? 1u : 0u;
+    found += index.GetActorsInRadius(index.GetActor(id)->location, 30.0).size();
+  }
+  queries.Stop();
+  ASSERT_GT(found, 0u);
+
+  carla::logging::log(
+      "Benchmark:", number_of_actors, "actors on", map->GetData().GetRoadCount(), "roads:",
+      "first update =", first.GetElapsedTime<std::chrono::microseconds>(), "us,",
+      "incremental update =", updates.GetElapsedTime<std::chrono::microseconds>() / (number_of_frames - 1u), "us,",
+      "leader + radius query =", queries.GetElapsedTime<std::chrono::nanoseconds>() / number_of_actors, "ns");
+}
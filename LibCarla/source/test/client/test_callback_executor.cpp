@@ -0,0 +1,84 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/client/detail/CallbackExecutor.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using carla::client::detail::CallbackExecutor;
+
+template <typename F>
+static void wait_until(F &&predicate) {
+  for (auto i = 0u; (i < 1000u) && !predicate(); ++i) {
+    std::this_thread::sleep_for(1ms);
+  }
+}
+
+TEST(callback_executor, inline_execution) {
+  CallbackExecutor executor;
+  int value = 0;
+  auto result = executor.Wrap(std::function<void(int)>([&](int i) { value = i; }), false);
+  result.second(42);
+  ASSERT_EQ(value, 42);
+  auto metrics = executor.GetMetrics();
+  ASSERT_EQ(metrics.size(), 1u);
+  ASSERT_EQ(metrics[0u].id, result.first);
+  ASSERT_EQ(metrics[0u].call_count, 1u);
+}
+
+TEST(callback_executor, serial_order) {
+  constexpr size_t number_of_calls = 1000u;
+  CallbackExecutor executor;
+  executor.SetWorkerThreads(4u);
+
+  std::vector<size_t> received;
+  std::atomic_bool overlapped{false};
+  std::atomic_bool is_running{false};
+  auto callback = executor.Wrap(std::function<void(size_t)>([&](size_t i) {
+    if (is_running.exchange(true)) {
+      overlapped = true;
+    }
+    received.emplace_back(i);
+    is_running = false;
+  }), false).second;
+
+  for (auto i = 0u; i < number_of_calls; ++i) {
+    callback(i);
+  }
+  wait_until([&]() { return executor.GetMetrics()[0u].call_count == number_of_calls; });
+
+  ASSERT_FALSE(overlapped);
+  ASSERT_EQ(received.size(), number_of_calls);
+  for (auto i = 0u; i < number_of_calls; ++i) {
+    ASSERT_EQ(received[i], i);
+  }
+}
+
+TEST(callback_executor, coalesce) {
+  constexpr size_t number_of_calls = 100u;
+  CallbackExecutor executor;
+  executor.SetWorkerThreads(2u);
+
+  std::atomic_size_t last{0u};
+  auto callback = executor.Wrap(std::function<void(size_t)>([&](size_t i) {
+    std::this_thread::sleep_for(1ms);
+    last = i;
+  }), true).second;
+
+  for (auto i = 1u; i <= number_of_calls; ++i) {
+    callback(i);
+  }
+  wait_until([&]() { return last == number_of_calls; });
+
+  const auto metrics = executor.GetMetrics()[0u];
+  ASSERT_EQ(last, number_of_calls);
+  ASSERT_GT(metrics.dropped_count, 0u);
+  ASSERT_EQ(metrics.call_count + metrics.dropped_count, number_of_calls);
+}
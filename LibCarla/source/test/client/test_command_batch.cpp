@@ -0,0 +1,122 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/rpc/CommandBatch.h>
+
+#include <unordered_map>
+
+using namespace carla::rpc;
+
+/// Stand-in for the simulator, keeps the parent of each actor spawned.
+class FakeEpisode {
+public:
+
+  Response<ActorId> Spawn(const Command::SpawnActor &command) {
+    if (command.description.id == "invalid") {
+      return ResponseError("invalid blueprint");
+    }
+    if (command.parent.has_value() && (actors.find(*command.parent) == actors.end())) {
+      return ResponseError("parent actor not found");
+    }
+    const auto id = ++_last_id;
+    actors[id] = command.parent.get_value_or(0u);
+    return id;
+  }
+
+  Response<void> Apply(const Command &command) {
+    const auto *destroy = boost::get<Command::DestroyActor>(&command.command);
+    const auto *autopilot = boost::get<Command::SetAutopilot>(&command.command);
+    const auto id = destroy != nullptr ? destroy->actor : autopilot->actor;
+    if (actors.find(id) == actors.end()) {
+      return ResponseError("actor not found");
+    }
+    if (destroy != nullptr) {
+      actors.erase(id);
+    }
+    return Response<void>::Success();
+  }
+
+  std::vector<CommandResponse> Execute(const std::vector<Command> &commands) {
+    return ExecuteCommandBatch(
+        commands,
+        [this](const Command::SpawnActor &c) { return Spawn(c); },
+        [this](const Command &c) { return Apply(c); });
+  }
+
+  std::unordered_map<ActorId, ActorId> actors;
+
+private:
+
+  ActorId _last_id = 100u;
+};
+
+static Command::SpawnActor MakeSpawn(std::string id) {
+  ActorDescription description;
+  description.id = std::move(id);
+  return Command::SpawnActor{std::move(description), carla::geom::Transform{}};
+}
+
+TEST(command_batch, responses_in_order) {
+  FakeEpisode episode;
+  auto responses = episode.Execute({
+      MakeSpawn("vehicle"),
+      MakeSpawn("invalid"),
+      Command::SetAutopilot{101u, true},
+      Command::DestroyActor{42u}});
+  ASSERT_EQ(responses.size(), 4u);
+  ASSERT_FALSE(responses[0u].HasError());
+  ASSERT_EQ(responses[0u].Get(), 101u);
+  ASSERT_TRUE(responses[1u].HasError());
+  ASSERT_EQ(responses[1u].GetError().What(), "invalid blueprint");
+  ASSERT_FALSE(responses[2u].HasError());
+  ASSERT_EQ(responses[2u].Get(), 101u);
+  ASSERT_TRUE(responses[3u].HasError());
+  ASSERT_EQ(episode.actors.size(), 1u);
+}
+
+TEST(command_batch, dependent_commands) {
+  FakeEpisode episode;
+
+  // A vehicle with autopilot and a sensor attached to it, which in turn has
+  // a sensor attached.
+  auto sensor = MakeSpawn("sensor");
+  sensor.parent = FutureActor;
+  auto nested = MakeSpawn("sensor");
+  nested.parent = FutureActor;
+  sensor.do_after.emplace_back(nested);
+  auto vehicle = MakeSpawn("vehicle");
+  vehicle.do_after.emplace_back(Command::SetAutopilot{FutureActor, true});
+  vehicle.do_after.emplace_back(sensor);
+
+  auto responses = episode.Execute({vehicle, vehicle});
+  ASSERT_EQ(responses.size(), 8u);
+  for (auto &response : responses) {
+    ASSERT_FALSE(response.HasError()) << response.GetError().What();
+  }
+  ASSERT_EQ(responses[0u].Get(), 101u);
+  ASSERT_EQ(responses[1u].Get(), 101u);
+  ASSERT_EQ(responses[2u].Get(), 102u);
+  ASSERT_EQ(responses[3u].Get(), 103u);
+  ASSERT_EQ(responses[4u].Get(), 104u);
+  ASSERT_EQ(episode.actors[102u], 101u);
+  ASSERT_EQ(episode.actors[103u], 102u);
+  ASSERT_EQ(episode.actors[105u], 104u);
+  ASSERT_EQ(episode.actors[106u], 105u);
+
+  // The commands depending on an actor that failed to spawn are not
+  // executed.
+  auto invalid = MakeSpawn("invalid");
+  invalid.do_after = vehicle.do_after;
+  const auto number_of_actors = episode.actors.size();
+  responses = episode.Execute({invalid});
+  ASSERT_EQ(responses.size(), 4u);
+  for (auto &response : responses) {
+    ASSERT_TRUE(response.HasError());
+  }
+  ASSERT_EQ(episode.actors.size(), number_of_actors);
+}
@@ -0,0 +1,107 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/client/Future.h>
+
+#include <atomic>
+#include <stdexcept>
+
+using carla::client::Future;
+using carla::client::WhenAll;
+
+/// Counts how many times the value is computed, fails if @a value is
+/// negative.
+class CountingState : public carla::client::detail::CachedFutureState<int> {
+public:
+
+  CountingState(int value, std::atomic_size_t &count) : _value(value), _count(count) {}
+
+  bool WaitFor(carla::time_duration) override {
+    return true;
+  }
+
+private:
+
+  int Compute() override {
+    ++_count;
+    if (_value < 0) {
+      throw std::runtime_error("negative value");
+    }
+    return _value;
+  }
+
+  const int _value;
+
+  std::atomic_size_t &_count;
+};
+
+static Future<int> MakeFuture(int value, std::atomic_size_t &count) {
+  return Future<int>{std::make_shared<CountingState>(value, count)};
+}
+
+TEST(future, ready) {
+  auto future = Future<int>::MakeReady(42);
+  ASSERT_TRUE(future.IsValid());
+  ASSERT_TRUE(future.IsReady());
+  ASSERT_EQ(future.Get(), 42);
+  ASSERT_FALSE(Future<int>{}.IsValid());
+}
+
+TEST(future, computed_once) {
+  std::atomic_size_t count{0u};
+  auto future = MakeFuture(3, count);
+  auto copy = future;
+  ASSERT_EQ(future.Get(), 3);
+  ASSERT_EQ(copy.Get(), 3);
+  ASSERT_EQ(count, 1u);
+
+  auto failing = MakeFuture(-1, count);
+  ASSERT_THROW(failing.Get(), std::runtime_error);
+  ASSERT_THROW(failing.Get(), std::runtime_error);
+  ASSERT_EQ(count, 2u);
+}
+
+TEST(future, then) {
+  std::atomic_size_t count{0u};
+  auto future = MakeFuture(3, count);
+  auto twice = future.Then([](int value) { return 2 * value; });
+  auto text = twice.Then([](int value) { return std::to_string(value); });
+  ASSERT_TRUE(text.IsReady());
+  ASSERT_EQ(text.Get(), "6");
+  ASSERT_EQ(twice.Get(), 6);
+  ASSERT_EQ(count, 1u);
+
+  // Errors propagate through the continuations, which are not called.
+  bool called = false;
+  auto failing = MakeFuture(-1, count).Then([&](int value) {
+    called = true;
+    return value;
+  });
+  ASSERT_THROW(failing.Get(), std::runtime_error);
+  ASSERT_FALSE(called);
+}
+
+TEST(future, when_all) {
+  std::atomic_size_t count{0u};
+  std::vector<Future<int>> futures;
+  for (auto i = 0; i < 10; ++i) {
+    futures.emplace_back(MakeFuture(i, count));
+  }
+  auto values = WhenAll(futures);
+  ASSERT_EQ(values.size(), 10u);
+  for (auto i = 0; i < 10; ++i) {
+    ASSERT_EQ(values[i], i);
+  }
+
+  // Every future completes even if one of them fails.
+  count = 0u;
+  futures[3u] = MakeFuture(-1, count);
+  futures[7u] = MakeFuture(7, count);
+  ASSERT_THROW(WhenAll(futures), std::runtime_error);
+  ASSERT_EQ(count, 2u);
+}
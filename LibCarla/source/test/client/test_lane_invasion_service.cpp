@@ -0,0 +1,83 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+#include "LaneInvasionUtil.h"
+
+#include <carla/client/Map.h>
+#include <carla/client/detail/LaneInvasionService.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+using carla::client::Timestamp;
+using carla::client::detail::LaneInvasionService;
+using carla::geom::Transform;
+using carla::road::element::LaneMarking;
+
+TEST(lane_invasion_service, events) {
+  auto map = util::lane_invasion::make_street();
+  LaneInvasionService service(map);
+
+  // Vehicle 1 changes from lane -1 to lane -2, vehicle 2 keeps its lane,
+  // vehicle 3 changes lane but is unsubscribed and vehicle 4 is gone.
+  std::vector<LaneMarking> crossed_lanes;
+  size_t events = 0u;
+  service.Subscribe(1u, util::lane_invasion::vehicle_box, [&](const Timestamp &, const Transform &, std::vector<LaneMarking> lanes) {
+    crossed_lanes.insert(crossed_lanes.end(), lanes.begin(), lanes.end());
+    ++events;
+  });
+  auto fail = [](const Timestamp &, const Transform &, std::vector<LaneMarking>) {
+    FAIL() << "unexpected lane invasion";
+  };
+  service.Subscribe(2u, util::lane_invasion::vehicle_box, fail);
+  service.Unsubscribe(service.Subscribe(3u, util::lane_invasion::vehicle_box, fail));
+  service.Subscribe(4u, util::lane_invasion::vehicle_box, fail);
+
+  std::unordered_map<carla::ActorId, Transform> transforms;
+  for (auto frame = 0u; frame <= 20u; ++frame) {
+    const auto lateral = static_cast<float>(frame) / 20.0f;
+    transforms[1u] = util::lane_invasion::get_transform(*map, 100.0 + frame, lateral);
+    transforms[2u] = util::lane_invasion::get_transform(*map, 300.0 + frame, 0.0f);
+    transforms[3u] = util::lane_invasion::get_transform(*map, 500.0 + frame, lateral);
+    service.Tick(Timestamp(frame, 0.05 * frame, 0.05, 0.0), [&](carla::ActorId id) -> const Transform * {
+      auto it = transforms.find(id);
+      return it != transforms.end() ? &it->second : nullptr;
+    });
+  }
+  // The four corners cross the broken line between both lanes.
+  ASSERT_EQ(crossed_lanes, std::vector<LaneMarking>(4u, LaneMarking::Broken));
+  ASSERT_GE(events, 1u);
+  ASSERT_LE(events, 4u);
+}
+
+TEST(lane_invasion_service, unsubscribe_during_tick) {
+  auto map = util::lane_invasion::make_street();
+  const auto frames = util::lane_invasion::make_weaving_vehicles(*map, 1u, 100u);
+  LaneInvasionService service(map);
+
+  // Two vehicles on top of each other, they cross lanes in the same ticks. The first callback called
+  // unsubscribes the other one, which was already computed in that tick.
+  size_t events[2u] = {0u, 0u};
+  size_t ids[2u];
+  for (auto i = 0u; i < 2u; ++i) {
+    ids[i] = service.Subscribe(static_cast<carla::ActorId>(i), util::lane_invasion::vehicle_box, [&, i](
+        const Timestamp &,
+        const Transform &,
+        std::vector<LaneMarking>) {
+      ++events[i];
+      service.Unsubscribe(ids[1u - i]);
+    });
+  }
+  for (auto frame = 0u; frame < frames.size(); ++frame) {
+    service.Tick(Timestamp(frame, 0.05 * frame, 0.05, 0.0), [&](carla::ActorId) {
+      return &frames[frame].front();
+    });
+  }
+  ASSERT_GT(events[0u] + events[1u], 1u);
+  ASSERT_EQ(std::min(events[0u], events[1u]), 0u);
+}
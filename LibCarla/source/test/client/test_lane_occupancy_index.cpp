@@ -0,0 +1,288 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+#include "test/OpenDriveGenerator.h"
+
+#include <carla/client/LaneOccupancyIndex.h>
+#include <carla/geom/Math.h>
+#include <carla/road/Map.h>
+#include <carla/road/WaypointGenerator.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+using carla::ActorId;
+using carla::client::LaneOccupancyIndex;
+using carla::client::LaneOccupant;
+using carla::geom::Location;
+using carla::geom::Math;
+using carla::road::WaypointGenerator;
+using carla::road::element::WaypointHandle;
+
+static carla::SharedPtr<carla::road::Map> MakeHighway(size_t number_of_roads) {
+  util::opendrive::highway_options options;
+  options.number_of_roads = number_of_roads;
+  options.lanes_per_direction = 3;
+  return util::opendrive::load_map(util::opendrive::make_highway(options));
+}
+
+/// Distinct waypoints at random on the driving lanes of @a map, at least one
+/// meter away from the ends of their road.
+static std::vector<WaypointHandle> MakeRandomWaypoints(
+    const carla::road::Map &map,
+    size_t count,
+    uint64_t seed) {
+  auto waypoints = WaypointGenerator::GenerateAllArrays(map, 1.0);
+  std::mt19937_64 rng(seed);
+  std::uniform_int_distribution<size_t> index(0u, waypoints.size() - 1u);
+  std::vector<WaypointHandle> result;
+  std::unordered_set<size_t> taken;
+  while (result.size() < count) {
+    const auto i = index(rng);
+    const auto handle = waypoints.GetHandle(i);
+    const auto length = map.GetData().GetRoad(handle.road_id)->GetLength();
+    if ((handle.s > 1.0) && (handle.s < length - 1.0) && taken.insert(i).second) {
+      result.emplace_back(handle);
+    }
+  }
+  return result;
+}
+
+struct Actors {
+  std::vector<ActorId> ids;
+  std::vector<WaypointHandle> waypoints;
+  std::vector<Location> locations;
+};
+
+static Actors MakeActors(const carla::road::Map &map, const std::vector<WaypointHandle> &waypoints) {
+  Actors result;
+  for (auto i = 0u; i < waypoints.size(); ++i) {
+    // Not consecutive ids, in no particular order.
+    result.ids.emplace_back(static_cast<ActorId>(7u * (waypoints.size() - i)));
+    result.waypoints.emplace_back(waypoints[i]);
+    result.locations.emplace_back(map.ComputeTransform(waypoints[i]).location);
+  }
+  return result;
+}
+
+/// Position along the highway, in its direction of travel, of a waypoint on a
+/// lane of the highway.
+static double GetPositionOnHighway(const carla::road::Map &map, const WaypointHandle &waypoint) {
+  double offset = 0.0;
+  for (auto id = 0u; id < waypoint.road_id; ++id) {
+    offset += map.GetData().GetRoad(id)->GetLength();
+  }
+  const auto position = offset + waypoint.s;
+  return waypoint.lane_id < 0 ? position : -position;
+}
+
+static void CheckSameOccupants(const std::vector<LaneOccupant> &lhs, const std::vector<size_t> &rhs, const Actors &actors) {
+  ASSERT_EQ(lhs.size(), rhs.size());
+  for (auto i = 0u; i < lhs.size(); ++i) {
+    ASSERT_EQ(lhs[i].id, actors.ids[rhs[i]]);
+  }
+}
+
+TEST(lane_occupancy_index, queries) {
+  constexpr double max_distance = 300.0;
+  auto map = MakeHighway(20u);
+  const auto actors = MakeActors(*map, MakeRandomWaypoints(*map, 300u, 3u));
+  LaneOccupancyIndex index(map, 15.0);
+  index.Update(42u, actors.ids, actors.locations);
+  ASSERT_EQ(index.GetFrameCount(), 42u);
+  ASSERT_EQ(index.size(), actors.ids.size());
+  ASSERT_FALSE(index.GetActor(1u).has_value());
+  ASSERT_FALSE(index.GetLeader(1u).has_value());
+
+  // The queries are checked against a brute force search over the lanes the
+  // index found, which must be the ones the map finds for each location.
+  const auto number_of_actors = actors.ids.size();
+  std::vector<WaypointHandle> waypoints;
+  for (auto i = 0u; i < number_of_actors; ++i) {
+    const auto actor = index.GetActor(actors.ids[i]);
+    ASSERT_TRUE(actor.has_value());
+    ASSERT_EQ(actor->id, actors.ids[i]);
+    const auto expected = map->GetClosestWaypointOnRoad(actors.locations[i]).GetHandle();
+    ASSERT_EQ(actor->waypoint.road_id, expected.road_id);
+    ASSERT_EQ(actor->waypoint.lane_id, expected.lane_id);
+    ASSERT_NEAR(actor->waypoint.s, expected.s, 1e-6);
+    waypoints.emplace_back(actor->waypoint);
+  }
+
+  for (auto i = 0u; i < number_of_actors; ++i) {
+    const auto &waypoint = waypoints[i];
+
+    // Actors in the same lane, 30 meters around.
+    std::vector<size_t> expected;
+    for (auto j = 0u; j < number_of_actors; ++j) {
+      const auto &other = waypoints[j];
+      if ((other.road_id == waypoint.road_id) &&
+          (other.lane_id == waypoint.lane_id) &&
+          (std::abs(other.s - waypoint.s) <= 30.0)) {
+        expected.emplace_back(j);
+      }
+    }
+    std::sort(expected.begin(), expected.end(), [&](size_t lhs, size_t rhs) {
+      return waypoints[lhs].s < waypoints[rhs].s;
+    });
+    CheckSameOccupants(
+        index.GetActorsInLane(waypoint.road_id, waypoint.lane_id, waypoint.s - 30.0, waypoint.s + 30.0),
+        expected,
+        actors);
+
+    // Actors within 25 meters.
+    expected.clear();
+    for (auto j = 0u; j < number_of_actors; ++j) {
+      if (Math::Distance2D(actors.locations[i], actors.locations[j]) <= 25.0) {
+        expected.emplace_back(j);
+      }
+    }
+    std::sort(expected.begin(), expected.end(), [&](size_t lhs, size_t rhs) {
+      return Math::DistanceSquared2D(actors.locations[i], actors.locations[lhs]) <
+             Math::DistanceSquared2D(actors.locations[i], actors.locations[rhs]);
+    });
+    CheckSameOccupants(index.GetActorsInRadius(actors.locations[i], 25.0), expected, actors);
+
+    // Leader and follower, the lanes of the highway are chained.
+    const auto position = GetPositionOnHighway(*map, waypoint);
+    boost::optional<size_t> leader, follower;
+    for (auto j = 0u; j < number_of_actors; ++j) {
+      const auto &other = waypoints[j];
+      if ((j == i) || (other.lane_id != waypoint.lane_id)) {
+        continue;
+      }
+      const auto other_position = GetPositionOnHighway(*map, other);
+      const auto distance = std::abs(other_position - position);
+      if (distance > max_distance) {
+        continue;
+      }
+      if ((other_position > position) &&
+          (!leader.has_value() || (other_position < GetPositionOnHighway(*map, waypoints[*leader])))) {
+        leader = j;
+      }
+      if ((other_position < position) &&
+          (!follower.has_value() || (other_position > GetPositionOnHighway(*map, waypoints[*follower])))) {
+        follower = j;
+      }
+    }
+    auto check_neighbor = [&](const auto &result, const boost::optional<size_t> &expected_index) {
+      ASSERT_EQ(result.has_value(), expected_index.has_value());
+      if (result.has_value()) {
+        ASSERT_EQ(result->occupant.id, actors.ids[*expected_index]);
+        const auto expected_distance = std::abs(
+            GetPositionOnHighway(*map, waypoints[*expected_index]) - position);
+        ASSERT_NEAR(result->distance, expected_distance, 1e-6);
+      }
+    };
+    check_neighbor(index.GetLeader(actors.ids[i], max_distance), leader);
+    check_neighbor(index.GetFollower(actors.ids[i], max_distance), follower);
+  }
+}
+
+TEST(lane_occupancy_index, incremental_update) {
+  auto map = MakeHighway(10u);
+  auto actors = MakeActors(*map, MakeRandomWaypoints(*map, 100u, 4u));
+  const auto length_of_highway = GetPositionOnHighway(*map, {9u, -1, map->GetData().GetRoad(9u)->GetLength()});
+  LaneOccupancyIndex index(map);
+  std::vector<WaypointHandle> next;
+  for (auto frame = 0u; frame < 60u; ++frame) {
+    index.Update(frame, actors.ids, actors.locations);
+    LaneOccupancyIndex from_scratch(map);
+    from_scratch.Update(frame, actors.ids, actors.locations);
+    for (auto i = 0u; i < actors.ids.size(); ++i) {
+      const auto tracked = index.GetActor(actors.ids[i]);
+      const auto expected = from_scratch.GetActor(actors.ids[i]);
+      ASSERT_TRUE(tracked.has_value());
+      ASSERT_TRUE(expected.has_value());
+      ASSERT_EQ(tracked->waypoint.lane_id, expected->waypoint.lane_id);
+      const auto length = map->GetData().GetRoad(expected->waypoint.road_id)->GetLength();
+      if ((expected->waypoint.s > 1.0) && (expected->waypoint.s < length - 1.0)) {
+        ASSERT_EQ(tracked->waypoint.road_id, expected->waypoint.road_id);
+        ASSERT_NEAR(tracked->waypoint.s, expected->waypoint.s, 1e-6);
+      }
+    }
+    // Move every other actor two meters, the rest stay still; actors at the
+    // end of the highway stop there.
+    for (auto i = 0u; i < actors.ids.size(); i += 2u) {
+      const auto position = GetPositionOnHighway(*map, actors.waypoints[i]);
+      if (((position > 0.0) && (position + 2.5 > length_of_highway)) ||
+          ((position < 0.0) && (position + 2.5 > 0.0))) {
+        continue;
+      }
+      next.clear();
+      WaypointGenerator::GetNext(*map, actors.waypoints[i], 2.0, next);
+      if (!next.empty()) {
+        actors.waypoints[i] = next.front();
+        actors.locations[i] = map->ComputeTransform(next.front()).location;
+      }
+    }
+  }
+}
+
+TEST(lane_occupancy_index, actors_added_and_removed) {
+  auto map = MakeHighway(4u);
+  auto all = MakeActors(*map, MakeRandomWaypoints(*map, 60u, 6u));
+  LaneOccupancyIndex index(map);
+  std::vector<WaypointHandle> next;
+  for (auto frame = 0u; frame < 12u; ++frame) {
+    // A different third of the actors is missing every frame.
+    Actors actors;
+    for (auto i = 0u; i < all.ids.size(); ++i) {
+      if ((i + frame) % 3u != 0u) {
+        actors.ids.emplace_back(all.ids[i]);
+        actors.waypoints.emplace_back(all.waypoints[i]);
+        actors.locations.emplace_back(all.locations[i]);
+      }
+    }
+    index.Update(frame, actors.ids, actors.locations);
+    LaneOccupancyIndex from_scratch(map);
+    from_scratch.Update(frame, actors.ids, actors.locations);
+    ASSERT_EQ(index.size(), actors.ids.size());
+    for (auto i = 0u; i < all.ids.size(); ++i) {
+      ASSERT_EQ(index.GetActor(all.ids[i]).has_value(), (i + frame) % 3u != 0u);
+    }
+    for (auto i = 0u; i < actors.ids.size(); ++i) {
+      const auto occupant = index.GetActor(actors.ids[i]);
+      ASSERT_TRUE(occupant.has_value());
+      const auto lane = index.GetActorsInLane(
+          occupant->waypoint.road_id,
+          occupant->waypoint.lane_id,
+          -1.0,
+          std::numeric_limits<double>::max());
+      ASSERT_TRUE(std::is_sorted(lane.begin(), lane.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.waypoint.s < rhs.waypoint.s;
+      }));
+      ASSERT_TRUE(std::any_of(lane.begin(), lane.end(), [&](const auto &item) {
+        return item.id == actors.ids[i];
+      }));
+      auto get_ids = [](const std::vector<LaneOccupant> &occupants) {
+        std::vector<ActorId> result;
+        for (auto &&item : occupants) {
+          result.emplace_back(item.id);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+      };
+      ASSERT_EQ(
+          get_ids(index.GetActorsInRadius(actors.locations[i], 50.0)),
+          get_ids(from_scratch.GetActorsInRadius(actors.locations[i], 50.0)));
+    }
+    // Every actor moves forward a meter, less than the size of a cell.
+    for (auto i = 0u; i < all.ids.size(); ++i) {
+      next.clear();
+      WaypointGenerator::GetNext(*map, all.waypoints[i], 1.0, next);
+      if (!next.empty()) {
+        all.waypoints[i] = next.front();
+        all.locations[i] = map->ComputeTransform(next.front()).location;
+      }
+    }
+  }
+}
+
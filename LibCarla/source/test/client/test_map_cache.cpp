@@ -0,0 +1,177 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+#include "OpenDriveGenerator.h"
+#include "TemporaryDirectory.h"
+
+#include <carla/client/detail/MapCache.h>
+#include <carla/opendrive/OpenDrive.h>
+#include <carla/road/CompiledMap.h>
+#include <carla/road/Map.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using carla::client::detail::MapCache;
+using carla::road::CompiledMap;
+
+static std::string MakeCity(size_t rows) {
+  util::opendrive::grid_city_options options;
+  options.rows = rows;
+  options.columns = 2u;
+  options.lanes_per_direction = 1;
+  return util::opendrive::make_grid_city(options);
+}
+
+static bool FileExists(const std::string &path) {
+  return std::ifstream(path).good();
+}
+
+static void WriteFile(const std::string &path, const std::vector<unsigned char> &data) {
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+
+class map_cache : public ::testing::Test {
+protected:
+
+  void SetUp() override {
+    ::unsetenv("CARLA_MAP_CACHE_DIR");
+    MapCache::Clear();
+  }
+
+  void TearDown() override {
+    MapCache::Clear();
+  }
+};
+
+TEST_F(map_cache, key) {
+  const auto xodr = MakeCity(2u);
+  ASSERT_EQ(MapCache::MakeKey(xodr), MapCache::MakeKey(std::string(xodr)));
+  // Same size, one byte different.
+  auto other = xodr;
+  other[other.size() / 2u] ^= 0x01;
+  const auto key = MapCache::MakeKey(xodr);
+  const auto other_key = MapCache::MakeKey(other);
+  ASSERT_EQ(key.size, other_key.size);
+  ASSERT_NE(key.digest, other_key.digest);
+  ASSERT_NE(key, MapCache::MakeKey(xodr + " "));
+}
+
+TEST_F(map_cache, hit) {
+  const auto xodr = MakeCity(2u);
+  const auto map = MapCache::GetOrBuild(xodr);
+  ASSERT_NE(map, nullptr);
+  ASSERT_EQ(MapCache::GetOrBuild(xodr), map);
+  ASSERT_EQ(MapCache::size(), 1u);
+}
+
+TEST_F(map_cache, miss) {
+  const auto map = MapCache::GetOrBuild(MakeCity(2u));
+  const auto other = MapCache::GetOrBuild(MakeCity(3u));
+  ASSERT_NE(map, nullptr);
+  ASSERT_NE(other, nullptr);
+  ASSERT_NE(map, other);
+  ASSERT_LT(map->GetData().GetRoadCount(), other->GetData().GetRoadCount());
+  ASSERT_EQ(MapCache::size(), 2u);
+}
+
+TEST_F(map_cache, eviction) {
+  const auto xodr = MakeCity(2u);
+  auto map = MapCache::GetOrBuild(xodr);
+  const auto road_count = map->GetData().GetRoadCount();
+  ASSERT_EQ(MapCache::size(), 1u);
+  // The cache does not keep the map alive, the entry is removed on the next
+  // lookup.
+  map.reset();
+  ASSERT_EQ(MapCache::size(), 1u);
+  const auto other = MapCache::GetOrBuild(MakeCity(3u));
+  ASSERT_EQ(MapCache::size(), 1u);
+  // Built again when requested after being evicted.
+  map = MapCache::GetOrBuild(xodr);
+  ASSERT_NE(map, nullptr);
+  ASSERT_EQ(map->GetData().GetRoadCount(), road_count);
+  ASSERT_EQ(MapCache::size(), 2u);
+}
+
+TEST_F(map_cache, concurrent_requests) {
+  const auto xodr = MakeCity(3u);
+  const auto other_xodr = MakeCity(2u);
+  constexpr size_t number_of_threads = 8u;
+  std::vector<carla::SharedPtr<const carla::road::Map>> maps(number_of_threads);
+  std::vector<std::thread> threads;
+  for (auto i = 0u; i < number_of_threads; ++i) {
+    threads.emplace_back([&, i]() {
+      maps[i] = MapCache::GetOrBuild(i % 2u == 0u ? xodr : other_xodr);
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (auto i = 0u; i < number_of_threads; ++i) {
+    ASSERT_NE(maps[i], nullptr);
+    ASSERT_EQ(maps[i], maps[i % 2u]);
+  }
+  ASSERT_NE(maps[0u], maps[1u]);
+  ASSERT_EQ(MapCache::size(), 2u);
+}
+
+TEST_F(map_cache, compiled_map_files) {
+  util::filesystem::temporary_directory directory;
+  ::setenv("CARLA_MAP_CACHE_DIR", directory.path().c_str(), 1);
+  const auto xodr = MakeCity(2u);
+  const auto key = MapCache::MakeKey(xodr);
+  const auto path = MapCache::GetCompiledMapPath(key);
+  ASSERT_EQ(path.find(directory.path()), 0u);
+
+  // Built from the OpenDRIVE and stored.
+  ASSERT_FALSE(FileExists(path));
+  const auto map = MapCache::GetOrBuild(xodr);
+  ASSERT_NE(map, nullptr);
+  ASSERT_TRUE(FileExists(path));
+  std::string error;
+  const auto stored = carla::opendrive::OpenDrive::LoadCompiledFile(path, &error, &key);
+  ASSERT_NE(stored, nullptr) << error;
+  ASSERT_EQ(stored->GetData().GetRoadCount(), map->GetData().GetRoadCount());
+
+  // Loaded from the file if its header matches: store another map as if it
+  // were compiled from this OpenDRIVE.
+  const auto other_xodr = MakeCity(3u);
+  const auto other = carla::opendrive::OpenDrive::Load(
+      other_xodr,
+      XmlInputType::CONTENT);
+  ASSERT_NE(other, nullptr);
+  WriteFile(path, CompiledMap::Write(*other, key));
+  MapCache::Clear();
+  auto loaded = MapCache::GetOrBuild(xodr);
+  ASSERT_NE(loaded, nullptr);
+  ASSERT_EQ(loaded->GetData().GetRoadCount(), other->GetData().GetRoadCount());
+  loaded.reset();
+
+  // A file compiled from another OpenDRIVE is rejected and replaced.
+  WriteFile(path, CompiledMap::Write(*other, MapCache::MakeKey(other_xodr)));
+  MapCache::Clear();
+  loaded = MapCache::GetOrBuild(xodr);
+  ASSERT_NE(loaded, nullptr);
+  ASSERT_EQ(loaded->GetData().GetRoadCount(), map->GetData().GetRoadCount());
+  ASSERT_NE(carla::opendrive::OpenDrive::LoadCompiledFile(path, &error, &key), nullptr) << error;
+  loaded.reset();
+
+  // So is a corrupted file.
+  auto blob = CompiledMap::Write(*map, key);
+  blob.resize(blob.size() / 2u);
+  WriteFile(path, blob);
+  MapCache::Clear();
+  loaded = MapCache::GetOrBuild(xodr);
+  ASSERT_NE(loaded, nullptr);
+  ASSERT_EQ(loaded->GetData().GetRoadCount(), map->GetData().GetRoadCount());
+  ASSERT_NE(carla::opendrive::OpenDrive::LoadCompiledFile(path, &error, &key), nullptr) << error;
+
+  ::unsetenv("CARLA_MAP_CACHE_DIR");
+}
@@ -8,8 +8,11 @@
 
 #include <carla/MsgPackAdaptors.h>
 #include <carla/ThreadGroup.h>
+#include <carla/client/Future.h>
+#include <carla/client/detail/RpcFutureState.h>
 #include <carla/rpc/Actor.h>
 #include <carla/rpc/Client.h>
+#include <carla/rpc/CommandBatch.h>
 #include <carla/rpc/Response.h>
 #include <carla/rpc/Server.h>
 
@@ -61,3 +64,112 @@ TEST(rpc, server_bind_sync_run_on_game_thread) {
   std::cout << "game thread: run " << i << " slices.\n";
   ASSERT_TRUE(done);
 }
+
+TEST(rpc, apply_batch_sync_stand_in) {
+  const auto port = (TESTING_PORT != 0u ? TESTING_PORT : 2017u);
+
+  Server server(port);
+
+  // Stand-in of the simulator, spawns actors with consecutive ids and fails
+  // any other command on an actor it did not spawn.
+  ActorId last_id = 0u;
+  server.BindSync("apply_batch_sync", [&](const std::vector<Command> &commands, bool) {
+    return Response<std::vector<CommandResponse>>(ExecuteCommandBatch(
+        commands,
+        [&](const Command::SpawnActor &c) -> Response<ActorId> {
+          if (c.parent.has_value() && (*c.parent > last_id)) {
+            return ResponseError("parent actor not found");
+          }
+          return ++last_id;
+        },
+        [&](const Command &c) -> Response<void> {
+          const auto *autopilot = boost::get<Command::SetAutopilot>(&c.command);
+          if ((autopilot == nullptr) || (autopilot->actor > last_id)) {
+            return ResponseError("actor not found");
+          }
+          return Response<void>::Success();
+        }));
+  });
+
+  server.AsyncRun(1u);
+
+  std::atomic_bool done{false};
+
+  carla::ThreadGroup threads;
+  threads.CreateThread([&]() {
+    Command::SpawnActor sensor{ActorDescription{}, carla::geom::Transform{}, FutureActor};
+    Command::SpawnActor vehicle{ActorDescription{}, carla::geom::Transform{}};
+    vehicle.do_after.emplace_back(Command::SetAutopilot{FutureActor, true});
+    vehicle.do_after.emplace_back(sensor);
+    std::vector<Command> commands{vehicle, Command::SetAutopilot{42u, true}};
+
+    Client client("localhost", port);
+    auto result = client.call("apply_batch_sync", commands, false)
+        .as<Response<std::vector<CommandResponse>>>();
+    EXPECT_FALSE(result.HasError());
+    auto &responses = result.Get();
+    EXPECT_EQ(responses.size(), 4u);
+    EXPECT_EQ(responses[0u].Get(), 1u);
+    EXPECT_EQ(responses[1u].Get(), 1u);
+    EXPECT_EQ(responses[2u].Get(), 2u);
+    EXPECT_TRUE(responses[3u].HasError());
+    done = true;
+  });
+
+  for (auto i = 0u; i < 1'000'000u; ++i) {
+    server.SyncRunFor(2ms);
+    if (done) {
+      break;
+    }
+  }
+  ASSERT_TRUE(done);
+}
+
+TEST(rpc, async_call_error_response) {
+  using carla::client::Future;
+  using carla::client::detail::RpcFutureState;
+
+  const auto port = (TESTING_PORT != 0u ? TESTING_PORT : 2017u);
+
+  Server server(port);
+
+  server.BindSync("succeed", []() -> Response<int> { return 42; });
+  server.BindSync("fail", []() -> Response<int> { return ResponseError("something failed"); });
+
+  server.AsyncRun(1u);
+
+  std::atomic_bool done{false};
+
+  carla::ThreadGroup threads;
+  threads.CreateThread([&]() {
+    Client client("localhost", port);
+    const auto timeout = carla::time_duration::seconds(10u);
+    Future<int> succeeded{std::make_shared<RpcFutureState<int>>(
+        client.async_call("succeed"),
+        "localhost",
+        timeout)};
+    Future<int> failed{std::make_shared<RpcFutureState<int>>(
+        client.async_call("fail"),
+        "localhost",
+        timeout)};
+    EXPECT_EQ(succeeded.Get(), 42);
+    // The error is kept, every call to Get throws it.
+    for (auto i = 0u; i < 2u; ++i) {
+      try {
+        failed.Get();
+        ADD_FAILURE() << "expected an exception";
+      } catch (const std::runtime_error &e) {
+        EXPECT_EQ(std::string(e.what()), "something failed");
+      }
+    }
+    done = true;
+  });
+
+  for (auto i = 0u; i < 1'000'000u; ++i) {
+    server.SyncRunFor(2ms);
+    if (done) {
+      break;
+    }
+  }
+  ASSERT_TRUE(done);
+}
@@ -0,0 +1,216 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/ThreadGroup.h>
+#include <carla/client/detail/StepPipeline.h>
+#include <carla/sensor/SensorData.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using carla::client::Timestamp;
+using carla::client::detail::StepPipeline;
+
+class FrameData : public carla::sensor::SensorData {
+public:
+
+  explicit FrameData(size_t frame) : SensorData(frame, 0.0, carla::rpc::Transform{}) {}
+};
+
+static Timestamp MakeTimestamp(size_t frame) {
+  return Timestamp{frame, 0.0, 0.0, 0.0};
+}
+
+static carla::SharedPtr<carla::sensor::SensorData> MakeData(size_t frame) {
+  return carla::MakeShared<FrameData>(frame);
+}
+
+TEST(step_pipeline, match_by_frame) {
+  StepPipeline pipeline{10u, {1u, 2u}, carla::time_duration::seconds(10u)};
+  const auto timeout = carla::time_duration::milliseconds(10u);
+
+  // Data of frames before the first one is ignored.
+  pipeline.OnTick(MakeTimestamp(9u));
+  pipeline.OnSensorData(1u, MakeData(9u));
+  pipeline.OnSensorData(2u, MakeData(9u));
+  ASSERT_FALSE(pipeline.WaitForFrame(timeout).has_value());
+
+  // Sensor data may arrive before the tick, and in any order.
+  pipeline.OnSensorData(2u, MakeData(10u));
+  pipeline.OnSensorData(2u, MakeData(11u));
+  pipeline.OnTick(MakeTimestamp(10u));
+  ASSERT_FALSE(pipeline.WaitForFrame(timeout).has_value());
+  pipeline.OnSensorData(3u, MakeData(10u)); // not stepped.
+  ASSERT_FALSE(pipeline.WaitForFrame(timeout).has_value());
+  pipeline.OnSensorData(1u, MakeData(10u));
+
+  auto frame = pipeline.WaitForFrame(timeout);
+  ASSERT_TRUE(frame.has_value());
+  ASSERT_EQ(frame->timestamp.frame_count, 10u);
+  ASSERT_EQ(frame->sensor_data.size(), 2u);
+  ASSERT_EQ(frame->sensor_data[0u]->GetFrameNumber(), 10u);
+  ASSERT_EQ(frame->sensor_data[1u]->GetFrameNumber(), 10u);
+  ASSERT_FALSE(pipeline.WaitForFrame(timeout).has_value());
+}
+
+TEST(step_pipeline, missed_sensor_frame) {
+  StepPipeline pipeline{1u, {7u}, carla::time_duration::seconds(10u)};
+  const auto timeout = carla::time_duration::milliseconds(10u);
+
+  // The sensor misses frame 1, the frame is returned without its data once
+  // frame 2 is complete.
+  pipeline.OnTick(MakeTimestamp(1u));
+  pipeline.OnTick(MakeTimestamp(2u));
+  ASSERT_FALSE(pipeline.WaitForFrame(timeout).has_value());
+  pipeline.OnSensorData(7u, MakeData(2u));
+
+  auto first = pipeline.WaitForFrame(timeout);
+  ASSERT_TRUE(first.has_value());
+  ASSERT_EQ(first->timestamp.frame_count, 1u);
+  ASSERT_EQ(first->sensor_data[0u], nullptr);
+  auto second = pipeline.WaitForFrame(timeout);
+  ASSERT_TRUE(second.has_value());
+  ASSERT_EQ(second->timestamp.frame_count, 2u);
+  ASSERT_NE(second->sensor_data[0u], nullptr);
+
+  // Late data of an already returned frame is discarded.
+  pipeline.OnSensorData(7u, MakeData(1u));
+  ASSERT_FALSE(pipeline.WaitForFrame(timeout).has_value());
+}
+
+TEST(step_pipeline, grace_period) {
+  StepPipeline pipeline{1u, {7u}, carla::time_duration::milliseconds(20u)};
+
+  // The sensor misses the last frame, returned without its data once the
+  // grace period has passed.
+  pipeline.OnTick(MakeTimestamp(1u));
+  ASSERT_FALSE(pipeline.WaitForFrame(carla::time_duration::milliseconds(0u)).has_value());
+  auto frame = pipeline.WaitForFrame(carla::time_duration::seconds(10u));
+  ASSERT_TRUE(frame.has_value());
+  ASSERT_EQ(frame->timestamp.frame_count, 1u);
+  ASSERT_EQ(frame->sensor_data[0u], nullptr);
+}
+
+/// Stand-in for the simulator in synchronous mode, ticks a frame for each cue
+/// in another thread. The sensor delivers data every other frame.
+class FakeSimulator {
+public:
+
+  explicit FakeSimulator(StepPipeline &pipeline)
+    : _pipeline(pipeline),
+      _thread([this]() { Run(); }) {}
+
+  ~FakeSimulator() {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _done = true;
+    }
+    _condition.notify_one();
+    _thread.join();
+  }
+
+  void SendTickCue() {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      ++_cues;
+      max_in_flight = std::max(max_in_flight, _cues - _frame);
+    }
+    _condition.notify_one();
+  }
+
+  size_t max_in_flight = 0u;
+
+private:
+
+  void Run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;) {
+      _condition.wait(lock, [this]() { return _done || (_frame < _cues); });
+      if (_done) {
+        return;
+      }
+      const auto frame = ++_frame;
+      lock.unlock();
+      _pipeline.OnTick(MakeTimestamp(frame));
+      if (frame % 2u == 0u) {
+        _pipeline.OnSensorData(7u, MakeData(frame));
+      }
+      lock.lock();
+    }
+  }
+
+  StepPipeline &_pipeline;
+
+  std::mutex _mutex;
+
+  std::condition_variable _condition;
+
+  size_t _cues = 0u;
+
+  size_t _frame = 0u;
+
+  bool _done = false;
+
+  std::thread _thread;
+};
+
+TEST(step_pipeline, sensor_every_other_frame) {
+  constexpr size_t number_of_frames = 9u;
+  StepPipeline pipeline{1u, {7u}, carla::time_duration::milliseconds(50u)};
+  FakeSimulator simulator{pipeline};
+  std::vector<carla::client::StepFrame> frames;
+  const auto received = pipeline.Run(
+      number_of_frames,
+      1u,
+      carla::time_duration::seconds(10u),
+      [&]() { simulator.SendTickCue(); },
+      [&](carla::client::StepFrame frame) { frames.emplace_back(std::move(frame)); });
+  ASSERT_EQ(received, number_of_frames);
+  ASSERT_EQ(frames.size(), number_of_frames);
+  ASSERT_EQ(simulator.max_in_flight, 1u);
+  for (auto i = 0u; i < number_of_frames; ++i) {
+    ASSERT_EQ(frames[i].timestamp.frame_count, i + 1u);
+    if ((i + 1u) % 2u == 0u) {
+      ASSERT_NE(frames[i].sensor_data[0u], nullptr);
+      ASSERT_EQ(frames[i].sensor_data[0u]->GetFrameNumber(), i + 1u);
+    } else {
+      ASSERT_EQ(frames[i].sensor_data[0u], nullptr);
+    }
+  }
+}
+
+TEST(step_pipeline, concurrent_producers) {
+  constexpr size_t number_of_frames = 500u;
+  StepPipeline pipeline{1u, {1u, 2u}, carla::time_duration::seconds(10u)};
+
+  carla::ThreadGroup threads;
+  threads.CreateThread([&]() {
+    for (auto i = 1u; i <= number_of_frames; ++i) {
+      pipeline.OnTick(MakeTimestamp(i));
+    }
+  });
+  for (auto sensor = 1u; sensor <= 2u; ++sensor) {
+    threads.CreateThread([&, sensor]() {
+      for (auto i = 1u; i <= number_of_frames; ++i) {
+        pipeline.OnSensorData(sensor, MakeData(i));
+      }
+    });
+  }
+
+  for (auto i = 1u; i <= number_of_frames; ++i) {
+    auto frame = pipeline.WaitForFrame(carla::time_duration::seconds(10u));
+    ASSERT_TRUE(frame.has_value());
+    ASSERT_EQ(frame->timestamp.frame_count, i);
+    ASSERT_EQ(frame->sensor_data[0u]->GetFrameNumber(), i);
+    ASSERT_EQ(frame->sensor_data[1u]->GetFrameNumber(), i);
+  }
+  threads.JoinAll();
+}
@@ -5,11 +5,16 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include "test.h"
+#include "GeomUtil.h"
 
+#include <carla/geom/BatchMath.h>
+#include <carla/geom/BoundingBox.h>
+#include <carla/geom/GeoLocation.h>
 #include <carla/geom/Vector3D.h>
 #include <carla/geom/Math.h>
 #include <carla/geom/Transform.h>
 #include <limits>
+#include <vector>
 
 namespace carla {
 namespace geom {
@@ -218,3 +223,198 @@ TEST(geom, nearest_point_arc) {
   ASSERT_NEAR(Math::DistArcPoint(Vector3D(1,-2,0),
       Vector3D(0,0,0), 1.57, 0, 1).second, 1.0, 0.01);
 }
+
+/// Geo-references from the equator to near the pole.
+static const std::vector<GeoLocation> GEO_REFERENCES = {
+    {0.0, 0.0, 0.0},
+    {41.3851, 2.1734, 12.0},
+    {-33.8688, 151.2093, 58.0},
+    {60.1699, 24.9384, -3.0},
+    {80.0, -170.0, 0.0}};
+
+TEST(geom, geo_location_batch_transform) {
+  // Not a multiple of the SIMD width.
+  const auto locations = util::geom::make_random_locations(1003u, 50000.0f);
+  std::vector<GeoLocation> result(locations.size());
+  for (auto &&reference : GEO_REFERENCES) {
+    reference.Transform(locations.data(), locations.size(), result.data());
+    for (auto i = 0u; i < locations.size(); ++i) {
+      const auto expected = reference.Transform(locations[i]);
+      ASSERT_NEAR(result[i].latitude, expected.latitude, 1e-11);
+      ASSERT_NEAR(result[i].longitude, expected.longitude, 1e-11);
+      ASSERT_EQ(result[i].altitude, expected.altitude);
+    }
+  }
+}
+
+TEST(geom, geo_location_inverse_transform) {
+  const auto locations = util::geom::make_random_locations(1003u, 50000.0f);
+  std::vector<GeoLocation> geo_locations(locations.size());
+  std::vector<Location> result(locations.size());
+  for (auto &&reference : GEO_REFERENCES) {
+    reference.Transform(locations.data(), locations.size(), geo_locations.data());
+    reference.InverseTransform(geo_locations.data(), geo_locations.size(), result.data());
+    for (auto i = 0u; i < locations.size(); ++i) {
+      // Same as the scalar path and back to the original location, up to
+      // the precision of a float.
+      const auto expected = reference.InverseTransform(geo_locations[i]);
+      ASSERT_NEAR(result[i].x, expected.x, 1e-3);
+      ASSERT_NEAR(result[i].y, expected.y, 1e-3);
+      ASSERT_EQ(result[i].z, expected.z);
+      ASSERT_NEAR(result[i].x, locations[i].x, 1e-2);
+      ASSERT_NEAR(result[i].y, locations[i].y, 1e-2);
+      ASSERT_NEAR(result[i].z, locations[i].z, 1e-3);
+    }
+  }
+}
+
+/// Difference between two angles in degrees, in [0, 180].
+static double AngleDifference(double a, double b) {
+  return std::abs(std::remainder(a - b, 360.0));
+}
+
+TEST(geom, inverse_transform_point) {
+  for (auto &&transform : util::geom::make_random_transforms(100u, 100.0f)) {
+    for (auto &&location : util::geom::make_random_locations(10u, 100.0f)) {
+      Vector3D point = location;
+      transform.TransformPoint(point);
+      transform.InverseTransformPoint(point);
+      ASSERT_NEAR(point.x, location.x, 1e-3);
+      ASSERT_NEAR(point.y, location.y, 1e-3);
+      ASSERT_NEAR(point.z, location.z, 1e-3);
+    }
+  }
+}
+
+TEST(geom, transform_compose) {
+  const auto parents = util::geom::make_random_transforms(100u, 100.0f);
+  const auto children = util::geom::make_random_transforms(101u, 10.0f);
+  const auto locations = util::geom::make_random_locations(10u, 10.0f);
+  for (auto i = 0u; i < parents.size(); ++i) {
+    const auto composed = parents[i].Compose(children[i]);
+    for (auto &&location : locations) {
+      Vector3D expected = location;
+      children[i].TransformPoint(expected);
+      parents[i].TransformPoint(expected);
+      Vector3D point = location;
+      composed.TransformPoint(point);
+      ASSERT_NEAR(point.x, expected.x, 1e-3);
+      ASSERT_NEAR(point.y, expected.y, 1e-3);
+      ASSERT_NEAR(point.z, expected.z, 1e-3);
+    }
+  }
+}
+
+TEST(geom, bounding_box_vertices) {
+  const BoundingBox box{Location(1.0f, -2.0f, 0.5f), Vector3D(2.0f, 1.0f, 0.5f)};
+  const auto vertices = box.GetLocalVertices();
+  ASSERT_EQ(vertices[0u], Location(-1.0f, -3.0f, 0.0f));
+  ASSERT_EQ(vertices[1u], Location(-1.0f, -3.0f, 1.0f));
+  ASSERT_EQ(vertices[2u], Location(-1.0f, -1.0f, 0.0f));
+  ASSERT_EQ(vertices[7u], Location(3.0f, -1.0f, 1.0f));
+  const Transform transform{Location(10.0f, 0.0f, 0.0f), Rotation(0.0f, 90.0f, 0.0f)};
+  const Location center(12.0f, 1.0f, 0.5f);
+  ASSERT_TRUE(box.Contains(center, transform));
+  for (auto &&vertex : box.GetWorldVertices(transform)) {
+    ASSERT_TRUE(box.Contains(vertex * 0.99 + center * 0.01, transform));
+    ASSERT_FALSE(box.Contains(vertex * 1.01 - center * 0.01, transform));
+  }
+  ASSERT_FALSE(box.Contains(Location(12.0f, 3.5f, 0.5f), transform));
+}
+
+TEST(geom, batch_transform_points) {
+  // Not a multiple of the SIMD width.
+  const auto locations = util::geom::make_random_locations(1003u, 200.0f);
+  const auto points = util::geom::make_point_arrays(locations);
+  PointArrays result;
+  PointArrays inverse;
+  for (auto &&transform : util::geom::make_random_transforms(13u, 200.0f)) {
+    BatchMath::TransformPoints(transform, points, result);
+    BatchMath::InverseTransformPoints(transform, result, inverse);
+    ASSERT_EQ(result.size(), locations.size());
+    ASSERT_EQ(inverse.size(), locations.size());
+    for (auto i = 0u; i < locations.size(); ++i) {
+      Vector3D expected = locations[i];
+      transform.TransformPoint(expected);
+      ASSERT_NEAR(result.x[i], expected.x, 1e-3);
+      ASSERT_NEAR(result.y[i], expected.y, 1e-3);
+      ASSERT_NEAR(result.z[i], expected.z, 1e-3);
+      expected = result[i];
+      transform.InverseTransformPoint(expected);
+      ASSERT_NEAR(inverse.x[i], expected.x, 1e-3);
+      ASSERT_NEAR(inverse.y[i], expected.y, 1e-3);
+      ASSERT_NEAR(inverse.z[i], expected.z, 1e-3);
+      ASSERT_NEAR(inverse.x[i], locations[i].x, 1e-3);
+    }
+  }
+}
+
+TEST(geom, batch_compose_transforms) {
+  const auto parents = util::geom::make_random_transforms(1003u, 200.0f);
+  auto children = util::geom::make_random_transforms(1002u, 10.0f);
+  children.emplace_back();
+  std::vector<Transform> result;
+  BatchMath::ComposeTransforms(parents, children, result);
+  ASSERT_EQ(result.size(), parents.size());
+  for (auto i = 0u; i < parents.size(); ++i) {
+    const auto expected = parents[i].Compose(children[i]);
+    ASSERT_NEAR(result[i].location.x, expected.location.x, 1e-3);
+    ASSERT_NEAR(result[i].location.y, expected.location.y, 1e-3);
+    ASSERT_NEAR(result[i].location.z, expected.location.z, 1e-3);
+    ASSERT_NEAR(AngleDifference(result[i].rotation.pitch, expected.rotation.pitch), 0.0, 1e-3);
+    ASSERT_NEAR(AngleDifference(result[i].rotation.yaw, expected.rotation.yaw), 0.0, 1e-3);
+    ASSERT_NEAR(AngleDifference(result[i].rotation.roll, expected.rotation.roll), 0.0, 1e-3);
+  }
+}
+
+TEST(geom, batch_bounding_box_contains) {
+  const auto locations = util::geom::make_random_locations(1003u, 5.0f);
+  const auto points = util::geom::make_point_arrays(locations);
+  const BoundingBox box{Location(0.5f, 0.0f, 0.01f), Vector3D(2.5f, 1.0f, 0.02f)};
+  std::vector<uint8_t> result;
+  size_t number_inside = 0u;
+  for (auto transform : util::geom::make_random_transforms(13u, 1.0f)) {
+    transform.location.z = 0.0f;
+    transform.rotation.pitch *= 0.01f;
+    transform.rotation.roll = 0.0f;
+    BatchMath::Contains(box, transform, points, result);
+    ASSERT_EQ(result.size(), locations.size());
+    for (auto i = 0u; i < locations.size(); ++i) {
+      // Float precision may change the result only at the faces of the box.
+      Vector3D local = locations[i];
+      transform.InverseTransformPoint(local);
+      local -= box.location;
+      const auto margin = std::min({
+          std::abs(std::abs(local.x) - box.extent.x),
+          std::abs(std::abs(local.y) - box.extent.y),
+          std::abs(std::abs(local.z) - box.extent.z)});
+      if (margin > 1e-4) {
+        ASSERT_EQ(result[i] != 0u, box.Contains(locations[i], transform)) << "point " << i;
+      }
+      number_inside += result[i];
+    }
+  }
+  ASSERT_GT(number_inside, 0u);
+}
+
+TEST(geom, batch_bounding_box_vertices) {
+  const auto transforms = util::geom::make_random_transforms(1003u, 200.0f);
+  const auto extents = util::geom::make_random_locations(1003u, 5.0f);
+  std::vector<BoundingBox> boxes;
+  for (auto &&extent : extents) {
+    boxes.emplace_back(
+        Location(0.1f * extent.y, 0.0f, 10.0f * extent.z),
+        Vector3D(std::abs(extent.x), std::abs(extent.y), 1.0f));
+  }
+  PointArrays result;
+  BatchMath::GetWorldVertices(boxes, transforms, result);
+  ASSERT_EQ(result.size(), 8u * boxes.size());
+  for (auto i = 0u; i < boxes.size(); ++i) {
+    const auto expected = boxes[i].GetWorldVertices(transforms[i]);
+    for (auto k = 0u; k < expected.size(); ++k) {
+      ASSERT_NEAR(result.x[8u * i + k], expected[k].x, 1e-3);
+      ASSERT_NEAR(result.y[8u * i + k], expected[k].y, 1e-3);
+      ASSERT_NEAR(result.z[8u * i + k], expected[k].z, 1e-3);
+    }
+  }
+}
@@ -0,0 +1,195 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+#include "OpenDriveGenerator.h"
+
+#include <carla/geom/Math.h>
+#include <carla/opendrive/OpenDrive.h>
+#include <carla/opendrive/parser/NumberParser.h>
+#include <carla/opendrive/parser/OpenDriveParser.h>
+#include <carla/road/WaypointGenerator.h>
+
+#include <cstring>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace carla::opendrive;
+using namespace carla::road;
+using namespace carla::road::element;
+using carla::opendrive::parser::ParseDouble;
+using carla::opendrive::parser::ParseInt;
+
+static void CheckParseDouble(const std::string &str) {
+  const double expected = std::stod(str);
+  const double value = ParseDouble(str.c_str());
+  // Bitwise equal, the fast path must round exactly as the standard library.
+  ASSERT_EQ(std::memcmp(&value, &expected, sizeof(double)), 0)
+      << str << ": " << std::setprecision(17) << value << " != " << expected;
+}
+
+TEST(opendrive, parse_double) {
+  for (auto str : {
+      "0", "0.0", "-0.0", "1", "-1", "+1", "3.5", "  3.5", "1.2e3", "1.2E-3",
+      "-2.5e+2", ".5", "5.", "0.1", "0.3", "1e22", "1e23", "1e-22", "1e-23",
+      "123456789012345678", "12345678901234567890123", "0.000000000000000000001234",
+      "9007199254740993", "2.2250738585072014e-308", "1.7976931348623157e308",
+      "3.14159265358979323846264338327950288", "1.5abc", "2.5e", "2.5e+"}) {
+    CheckParseDouble(str);
+  }
+  ASSERT_EQ(ParseDouble(""), 0.0);
+  ASSERT_EQ(ParseDouble("abc"), 0.0);
+  ASSERT_EQ(ParseDouble("-"), 0.0);
+  ASSERT_EQ(ParseDouble(nullptr), 0.0);
+
+  std::mt19937_64 rng(31u);
+  std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+  std::uniform_int_distribution<int> exponent(-30, 30);
+  std::uniform_int_distribution<int> precision(1, 17);
+  for (auto i = 0u; i < 20000u; ++i) {
+    std::ostringstream out;
+    if (i % 2u == 0u) {
+      out << std::fixed;
+    }
+    out << std::setprecision(precision(rng)) << mantissa(rng) * std::pow(10.0, exponent(rng));
+    CheckParseDouble(out.str());
+  }
+}
+
+TEST(opendrive, parse_int) {
+  for (auto str : {"0", "-0", "42", "-42", "+7", "  12", "3.5", "12abc", "-2147483648", "2147483647"}) {
+    ASSERT_EQ(ParseInt(str), std::atoi(str)) << str;
+  }
+  ASSERT_EQ(ParseInt(""), 0);
+  ASSERT_EQ(ParseInt("abc"), 0);
+  ASSERT_EQ(ParseInt(nullptr), 0);
+}
+
+static std::string MakeHighway(size_t number_of_roads) {
+  util::opendrive::highway_options options;
+  options.number_of_roads = number_of_roads;
+  return util::opendrive::make_highway(options);
+}
+
+static void CheckSameRoads(const types::OpenDriveData &lhs, const types::OpenDriveData &rhs) {
+  ASSERT_EQ(lhs.roads.size(), rhs.roads.size());
+  for (auto i = 0u; i < lhs.roads.size(); ++i) {
+    const auto &a = lhs.roads[i];
+    const auto &b = rhs.roads[i];
+    ASSERT_EQ(a.attributes.id, b.attributes.id);
+    ASSERT_EQ(a.attributes.name, b.attributes.name);
+    ASSERT_EQ(a.attributes.length, b.attributes.length);
+    ASSERT_EQ(a.geometry_attributes.size(), b.geometry_attributes.size());
+    for (auto j = 0u; j < a.geometry_attributes.size(); ++j) {
+      const auto &ga = *a.geometry_attributes[j];
+      const auto &gb = *b.geometry_attributes[j];
+      ASSERT_EQ(ga.type, gb.type);
+      ASSERT_EQ(ga.start_position_x, gb.start_position_x);
+      ASSERT_EQ(ga.start_position_y, gb.start_position_y);
+      ASSERT_EQ(ga.heading, gb.heading);
+      ASSERT_EQ(ga.length, gb.length);
+    }
+    ASSERT_EQ(a.road_profiles.elevation_profile.size(), b.road_profiles.elevation_profile.size());
+    ASSERT_EQ(a.lanes.lane_sections.size(), b.lanes.lane_sections.size());
+    for (auto j = 0u; j < a.lanes.lane_sections.size(); ++j) {
+      const auto &sa = a.lanes.lane_sections[j];
+      const auto &sb = b.lanes.lane_sections[j];
+      ASSERT_EQ(sa.left.size(), sb.left.size());
+      ASSERT_EQ(sa.right.size(), sb.right.size());
+      for (auto k = 0u; k < sa.right.size(); ++k) {
+        ASSERT_EQ(sa.right[k].attributes.id, sb.right[k].attributes.id);
+        ASSERT_EQ(sa.right[k].lane_width.front().width, sb.right[k].lane_width.front().width);
+      }
+    }
+  }
+}
+
+TEST(opendrive, parallel_parse) {
+  const auto xodr = MakeHighway(300u);
+  types::OpenDriveData expected;
+  ASSERT_TRUE(OpenDriveParser::Parse(xodr.c_str(), expected, XmlInputType::CONTENT, nullptr, 1u));
+  ASSERT_EQ(expected.roads.size(), 300u);
+  for (auto i = 0u; i < expected.roads.size(); ++i) {
+    ASSERT_EQ(expected.roads[i].attributes.id, static_cast<int>(i));
+    ASSERT_EQ(expected.roads[i].geometry_attributes.size(), 3u);
+    ASSERT_EQ(expected.roads[i].lanes.lane_sections.front().right.size(), 3u);
+  }
+  for (auto number_of_threads : {2u, 5u, 0u}) {
+    types::OpenDriveData data;
+    ASSERT_TRUE(OpenDriveParser::Parse(xodr.c_str(), data, XmlInputType::CONTENT, nullptr, number_of_threads));
+    CheckSameRoads(expected, data);
+  }
+}
+
+/// Every driving lane of @a map can be followed, except @a number_of_dead_ends.
+static void CheckLanesAreConnected(const Map &map, size_t number_of_dead_ends) {
+  size_t dead_ends = 0u;
+  for (auto &&road : map.GetData().GetRoadSegments()) {
+    const auto lanes = road.GetInfo<RoadInfoLane>(0.0);
+    ASSERT_NE(lanes, nullptr);
+    for (auto lane_id : lanes->getLanesIDs(RoadInfoLane::which_lane_e::Both)) {
+      if (lanes->getLane(lane_id)->_type != LaneType::Driving) {
+        continue;
+      }
+      if (map.GetSuccessorTable().GetSuccessors(road.GetId(), lane_id).empty()) {
+        ++dead_ends;
+      }
+    }
+  }
+  ASSERT_EQ(dead_ends, number_of_dead_ends);
+}
+
+TEST(opendrive, generated_grid_city) {
+  util::opendrive::grid_city_options options;
+  options.rows = 3u;
+  options.columns = 4u;
+  options.lanes_per_direction = 2;
+  const auto map = util::opendrive::load_map(util::opendrive::make_grid_city(options));
+  ASSERT_NE(map, nullptr);
+  // Streets, plus a connection straight, left and right from each arm of
+  // each junction that has somewhere to go.
+  constexpr size_t streets = 3u * 3u + 2u * 4u;
+  size_t connections = 0u;
+  for (auto row = 0u; row < 3u; ++row) {
+    for (auto column = 0u; column < 4u; ++column) {
+      const size_t arms =
+          (row > 0u) + (row + 1u < 3u) + (column > 0u) + (column + 1u < 4u);
+      connections += arms * (arms - 1u);
+    }
+  }
+  ASSERT_EQ(map->GetData().GetRoadCount(), streets + connections);
+  CheckLanesAreConnected(*map, 0u);
+
+  // Following any lane long enough crosses several junctions.
+  const auto waypoints = WaypointGenerator::GenerateAll(*map, 10.0);
+  ASSERT_FALSE(waypoints.empty());
+  for (auto &&waypoint : waypoints) {
+    ASSERT_FALSE(WaypointGenerator::GetNext(waypoint, 250.0).empty());
+  }
+}
+
+TEST(opendrive, generated_highway) {
+  constexpr size_t number_of_roads = 40u;
+  constexpr int lanes = 3;
+  util::opendrive::highway_options options;
+  options.number_of_roads = number_of_roads;
+  options.lanes_per_direction = lanes;
+  const auto map = util::opendrive::load_map(util::opendrive::make_highway(options));
+  ASSERT_NE(map, nullptr);
+  ASSERT_EQ(map->GetData().GetRoadCount(), number_of_roads);
+  // Only the lanes leaving the ends of the highway go nowhere.
+  CheckLanesAreConnected(*map, 2u * lanes);
+
+  // Consecutive roads are continuous.
+  for (id_type id = 0u; id + 1u < number_of_roads; ++id) {
+    const auto &road = *map->GetData().GetRoad(id);
+    const auto end = road.GetDirectedPointIn(road.GetLength());
+    const auto start = map->GetData().GetRoad(id + 1u)->GetDirectedPointIn(0.0);
+    ASSERT_NEAR(carla::geom::Math::Distance(end.location, start.location), 0.0, 0.01) << "road " << id;
+  }
+}
@@ -5,15 +5,35 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include "test.h"
+#include "OpenDriveGenerator.h"
+#include "RoadMapUtil.h"
+#include "TemporaryDirectory.h"
 
+#include <carla/opendrive/OpenDrive.h>
+#include <carla/road/CompiledMap.h>
+#include <carla/road/MapArena.h>
 #include <carla/road/MapBuilder.h>
+#include <carla/road/RoutePlanner.h>
+#include <carla/road/WaypointGenerator.h>
 #include <carla/geom/Location.h>
 #include <carla/geom/Math.h>
 #include <carla/road/element/RoadInfoVisitor.h>
 
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <random>
+#include <thread>
+
 using namespace carla::road;
 using namespace carla::road::element;
 using namespace carla::geom;
+using carla::opendrive::OpenDrive;
 
 TEST(road, add_geometry) {
   MapBuilder builder;
@@ -60,6 +80,42 @@ TEST(road, add_information) {
   ASSERT_EQ(r->velocity, 90.0);
 }
 
+TEST(road, map_arena) {
+  struct Counted {
+    explicit Counted(int &in_count) : count(in_count) { ++count; }
+    ~Counted() { --count; }
+    int &count;
+  };
+  struct alignas(32) Aligned {
+    double value[4u];
+  };
+  int count = 0;
+  {
+    MapArena arena(64u);
+    std::vector<Counted *> elements;
+    for (auto i = 0; i < 100; ++i) {
+      elements.emplace_back(arena.Make<Counted>(count));
+      const auto *aligned = arena.Make<Aligned>();
+      ASSERT_EQ(reinterpret_cast<uintptr_t>(aligned) % 32u, 0u);
+    }
+    ASSERT_EQ(count, 100);
+    // Elements spliced into another arena outlive the original one.
+    MapArena other;
+    {
+      MapArena temporary;
+      temporary.Make<Counted>(count);
+      other.Splice(std::move(temporary));
+      ASSERT_EQ(temporary.GetSize(), 0u);
+    }
+    ASSERT_EQ(count, 101);
+    MapArena moved = std::move(arena);
+    ASSERT_EQ(count, 101);
+    ASSERT_EQ(&elements.front()->count, &count);
+    ASSERT_GT(moved.GetSize(), 100u * (sizeof(Counted) + sizeof(Aligned)));
+  }
+  ASSERT_EQ(count, 0);
+}
+
 TEST(road, set_and_get_connections_for) {
   MapBuilder builder;
   for (int i = 0; i < 10; ++i) {
@@ -201,3 +257,805 @@ TEST(road, get_information) {
   const auto r = m.GetData().GetRoad(0)->GetInfo<RoadInfoVelocity>(0.0);
   (void)r;
 }
+
+TEST(road, get_infos_order) {
+  MapBuilder builder;
+  RoadSegmentDefinition def(0);
+
+  def.MakeGeometry<GeometryLine>(0, 10, 0, carla::geom::Location());
+  def.MakeInfo<element::RoadInfoVelocity>(5, 30);
+  def.MakeInfo<element::RoadInfoLane>();
+  def.MakeInfo<element::RoadInfoVelocity>(0, 10);
+  def.MakeInfo<element::RoadInfoVelocity>(5, 40);
+  def.MakeInfo<element::RoadInfoVelocity>(2, 20);
+
+  builder.AddRoadSegmentDefinition(def);
+  auto map_ptr = builder.Build();
+  const auto &road = *map_ptr->GetData().GetRoad(0);
+
+  // Infos at the same distance keep the order of insertion.
+  ASSERT_EQ(road.GetInfo<RoadInfoVelocity>(5.0)->velocity, 40.0);
+  ASSERT_EQ(road.GetInfoReverse<RoadInfoVelocity>(3.0)->velocity, 30.0);
+  ASSERT_EQ(road.GetInfoReverse<RoadInfoVelocity>(6.0), nullptr);
+  ASSERT_NE(road.GetInfo<RoadInfoLane>(6.0), nullptr);
+  ASSERT_EQ(road.GetInfo<RoadElevationInfo>(6.0), nullptr);
+
+  auto to_velocities = [](const auto &infos) {
+    std::vector<double> result;
+    for (auto &&info : infos) {
+      result.emplace_back(info->velocity);
+    }
+    return result;
+  };
+  ASSERT_EQ(to_velocities(road.GetInfos<RoadInfoVelocity>(5.0)), (std::vector<double>{40, 30, 20, 10}));
+  ASSERT_EQ(to_velocities(road.GetInfos<RoadInfoVelocity>(1.0)), (std::vector<double>{10}));
+  ASSERT_EQ(to_velocities(road.GetInfosReverse<RoadInfoVelocity>(2.0)), (std::vector<double>{20, 30, 40}));
+}
+
+TEST(road, lane_types) {
+  for (auto type : {LaneType::Driving, LaneType::Parking, LaneType::RoadWorks, LaneType::OnRamp, LaneType::None}) {
+    ASSERT_EQ(ParseLaneType(ToString(type)), type);
+  }
+  ASSERT_EQ(ParseLaneType("sidewalk"), LaneType::Sidewalk);
+  ASSERT_EQ(ParseLaneType("unknown"), LaneType::None);
+
+  RoadInfoLane lanes;
+  lanes.addLaneInfo(2, 3.0, LaneType::Sidewalk);
+  lanes.addLaneInfo(-1, 3.0, LaneType::Driving);
+  lanes.addLaneInfo(1, 3.0, LaneType::Driving);
+  lanes.addLaneInfo(-3, 3.0, LaneType::Parking);
+  ASSERT_EQ(lanes.size(), 4);
+  ASSERT_EQ(lanes.getLane(0), nullptr);
+  ASSERT_EQ(lanes.getLane(-2), nullptr);
+  ASSERT_EQ(lanes.getLane(3), nullptr);
+  ASSERT_EQ(lanes.getLane(-3)->_type, LaneType::Parking);
+  ASSERT_EQ(lanes.getLanesIDs(), (std::vector<int>{-3, -1, 1, 2}));
+  ASSERT_EQ(lanes.getLanesIDs(RoadInfoLane::which_lane_e::Right), (std::vector<int>{-1, -3}));
+  ASSERT_EQ(lanes.getLanesIDs(RoadInfoLane::which_lane_e::Left), (std::vector<int>{1, 2}));
+
+  auto lanes_of_type = [&](LaneTypeMask mask) {
+    std::vector<int> result;
+    lanes.ForEachLane(mask, [&](int id) { result.emplace_back(id); });
+    return result;
+  };
+  ASSERT_EQ(lanes_of_type(static_cast<LaneTypeMask>(LaneType::Driving)), (std::vector<int>{-1, 1}));
+  ASSERT_EQ(lanes_of_type(LaneType::Driving | LaneType::Parking), (std::vector<int>{-3, -1, 1}));
+  ASSERT_EQ(lanes_of_type(static_cast<LaneTypeMask>(LaneType::Any)), (std::vector<int>{-3, -1, 1, 2}));
+}
+
+/// Check that the nearest point to points placed at a known offset of the
+/// geometry is found.
+static void CheckNearestPoint(const Geometry &geometry) {
+  const double length = geometry.GetLength();
+  for (auto i = 1u; i < 100u; ++i) {
+    const double s = length * i / 100.0;
+    for (auto offset : {-2.0, -0.5, 0.0, 0.5, 2.0}) {
+      auto point = geometry.PosFromDist(s);
+      point.ApplyLateralOffset(offset);
+      const auto nearest = geometry.DistanceTo(point.location);
+      ASSERT_NEAR(nearest.first, s, 0.01);
+      ASSERT_NEAR(nearest.second, std::abs(offset), 0.01);
+    }
+  }
+}
+
+TEST(road, geom_tessellation) {
+  const GeometryLine line(0.0, 50.0, 0.3, Location(10.0f, -20.0f, 0.0f));
+  const GeometryArc arc(0.0, 60.0, 1.2, Location(-30.0f, 5.0f, 0.0f), 0.04);
+  const GeometryArc arc_negative(0.0, 60.0, -2.0, Location(100.0f, 50.0f, 0.0f), -0.05);
+  const GeometrySpiral spiral(0.0, 80.0, 0.5, Location(-5.0f, 5.0f, 0.0f), 0.0, 0.03);
+  const GeometrySpiral spiral_negative(0.0, 80.0, 2.5, Location(0.0f, 0.0f, 0.0f), 0.0, -0.03);
+  for (const Geometry *geometry : {
+      static_cast<const Geometry *>(&line),
+      static_cast<const Geometry *>(&arc),
+      static_cast<const Geometry *>(&arc_negative),
+      static_cast<const Geometry *>(&spiral),
+      static_cast<const Geometry *>(&spiral_negative)}) {
+    const auto &tessellation = geometry->GetTessellation();
+    ASSERT_GE(tessellation.size(), 2u);
+    ASSERT_EQ(tessellation.s.front(), 0.0);
+    ASSERT_EQ(tessellation.s.back(), geometry->GetLength());
+    CheckNearestPoint(*geometry);
+  }
+}
+
+TEST(road, spatial_index_matches_brute_force) {
+  constexpr size_t size = 10u;
+  auto map = util::road_map::make_synthetic_map(size);
+  const auto &index = map->GetSpatialIndex();
+  std::mt19937_64 rng(7u);
+  std::uniform_real_distribution<float> coordinate(-200.0f, size * 100.0f + 200.0f);
+  for (auto count : {1u, 3u, 10u}) {
+    for (auto i = 0u; i < 500u; ++i) {
+      const Location location(coordinate(rng), coordinate(rng), 0.0f);
+      const auto expected = util::road_map::get_nearest_roads_brute_force(*map, location, count);
+      const auto result = index.GetNearestRoads(location, count);
+      ASSERT_EQ(result.size(), expected.size());
+      for (auto j = 0u; j < result.size(); ++j) {
+        ASSERT_EQ(result[j].road->GetId(), expected[j].first);
+        ASSERT_EQ(result[j].distance, expected[j].second);
+      }
+    }
+  }
+}
+
+static void CheckWaypoint(
+    const Map &map,
+    const WaypointArrays &arrays,
+    size_t index,
+    const Waypoint &expected) {
+  ASSERT_EQ(arrays.GetHandle(index), expected.GetHandle());
+  const auto transform = expected.ComputeTransform();
+  ASSERT_EQ(arrays.locations[3u * index + 0u], transform.location.x);
+  ASSERT_EQ(arrays.locations[3u * index + 1u], transform.location.y);
+  ASSERT_EQ(arrays.locations[3u * index + 2u], transform.location.z);
+  ASSERT_EQ(arrays.rotations[3u * index + 0u], transform.rotation.pitch);
+  ASSERT_EQ(arrays.rotations[3u * index + 1u], transform.rotation.yaw);
+  ASSERT_EQ(arrays.rotations[3u * index + 2u], transform.rotation.roll);
+  ASSERT_EQ(map.MakeWaypoint(arrays.GetHandle(index)).GetHandle(), expected.GetHandle());
+}
+
+TEST(road, generate_waypoint_arrays) {
+  auto map = util::road_map::load_grid_city(4u);
+  const auto driving_and_sidewalk = LaneType::Driving | LaneType::Sidewalk;
+  const auto expected = WaypointGenerator::GenerateAll(*map, 3.0, driving_and_sidewalk);
+  ASSERT_GT(expected.size(), 1000u);
+  ASSERT_TRUE(std::any_of(expected.begin(), expected.end(), [](const Waypoint &waypoint) {
+    return waypoint.GetLaneType() == LaneType::Sidewalk;
+  }));
+  for (auto number_of_threads : {1u, 3u, 0u}) {
+    const auto arrays = WaypointGenerator::GenerateAllArrays(*map, 3.0, driving_and_sidewalk, number_of_threads);
+    ASSERT_EQ(arrays.size(), expected.size());
+    ASSERT_EQ(arrays.locations.size(), 3u * expected.size());
+    for (auto i = 0u; i < expected.size(); ++i) {
+      CheckWaypoint(*map, arrays, i, expected[i]);
+    }
+  }
+
+  const auto expected_topology = WaypointGenerator::GenerateTopology(*map);
+  ASSERT_FALSE(expected_topology.empty());
+  for (auto number_of_threads : {1u, 3u}) {
+    const auto topology = WaypointGenerator::GenerateTopologyArrays(*map, number_of_threads);
+    ASSERT_EQ(topology.size(), expected_topology.size());
+    for (auto i = 0u; i < expected_topology.size(); ++i) {
+      CheckWaypoint(*map, topology.from, i, expected_topology[i].first);
+      CheckWaypoint(*map, topology.to, i, expected_topology[i].second);
+    }
+  }
+}
+
+/// Number of streets of util::road_map::load_grid_city(@a size), their ids
+/// come before the ids of the roads inside the junctions.
+static size_t GetNumberOfStreets(size_t size) {
+  return 2u * size * (size - 1u);
+}
+
+static void CheckRoute(const Route &route, const WaypointHandle &origin, const WaypointHandle &destination, double step) {
+  ASSERT_FALSE(route.empty());
+  ASSERT_EQ(route.waypoints.GetHandle(0u), origin);
+  ASSERT_EQ(route.waypoints.GetHandle(route.waypoints.size() - 1u), destination);
+  for (auto i = 1u; i < route.waypoints.size(); ++i) {
+    const auto *a = &route.waypoints.locations[3u * (i - 1u)];
+    const auto *b = &route.waypoints.locations[3u * i];
+    const Location location_a(a[0u], a[1u], a[2u]);
+    const Location location_b(b[0u], b[1u], b[2u]);
+    // Besides the step, lanes may jump at intersections and lane changes.
+    ASSERT_LE(Math::Distance(location_a, location_b), step + 12.0);
+  }
+}
+
+TEST(road, route_planner) {
+  constexpr double step = 2.0;
+  auto map = util::road_map::load_grid_city(6u);
+  RoutePlanner a_star(map);
+  RoutePlanner hierarchy(map);
+  hierarchy.BuildContractionHierarchy();
+  ASSERT_EQ(a_star.GetNumberOfNodes(), util::road_map::get_driving_lanes(*map).size());
+  ASSERT_TRUE(hierarchy.HasContractionHierarchy());
+
+  const auto origins = util::road_map::make_random_waypoints(*map, 200u, 1u);
+  const auto destinations = util::road_map::make_random_waypoints(*map, 200u, 2u);
+  for (auto i = 0u; i < origins.size(); ++i) {
+    const auto route = a_star.ComputeRoute(origins[i], destinations[i], step);
+    const auto route_ch = hierarchy.ComputeRoute(origins[i], destinations[i], step);
+    CheckRoute(route, origins[i], destinations[i], step);
+    CheckRoute(route_ch, origins[i], destinations[i], step);
+    ASSERT_NEAR(route.length, route_ch.length, 1e-6);
+  }
+
+  // Queries running while the hierarchy is built.
+  RoutePlanner concurrent(map);
+  std::thread builder([&]() { concurrent.BuildContractionHierarchy(); });
+  for (auto i = 0u; i < origins.size(); ++i) {
+    EXPECT_NEAR(
+        concurrent.ComputeRoute(origins[i], destinations[i], step).length,
+        a_star.ComputeRoute(origins[i], destinations[i], step).length,
+        1e-6);
+  }
+  builder.join();
+  ASSERT_TRUE(concurrent.HasContractionHierarchy());
+
+  // Destination ahead on the same lane.
+  const auto &road = *map->GetData().GetRoad(0u);
+  const WaypointHandle start{0u, -1, 10.0};
+  const WaypointHandle ahead{0u, -1, road.GetLength() - 10.0};
+  for (auto *planner : {&a_star, &hierarchy}) {
+    const auto route = planner->ComputeRoute(start, ahead, step);
+    CheckRoute(route, start, ahead, step);
+    ASSERT_NEAR(route.length, road.GetLength() - 20.0, 1e-9);
+    // Destination behind, the route goes around the block.
+    const auto back = planner->ComputeRoute(ahead, start, step);
+    CheckRoute(back, ahead, start, step);
+    ASSERT_GT(back.length, 3.0 * road.GetLength());
+    // Change to the adjacent lane along the same road.
+    const WaypointHandle adjacent{0u, -2, road.GetLength() - 10.0};
+    const auto lane_change = planner->ComputeRoute(start, adjacent, step);
+    CheckRoute(lane_change, start, adjacent, step);
+    ASSERT_NEAR(lane_change.length, road.GetLength() - 20.0, 1e-9);
+  }
+
+  // Batch queries.
+  std::vector<std::pair<Location, Location>> queries;
+  for (auto i = 0u; i < 50u; ++i) {
+    queries.emplace_back(
+        map->ComputeTransform(origins[i]).location,
+        map->ComputeTransform(destinations[i]).location);
+  }
+  const auto routes = hierarchy.ComputeRoutes(queries, step, 3u);
+  ASSERT_EQ(routes.size(), queries.size());
+  for (auto i = 0u; i < queries.size(); ++i) {
+    const auto expected = hierarchy.ComputeRoute(queries[i].first, queries[i].second, step);
+    ASSERT_EQ(routes[i].waypoints.s, expected.waypoints.s);
+    ASSERT_EQ(routes[i].waypoints.lane_ids, expected.waypoints.lane_ids);
+  }
+}
+
+/// Shortest distance driven from the entrance of each lane of @a lanes to the
+/// entrance of every other lane, found by brute force with Dijkstra on a lane
+/// graph with the costs of RoutePlanner. The minimum cost routes may differ in
+/// the distance driven, so it returns the [min, max] range of them, or
+/// nothing if not reachable.
+class BruteForceRoutePlanner {
+public:
+
+  using Range = std::pair<double, double>;
+
+  BruteForceRoutePlanner(const Map &map, std::vector<std::pair<id_type, int>> lanes)
+    : _lanes(std::move(lanes)),
+      _edges(_lanes.size()) {
+    constexpr double lane_change_cost = 10.0;
+    std::map<std::pair<id_type, int>, size_t> index;
+    for (auto i = 0u; i < _lanes.size(); ++i) {
+      index.emplace(_lanes[i], i);
+    }
+    auto entrance = [&](size_t i) {
+      const auto &road = *map.GetData().GetRoad(_lanes[i].first);
+      return map.ComputeTransform(GetEntrance(road, _lanes[i].second)).location;
+    };
+    for (auto i = 0u; i < _lanes.size(); ++i) {
+      const auto &road = *map.GetData().GetRoad(_lanes[i].first);
+      const auto waypoint = map.MakeWaypoint(GetEntrance(road, _lanes[i].second));
+      for (auto &&successor : map.GetSuccessorTable().GetSuccessors(_lanes[i].first, _lanes[i].second)) {
+        const auto it = index.find({successor.road_id, successor.lane_id});
+        if (it != index.end()) {
+          const double distance = Math::Distance(entrance(i), entrance(it->second));
+          _edges[i].push_back({it->second, std::max(road.GetLength(), distance), road.GetLength()});
+        }
+      }
+      for (auto &&adjacent : {WaypointGenerator::GetLeft(waypoint), WaypointGenerator::GetRight(waypoint)}) {
+        if (!adjacent || ((adjacent->GetLaneId() < 0) != (_lanes[i].second < 0))) {
+          continue;
+        }
+        const auto it = index.find({_lanes[i].first, adjacent->GetLaneId()});
+        if (it != index.end()) {
+          const double distance = Math::Distance(entrance(i), entrance(it->second));
+          _edges[i].push_back({it->second, std::max(lane_change_cost, distance), 0.0});
+        }
+      }
+    }
+  }
+
+  static WaypointHandle GetEntrance(const RoadSegment &road, int lane_id) {
+    return {road.GetId(), lane_id, lane_id <= 0 ? 0.0 : road.GetLength()};
+  }
+
+  std::vector<boost::optional<Range>> Compute(size_t origin) const {
+    constexpr double epsilon = 1e-6;
+    std::vector<double> cost(_lanes.size(), std::numeric_limits<double>::infinity());
+    std::vector<boost::optional<Range>> length(_lanes.size());
+    std::vector<bool> settled(_lanes.size(), false);
+    cost[origin] = 0.0;
+    length[origin] = Range{0.0, 0.0};
+    for (;;) {
+      size_t node = _lanes.size();
+      for (auto i = 0u; i < _lanes.size(); ++i) {
+        if (!settled[i] && length[i] && ((node == _lanes.size()) || (cost[i] < cost[node]))) {
+          node = i;
+        }
+      }
+      if (node == _lanes.size()) {
+        return length;
+      }
+      settled[node] = true;
+      for (auto &&edge : _edges[node]) {
+        const auto new_cost = cost[node] + edge.cost;
+        const Range new_length{length[node]->first + edge.length, length[node]->second + edge.length};
+        if (new_cost < cost[edge.node] - epsilon) {
+          cost[edge.node] = new_cost;
+          length[edge.node] = new_length;
+        } else if (new_cost <= cost[edge.node] + epsilon) {
+          length[edge.node]->first = std::min(length[edge.node]->first, new_length.first);
+          length[edge.node]->second = std::max(length[edge.node]->second, new_length.second);
+        }
+      }
+    }
+  }
+
+private:
+
+  struct Edge {
+    size_t node;
+    double cost;
+    double length;
+  };
+
+  std::vector<std::pair<id_type, int>> _lanes;
+
+  std::vector<std::vector<Edge>> _edges;
+};
+
+TEST(road, route_planner_matches_brute_force) {
+  auto map = util::road_map::load_grid_city(3u);
+  const auto lanes = util::road_map::get_driving_lanes(*map);
+  const BruteForceRoutePlanner brute_force(*map, lanes);
+  RoutePlanner a_star(map);
+  RoutePlanner hierarchy(map);
+  hierarchy.BuildContractionHierarchy();
+
+  std::mt19937_64 rng(11u);
+  std::uniform_int_distribution<size_t> lane(0u, lanes.size() - 1u);
+  size_t number_of_routes = 0u;
+  for (auto i = 0u; i < 10u; ++i) {
+    const auto origin = lane(rng);
+    const auto expected = brute_force.Compute(origin);
+    const auto &origin_road = *map->GetData().GetRoad(lanes[origin].first);
+    const auto origin_handle = BruteForceRoutePlanner::GetEntrance(origin_road, lanes[origin].second);
+    for (auto j = 0u; j < lanes.size(); ++j) {
+      if (lanes[j].first == lanes[origin].first) {
+        continue;
+      }
+      const auto &road = *map->GetData().GetRoad(lanes[j].first);
+      const auto destination = BruteForceRoutePlanner::GetEntrance(road, lanes[j].second);
+      for (auto *planner : {&a_star, &hierarchy}) {
+        const auto route = planner->ComputeRoute(origin_handle, destination);
+        ASSERT_EQ(route.empty(), !expected[j]);
+        if (expected[j]) {
+          ASSERT_GE(route.length, expected[j]->first - 1e-6);
+          ASSERT_LE(route.length, expected[j]->second + 1e-6);
+          ++number_of_routes;
+        }
+      }
+    }
+  }
+  ASSERT_GT(number_of_routes, 2000u);
+}
+
+// =============================================================================
+// -- WaypointGenerator::GetNext -----------------------------------------------
+// =============================================================================
+
+static std::vector<WaypointHandle> ToHandles(const std::vector<Waypoint> &waypoints) {
+  std::vector<WaypointHandle> result;
+  for (auto &&waypoint : waypoints) {
+    result.emplace_back(waypoint.GetHandle());
+  }
+  return result;
+}
+
+TEST(road, waypoint_get_next) {
+  auto map = util::road_map::load_grid_city(6u);
+  const auto waypoints = util::road_map::make_random_waypoints(*map, 200u, 5u);
+  std::vector<WaypointHandle> next;
+  for (auto distance : {0.5, 10.0, 150.0, 400.0}) {
+    for (auto &&handle : waypoints) {
+      const auto waypoint = map->MakeWaypoint(handle);
+      const auto expected = ToHandles(util::road_map::get_next_recursive(map, waypoint, distance));
+      ASSERT_EQ(ToHandles(WaypointGenerator::GetNext(waypoint, distance)), expected);
+      next.clear();
+      WaypointGenerator::GetNext(*map, handle, distance, next);
+      ASSERT_EQ(next, expected);
+    }
+  }
+}
+
+/// Distance from @a location to the center of the lane of @a waypoint, at the
+/// nearest point of its road.
+static double DistanceToLane(const Waypoint &waypoint, const Location &location) {
+  const auto &road = waypoint.GetRoadSegment();
+  const auto nearest = road.GetNearestPoint(location);
+  auto lanes = road.GetInfo<RoadInfoLane>(0.0);
+  auto dp = road.GetDirectedPointIn(nearest.first);
+  dp.ApplyLateralOffset(lanes->getLane(waypoint.GetLaneId())->_lane_center_offset);
+  return Math::Distance2D(dp.location, location);
+}
+
+/// Check the waypoint tracked at @a location against the nearest one found by
+/// the global search, @a expected, on a grid city of @a size.
+static void CheckTrackedWaypoint(
+    const Map &map,
+    size_t size,
+    const Waypoint &tracked,
+    const Waypoint &expected,
+    const Location &location) {
+  const auto s = expected.GetDistance();
+  const auto &road = expected.GetRoadSegment();
+  if ((road.GetId() < GetNumberOfStreets(size)) && (s > 10.0) && (s < road.GetLength() - 10.0)) {
+    ASSERT_EQ(tracked.GetHandle(), expected.GetHandle());
+  } else if (tracked.GetHandle() != expected.GetHandle()) {
+    // The roads inside a junction overlap, tracking keeps to the roads linked
+    // to the previous one as long as the location is inside its lane.
+    ASSERT_TRUE(map.IsInsideLane(tracked.GetHandle(), location));
+  }
+}
+
+TEST(road, track_waypoint) {
+  auto map = util::road_map::load_grid_city(6u);
+  const auto trajectories = util::road_map::make_trajectories(*map, util::road_map::make_random_waypoints(*map, 100u, 7u), 200u, 1.5, 0.8f);
+  size_t count = 0u;
+  for (auto &&trajectory : trajectories) {
+    auto tracked = map->GetClosestWaypointOnRoad(trajectory.front());
+    for (auto &&location : trajectory) {
+      tracked = map->TrackWaypoint(tracked, location);
+      CheckTrackedWaypoint(*map, 6u, tracked, map->GetClosestWaypointOnRoad(location), location);
+      ++count;
+    }
+  }
+  ASSERT_GT(count, 10000u);
+
+  // Jumping far away falls back to the global search.
+  auto previous = map->MakeWaypoint({0u, -1, 10.0});
+  const Location far_away = map->ComputeTransform({GetNumberOfStreets(6u) - 1u, -1, 50.0}).location;
+  ASSERT_EQ(
+      map->TrackWaypoint(previous, far_away).GetHandle(),
+      map->GetClosestWaypointOnRoad(far_away).GetHandle());
+}
+
+TEST(road, track_waypoint_near_lane_borders) {
+  auto map = util::road_map::load_grid_city(4u);
+  const auto origins = util::road_map::make_random_waypoints(*map, 50u, 10u);
+  size_t off_road = 0u;
+  // From the center of the lane to past the border of the outermost lane,
+  // along trajectories crossing junctions.
+  for (auto lateral_offset : {0.0f, 1.7f, 1.8f, -1.8f, 3.6f, 6.0f, 9.0f}) {
+    for (auto &&trajectory : util::road_map::make_trajectories(*map, origins, 100u, 2.0, lateral_offset)) {
+      auto tracked = map->GetClosestWaypointOnRoad(trajectory.front()).GetHandle();
+      for (auto &&location : trajectory) {
+        tracked = map->TrackWaypoint(tracked, location);
+        const auto expected = map->GetClosestWaypointOnRoad(location).GetHandle();
+        const bool is_on_road = map->GetWaypoint(location).has_value();
+        // A tracked lane is only kept if the location is inside it, so it is
+        // never off-road where the global search is on the road.
+        if (tracked != expected) {
+          ASSERT_TRUE(map->IsInsideLane(tracked, location));
+        }
+        ASSERT_TRUE(!is_on_road || map->IsInsideLane(tracked, location));
+        off_road += is_on_road ? 0u : 1u;
+      }
+    }
+  }
+  ASSERT_GT(off_road, 1000u);
+}
+
+TEST(road, track_waypoints) {
+  auto map = util::road_map::load_grid_city(6u);
+  const auto trajectories = util::road_map::make_trajectories(*map, util::road_map::make_random_waypoints(*map, 50u, 8u), 100u, 2.0, -0.5f);
+  std::vector<Waypoint> previous;
+  for (auto &&trajectory : trajectories) {
+    previous.emplace_back(map->GetClosestWaypointOnRoad(trajectory.front()));
+  }
+  std::vector<Location> locations;
+  for (auto i = 0u; i < 100u; ++i) {
+    locations.clear();
+    for (auto &&trajectory : trajectories) {
+      locations.emplace_back(trajectory[std::min<size_t>(i, trajectory.size() - 1u)]);
+    }
+    auto tracked = map->TrackWaypoints(previous, locations);
+    ASSERT_EQ(tracked.size(), locations.size());
+    for (auto j = 0u; j < locations.size(); ++j) {
+      ASSERT_EQ(tracked[j].GetHandle(), map->TrackWaypoint(previous[j], locations[j]).GetHandle());
+    }
+    previous = std::move(tracked);
+  }
+}
+
+/// A loop of two roads, each one a straight line followed by a half circle,
+/// with a driving lane in each direction and a sidewalk.
+static const char *COMPILED_MAP_TEST_XODR = R"(<?xml version="1.0" standalone="yes"?>
+<OpenDRIVE>
+  <header revMajor="1" revMinor="4" name="" version="1">
+    <geoReference><![CDATA[+lat_0=4.9e+1 +lon_0=8.0e+0]]></geoReference>
+  </header>
+  <road name="Road 1" length="257.0796" id="1" junction="-1">
+    <link>
+      <predecessor elementType="road" elementId="2" contactPoint="end"/>
+      <successor elementType="road" elementId="2" contactPoint="start"/>
+    </link>
+    <planView>
+      <geometry s="0.0" x="0.0" y="0.0" hdg="0.0" length="100.0"><line/></geometry>
+      <geometry s="100.0" x="100.0" y="0.0" hdg="0.0" length="157.0796"><arc curvature="0.02"/></geometry>
+    </planView>
+    <elevationProfile>
+      <elevation s="0.0" a="0.0" b="0.01" c="0.0" d="0.0"/>
+    </elevationProfile>
+    <lanes>
+      <laneOffset s="0.0" a="0.0" b="0.0" c="0.0" d="0.0"/>
+      <laneSection s="0.0">
+        <left>
+          <lane id="1" type="driving" level="false">
+            <link><predecessor id="1"/><successor id="1"/></link>
+            <width sOffset="0.0" a="3.5" b="0.0" c="0.0" d="0.0"/>
+            <roadMark sOffset="0.0" type="solid" weight="standard" color="standard" width="0.15" laneChange="none"/>
+          </lane>
+        </left>
+        <center>
+          <lane id="0" type="driving" level="false">
+            <roadMark sOffset="0.0" type="solid" weight="standard" color="standard" width="0.15" laneChange="none"/>
+          </lane>
+        </center>
+        <right>
+          <lane id="-1" type="driving" level="false">
+            <link><predecessor id="-1"/><successor id="-1"/></link>
+            <width sOffset="0.0" a="3.5" b="0.0" c="0.0" d="0.0"/>
+            <roadMark sOffset="0.0" type="broken" weight="standard" color="standard" width="0.15" laneChange="both"/>
+          </lane>
+          <lane id="-2" type="sidewalk" level="false">
+            <width sOffset="0.0" a="2.0" b="0.0" c="0.0" d="0.0"/>
+          </lane>
+        </right>
+      </laneSection>
+    </lanes>
+  </road>
+  <road name="Road 2" length="257.0796" id="2" junction="-1">
+    <link>
+      <predecessor elementType="road" elementId="1" contactPoint="end"/>
+      <successor elementType="road" elementId="1" contactPoint="start"/>
+    </link>
+    <planView>
+      <geometry s="0.0" x="100.0" y="100.0" hdg="3.1415927" length="100.0"><line/></geometry>
+      <geometry s="100.0" x="0.0" y="100.0" hdg="3.1415927" length="157.0796"><arc curvature="0.02"/></geometry>
+    </planView>
+    <elevationProfile>
+      <elevation s="0.0" a="2.57" b="-0.01" c="0.0" d="0.0"/>
+    </elevationProfile>
+    <lanes>
+      <laneOffset s="0.0" a="0.0" b="0.0" c="0.0" d="0.0"/>
+      <laneSection s="0.0">
+        <left>
+          <lane id="1" type="driving" level="false">
+            <link><predecessor id="1"/><successor id="1"/></link>
+            <width sOffset="0.0" a="3.5" b="0.0" c="0.0" d="0.0"/>
+            <roadMark sOffset="0.0" type="solid" weight="standard" color="standard" width="0.15" laneChange="none"/>
+          </lane>
+        </left>
+        <center>
+          <lane id="0" type="driving" level="false">
+            <roadMark sOffset="0.0" type="solid" weight="standard" color="standard" width="0.15" laneChange="none"/>
+          </lane>
+        </center>
+        <right>
+          <lane id="-1" type="driving" level="false">
+            <link><predecessor id="-1"/><successor id="-1"/></link>
+            <width sOffset="0.0" a="3.5" b="0.0" c="0.0" d="0.0"/>
+            <roadMark sOffset="0.0" type="broken" weight="standard" color="standard" width="0.15" laneChange="both"/>
+          </lane>
+          <lane id="-2" type="sidewalk" level="false">
+            <width sOffset="0.0" a="2.0" b="0.0" c="0.0" d="0.0"/>
+          </lane>
+        </right>
+      </laneSection>
+    </lanes>
+  </road>
+  <tlGroup redTime="10" yellowTime="3" greenTime="10">
+    <trafficlight xPos="100.0" yPos="-5.0" zPos="0.0" xRot="0.0" yRot="0.0" zRot="90.0">
+      <tfBox xPos="95.0" yPos="-2.0" zPos="0.0" xRot="0.0" yRot="0.0" zRot="90.0"/>
+    </trafficlight>
+  </tlGroup>
+  <trafficsign speed="30" xPos="50.0" yPos="-5.0" zPos="0.0" xRot="0.0" yRot="0.0" zRot="0.0">
+    <tsBox xPos="50.0" yPos="-2.0" zPos="0.0" xRot="0.0" yRot="0.0" zRot="0.0"/>
+  </trafficsign>
+</OpenDRIVE>
+)";
+
+TEST(road, unknown_lane_types) {
+  // Lane types are no longer kept as strings, names not defined by OpenDRIVE
+  // (or with a different case) are parsed as "none".
+  std::string xodr = COMPILED_MAP_TEST_XODR;
+  for (auto pos = xodr.find("type=\"sidewalk\""); pos != std::string::npos; pos = xodr.find("type=\"sidewalk\"")) {
+    xodr.replace(pos, 15u, "type=\"Sidewalk\"");
+  }
+  const auto map = OpenDrive::Load(xodr, XmlInputType::CONTENT);
+  ASSERT_NE(map, nullptr);
+  ASSERT_TRUE(WaypointGenerator::GenerateAll(*map, 10.0, static_cast<LaneTypeMask>(LaneType::Sidewalk)).empty());
+  const auto waypoints = WaypointGenerator::GenerateAll(*map, 10.0, static_cast<LaneTypeMask>(LaneType::None));
+  ASSERT_FALSE(waypoints.empty());
+  for (auto &&waypoint : waypoints) {
+    ASSERT_EQ(waypoint.GetLaneId(), -2);
+    ASSERT_EQ(waypoint.GetLaneType(), LaneType::None);
+    ASSERT_EQ(waypoint.GetType(), "none");
+  }
+}
+
+static void CheckSameWaypointArrays(const WaypointArrays &lhs, const WaypointArrays &rhs) {
+  ASSERT_EQ(lhs.road_ids, rhs.road_ids);
+  ASSERT_EQ(lhs.lane_ids, rhs.lane_ids);
+  ASSERT_EQ(lhs.s, rhs.s);
+  ASSERT_EQ(lhs.locations, rhs.locations);
+  ASSERT_EQ(lhs.rotations, rhs.rotations);
+}
+
+/// Check that every query gives exactly the same result on both maps.
+static void CheckSameMap(const Map &expected, const Map &map) {
+  const auto &data = map.GetData();
+  ASSERT_EQ(data.GetRoadCount(), expected.GetData().GetRoadCount());
+  ASSERT_EQ(data.GetGeoReference().latitude, expected.GetData().GetGeoReference().latitude);
+  ASSERT_EQ(data.GetGeoReference().longitude, expected.GetData().GetGeoReference().longitude);
+  ASSERT_EQ(data.GetJunctionInformation().size(), expected.GetData().GetJunctionInformation().size());
+  ASSERT_EQ(data.GetTrafficGroups().size(), expected.GetData().GetTrafficGroups().size());
+  ASSERT_EQ(data.GetTrafficSigns().size(), expected.GetData().GetTrafficSigns().size());
+  ASSERT_EQ(map.GetSuccessorTable().size(), expected.GetSuccessorTable().size());
+
+  const auto all_lanes = LaneType::Driving | LaneType::Sidewalk;
+  CheckSameWaypointArrays(
+      WaypointGenerator::GenerateAllArrays(map, 1.5, all_lanes, 1u),
+      WaypointGenerator::GenerateAllArrays(expected, 1.5, all_lanes, 1u));
+  const auto topology = WaypointGenerator::GenerateTopologyArrays(map, 1u);
+  const auto expected_topology = WaypointGenerator::GenerateTopologyArrays(expected, 1u);
+  CheckSameWaypointArrays(topology.from, expected_topology.from);
+  CheckSameWaypointArrays(topology.to, expected_topology.to);
+
+  std::mt19937_64 rng(23u);
+  std::uniform_real_distribution<float> coordinate(-50.0f, 300.0f);
+  for (auto i = 0u; i < 200u; ++i) {
+    const Location location(coordinate(rng), coordinate(rng), 0.0f);
+    const auto waypoint = map.GetClosestWaypointOnRoad(location);
+    const auto expected_waypoint = expected.GetClosestWaypointOnRoad(location);
+    ASSERT_EQ(waypoint.GetHandle(), expected_waypoint.GetHandle());
+    const auto transform = waypoint.ComputeTransform();
+    const auto expected_transform = expected_waypoint.ComputeTransform();
+    ASSERT_EQ(transform.location, expected_transform.location);
+    ASSERT_EQ(transform.rotation.yaw, expected_transform.rotation.yaw);
+    ASSERT_EQ(transform.rotation.pitch, expected_transform.rotation.pitch);
+    ASSERT_EQ(
+        ToHandles(WaypointGenerator::GetNext(waypoint, 30.0)),
+        ToHandles(WaypointGenerator::GetNext(expected_waypoint, 30.0)));
+  }
+}
+
+TEST(road, compiled_map) {
+  const auto grid = util::road_map::load_grid_city(6u);
+  const auto grid_blob = CompiledMap::Write(*grid);
+  const auto compiled_grid = CompiledMap::Read(grid_blob.data(), grid_blob.size());
+  ASSERT_NE(compiled_grid, nullptr);
+  CheckSameMap(*grid, *compiled_grid);
+  // Writing the loaded map again gives exactly the same blob.
+  ASSERT_EQ(CompiledMap::Write(*compiled_grid), grid_blob);
+
+  std::string error;
+  const auto map = OpenDrive::Load(COMPILED_MAP_TEST_XODR, XmlInputType::CONTENT, &error);
+  ASSERT_TRUE(error.empty()) << error;
+  ASSERT_EQ(map->GetData().GetRoadCount(), 2u);
+  ASSERT_EQ(WaypointGenerator::GenerateTopology(*map).size(), 4u);
+  const auto blob = OpenDrive::Compile(COMPILED_MAP_TEST_XODR, &error);
+  ASSERT_TRUE(error.empty()) << error;
+  ASSERT_FALSE(blob.empty());
+  const auto compiled = OpenDrive::LoadCompiled(blob, &error);
+  ASSERT_NE(compiled, nullptr) << error;
+  CheckSameMap(*map, *compiled);
+
+  util::filesystem::temporary_directory directory;
+  const auto path = directory.path("compiled_map_test.bin");
+  {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(blob.data()), static_cast<std::streamsize>(blob.size()));
+  }
+  const auto source = CompiledMap::MakeSource(COMPILED_MAP_TEST_XODR);
+  const auto mapped = OpenDrive::LoadCompiledFile(path, &error, &source);
+  ASSERT_NE(mapped, nullptr) << error;
+  CheckSameMap(*map, *mapped);
+
+  // Not compiled from this OpenDRIVE.
+  const auto other_source = CompiledMap::MakeSource(std::string(COMPILED_MAP_TEST_XODR) + " ");
+  ASSERT_EQ(OpenDrive::LoadCompiledFile(path, &error, &other_source), nullptr);
+  ASSERT_NE(error.find("different OpenDRIVE"), std::string::npos) << error;
+}
+
+/// Replace the first occurrence of the bytes of @a values in @a blob by the
+/// bytes of @a replacement.
+template <typename T>
+static void PatchBlob(
+    std::vector<unsigned char> &blob,
+    const std::vector<T> &values,
+    const std::vector<T> &replacement) {
+  const auto *bytes = reinterpret_cast<const unsigned char *>(values.data());
+  const auto size = values.size() * sizeof(T);
+  const auto it = std::search(blob.begin(), blob.end(), bytes, bytes + size);
+  ASSERT_NE(it, blob.end());
+  std::memcpy(&*it, replacement.data(), size);
+}
+
+TEST(road, compiled_map_rejects_invalid_values) {
+  std::string error;
+  const auto blob = OpenDrive::Compile(COMPILED_MAP_TEST_XODR, &error);
+  ASSERT_FALSE(blob.empty()) << error;
+  ASSERT_NE(CompiledMap::Read(blob.data(), blob.size()), nullptr);
+
+  // Lane type of the sidewalk, 2m wide lane -2, combined with another type.
+  auto blob_lane_type = blob;
+  int32_t lane_id = -2;
+  double width = 2.0;
+  std::vector<unsigned char> sidewalk(sizeof(lane_id) + sizeof(width));
+  std::memcpy(sidewalk.data(), &lane_id, sizeof(lane_id));
+  std::memcpy(sidewalk.data() + sizeof(lane_id), &width, sizeof(width));
+  auto with_type = [&](uint32_t type) {
+    auto bytes = sidewalk;
+    const auto *type_bytes = reinterpret_cast<const unsigned char *>(&type);
+    bytes.insert(bytes.end(), type_bytes, type_bytes + sizeof(type));
+    return bytes;
+  };
+  PatchBlob(
+      blob_lane_type,
+      with_type(static_cast<uint32_t>(LaneType::Sidewalk)),
+      with_type(static_cast<uint32_t>(LaneType::Sidewalk | LaneType::Driving)));
+  ASSERT_EQ(CompiledMap::Read(blob_lane_type.data(), blob_lane_type.size(), &error), nullptr);
+  ASSERT_NE(error.find("lane type"), std::string::npos) << error;
+
+  // Lane change of the broken mark, 0.15m wide with lane change "both".
+  auto blob_lane_change = blob;
+  width = 0.15;
+  std::vector<unsigned char> mark(sizeof(width) + 1u);
+  std::memcpy(mark.data(), &width, sizeof(width));
+  mark.back() = static_cast<unsigned char>(RoadInfoMarkRecord::LaneChange::Both);
+  auto invalid_mark = mark;
+  invalid_mark.back() = 0x04u;
+  PatchBlob(blob_lane_change, mark, invalid_mark);
+  ASSERT_EQ(CompiledMap::Read(blob_lane_change.data(), blob_lane_change.size(), &error), nullptr);
+  ASSERT_NE(error.find("lane change"), std::string::npos) << error;
+
+  // Lane link of lane -1 to lane -1 of road 2: lane id, number of links,
+  // next lane id, next road id.
+  auto blob_link = blob;
+  PatchBlob<int32_t>(blob_link, {-1, 1, -1, 2}, {-1, 1, -1, 42});
+  ASSERT_EQ(CompiledMap::Read(blob_link.data(), blob_link.size(), &error), nullptr);
+  ASSERT_NE(error.find("missing road"), std::string::npos) << error;
+  auto blob_lane_zero = blob;
+  PatchBlob<int32_t>(blob_lane_zero, {-1, 1, -1, 2}, {-1, 1, 0, 2});
+  ASSERT_EQ(CompiledMap::Read(blob_lane_zero.data(), blob_lane_zero.size(), &error), nullptr);
+  ASSERT_NE(error.find("lane link"), std::string::npos) << error;
+}
+
+TEST(road, compiled_map_rejects_invalid_data) {
+  const auto blob = CompiledMap::Write(*util::road_map::load_grid_city(3u));
+  std::string error;
+  ASSERT_EQ(CompiledMap::Read(nullptr, 0u, &error), nullptr);
+  ASSERT_FALSE(error.empty());
+  // Every truncation must be detected.
+  for (auto size = 0u; size < blob.size(); size += 7u) {
+    error.clear();
+    ASSERT_EQ(CompiledMap::Read(blob.data(), size, &error), nullptr);
+    ASSERT_FALSE(error.empty());
+  }
+  // Trailing garbage.
+  auto longer = blob;
+  longer.push_back(0u);
+  ASSERT_EQ(CompiledMap::Read(longer.data(), longer.size()), nullptr);
+  // Another version of the format.
+  auto other_version = blob;
+  other_version[8u] ^= 0xFFu;
+  error.clear();
+  ASSERT_EQ(CompiledMap::Read(other_version.data(), other_version.size(), &error), nullptr);
+  ASSERT_NE(error.find("version"), std::string::npos) << error;
+
+  ASSERT_EQ(OpenDrive::LoadCompiledFile("this/file/does/not/exist.bin", &error), nullptr);
+  ASSERT_FALSE(error.empty());
+}
+
@@ -9,6 +9,7 @@
 #include <carla/ThreadGroup.h>
 #include <carla/streaming/Client.h>
 #include <carla/streaming/Server.h>
+#include <carla/streaming/detail/DeserializationExecutor.h>
 #include <carla/streaming/detail/Dispatcher.h>
 #include <carla/streaming/detail/tcp/Client.h>
 #include <carla/streaming/detail/tcp/Server.h>
@@ -16,6 +17,10 @@
 #include <carla/streaming/low_level/Server.h>
 
 #include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
 
 // This is required for low level to properly stop the threads in case of
 // exception/assert.
@@ -253,3 +258,93 @@ TEST(streaming, multi_stream) {
     }
   }
 }
+
+TEST(streaming, deserialization_executor_order) {
+  using namespace carla::streaming::detail;
+  using namespace util::buffer;
+  constexpr size_t number_of_streams = 6u;
+  constexpr size_t number_of_messages = 1000u;
+
+  struct Received {
+    std::vector<size_t> messages;
+    std::set<std::thread::id> threads;
+  };
+  std::vector<Received> received(number_of_streams);
+  std::atomic_size_t count{0u};
+
+  {
+    DeserializationExecutor executor{3u};
+    std::vector<DeserializationExecutor::callback_function_type> callbacks;
+    for (auto i = 0u; i < number_of_streams; ++i) {
+      callbacks.emplace_back(executor.Wrap(i, [&received, &count, i](carla::Buffer buffer) {
+        received[i].messages.emplace_back(std::stoul(as_string(buffer)));
+        received[i].threads.insert(std::this_thread::get_id());
+        ++count;
+      }));
+    }
+    for (auto j = 0u; j < number_of_messages; ++j) {
+      for (auto &callback : callbacks) {
+        const auto message = std::to_string(j);
+        callback(carla::Buffer(boost::asio::buffer(message)));
+      }
+    }
+    for (auto i = 0u; (i < 1000u) && (count < number_of_streams * number_of_messages); ++i) {
+      std::this_thread::sleep_for(1ms);
+    }
+  }
+
+  for (auto &item : received) {
+    ASSERT_EQ(item.messages.size(), number_of_messages);
+    for (auto j = 0u; j < number_of_messages; ++j) {
+      ASSERT_EQ(item.messages[j], j);
+    }
+    ASSERT_EQ(item.threads.size(), 1u);
+  }
+}
+
+TEST(streaming, client_with_deserialization_workers) {
+  using namespace carla::streaming;
+  using namespace util::buffer;
+  constexpr size_t number_of_streams = 4u;
+  constexpr size_t number_of_messages = 100u;
+
+  Server srv(TESTING_PORT);
+  srv.AsyncRun(number_of_streams);
+  std::vector<Stream> streams;
+  for (auto i = 0u; i < number_of_streams; ++i) {
+    streams.emplace_back(srv.MakeStream());
+  }
+
+  std::mutex mutex;
+  std::vector<std::vector<size_t>> received(number_of_streams);
+  std::set<std::thread::id> callback_threads;
+  {
+    Client c;
+    c.SetDeserializationWorkerThreads(2u);
+    c.AsyncRun(2u);
+    for (auto i = 0u; i < number_of_streams; ++i) {
+      c.Subscribe(streams[i].token(), [&, i](auto buffer) {
+        std::lock_guard<std::mutex> lock(mutex);
+        received[i].emplace_back(std::stoul(as_string(buffer)));
+        callback_threads.insert(std::this_thread::get_id());
+      });
+    }
+
+    std::this_thread::sleep_for(20ms);
+    for (auto j = 0u; j < number_of_messages; ++j) {
+      std::this_thread::sleep_for(1ms);
+      for (auto &stream : streams) {
+        stream << std::to_string(j);
+      }
+    }
+    std::this_thread::sleep_for(20ms);
+  } // client dies here.
+
+  ASSERT_LE(callback_threads.size(), 2u);
+  for (auto &messages : received) {
+    ASSERT_GE(messages.size(), number_of_messages - 3u);
+    for (auto j = 1u; j < messages.size(); ++j) {
+      ASSERT_LT(messages[j - 1u], messages[j]);
+    }
+  }
+}
@@ -0,0 +1,100 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+#include "GeomUtil.h"
+
+#include <carla/StopWatch.h>
+#include <carla/geom/BatchMath.h>
+#include <carla/geom/BoundingBox.h>
+#include <carla/geom/GeoLocation.h>
+#include <carla/geom/Location.h>
+#include <carla/geom/Transform.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace carla::geom;
+
+TEST(benchmark_geom, geo_location_transform) {
+  constexpr size_t number_of_locations = 100000u;
+  const auto locations = util::geom::make_random_locations(number_of_locations, 5000.0f);
+  const GeoLocation reference{41.3851, 2.1734, 12.0};
+  std::vector<GeoLocation> geo_locations(number_of_locations);
+  std::vector<Location> result(number_of_locations);
+
+  carla::StopWatch scalar;
+  for (auto i = 0u; i < number_of_locations; ++i) {
+    geo_locations[i] = reference.Transform(locations[i]);
+  }
+  for (auto i = 0u; i < number_of_locations; ++i) {
+    result[i] = reference.InverseTransform(geo_locations[i]);
+  }
+  scalar.Stop();
+
+  carla::StopWatch batch;
+  reference.Transform(locations.data(), number_of_locations, geo_locations.data());
+  reference.InverseTransform(geo_locations.data(), number_of_locations, result.data());
+  batch.Stop();
+
+  carla::logging::log(
+      "Benchmark:", number_of_locations, "locations to GeoLocation and back:",
+      "scalar =", scalar.GetElapsedTime<std::chrono::microseconds>(), "us,",
+      "batch =", batch.GetElapsedTime<std::chrono::microseconds>(), "us");
+}
+
+TEST(benchmark_geom, batch_math) {
+  constexpr size_t number_of_actors = 2000u;
+  const auto transforms = util::geom::make_random_transforms(number_of_actors, 200.0f);
+  const std::vector<BoundingBox> boxes(
+      number_of_actors,
+      BoundingBox{Location(0.0f, 0.0f, 0.7f), Vector3D(2.3f, 1.0f, 0.7f)});
+  const Transform camera{Location(-5.5f, 0.0f, 2.8f), Rotation(-15.0f, 0.0f, 0.0f)};
+
+  // Every vertex of every actor into the camera space.
+  PointArrays scalar_vertices(8u * number_of_actors);
+  carla::StopWatch scalar;
+  for (auto i = 0u; i < number_of_actors; ++i) {
+    const auto vertices = boxes[i].GetWorldVertices(transforms[i]);
+    for (auto k = 0u; k < vertices.size(); ++k) {
+      Vector3D vertex = vertices[k];
+      camera.InverseTransformPoint(vertex);
+      scalar_vertices.x[8u * i + k] = vertex.x;
+      scalar_vertices.y[8u * i + k] = vertex.y;
+      scalar_vertices.z[8u * i + k] = vertex.z;
+    }
+  }
+  scalar.Stop();
+
+  PointArrays vertices;
+  carla::StopWatch batch;
+  BatchMath::GetWorldVertices(boxes, transforms, vertices);
+  BatchMath::InverseTransformPoints(camera, vertices, vertices);
+  batch.Stop();
+
+  ASSERT_EQ(vertices.size(), scalar_vertices.size());
+  carla::logging::log(
+      "Benchmark:", number_of_actors, "bounding boxes into camera space:",
+      "scalar =", scalar.GetElapsedTime<std::chrono::microseconds>(), "us,",
+      "batch =", batch.GetElapsedTime<std::chrono::microseconds>(), "us");
+
+  // Every point of a lidar sweep against every box.
+  const auto points = util::geom::make_point_arrays(util::geom::make_random_locations(100000u, 100.0f));
+  std::vector<uint8_t> inside;
+  size_t number_inside = 0u;
+  carla::StopWatch contains;
+  for (auto i = 0u; i < 20u; ++i) {
+    BatchMath::Contains(boxes[i], transforms[i], points, inside);
+    for (auto value : inside) {
+      number_inside += value;
+    }
+  }
+  contains.Stop();
+  carla::logging::log(
+      "Benchmark:", points.size(), "points against 20 bounding boxes:",
+      contains.GetElapsedTime<std::chrono::microseconds>(), "us,",
+      number_inside, "inside");
+}
@@ -0,0 +1,213 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+#include "OpenDriveGenerator.h"
+
+#include <carla/StopWatch.h>
+#include <carla/opendrive/OpenDrive.h>
+#include <carla/opendrive/parser/NumberParser.h>
+#include <carla/opendrive/parser/OpenDriveParser.h>
+#include <carla/road/WaypointGenerator.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#  include <malloc.h>
+#  include <unistd.h>
+#endif
+
+using namespace carla::opendrive;
+using namespace carla::road;
+using namespace carla::road::element;
+using carla::opendrive::parser::ParseDouble;
+
+/// Log a benchmark result as a single line of JSON.
+static void LogBenchmark(
+    const std::string &map_name,
+    size_t number_of_roads,
+    const char *operation,
+    size_t count,
+    const carla::StopWatch &stop_watch) {
+  const auto total = stop_watch.GetElapsedTime<std::chrono::microseconds>();
+  std::ostringstream json;
+  json << "{\"map\": \"" << map_name << "\", \"roads\": " << number_of_roads
+       << ", \"operation\": \"" << operation << "\", \"count\": " << count
+       << ", \"total_us\": " << total
+       << ", \"us_per_operation\": " << static_cast<double>(total) / std::max<size_t>(count, 1u) << "}";
+  carla::logging::log("Benchmark:", json.str());
+}
+
+static void BenchmarkMap(const std::string &map_name, const std::string &xodr) {
+  constexpr size_t number_of_queries = 2000u;
+
+  carla::StopWatch load;
+  const auto map = OpenDrive::Load(xodr, XmlInputType::CONTENT);
+  load.Stop();
+  ASSERT_NE(map, nullptr);
+  const auto number_of_roads = map->GetData().GetRoadCount();
+  LogBenchmark(map_name, number_of_roads, "OpenDrive::Load", 1u, load);
+
+  carla::StopWatch generate_all;
+  const auto waypoints = WaypointGenerator::GenerateAll(*map, 2.0);
+  generate_all.Stop();
+  ASSERT_FALSE(waypoints.empty());
+  LogBenchmark(map_name, number_of_roads, "GenerateAll(2m)", waypoints.size(), generate_all);
+
+  carla::StopWatch generate_topology;
+  const auto topology = WaypointGenerator::GenerateTopology(*map);
+  generate_topology.Stop();
+  LogBenchmark(map_name, number_of_roads, "GenerateTopology", topology.size(), generate_topology);
+
+  std::mt19937_64 rng(11u);
+  std::uniform_int_distribution<size_t> random_index(0u, waypoints.size() - 1u);
+  std::vector<carla::geom::Location> locations;
+  std::vector<Waypoint> origins;
+  for (auto i = 0u; i < number_of_queries; ++i) {
+    const auto &waypoint = waypoints[random_index(rng)];
+    locations.emplace_back(waypoint.ComputeTransform().location + carla::geom::Location(0.5f, 0.5f, 0.0f));
+    origins.emplace_back(waypoint);
+  }
+
+  size_t found = 0u;
+  carla::StopWatch get_waypoint;
+  for (auto &&location : locations) {
+    found += map->GetWaypoint(location).has_value() ? 1u : 0u;
+  }
+  get_waypoint.Stop();
+  ASSERT_GT(found, 0u);
+  LogBenchmark(map_name, number_of_roads, "GetWaypoint", locations.size(), get_waypoint);
+
+  size_t next = 0u;
+  carla::StopWatch get_next;
+  for (auto &&origin : origins) {
+    next += WaypointGenerator::GetNext(origin, 50.0).size();
+  }
+  get_next.Stop();
+  ASSERT_GT(next, 0u);
+  LogBenchmark(map_name, number_of_roads, "GetNext(50m)", origins.size(), get_next);
+}
+
+TEST(benchmark_opendrive, generated_maps) {
+  util::opendrive::grid_city_options grid;
+  grid.rows = 12u;
+  grid.columns = 12u;
+  BenchmarkMap("grid_city_12x12", util::opendrive::make_grid_city(grid));
+
+  util::opendrive::highway_options highway;
+  highway.number_of_roads = 1000u;
+  BenchmarkMap("highway_1000", util::opendrive::make_highway(highway));
+}
+
+/// Resident memory of this process [bytes], 0 if unknown.
+static size_t GetResidentMemory() {
+#ifdef __linux__
+  std::ifstream statm("/proc/self/statm");
+  size_t total = 0u;
+  size_t resident = 0u;
+  statm >> total >> resident;
+  return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+  return 0u;
+#endif // __linux__
+}
+
+/// Bytes of heap memory in use by this process, 0 if unknown.
+static size_t GetHeapMemoryInUse() {
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 33))
+  return mallinfo2().uordblks;
+#else
+  return 0u;
+#endif
+}
+
+TEST(benchmark_opendrive, generated_map_memory) {
+  util::opendrive::grid_city_options options;
+  options.rows = 24u;
+  options.columns = 24u;
+  const auto xodr = util::opendrive::make_grid_city(options);
+
+  const auto resident_before = GetResidentMemory();
+  const auto heap_before = GetHeapMemoryInUse();
+  carla::StopWatch load;
+  auto map = OpenDrive::Load(xodr, XmlInputType::CONTENT);
+  load.Stop();
+  ASSERT_NE(map, nullptr);
+  const auto resident_after = GetResidentMemory();
+  const auto heap_after = GetHeapMemoryInUse();
+  const auto number_of_roads = map->GetData().GetRoadCount();
+  const auto arena_size = map->GetData().GetArenaSize();
+
+  carla::StopWatch destroy;
+  map.reset();
+  destroy.Stop();
+
+  std::ostringstream json;
+  json << "{\"map\": \"grid_city_24x24\", \"roads\": " << number_of_roads
+       << ", \"load_us\": " << load.GetElapsedTime<std::chrono::microseconds>()
+       << ", \"destroy_us\": " << destroy.GetElapsedTime<std::chrono::microseconds>()
+       << ", \"resident_kb\": " << (resident_after - std::min(resident_before, resident_after)) / 1024u
+       << ", \"heap_kb\": " << (heap_after - std::min(heap_before, heap_after)) / 1024u
+       << ", \"arena_kb\": " << arena_size / 1024u << "}";
+  carla::logging::log("Benchmark:", json.str());
+}
+
+TEST(benchmark_opendrive, parse) {
+  util::opendrive::highway_options options;
+  options.number_of_roads = 5000u;
+  const auto xodr = util::opendrive::make_highway(options);
+
+  carla::StopWatch single_thread;
+  types::OpenDriveData single_thread_data;
+  ASSERT_TRUE(OpenDriveParser::Parse(xodr.c_str(), single_thread_data, XmlInputType::CONTENT, nullptr, 1u));
+  single_thread.Stop();
+
+  carla::StopWatch multi_thread;
+  types::OpenDriveData multi_thread_data;
+  ASSERT_TRUE(OpenDriveParser::Parse(xodr.c_str(), multi_thread_data, XmlInputType::CONTENT));
+  multi_thread.Stop();
+
+  ASSERT_EQ(multi_thread_data.roads.size(), single_thread_data.roads.size());
+  carla::logging::log(
+      "Benchmark: parse", xodr.size() / 1024u, "KiB OpenDRIVE with", single_thread_data.roads.size(), "roads:",
+      "1 thread =", single_thread.GetElapsedTime(), "ms,",
+      std::thread::hardware_concurrency(), "threads =", multi_thread.GetElapsedTime(), "ms");
+
+  // Numbers as exported by most editors, and with all their digits.
+  for (auto precision : {9, 17}) {
+    std::vector<std::string> numbers;
+    std::mt19937_64 rng(3u);
+    std::uniform_real_distribution<double> random(-1000.0, 1000.0);
+    for (auto i = 0u; i < 200000u; ++i) {
+      std::ostringstream out;
+      out << std::setprecision(precision) << random(rng);
+      numbers.emplace_back(out.str());
+    }
+    double checksum_stod = 0.0;
+    carla::StopWatch stod;
+    for (auto &&number : numbers) {
+      checksum_stod += std::stod(number);
+    }
+    stod.Stop();
+    double checksum_fast = 0.0;
+    carla::StopWatch fast;
+    for (auto &&number : numbers) {
+      checksum_fast += ParseDouble(number.c_str());
+    }
+    fast.Stop();
+    ASSERT_EQ(checksum_stod, checksum_fast);
+    carla::logging::log(
+        "Benchmark:", numbers.size(), "numbers with", precision, "digits:",
+        "std::stod =", stod.GetElapsedTime<std::chrono::microseconds>(), "us,",
+        "ParseDouble =", fast.GetElapsedTime<std::chrono::microseconds>(), "us");
+  }
+}
@@ -0,0 +1,93 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/RecurrentSharedFuture.h>
+#include <carla/ThreadGroup.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+static void BenchmarkWakeupLatency(const size_t number_of_threads) {
+  using namespace carla;
+  using clock = std::chrono::steady_clock;
+  using nanoseconds = std::chrono::nanoseconds;
+  ThreadGroup threads;
+  RecurrentSharedFuture<int64_t> future;
+
+  constexpr size_t number_of_ticks = 200u;
+
+  auto now = []() -> int64_t {
+    return std::chrono::duration_cast<nanoseconds>(clock::now().time_since_epoch()).count();
+  };
+
+  std::mutex mutex;
+  std::vector<int64_t> latencies;
+  latencies.reserve(number_of_threads * number_of_ticks);
+  // A negative value tells the waiters to stop.
+  constexpr int64_t stop = -1;
+  std::atomic_size_t running{number_of_threads};
+
+  threads.CreateThreads(number_of_threads, [&]() {
+    std::vector<int64_t> thread_latencies;
+    thread_latencies.reserve(number_of_ticks);
+    for (;;) {
+      auto result = future.WaitFor(1s);
+      EXPECT_TRUE(result.has_value());
+      if (!result.has_value() || (*result == stop)) {
+        break;
+      }
+      thread_latencies.emplace_back(now() - *result);
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      latencies.insert(latencies.end(), thread_latencies.begin(), thread_latencies.end());
+    }
+    --running;
+  });
+
+  std::this_thread::sleep_for(20ms);
+  for (auto i = 0u; i < number_of_ticks; ++i) {
+    future.SetValue(now());
+    std::this_thread::sleep_for(1ms);
+  }
+  // A waiter may miss a value while it records the previous one, keep
+  // publishing the stop value until every waiter has seen it.
+  while (running > 0u) {
+    future.SetValue(stop);
+    std::this_thread::sleep_for(1ms);
+  }
+  threads.JoinAll();
+
+  ASSERT_FALSE(latencies.empty());
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&](double p) {
+    auto index = static_cast<size_t>(p * static_cast<double>(latencies.size() - 1u));
+    return static_cast<double>(latencies[index]) * 1e-3;
+  };
+  carla::logging::log(
+      "Benchmark:", number_of_threads, "waiters,",
+      latencies.size(), "wakeups, tick-to-wakeup latency (us):",
+      "p50 =", percentile(0.50),
+      "p90 =", percentile(0.90),
+      "p99 =", percentile(0.99),
+      "max =", percentile(1.0));
+}
+
+TEST(benchmark_recurrent_shared_future, wakeup_latency_1_waiter) {
+  BenchmarkWakeupLatency(1u);
+}
+
+TEST(benchmark_recurrent_shared_future, wakeup_latency_16_waiters) {
+  BenchmarkWakeupLatency(16u);
+}
+
+TEST(benchmark_recurrent_shared_future, wakeup_latency_128_waiters) {
+  BenchmarkWakeupLatency(128u);
+}
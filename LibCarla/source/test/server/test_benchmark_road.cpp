@@ -0,0 +1,336 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+#include "OpenDriveGenerator.h"
+#include "RoadMapUtil.h"
+
+#include <carla/StopWatch.h>
+#include <carla/opendrive/OpenDrive.h>
+#include <carla/road/Map.h>
+#include <carla/road/CompiledMap.h>
+#include <carla/road/MapBuilder.h>
+#include <carla/road/RoutePlanner.h>
+#include <carla/road/WaypointGenerator.h>
+#include <carla/road/element/Geometry.h>
+#include <carla/road/element/RoadInfoVisitor.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace carla::opendrive;
+using namespace carla::road;
+using namespace carla::road::element;
+using carla::geom::Location;
+
+TEST(benchmark_road, spatial_index) {
+  constexpr size_t size = 50u;
+  constexpr size_t number_of_queries = 1000u;
+  constexpr size_t count = 10u;
+  auto map = util::road_map::make_synthetic_map(size);
+  std::mt19937_64 rng(7u);
+  std::uniform_real_distribution<float> coordinate(0.0f, size * 100.0f);
+  std::vector<Location> locations;
+  for (auto i = 0u; i < number_of_queries; ++i) {
+    locations.emplace_back(coordinate(rng), coordinate(rng), 0.0f);
+  }
+
+  double checksum_brute_force = 0.0;
+  carla::StopWatch brute_force;
+  for (auto &&location : locations) {
+    checksum_brute_force += util::road_map::get_nearest_roads_brute_force(*map, location, count).front().second;
+  }
+  brute_force.Stop();
+
+  double checksum_index = 0.0;
+  carla::StopWatch indexed;
+  for (auto &&location : locations) {
+    checksum_index += map->GetSpatialIndex().GetNearestRoads(location, count).front().distance;
+  }
+  indexed.Stop();
+
+  ASSERT_EQ(checksum_index, checksum_brute_force);
+  carla::logging::log(
+      "Benchmark:", map->GetData().GetRoadCount(), "roads,",
+      number_of_queries, "nearest road queries:",
+      "brute force =", brute_force.GetElapsedTime<std::chrono::microseconds>() / number_of_queries, "us/query,",
+      "spatial index =", indexed.GetElapsedTime<std::chrono::microseconds>() / number_of_queries, "us/query");
+}
+
+TEST(benchmark_road, geom_tessellation) {
+  constexpr size_t number_of_queries = 100000u;
+  const GeometryArc arc(0.0, 60.0, 1.2, Location(-30.0f, 5.0f, 0.0f), 0.04);
+  const GeometrySpiral spiral(0.0, 80.0, 0.5, Location(-5.0f, 5.0f, 0.0f), 0.0, 0.03);
+  std::mt19937_64 rng(7u);
+  std::uniform_real_distribution<float> coordinate(-50.0f, 50.0f);
+  std::vector<Location> locations;
+  for (auto i = 0u; i < number_of_queries; ++i) {
+    locations.emplace_back(coordinate(rng), coordinate(rng), 0.0f);
+  }
+
+  double checksum = 0.0;
+  carla::StopWatch arc_distance;
+  for (auto &&p : locations) {
+    checksum += arc.DistanceTo(p).second;
+  }
+  arc_distance.Stop();
+  carla::StopWatch spiral_distance;
+  for (auto &&p : locations) {
+    checksum += spiral.DistanceTo(p).second;
+  }
+  spiral_distance.Stop();
+  carla::StopWatch spiral_position;
+  for (auto i = 1u; i <= number_of_queries; ++i) {
+    checksum += spiral.PosFromDist(spiral.GetLength() * i / number_of_queries).location.x;
+  }
+  spiral_position.Stop();
+
+  ASSERT_TRUE(std::isfinite(checksum));
+  auto ns = [&](const carla::StopWatch &watch) {
+    return watch.GetElapsedTime<std::chrono::nanoseconds>() / number_of_queries;
+  };
+  carla::logging::log(
+      "Benchmark:", number_of_queries, "queries:",
+      "arc nearest point =", ns(arc_distance), "ns/query,",
+      "spiral nearest point =", ns(spiral_distance), "ns/query,",
+      "spiral position =", ns(spiral_position), "ns/query");
+}
+
+TEST(benchmark_road, road_segment_lookup) {
+  constexpr size_t number_of_geometries = 200u;
+  constexpr size_t number_of_infos = 200u;
+  constexpr size_t number_of_queries = 100000u;
+  constexpr double geometry_length = 5.0;
+
+  MapBuilder builder;
+  RoadSegmentDefinition def(0);
+  for (auto i = 0u; i < number_of_geometries; ++i) {
+    def.MakeGeometry<GeometryLine>(i * geometry_length, geometry_length, 0.0, Location(i * geometry_length, 0.0f, 0.0f));
+  }
+  const double length = number_of_geometries * geometry_length;
+  for (auto i = 0u; i < number_of_infos; ++i) {
+    const double d = length * i / number_of_infos;
+    def.MakeInfo<RoadInfoVelocity>(d, 10.0);
+    def.MakeInfo<RoadInfoLaneWidth>(d, -1, 3.5, 0.0, 0.0, 0.0);
+    def.MakeInfo<RoadInfoMarkRecord>(d, -1);
+  }
+  def.MakeInfo<RoadInfoLane>();
+  builder.AddRoadSegmentDefinition(def);
+  auto map_ptr = builder.Build();
+  const auto &road = *map_ptr->GetData().GetRoad(0);
+
+  double checksum = 0.0;
+  carla::StopWatch directed_point;
+  for (auto i = 0u; i < number_of_queries; ++i) {
+    checksum += road.GetDirectedPointIn(length * i / number_of_queries).location.x;
+  }
+  directed_point.Stop();
+  carla::StopWatch lane_info;
+  for (auto i = 0u; i < number_of_queries; ++i) {
+    checksum += road.GetInfo<RoadInfoLane>(length * i / number_of_queries)->d;
+  }
+  lane_info.Stop();
+  carla::StopWatch velocity_info;
+  for (auto i = 0u; i < number_of_queries; ++i) {
+    checksum += road.GetInfo<RoadInfoVelocity>(length * i / number_of_queries)->velocity;
+  }
+  velocity_info.Stop();
+
+  ASSERT_TRUE(std::isfinite(checksum));
+  auto ns = [&](const carla::StopWatch &watch) {
+    return watch.GetElapsedTime<std::chrono::nanoseconds>() / number_of_queries;
+  };
+  carla::logging::log(
+      "Benchmark:", number_of_geometries, "geometries,", 3u * number_of_infos + 1u, "infos:",
+      "GetDirectedPointIn =", ns(directed_point), "ns,",
+      "GetInfo<RoadInfoLane> =", ns(lane_info), "ns,",
+      "GetInfo<RoadInfoVelocity> =", ns(velocity_info), "ns");
+}
+
+TEST(benchmark_road, generate_waypoints) {
+  constexpr double distance = 1.0;
+  auto map = util::road_map::load_grid_city(20u);
+
+  carla::StopWatch waypoints;
+  std::vector<std::shared_ptr<Waypoint>> result;
+  for (auto &&waypoint : WaypointGenerator::GenerateAll(*map, distance)) {
+    // The client wraps each waypoint in a heap allocated object.
+    result.emplace_back(std::make_shared<Waypoint>(waypoint));
+    result.back()->ComputeTransform();
+  }
+  waypoints.Stop();
+
+  carla::StopWatch single_thread;
+  const auto arrays = WaypointGenerator::GenerateAllArrays(*map, distance, static_cast<LaneTypeMask>(LaneType::Driving), 1u);
+  single_thread.Stop();
+
+  carla::StopWatch multi_thread;
+  const auto parallel_arrays = WaypointGenerator::GenerateAllArrays(*map, distance);
+  multi_thread.Stop();
+
+  ASSERT_EQ(arrays.size(), result.size());
+  ASSERT_EQ(parallel_arrays.s, arrays.s);
+  carla::logging::log(
+      "Benchmark:", result.size(), "waypoints:",
+      "waypoint objects =", waypoints.GetElapsedTime(), "ms,",
+      "arrays =", single_thread.GetElapsedTime(), "ms,",
+      "arrays with", std::thread::hardware_concurrency(), "threads =", multi_thread.GetElapsedTime(), "ms");
+}
+
+TEST(benchmark_road, route_planner) {
+  constexpr size_t number_of_queries = 200u;
+  auto map = util::road_map::load_grid_city(20u);
+  const auto origins = util::road_map::make_random_waypoints(*map, number_of_queries, 3u);
+  const auto destinations = util::road_map::make_random_waypoints(*map, number_of_queries, 4u);
+
+  RoutePlanner planner(map);
+  double length_a_star = 0.0;
+  carla::StopWatch a_star;
+  for (auto i = 0u; i < number_of_queries; ++i) {
+    length_a_star += planner.ComputeRoute(origins[i], destinations[i]).length;
+  }
+  a_star.Stop();
+
+  carla::StopWatch preprocessing;
+  planner.BuildContractionHierarchy();
+  preprocessing.Stop();
+
+  double length_hierarchy = 0.0;
+  carla::StopWatch hierarchy;
+  for (auto i = 0u; i < number_of_queries; ++i) {
+    length_hierarchy += planner.ComputeRoute(origins[i], destinations[i]).length;
+  }
+  hierarchy.Stop();
+
+  ASSERT_NEAR(length_a_star, length_hierarchy, 1e-3);
+  carla::logging::log(
+      "Benchmark:", planner.GetNumberOfNodes(), "lanes,", number_of_queries, "route queries:",
+      "A* =", a_star.GetElapsedTime<std::chrono::microseconds>() / number_of_queries, "us/query,",
+      "contraction hierarchy =", hierarchy.GetElapsedTime<std::chrono::microseconds>() / number_of_queries, "us/query",
+      "(preprocessing", preprocessing.GetElapsedTime(), "ms)");
+}
+
+TEST(benchmark_road, waypoint_get_next) {
+  constexpr size_t number_of_waypoints = 2000u;
+  auto map = util::road_map::load_grid_city(20u);
+  std::vector<Waypoint> waypoints;
+  for (auto &&handle : util::road_map::make_random_waypoints(*map, number_of_waypoints, 6u)) {
+    waypoints.emplace_back(map->MakeWaypoint(handle));
+  }
+  // Short steps, as local planners do every tick, and long ones crossing
+  // several junctions.
+  for (auto distance : {2.0, 250.0}) {
+    size_t count_recursive = 0u;
+    carla::StopWatch recursive;
+    for (auto &&waypoint : waypoints) {
+      count_recursive += util::road_map::get_next_recursive(map, waypoint, distance).size();
+    }
+    recursive.Stop();
+
+    size_t count_iterative = 0u;
+    carla::StopWatch iterative;
+    for (auto &&waypoint : waypoints) {
+      count_iterative += WaypointGenerator::GetNext(waypoint, distance).size();
+    }
+    iterative.Stop();
+
+    size_t count_handles = 0u;
+    std::vector<WaypointHandle> buffer;
+    carla::StopWatch handles;
+    for (auto &&waypoint : waypoints) {
+      buffer.clear();
+      WaypointGenerator::GetNext(*map, waypoint.GetHandle(), distance, buffer);
+      count_handles += buffer.size();
+    }
+    handles.Stop();
+
+    ASSERT_EQ(count_recursive, count_iterative);
+    ASSERT_EQ(count_recursive, count_handles);
+    carla::logging::log(
+        "Benchmark:", number_of_waypoints, "x GetNext(", distance, "m ) ->", count_recursive, "waypoints:",
+        "recursive =", recursive.GetElapsedTime<std::chrono::microseconds>(), "us,",
+        "iterative =", iterative.GetElapsedTime<std::chrono::microseconds>(), "us,",
+        "handles into a reused buffer =", handles.GetElapsedTime<std::chrono::microseconds>(), "us");
+  }
+}
+
+TEST(benchmark_road, compiled_map) {
+  constexpr size_t repetitions = 20u;
+  const auto xodr = util::opendrive::make_grid_city(util::opendrive::grid_city_options{});
+  const auto number_of_roads = util::opendrive::load_map(xodr)->GetData().GetRoadCount();
+  size_t checksum = 0u;
+
+  carla::StopWatch xml;
+  for (auto i = 0u; i < repetitions; ++i) {
+    checksum += OpenDrive::Load(xodr, XmlInputType::CONTENT)->GetData().GetRoadCount();
+  }
+  xml.Stop();
+
+  const auto blob = OpenDrive::Compile(xodr);
+  carla::StopWatch compiled;
+  for (auto i = 0u; i < repetitions; ++i) {
+    checksum += OpenDrive::LoadCompiled(blob)->GetData().GetRoadCount();
+  }
+  compiled.Stop();
+
+  const auto grid = util::road_map::load_grid_city(30u);
+  const auto grid_blob = CompiledMap::Write(*grid);
+  carla::StopWatch compiled_grid;
+  checksum += CompiledMap::Read(grid_blob.data(), grid_blob.size())->GetData().GetRoadCount();
+  compiled_grid.Stop();
+
+  ASSERT_EQ(checksum, 2u * repetitions * number_of_roads + grid->GetData().GetRoadCount());
+  carla::logging::log(
+      "Benchmark:", repetitions, "loads of a", number_of_roads, "roads,", xodr.size(), "bytes OpenDRIVE:",
+      "xml =", xml.GetElapsedTime<std::chrono::microseconds>() / repetitions, "us/load,",
+      "compiled (", blob.size(), "bytes ) =", compiled.GetElapsedTime<std::chrono::microseconds>() / repetitions, "us/load;",
+      grid->GetData().GetRoadCount(), "roads compiled map (", grid_blob.size(), "bytes ) =",
+      compiled_grid.GetElapsedTime(), "ms");
+}
+
+TEST(benchmark_road, track_waypoint) {
+  auto map = util::road_map::load_grid_city(20u);
+  // A vehicle at 50 km/h ticking at 20 FPS moves about 0.7 meters per tick.
+  const auto trajectories = util::road_map::make_trajectories(*map, util::road_map::make_random_waypoints(*map, 200u, 9u), 100u, 0.7, 0.5f);
+  std::vector<Location> locations;
+  for (auto &&trajectory : trajectories) {
+    locations.insert(locations.end(), trajectory.begin(), trajectory.end());
+  }
+
+  carla::StopWatch global;
+  std::vector<Waypoint> expected;
+  for (auto &&location : locations) {
+    expected.emplace_back(map->GetClosestWaypointOnRoad(location));
+  }
+  global.Stop();
+
+  carla::StopWatch tracked;
+  std::vector<Waypoint> result;
+  for (auto &&trajectory : trajectories) {
+    auto waypoint = map->GetClosestWaypointOnRoad(trajectory.front());
+    for (auto &&location : trajectory) {
+      waypoint = map->TrackWaypoint(waypoint, location);
+      result.emplace_back(waypoint);
+    }
+  }
+  tracked.Stop();
+
+  // Correctness is checked by road.track_waypoint, inside the junctions the
+  // tracked lane may differ from the global search.
+  ASSERT_EQ(result.size(), locations.size());
+  size_t same = 0u;
+  for (auto i = 0u; i < locations.size(); ++i) {
+    same += (result[i].GetHandle() == expected[i].GetHandle()) ? 1u : 0u;
+  }
+  carla::logging::log(
+      "Benchmark:", locations.size(), "waypoints along", trajectories.size(), "trajectories:",
+      "global search =", global.GetElapsedTime<std::chrono::microseconds>(), "us,",
+      "tracked =", tracked.GetElapsedTime<std::chrono::microseconds>(), "us",
+      "(", same, "equal to the global search)");
+}
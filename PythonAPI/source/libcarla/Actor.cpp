@@ -89,6 +89,9 @@ void export_actor() {
     .def("get_control", &cc::Vehicle::GetControl)
     .def("apply_physics_control", &cc::Vehicle::ApplyPhysicsControl, (arg("physics_control")))
     .def("get_physics_control", CONST_CALL_WITHOUT_GIL(cc::Vehicle, GetPhysicsControl))
+    .def("get_physics_control_async", +[](const cc::Vehicle &self) {
+      return PythonFuture(self.AsyncGetPhysicsControl());
+    })
     .def("set_autopilot", &cc::Vehicle::SetAutopilot, (arg("enabled") = true))
     .def("get_speed_limit", &cc::Vehicle::GetSpeedLimit)
     .def("get_traffic_light_state", &cc::Vehicle::GetTrafficLightState)
@@ -135,6 +138,9 @@ void export_actor() {
     .def("is_frozen", &cc::TrafficLight::IsFrozen)
     .def("get_pole_index", &cc::TrafficLight::GetPoleIndex)
     .def("get_group_traffic_lights", &GetGroupTrafficLights)
+    .def("get_group_traffic_lights_async", +[](cc::TrafficLight &self) {
+      return MakeListFuture(self.AsyncGetGroupTrafficLights());
+    })
     .def(self_ns::str(self_ns::self))
   ;
 }
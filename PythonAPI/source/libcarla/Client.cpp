@@ -34,6 +34,37 @@ static void ApplyBatchCommands(
   self.ApplyBatch(std::move(result), do_tick);
 }
 
+static auto ApplyBatchCommandsSync(
+    const carla::client::Client &self,
+    const boost::python::object &commands,
+    bool do_tick) {
+  using CommandType = carla::rpc::Command;
+  std::vector<CommandType> cmds{
+      boost::python::stl_input_iterator<CommandType>(commands),
+      boost::python::stl_input_iterator<CommandType>()};
+  std::vector<carla::rpc::CommandResponse> responses;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    responses = self.ApplyBatchSync(std::move(cmds), do_tick);
+  }
+  boost::python::list result;
+  for (auto &response : responses) {
+    result.append(std::move(response));
+  }
+  return result;
+}
+
+static auto ApplyBatchAndTick(
+    const carla::client::Client &self,
+    const boost::python::object &commands) {
+  using CommandType = carla::rpc::Command;
+  std::vector<CommandType> result{
+      boost::python::stl_input_iterator<CommandType>(commands),
+      boost::python::stl_input_iterator<CommandType>()};
+  carla::PythonUtil::ReleaseGIL unlock;
+  return self.ApplyBatchAndTick(std::move(result));
+}
+
 void export_client() {
   using namespace boost::python;
   namespace cc = carla::client;
@@ -41,6 +72,7 @@ void export_client() {
   class_<cc::Client>("Client",
       init<std::string, uint16_t, size_t>((arg("host"), arg("port"), arg("worker_threads")=0u)))
     .def("set_timeout", &::SetTimeout, (arg("seconds")))
+    .def("set_deserialization_worker_threads", &cc::Client::SetDeserializationWorkerThreads, (arg("worker_threads")))
     .def("get_client_version", &cc::Client::GetClientVersion)
     .def("get_server_version", CONST_CALL_WITHOUT_GIL(cc::Client, GetServerVersion))
     .def("get_world", &cc::Client::GetWorld)
@@ -54,5 +86,7 @@ void export_client() {
     .def("show_recorder_actors_blocked", CALL_WITHOUT_GIL_3(cc::Client, ShowRecorderActorsBlocked, std::string, float, float), (arg("name"), arg("min_time"), arg("min_distance")))
     .def("replay_file", CALL_WITHOUT_GIL_4(cc::Client, ReplayFile, std::string, float, float, int), (arg("name"), arg("time_start"), arg("duration"), arg("follow_id")))
     .def("apply_batch", &ApplyBatchCommands, (arg("commands"), arg("do_tick")=false))
+    .def("apply_batch_sync", &ApplyBatchCommandsSync, (arg("commands"), arg("do_tick")=false))
+    .def("apply_batch_and_tick", &ApplyBatchAndTick, (arg("commands")))
   ;
 }
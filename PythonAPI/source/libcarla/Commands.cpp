@@ -5,7 +5,24 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include <carla/PythonUtil.h>
+#include <carla/client/ActorBlueprint.h>
 #include <carla/rpc/Command.h>
+#include <carla/rpc/CommandResponse.h>
+
+static auto MakeSpawnActor(
+    const carla::client::ActorBlueprint &blueprint,
+    const carla::geom::Transform &transform) {
+  using Command = carla::rpc::Command::SpawnActor;
+  return boost::shared_ptr<Command>(new Command{blueprint.MakeActorDescription(), transform});
+}
+
+static auto MakeSpawnActorWithParent(
+    const carla::client::ActorBlueprint &blueprint,
+    const carla::geom::Transform &transform,
+    carla::rpc::ActorId parent) {
+  using Command = carla::rpc::Command::SpawnActor;
+  return boost::shared_ptr<Command>(new Command{blueprint.MakeActorDescription(), transform, parent});
+}
 
 void export_commands() {
   using namespace boost::python;
@@ -16,6 +33,29 @@ void export_commands() {
   scope().attr("command") = command_module;
   scope io_scope = command_module;
 
+  io_scope.attr("FutureActor") = cr::FutureActor;
+
+  class_<cr::CommandResponse>("Response", no_init)
+    .add_property("actor_id", +[](const cr::CommandResponse &self) {
+      return self.HasError() ? cr::ActorId(0u) : self.Get();
+    })
+    .add_property("error", +[](const cr::CommandResponse &self) {
+      return self.HasError() ? self.GetError().What() : std::string();
+    })
+    .def("has_error", &cr::CommandResponse::HasError)
+  ;
+
+  class_<cr::Command::SpawnActor>("SpawnActor")
+    .def("__init__", make_constructor(&MakeSpawnActor, default_call_policies(),
+        (arg("blueprint"), arg("transform"))))
+    .def("__init__", make_constructor(&MakeSpawnActorWithParent, default_call_policies(),
+        (arg("blueprint"), arg("transform"), arg("parent_id"))))
+    .def_readwrite("transform", &cr::Command::SpawnActor::transform)
+    .def("then", +[](cr::Command::SpawnActor &self, cr::Command command) {
+      self.do_after.push_back(std::move(command));
+    }, (arg("command")), return_self<>())
+  ;
+
   class_<cr::Command::DestroyActor>("DestroyActor")
     .def(init<cr::ActorId>((arg("actor_id"))))
     .def_readwrite("actor_id", &cr::Command::DestroyActor::actor)
@@ -69,6 +109,7 @@ void export_commands() {
     .def_readwrite("enabled", &cr::Command::SetAutopilot::enabled)
   ;
 
+  implicitly_convertible<cr::Command::SpawnActor, cr::Command>();
   implicitly_convertible<cr::Command::DestroyActor, cr::Command>();
   implicitly_convertible<cr::Command::ApplyVehicleControl, cr::Command>();
   implicitly_convertible<cr::Command::ApplyWalkerControl, cr::Command>();
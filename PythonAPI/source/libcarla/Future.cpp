@@ -0,0 +1,48 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include <boost/python/stl_iterator.hpp>
+
+#include <exception>
+
+static auto WhenAll(const boost::python::object &futures) {
+  std::vector<PythonFuture> list{
+      boost::python::stl_input_iterator<PythonFuture>(futures),
+      boost::python::stl_input_iterator<PythonFuture>()};
+  // Retrieve every result before raising, so no request is left in flight.
+  boost::python::list result;
+  std::exception_ptr error;
+  PyObject *type = nullptr, *value = nullptr, *traceback = nullptr;
+  for (auto &future : list) {
+    try {
+      result.append(future.Result());
+    } catch (...) {
+      if (error == nullptr) {
+        error = std::current_exception();
+        PyErr_Fetch(&type, &value, &traceback);
+      } else {
+        PyErr_Clear();
+      }
+    }
+  }
+  if (error != nullptr) {
+    PyErr_Restore(type, value, traceback);
+    std::rethrow_exception(error);
+  }
+  return result;
+}
+
+void export_future() {
+  using namespace boost::python;
+
+  class_<PythonFuture>("Future", no_init)
+    .def("done", &PythonFuture::Done)
+    .def("wait", &PythonFuture::Wait, (arg("seconds")=10.0))
+    .def("result", &PythonFuture::Result)
+  ;
+
+  def("when_all", &WhenAll, (arg("futures")));
+}
@@ -6,8 +6,10 @@
 
 #include <carla/FileSystem.h>
 #include <carla/PythonUtil.h>
+#include <carla/client/LaneOccupancyIndex.h>
 #include <carla/client/Map.h>
 #include <carla/client/Waypoint.h>
+#include <carla/road/RoutePlanner.h>
 
 #include <fstream>
 
@@ -47,24 +49,298 @@ static auto GetTopology(const carla::client::Map &self) {
   return result;
 }
 
+static auto GenerateWaypoints(
+    const carla::client::Map &self,
+    double distance,
+    carla::road::element::LaneTypeMask lane_type) {
+  boost::python::list result;
+  for (auto &&waypoint : self.GenerateWaypoints(distance, lane_type)) {
+    result.append(waypoint);
+  }
+  return result;
+}
+
+static auto GenerateWaypointArrays(
+    const carla::client::Map &self,
+    double distance,
+    carla::road::element::LaneTypeMask lane_type) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  return self.GenerateWaypointArrays(distance, lane_type);
+}
+
+static auto GetTopologyArrays(const carla::client::Map &self) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  return self.GetTopologyArrays();
+}
+
+static auto MakeWaypoint(
+    const carla::client::Map &self,
+    carla::road::element::id_type road_id,
+    int lane_id,
+    double s) {
+  return self.MakeWaypoint({road_id, lane_id, s});
+}
+
+static auto MakeRoutePlanner(const carla::client::Map &self, double lane_change_cost) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  return self.MakeRoutePlanner(lane_change_cost);
+}
+
+static void BuildContractionHierarchy(carla::road::RoutePlanner &self) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  self.BuildContractionHierarchy();
+}
+
+static auto ComputeRoute(
+    const carla::road::RoutePlanner &self,
+    const carla::geom::Location &origin,
+    const carla::geom::Location &destination,
+    double step) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  return self.ComputeRoute(origin, destination, step);
+}
+
+static auto ComputeRoutes(
+    const carla::road::RoutePlanner &self,
+    const boost::python::object &queries,
+    double step,
+    size_t number_of_threads) {
+  namespace py = boost::python;
+  std::vector<std::pair<carla::geom::Location, carla::geom::Location>> pairs;
+  const auto size = py::len(queries);
+  pairs.reserve(size);
+  for (auto i = 0u; i < size; ++i) {
+    pairs.emplace_back(
+        py::extract<carla::geom::Location>(queries[i][0]),
+        py::extract<carla::geom::Location>(queries[i][1]));
+  }
+  std::vector<carla::road::Route> routes;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    routes = self.ComputeRoutes(pairs, step, number_of_threads);
+  }
+  py::list result;
+  for (auto &&route : routes) {
+    result.append(route);
+  }
+  return result;
+}
+
+static auto MakeLaneOccupancyIndex(const carla::client::Map &self, double cell_size) {
+  return self.MakeLaneOccupancyIndex(cell_size);
+}
+
+static void UpdateLaneOccupancyIndex(
+    carla::client::LaneOccupancyIndex &self,
+    size_t frame_count,
+    const boost::python::object &ids,
+    const boost::python::object &locations) {
+  namespace py = boost::python;
+  const auto size = py::len(ids);
+  if (py::len(locations) != size) {
+    PyErr_SetString(PyExc_ValueError, "ids and locations must have the same length");
+    py::throw_error_already_set();
+  }
+  std::vector<carla::ActorId> actor_ids;
+  std::vector<carla::geom::Location> actor_locations;
+  actor_ids.reserve(size);
+  actor_locations.reserve(size);
+  for (auto i = 0u; i < size; ++i) {
+    actor_ids.emplace_back(py::extract<carla::ActorId>(ids[i]));
+    actor_locations.emplace_back(py::extract<carla::geom::Location>(locations[i]));
+  }
+  carla::PythonUtil::ReleaseGIL unlock;
+  self.Update(frame_count, actor_ids, actor_locations);
+}
+
+template <typename T>
+static boost::python::object OptionalToPython(const boost::optional<T> &optional) {
+  return optional.has_value() ? boost::python::object(*optional) : boost::python::object();
+}
+
+static boost::python::object NeighborToPython(
+    const boost::optional<carla::client::LaneOccupancyIndex::Neighbor> &neighbor) {
+  if (!neighbor.has_value()) {
+    return boost::python::object();
+  }
+  return boost::python::make_tuple(neighbor->occupant, neighbor->distance);
+}
+
+static boost::python::list OccupantsToPython(const std::vector<carla::client::LaneOccupant> &occupants) {
+  boost::python::list result;
+  for (auto &&occupant : occupants) {
+    result.append(occupant);
+  }
+  return result;
+}
+
 static carla::geom::GeoLocation ToGeolocation(
     const carla::client::Map &self,
     const carla::geom::Location &location) {
   return self.GetGeoReference().Transform(location);
 }
 
+static carla::geom::Location FromGeolocation(
+    const carla::client::Map &self,
+    const carla::geom::GeoLocation &geo_location) {
+  return self.GetGeoReference().InverseTransform(geo_location);
+}
+
+/// Numbers of @a object, (x, y, z) or (latitude, longitude, altitude) per
+/// point, e.g. a NumPy array of shape (n, 3).
+static std::vector<double> CopyPointsBuffer(const boost::python::object &object) {
+  auto result = CopyBufferToDoubles(object);
+  if (result.size() % 3u != 0u) {
+    PyErr_SetString(PyExc_ValueError, "expected three numbers per point");
+    boost::python::throw_error_already_set();
+  }
+  return result;
+}
+
+static auto ToGeolocations(const carla::client::Map &self, const boost::python::object &locations) {
+  const auto values = CopyPointsBuffer(locations);
+  std::vector<carla::geom::GeoLocation> result(values.size() / 3u);
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    std::vector<carla::geom::Location> points;
+    points.reserve(result.size());
+    for (auto i = 0u; i < values.size(); i += 3u) {
+      points.emplace_back(
+          static_cast<float>(values[i]),
+          static_cast<float>(values[i + 1u]),
+          static_cast<float>(values[i + 2u]));
+    }
+    self.GetGeoReference().Transform(points.data(), points.size(), result.data());
+  }
+  return CopyArrayToBuffer(result);
+}
+
+static auto FromGeolocations(const carla::client::Map &self, const boost::python::object &geo_locations) {
+  const auto values = CopyPointsBuffer(geo_locations);
+  std::vector<carla::geom::Location> result(values.size() / 3u);
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    std::vector<carla::geom::GeoLocation> points;
+    points.reserve(result.size());
+    for (auto i = 0u; i < values.size(); i += 3u) {
+      points.emplace_back(values[i], values[i + 1u], values[i + 2u]);
+    }
+    self.GetGeoReference().InverseTransform(points.data(), points.size(), result.data());
+  }
+  return CopyArrayToBuffer(result);
+}
+
 void export_map() {
   using namespace boost::python;
   namespace cc = carla::client;
   namespace cg = carla::geom;
+  namespace cr = carla::road;
+  namespace cre = carla::road::element;
+
+  enum_<cre::LaneType>("LaneType")
+    .value("None", cre::LaneType::None)
+    .value("Driving", cre::LaneType::Driving)
+    .value("Stop", cre::LaneType::Stop)
+    .value("Shoulder", cre::LaneType::Shoulder)
+    .value("Biking", cre::LaneType::Biking)
+    .value("Sidewalk", cre::LaneType::Sidewalk)
+    .value("Border", cre::LaneType::Border)
+    .value("Restricted", cre::LaneType::Restricted)
+    .value("Parking", cre::LaneType::Parking)
+    .value("Bidirectional", cre::LaneType::Bidirectional)
+    .value("Median", cre::LaneType::Median)
+    .value("Special1", cre::LaneType::Special1)
+    .value("Special2", cre::LaneType::Special2)
+    .value("Special3", cre::LaneType::Special3)
+    .value("RoadWorks", cre::LaneType::RoadWorks)
+    .value("Tram", cre::LaneType::Tram)
+    .value("Rail", cre::LaneType::Rail)
+    .value("Entry", cre::LaneType::Entry)
+    .value("Exit", cre::LaneType::Exit)
+    .value("OffRamp", cre::LaneType::OffRamp)
+    .value("OnRamp", cre::LaneType::OnRamp)
+    .value("Any", cre::LaneType::Any)
+  ;
+
+#define ARRAY_AS_BUFFER(name) +[](const cr::WaypointArrays &self) { \
+      return CopyArrayToBuffer(self.name); \
+    }
+
+  class_<cr::WaypointArrays>("WaypointArrays", no_init)
+    .add_property("road_ids", ARRAY_AS_BUFFER(road_ids))
+    .add_property("lane_ids", ARRAY_AS_BUFFER(lane_ids))
+    .add_property("s", ARRAY_AS_BUFFER(s))
+    .add_property("locations", ARRAY_AS_BUFFER(locations))
+    .add_property("rotations", ARRAY_AS_BUFFER(rotations))
+    .def("__len__", &cr::WaypointArrays::size)
+  ;
+
+#undef ARRAY_AS_BUFFER
+
+  class_<cr::TopologyArrays>("TopologyArrays", no_init)
+    .def_readonly("from_waypoints", &cr::TopologyArrays::from)
+    .def_readonly("to_waypoints", &cr::TopologyArrays::to)
+    .def("__len__", &cr::TopologyArrays::size)
+  ;
+
+  class_<cr::Route>("Route", no_init)
+    .def_readonly("waypoints", &cr::Route::waypoints)
+    .def_readonly("length", &cr::Route::length)
+    .def("__len__", +[](const cr::Route &self) { return self.waypoints.size(); })
+  ;
+
+  class_<cr::RoutePlanner, boost::noncopyable, boost::shared_ptr<cr::RoutePlanner>>("RoutePlanner", no_init)
+    .add_property("number_of_lanes", &cr::RoutePlanner::GetNumberOfNodes)
+    .add_property("has_contraction_hierarchy", &cr::RoutePlanner::HasContractionHierarchy)
+    .def("build_contraction_hierarchy", &BuildContractionHierarchy)
+    .def("compute_route", &ComputeRoute, (arg("origin"), arg("destination"), arg("step")=2.0))
+    .def("compute_routes", &ComputeRoutes, (arg("queries"), arg("step")=2.0, arg("number_of_threads")=0u))
+  ;
+
+  class_<cc::LaneOccupant>("LaneOccupant", no_init)
+    .def_readonly("id", &cc::LaneOccupant::id)
+    .add_property("road_id", +[](const cc::LaneOccupant &self) { return self.waypoint.road_id; })
+    .add_property("lane_id", +[](const cc::LaneOccupant &self) { return self.waypoint.lane_id; })
+    .add_property("s", +[](const cc::LaneOccupant &self) { return self.waypoint.s; })
+    .def_readonly("location", &cc::LaneOccupant::location)
+  ;
+
+  class_<cc::LaneOccupancyIndex, boost::noncopyable, boost::shared_ptr<cc::LaneOccupancyIndex>>("LaneOccupancyIndex", no_init)
+    .add_property("frame_count", &cc::LaneOccupancyIndex::GetFrameCount)
+    .def("__len__", &cc::LaneOccupancyIndex::size)
+    .def("update", &UpdateLaneOccupancyIndex, (arg("frame_count"), arg("ids"), arg("locations")))
+    .def("get_actor", +[](const cc::LaneOccupancyIndex &self, carla::ActorId id) {
+      return OptionalToPython(self.GetActor(id));
+    }, (arg("id")))
+    .def("get_actors_in_lane", +[](const cc::LaneOccupancyIndex &self, cre::id_type road_id, int lane_id, double s_min, double s_max) {
+      return OccupantsToPython(self.GetActorsInLane(road_id, lane_id, s_min, s_max));
+    }, (arg("road_id"), arg("lane_id"), arg("s_min"), arg("s_max")))
+    .def("get_leader", +[](const cc::LaneOccupancyIndex &self, carla::ActorId id, double max_distance) {
+      return NeighborToPython(self.GetLeader(id, max_distance));
+    }, (arg("id"), arg("max_distance")=100.0))
+    .def("get_follower", +[](const cc::LaneOccupancyIndex &self, carla::ActorId id, double max_distance) {
+      return NeighborToPython(self.GetFollower(id, max_distance));
+    }, (arg("id"), arg("max_distance")=100.0))
+    .def("get_actors_in_radius", +[](const cc::LaneOccupancyIndex &self, const cg::Location &location, double radius) {
+      return OccupantsToPython(self.GetActorsInRadius(location, radius));
+    }, (arg("location"), arg("radius")))
+  ;
 
   class_<cc::Map, boost::noncopyable, boost::shared_ptr<cc::Map>>("Map", no_init)
     .add_property("name", CALL_RETURNING_COPY(cc::Map, GetName))
     .def("get_spawn_points", CALL_RETURNING_LIST(cc::Map, GetRecommendedSpawnPoints))
     .def("get_waypoint", &cc::Map::GetWaypoint, (arg("location"), arg("project_to_road")=true))
     .def("get_topology", &GetTopology)
-    .def("generate_waypoints", CALL_RETURNING_LIST_1(cc::Map, GenerateWaypoints, double), (args("distance")))
+    .def("generate_waypoints", &GenerateWaypoints, (arg("distance"), arg("lane_type")=static_cast<cre::LaneTypeMask>(cre::LaneType::Driving)))
+    .def("generate_waypoint_arrays", &GenerateWaypointArrays, (arg("distance"), arg("lane_type")=static_cast<cre::LaneTypeMask>(cre::LaneType::Driving)))
+    .def("get_topology_arrays", &GetTopologyArrays)
+    .def("make_waypoint", &MakeWaypoint, (arg("road_id"), arg("lane_id"), arg("s")))
+    .def("make_route_planner", &MakeRoutePlanner, (arg("lane_change_cost")=10.0))
+    .def("make_lane_occupancy_index", &MakeLaneOccupancyIndex, (arg("cell_size")=20.0))
     .def("transform_to_geolocation", &ToGeolocation, (arg("location")))
+    .def("transform_from_geolocation", &FromGeolocation, (arg("geolocation")))
+    .def("transform_to_geolocations", &ToGeolocations, (arg("locations")))
+    .def("transform_from_geolocations", &FromGeolocations, (arg("geolocations")))
     .def("to_opendrive", CALL_RETURNING_COPY(cc::Map, GetOpenDrive))
     .def("save_to_disk", &SaveOpenDriveToDisk, (arg("path")=""))
     .def(self_ns::str(self_ns::self))
@@ -6,9 +6,13 @@
 
 #include <carla/PythonUtil.h>
 #include <carla/client/Actor.h>
+#include <carla/client/ActorChanges.h>
 #include <carla/client/ActorList.h>
+#include <carla/client/LaneOccupancyIndex.h>
+#include <carla/client/Sensor.h>
 #include <carla/client/World.h>
 
+#include <boost/python/stl_iterator.hpp>
 #include <boost/python/suite/indexing/vector_indexing_suite.hpp>
 
 namespace carla {
@@ -26,6 +30,29 @@ namespace client {
     return out;
   }
 
+  std::ostream &operator<<(std::ostream &out, const ActorChanges &changes) {
+    out << "ActorChanges(frame_count=" << changes.frame_count
+        << ",spawned=" << changes.spawned->size()
+        << ",destroyed=" << changes.destroyed.size()
+        << ",truncated=" << (changes.truncated ? "True" : "False") << ')';
+    return out;
+  }
+
+  std::ostream &operator<<(std::ostream &out, const CallbackMetrics &metrics) {
+    out << "CallbackMetrics(id=" << metrics.id
+        << ",call_count=" << metrics.call_count
+        << ",dropped_count=" << metrics.dropped_count
+        << ",mean_queue_time=" << metrics.mean_queue_time
+        << ",mean_execution_time=" << metrics.mean_execution_time << ')';
+    return out;
+  }
+
+  std::ostream &operator<<(std::ostream &out, const StepFrame &frame) {
+    out << "StepFrame(frame_count=" << frame.timestamp.frame_count
+        << ",sensor_data=" << frame.sensor_data.size() << ')';
+    return out;
+  }
+
   std::ostream &operator<<(std::ostream &out, const World &world) {
     out << "World(id=" << world.GetId() << ')';
     return out;
@@ -52,8 +79,74 @@ static auto WaitForTick(const carla::client::World &world, double seconds) {
   return world.WaitForTick(TimeDurationFromSeconds(seconds));
 }
 
-static void OnTick(carla::client::World &self, boost::python::object callback) {
-  self.OnTick(MakeCallback(std::move(callback)));
+static auto OnTick(carla::client::World &self, boost::python::object callback, bool coalesce) {
+  return self.OnTick(MakeCallback(std::move(callback)), coalesce);
+}
+
+static void Step(
+    carla::client::World &self,
+    size_t number_of_frames,
+    boost::python::object callback,
+    const boost::python::object &sensors,
+    size_t max_in_flight,
+    double seconds) {
+  using SensorPtr = carla::SharedPtr<carla::client::Sensor>;
+  std::vector<SensorPtr> sensor_list{
+      boost::python::stl_input_iterator<SensorPtr>(sensors),
+      boost::python::stl_input_iterator<SensorPtr>()};
+  auto on_frame = MakeCallback(std::move(callback));
+  carla::PythonUtil::ReleaseGIL unlock;
+  self.Step(
+      number_of_frames,
+      std::move(on_frame),
+      sensor_list,
+      max_in_flight,
+      TimeDurationFromSeconds(seconds));
+}
+
+/// ActorStateArrays with its arrays already converted to Python bytes, so
+/// reading an attribute does not copy the array again.
+struct PythonActorStateArrays {
+  size_t frame_count;
+  size_t size;
+  boost::python::object ids;
+  boost::python::object valid;
+  boost::python::object locations;
+  boost::python::object rotations;
+  boost::python::object velocities;
+  boost::python::object angular_velocities;
+  boost::python::object accelerations;
+  boost::python::object vehicle_controls;
+};
+
+static auto GetActorStates(
+    const carla::client::World &self,
+    const boost::python::object &actor_ids,
+    uint32_t fields) {
+  std::vector<carla::ActorId> ids{
+      boost::python::stl_input_iterator<carla::ActorId>(actor_ids),
+      boost::python::stl_input_iterator<carla::ActorId>()};
+  carla::client::ActorStateArrays arrays;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    arrays = self.GetActorStates(ids, fields);
+  }
+  PythonActorStateArrays result;
+  result.frame_count = arrays.frame_count;
+  result.size = arrays.ids.size();
+  result.ids = CopyArrayToBuffer(arrays.ids);
+  result.valid = CopyArrayToBuffer(arrays.valid);
+  result.locations = CopyArrayToBuffer(arrays.locations);
+  result.rotations = CopyArrayToBuffer(arrays.rotations);
+  result.velocities = CopyArrayToBuffer(arrays.velocities);
+  result.angular_velocities = CopyArrayToBuffer(arrays.angular_velocities);
+  result.accelerations = CopyArrayToBuffer(arrays.accelerations);
+  result.vehicle_controls = CopyArrayToBuffer(arrays.vehicle_controls);
+  return result;
+}
+
+static auto OnActorsChanged(carla::client::World &self, boost::python::object callback) {
+  return self.OnActorsChanged(MakeCallback(std::move(callback)));
 }
 
 void export_world() {
@@ -86,6 +179,73 @@ void export_world() {
     .def(self_ns::str(self_ns::self))
   ;
 
+  class_<cc::ActorChanges>("ActorChanges", no_init)
+    .def_readonly("frame_count", &cc::ActorChanges::frame_count)
+    .add_property("spawned", +[](const cc::ActorChanges &self) { return self.spawned; })
+    .add_property("destroyed", +[](const cc::ActorChanges &self) {
+      boost::python::list result;
+      for (auto id : self.destroyed) {
+        result.append(id);
+      }
+      return result;
+    })
+    .def_readonly("truncated", &cc::ActorChanges::truncated)
+    .def(self_ns::str(self_ns::self))
+  ;
+
+  enum_<cc::ActorStateArrays::Field>("ActorStateField")
+    .value("None", cc::ActorStateArrays::None)
+    .value("Location", cc::ActorStateArrays::Location)
+    .value("Rotation", cc::ActorStateArrays::Rotation)
+    .value("Velocity", cc::ActorStateArrays::Velocity)
+    .value("AngularVelocity", cc::ActorStateArrays::AngularVelocity)
+    .value("Acceleration", cc::ActorStateArrays::Acceleration)
+    .value("VehicleControl", cc::ActorStateArrays::VehicleControl)
+    .value("All", cc::ActorStateArrays::All)
+  ;
+
+#define ARRAY_ATTRIBUTE(name) +[](const PythonActorStateArrays &self) { \
+      return self.name; \
+    }
+
+  class_<PythonActorStateArrays>("ActorStateArrays", no_init)
+    .def_readonly("frame_count", &PythonActorStateArrays::frame_count)
+    .add_property("ids", ARRAY_ATTRIBUTE(ids))
+    .add_property("valid", ARRAY_ATTRIBUTE(valid))
+    .add_property("locations", ARRAY_ATTRIBUTE(locations))
+    .add_property("rotations", ARRAY_ATTRIBUTE(rotations))
+    .add_property("velocities", ARRAY_ATTRIBUTE(velocities))
+    .add_property("angular_velocities", ARRAY_ATTRIBUTE(angular_velocities))
+    .add_property("accelerations", ARRAY_ATTRIBUTE(accelerations))
+    .add_property("vehicle_controls", ARRAY_ATTRIBUTE(vehicle_controls))
+    .def("__len__", +[](const PythonActorStateArrays &self) { return self.size; })
+  ;
+
+#undef ARRAY_ATTRIBUTE
+
+  class_<cc::CallbackMetrics>("CallbackMetrics", no_init)
+    .def_readonly("id", &cc::CallbackMetrics::id)
+    .def_readonly("call_count", &cc::CallbackMetrics::call_count)
+    .def_readonly("dropped_count", &cc::CallbackMetrics::dropped_count)
+    .def_readonly("mean_queue_time", &cc::CallbackMetrics::mean_queue_time)
+    .def_readonly("max_queue_time", &cc::CallbackMetrics::max_queue_time)
+    .def_readonly("mean_execution_time", &cc::CallbackMetrics::mean_execution_time)
+    .def_readonly("max_execution_time", &cc::CallbackMetrics::max_execution_time)
+    .def(self_ns::str(self_ns::self))
+  ;
+
+  class_<cc::StepFrame>("StepFrame", no_init)
+    .def_readonly("timestamp", &cc::StepFrame::timestamp)
+    .add_property("sensor_data", +[](const cc::StepFrame &self) {
+      boost::python::list result;
+      for (auto &data : self.sensor_data) {
+        result.append(data);
+      }
+      return result;
+    })
+    .def(self_ns::str(self_ns::self))
+  ;
+
   class_<cr::EpisodeSettings>("WorldSettings")
     .def(init<bool, bool>(
         (arg("synchronous_mode")=false,
@@ -118,11 +278,29 @@ void export_world() {
     .def("get_weather", CONST_CALL_WITHOUT_GIL(cc::World, GetWeather))
     .def("set_weather", &cc::World::SetWeather)
     .def("get_actors", CONST_CALL_WITHOUT_GIL(cc::World, GetActors))
+    .def("get_actor_changes", CONST_CALL_WITHOUT_GIL_1(cc::World, GetActorChanges, size_t), (arg("since_frame")=0u))
+    .def("get_actor_states", &GetActorStates, (arg("actor_ids"), arg("fields")=uint32_t(cc::ActorStateArrays::All)))
+    .def("make_lane_occupancy_index", +[](cc::World &self, const std::string &actor_filter, double cell_size) {
+      carla::PythonUtil::ReleaseGIL unlock;
+      return self.MakeLaneOccupancyIndex(actor_filter, cell_size);
+    }, (arg("actor_filter")="vehicle.*", arg("cell_size")=20.0))
     .def("spawn_actor", SPAWN_ACTOR_WITHOUT_GIL(SpawnActor))
     .def("try_spawn_actor", SPAWN_ACTOR_WITHOUT_GIL(TrySpawnActor))
+    .def("spawn_actor_async", +[](
+        cc::World &self,
+        const cc::ActorBlueprint &blueprint,
+        const cg::Transform &transform,
+        cc::Actor *parent) {
+      carla::PythonUtil::ReleaseGIL unlock;
+      return PythonFuture(self.AsyncSpawnActor(blueprint, transform, parent));
+    }, (arg("blueprint"), arg("transform"), arg("attach_to")=carla::SharedPtr<cc::Actor>()))
     .def("wait_for_tick", &WaitForTick, (arg("seconds")=10.0))
-    .def("on_tick", &OnTick, (arg("callback")))
+    .def("on_tick", &OnTick, (arg("callback"), arg("coalesce")=false))
+    .def("on_actors_changed", &OnActorsChanged, (arg("callback")))
+    .def("set_callback_worker_threads", &cc::World::SetCallbackWorkerThreads, (arg("worker_threads")))
+    .def("get_callback_metrics", CALL_RETURNING_LIST(cc::World, GetCallbackMetrics))
     .def("tick", &cc::World::Tick)
+    .def("step", &Step, (arg("frames"), arg("on_frame"), arg("sensors")=list(), arg("max_in_flight")=2u, arg("seconds")=10.0))
     .def(self_ns::str(self_ns::self))
   ;
 
@@ -7,7 +7,11 @@
 #include <carla/Memory.h>
 #include <carla/PythonUtil.h>
 #include <carla/Time.h>
+#include <carla/client/Future.h>
 
+#include <boost/optional.hpp>
+
+#include <functional>
 #include <ostream>
 #include <type_traits>
 #include <vector>
@@ -121,6 +125,40 @@ static carla::time_duration TimeDurationFromSeconds(double seconds) {
   return carla::time_duration::milliseconds(ms);
 }
 
+template <typename T>
+static boost::python::object CopyArrayToBuffer(const std::vector<T> &array) {
+  auto *data = reinterpret_cast<const char *>(array.data());
+  auto size = sizeof(T) * array.size();
+  return boost::python::object(boost::python::handle<>(PyBytes_FromStringAndSize(data, size)));
+}
+
+/// Copy the numbers of @a object, any object supporting the buffer protocol
+/// with float32 or float64 items (e.g. a NumPy array), as doubles.
+static std::vector<double> CopyBufferToDoubles(const boost::python::object &object) {
+  namespace py = boost::python;
+  Py_buffer view;
+  if (PyObject_GetBuffer(object.ptr(), &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+    py::throw_error_already_set();
+  }
+  std::vector<double> result;
+  const std::string format = view.format != nullptr ? view.format : "B";
+  const auto type = format.empty() ? 'B' : format.back();
+  const bool native = (format.size() == 1u) || (format[0u] == '=') || (format[0u] == '@');
+  if (native && (type == 'f') && (view.itemsize == sizeof(float))) {
+    const auto *data = reinterpret_cast<const float *>(view.buf);
+    result.assign(data, data + view.len / sizeof(float));
+  } else if (native && (type == 'd') && (view.itemsize == sizeof(double))) {
+    const auto *data = reinterpret_cast<const double *>(view.buf);
+    result.assign(data, data + view.len / sizeof(double));
+  } else {
+    PyBuffer_Release(&view);
+    PyErr_SetString(PyExc_TypeError, "expected a contiguous buffer of float32 or float64");
+    py::throw_error_already_set();
+  }
+  PyBuffer_Release(&view);
+  return result;
+}
+
 static auto MakeCallback(boost::python::object callback) {
   namespace py = boost::python;
   // Make sure the callback is actually callable.
@@ -144,6 +182,62 @@ static auto MakeCallback(boost::python::object callback) {
   };
 }
 
+/// Type-erased handle to a carla::client::Future, exposed as carla.Future.
+/// The result is waited for without the GIL and converted to a Python
+/// object with the GIL held.
+class PythonFuture {
+public:
+
+  template <typename T, typename ConvertF>
+  PythonFuture(carla::client::Future<T> future, ConvertF convert)
+    : _wait([future](carla::time_duration timeout) { return future.WaitFor(timeout); }),
+      _get([future, convert]() {
+        boost::optional<T> value;
+        {
+          carla::PythonUtil::ReleaseGIL unlock;
+          value = future.Get();
+        }
+        return convert(*value);
+      }) {}
+
+  template <typename T>
+  explicit PythonFuture(carla::client::Future<T> future)
+    : PythonFuture(std::move(future), [](const T &value) {
+        return boost::python::object(value);
+      }) {}
+
+  bool Done() const {
+    return _wait(carla::time_duration::milliseconds(0u));
+  }
+
+  bool Wait(double seconds) const {
+    carla::PythonUtil::ReleaseGIL unlock;
+    return _wait(TimeDurationFromSeconds(seconds));
+  }
+
+  boost::python::object Result() const {
+    return _get();
+  }
+
+private:
+
+  std::function<bool(carla::time_duration)> _wait;
+
+  std::function<boost::python::object()> _get;
+};
+
+/// Convert a future holding a vector to a future of a Python list.
+template <typename T>
+static PythonFuture MakeListFuture(carla::client::Future<std::vector<T>> future) {
+  return PythonFuture(std::move(future), [](const std::vector<T> &values) {
+    boost::python::list result;
+    for (auto &&value : values) {
+      result.append(value);
+    }
+    return boost::python::object(result);
+  });
+}
+
 #include "Geom.cpp"
 #include "Actor.cpp"
 #include "Blueprint.cpp"
@@ -156,6 +250,7 @@ static auto MakeCallback(boost::python::object callback) {
 #include "Weather.cpp"
 #include "World.cpp"
 #include "Commands.cpp"
+#include "Future.cpp"
 
 BOOST_PYTHON_MODULE(libcarla) {
   using namespace boost::python;
@@ -173,4 +268,5 @@ BOOST_PYTHON_MODULE(libcarla) {
   export_client();
   export_exception();
   export_commands();
+  export_future();
 }
@@ -19,6 +19,7 @@
 #include <carla/rpc/ActorDefinition.h>
 #include <carla/rpc/ActorDescription.h>
 #include <carla/rpc/Command.h>
+#include <carla/rpc/CommandBatch.h>
 #include <carla/rpc/DebugShape.h>
 #include <carla/rpc/EpisodeInfo.h>
 #include <carla/rpc/EpisodeSettings.h>
@@ -776,29 +777,64 @@ void FTheNewCarlaServer::FPimpl::BindActions()
 
   using C = cr::Command;
 
+  auto spawn_command_actor = [=](const C::SpawnActor &c) -> R<cr::ActorId>
+  {
+    auto Result = c.parent.has_value() ?
+        spawn_actor_with_parent(c.description, c.transform, *c.parent) :
+        spawn_actor(c.description, c.transform);
+    if (!Result)
+    {
+      return Result.GetError();
+    }
+    return Result.Get().id;
+  };
+
   auto command_visitor = carla::MakeOverload(
-      [=](const C::DestroyActor &c) { destroy_actor(c.actor); },
-      [=](const C::ApplyVehicleControl &c) { apply_control_to_vehicle(c.actor, c.control); },
-      [=](const C::ApplyWalkerControl &c) { apply_control_to_walker(c.actor, c.control); },
-      [=](const C::ApplyTransform &c) { set_actor_transform(c.actor, c.transform); },
-      [=](const C::ApplyVelocity &c) { set_actor_velocity(c.actor, c.velocity); },
-      [=](const C::ApplyAngularVelocity &c) { set_actor_angular_velocity(c.actor, c.angular_velocity); },
-      [=](const C::ApplyImpulse &c) { add_actor_impulse(c.actor, c.impulse); },
-      [=](const C::SetSimulatePhysics &c) { set_actor_simulate_physics(c.actor, c.enabled); },
-      [=](const C::SetAutopilot &c) { set_actor_autopilot(c.actor, c.enabled); },
-      [](const auto &) { UE_LOG(LogCarla, Fatal, TEXT("Invalid command!")); });
+      [=](const C::DestroyActor &c) { return destroy_actor(c.actor); },
+      [=](const C::ApplyVehicleControl &c) { return apply_control_to_vehicle(c.actor, c.control); },
+      [=](const C::ApplyWalkerControl &c) { return apply_control_to_walker(c.actor, c.control); },
+      [=](const C::ApplyTransform &c) { return set_actor_transform(c.actor, c.transform); },
+      [=](const C::ApplyVelocity &c) { return set_actor_velocity(c.actor, c.velocity); },
+      [=](const C::ApplyAngularVelocity &c) { return set_actor_angular_velocity(c.actor, c.angular_velocity); },
+      [=](const C::ApplyImpulse &c) { return add_actor_impulse(c.actor, c.impulse); },
+      [=](const C::SetSimulatePhysics &c) { return set_actor_simulate_physics(c.actor, c.enabled); },
+      [=](const C::SetAutopilot &c) { return set_actor_autopilot(c.actor, c.enabled); },
+      [](const auto &) -> R<void> { RESPOND_ERROR("invalid command"); });
+
+  auto apply_command = [=](const cr::Command &command) -> R<void>
+  {
+    return boost::apply_visitor(command_visitor, command.command);
+  };
 
   BIND_SYNC(apply_batch) << [=](const std::vector<cr::Command> &commands, bool do_tick_cue) -> R<void>
   {
-    for (const auto &command : commands)
+    cr::ExecuteCommandBatch(commands, spawn_command_actor, apply_command);
+    if (do_tick_cue)
     {
-      boost::apply_visitor(command_visitor, command.command);
+      tick_cue();
     }
+    return R<void>::Success();
+  };
+
+  BIND_SYNC(apply_batch_sync) << [=](
+      const std::vector<cr::Command> &commands,
+      bool do_tick_cue) -> R<std::vector<cr::CommandResponse>>
+  {
+    auto Responses = cr::ExecuteCommandBatch(commands, spawn_command_actor, apply_command);
     if (do_tick_cue)
     {
       tick_cue();
     }
-    return R<void>::Success();
+    return Responses;
+  };
+
+  BIND_SYNC(apply_batch_and_tick) << [=](const std::vector<cr::Command> &commands) -> R<uint64_t>
+  {
+    cr::ExecuteCommandBatch(commands, spawn_command_actor, apply_command);
+    tick_cue();
+    // Sync calls run on the game thread after the current frame has ticked,
+    // every pending cue releases one more frame.
+    return GFrameCounter + TickCuesReceived;
   };
 }
 